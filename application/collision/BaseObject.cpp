@@ -8,12 +8,14 @@ void BaseObject::Initialize(const Vector3 &position, float radius, CollisionType
 
 	// キャラの位置とコライダーの位置を同期
 	collider_->SetPosition(position); // カプセルの位置を設定
+	collider_->SetPreviousPosition(position);
 	collider_->SetRadius(radius);	  // カプセルの半径を設定
 
 	// 衝突タイプとグループ設定
 	collisionType_ = type;
 	group_ = group;
 	isCollisionEnabled_ = true;
+	isCollisionResponseEnabled_ = true;
 
 	// デフォルトではすべてのグループと衝突（デフォルトは 0xFFFF）
 	collisionLayerMask_ = 0xFFFF;
@@ -22,5 +24,37 @@ void BaseObject::Initialize(const Vector3 &position, float radius, CollisionType
 ///=============================================================================
 ///						更新
 void BaseObject::Update(const Vector3 &position) {
+	// 移動判定用に更新前の位置を保持
+	collider_->SetPreviousPosition(collider_->GetPosition());
 	collider_->SetPosition(position);
 }
+
+///=============================================================================
+///						更新（前フレーム位置を指定）
+void BaseObject::Update(const Vector3 &previousPosition, const Vector3 &position) {
+	collider_->SetPreviousPosition(previousPosition);
+	collider_->SetPosition(position);
+}
+
+///=============================================================================
+///						移動判定の有効/無効
+void BaseObject::SetSweptCollisionEnabled(bool enabled) {
+	if (!collider_)
+		return;
+	// 切り替え時に前フレーム位置を揃え、過去の位置からの掃引を防ぐ
+	collider_->SetPreviousPosition(collider_->GetPosition());
+	collider_->SetSwept(enabled);
+}
+
+///=============================================================================
+///						衝突中のオブジェクトを削除
+void BaseObject::RemoveCollidingObject(BaseObject *other) {
+	for (size_t i = 0; i < collidingObjects_.size(); ++i) {
+		if (collidingObjects_[i] == other) {
+			// 末尾と入れ替えて削除
+			collidingObjects_[i] = collidingObjects_.back();
+			collidingObjects_.pop_back();
+			return;
+		}
+	}
+}
@@ -4,7 +4,11 @@ using namespace MagMath;
 #include "Collider.h"
 #include <cstdint>
 #include <memory>
-#include <unordered_set>
+#include <vector>
+
+//========================================
+// 未登録を表す衝突ID
+constexpr uint32_t kInvalidCollisionId = 0xFFFFFFFFu;
 
 ///=============================================================================
 ///						衝突判定タイプ
@@ -50,8 +54,14 @@ public:
 
 	/// @brief 更新
 	/// @param position 最新の位置情報（毎フレーム更新される）
+	/// @note 移動判定が有効な場合、更新前の位置を前フレーム位置として保持する
 	void Update(const Vector3 &position);
 
+	/// @brief 更新（前フレーム位置を明示的に指定）
+	/// @param previousPosition 移動開始位置（ワープ時は現在位置と同じ値を渡す）
+	/// @param position 最新の位置情報
+	void Update(const Vector3 &previousPosition, const Vector3 &position);
+
 	/// \brief 衝突開始時の処理
 	virtual void OnCollisionEnter(BaseObject *other) = 0;
 
@@ -71,11 +81,38 @@ public:
 		collider_ = collider;
 	}
 
-	/// \brief 衝突中のオブジェクトのセットの取得
-	std::unordered_set<BaseObject *> &GetCollidingObjects() {
+	/// \brief 衝突中のオブジェクト一覧の取得
+	const std::vector<BaseObject *> &GetCollidingObjects() const {
 		return collidingObjects_;
 	}
 
+	//========================================
+	// 衝突システム内部用（CollisionManagerから呼ばれる）
+	//========================================
+
+	/// @brief 衝突中のオブジェクトを追加
+	void AddCollidingObject(BaseObject *other) {
+		collidingObjects_.push_back(other);
+	}
+
+	/// @brief 衝突中のオブジェクトを削除（順序は保持しない）
+	void RemoveCollidingObject(BaseObject *other);
+
+	/// @brief 衝突中のオブジェクトをすべて削除
+	void ClearCollidingObjects() {
+		collidingObjects_.clear();
+	}
+
+	/// @brief 衝突ID（CollisionManagerへの登録中のみ有効）
+	uint32_t GetCollisionId() const {
+		return collisionId_;
+	}
+
+	/// @brief 衝突IDを設定
+	void SetCollisionId(uint32_t id) {
+		collisionId_ = id;
+	}
+
 	//========================================
 	// 有効/無効制御
 	//========================================
@@ -90,6 +127,30 @@ public:
 		isCollisionEnabled_ = enabled;
 	}
 
+	/// @brief 衝突応答（接触の検出とイベント）が有効かどうか
+	bool IsCollisionResponseEnabled() const {
+		return isCollisionResponseEnabled_;
+	}
+
+	/// @brief 衝突応答を有効/無効に設定
+	/// @note 無効にしても空間クエリ（ロックオン等）の対象には残る。衝突判定自体を止める場合はSetCollisionEnabled
+	void SetCollisionResponseEnabled(bool enabled) {
+		isCollisionResponseEnabled_ = enabled;
+	}
+
+	//========================================
+	// 移動判定（連続衝突判定）制御
+	//========================================
+
+	/// @brief 移動判定が有効かどうか
+	bool IsSweptCollisionEnabled() const {
+		return collider_ && collider_->IsSwept();
+	}
+
+	/// @brief 移動判定を有効/無効に設定
+	/// @note 有効にすると前フレーム位置から現在位置までの掃引球で判定し、高速な弾のすり抜けを防ぐ
+	void SetSweptCollisionEnabled(bool enabled);
+
 	//========================================
 	// 衝突タイプ制御
 	//========================================
@@ -142,12 +203,18 @@ protected:
 	// コライダー
 	std::shared_ptr<Collider> collider_;
 
-	// 衝突中のオブジェクトのセット
-	std::unordered_set<BaseObject *> collidingObjects_;
+	// 衝突中のオブジェクト一覧（接触数は少数のため線形探索で十分）
+	std::vector<BaseObject *> collidingObjects_;
+
+	// CollisionManagerが割り当てる衝突ID
+	uint32_t collisionId_ = kInvalidCollisionId;
 
 	// 衝突判定の有効/無効
 	bool isCollisionEnabled_ = true;
 
+	// 衝突応答の有効/無効（無効でも空間クエリの対象）
+	bool isCollisionResponseEnabled_ = true;
+
 	// 衝突判定タイプ
 	CollisionType collisionType_ = CollisionType::DYNAMIC;
 
@@ -1,9 +1,16 @@
 #include "Collider.h"
+#include "CollisionKernel.h"
 #include <cmath>
 
 ///=============================================================================
 ///						円同士の判定
 bool Collider::Intersects(const Collider &other) const {
+	// 移動判定は接触時刻の有無で判定
+	if (isSwept_ || other.isSwept_) {
+		float time = 0.0f;
+		return CalculateTimeOfImpact(other, time);
+	}
+
 	// 2つの球体間の距離の二乗を計算
 	Vector3 diff = position_ - other.position_;
 	float distanceSquared = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
@@ -19,7 +26,32 @@ bool Collider::Intersects(const Collider &other) const {
 ///=============================================================================
 ///						衝突詳細情報の計算
 bool Collider::GetCollisionInfo(const Collider &other, CollisionInfo &outInfo) const {
-	Vector3 diff = position_ - other.position_;
+	//========================================
+	// 移動判定の場合は接触時刻を求め、その位置で詳細を求める
+	if (isSwept_ || other.isSwept_) {
+		float time = 0.0f;
+		bool isHit = CalculateTimeOfImpact(other, time);
+		GetCollisionInfo(other, isHit ? time : 1.0f, outInfo);
+		// NOTE: 接触時刻では貫通量がほぼ0になるため、移動判定は接触時刻の有無で判定
+		return isHit;
+	}
+
+	GetCollisionInfo(other, 1.0f, outInfo);
+	return outInfo.penetration > 0.0f;
+}
+
+///=============================================================================
+///						衝突詳細情報の計算（接触時刻が既知）
+void Collider::GetCollisionInfo(const Collider &other, float timeOfImpact, CollisionInfo &outInfo) const {
+	//========================================
+	// 接触時刻の位置（移動判定でない側は現在位置に静止しているとみなす）
+	const Vector3 &startA = isSwept_ ? previousPosition_ : position_;
+	const Vector3 &startB = other.isSwept_ ? other.previousPosition_ : other.position_;
+	Vector3 positionA = startA + (position_ - startA) * timeOfImpact;
+	Vector3 positionB = startB + (other.position_ - startB) * timeOfImpact;
+	outInfo.timeOfImpact = timeOfImpact;
+
+	Vector3 diff = positionA - positionB;
 	float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y + diff.z * diff.z);
 
 	outInfo.distance = distance;
@@ -32,14 +64,26 @@ bool Collider::GetCollisionInfo(const Collider &other, CollisionInfo &outInfo) c
 	if (distance < 0.0001f) {
 		// 距離がほぼ0の場合は、上向きが法線
 		outInfo.normal = {0.0f, 1.0f, 0.0f};
-		outInfo.contactPoint = position_;
+		outInfo.contactPoint = positionA;
 	} else {
 		// 法線向きを計算
 		outInfo.normal = diff * (1.0f / distance);
 
 		// 接触点を計算（2つのコライダーの中心から半径分内側に移動）
-		outInfo.contactPoint = position_ - outInfo.normal * radius_;
+		outInfo.contactPoint = positionA - outInfo.normal * radius_;
 	}
+}
 
-	return outInfo.penetration > 0.0f;
-}
\ No newline at end of file
+///=============================================================================
+///						移動判定の接触時刻を計算
+bool Collider::CalculateTimeOfImpact(const Collider &other, float &outTime) const {
+	// 移動判定でない側は現在位置に静止しているとみなす
+	const Vector3 &startA = isSwept_ ? previousPosition_ : position_;
+	const Vector3 &startB = other.isSwept_ ? other.previousPosition_ : other.position_;
+	Vector3 start = startA - startB;
+	Vector3 motion = (position_ - startA) - (other.position_ - startB);
+
+	return CollisionKernel::SweptSphereTimeOfImpact(start.x, start.y, start.z,
+													motion.x, motion.y, motion.z,
+													radius_ + other.radius_, outTime);
+}
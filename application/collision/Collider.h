@@ -16,6 +16,7 @@ struct CollisionInfo {
 	Vector3 normal = {0.0f, 1.0f, 0.0f};	   ///< 衝突法線
 	float distance = 0.0f;					   ///< 2つのコライダーの中心間距離
 	float penetration = 0.0f;				   ///< 貫通量
+	float timeOfImpact = 1.0f;				   ///< 接触時刻（0=前フレーム位置, 1=現在位置）。移動判定なしの場合は常に1
 };
 
 ///=============================================================================
@@ -32,6 +33,26 @@ public:
 		position_ = position;
 	}
 
+	/// \brief 前フレーム位置の取得（移動判定用）
+	const Vector3 &GetPreviousPosition() const {
+		return previousPosition_;
+	}
+
+	/// \brief 前フレーム位置の設定（ワープ時などは現在位置と同じ値を設定する）
+	void SetPreviousPosition(const Vector3 &position) {
+		previousPosition_ = position;
+	}
+
+	/// \brief 移動判定（前フレーム位置から現在位置までの掃引球）が有効か
+	bool IsSwept() const {
+		return isSwept_;
+	}
+
+	/// \brief 移動判定の有効/無効
+	void SetSwept(bool swept) {
+		isSwept_ = swept;
+	}
+
 	/// \brief 半径の取得
 	float GetRadius() const {
 		return radius_;
@@ -47,6 +68,7 @@ public:
 	 * @param other 衝突判定対象となるコライダー
 	 * @return 衝突している場合true、していない場合false
 	 * @note 両コライダーの中心間距離と半径の合計で判定
+	 *       どちらかが移動判定の場合は、前フレーム位置からの移動中に接触したかで判定
 	 */
 	bool Intersects(const Collider &other) const;
 
@@ -55,13 +77,33 @@ public:
 	 * @param other 衝突判定対象となるコライダー
 	 * @param outInfo 接触点などの詳細情報を出力
 	 * @return 衝突している場合true
+	 * @note 移動判定の場合は接触時刻での位置から接触点・法線を求め、timeOfImpactに時刻を格納
 	 */
 	bool GetCollisionInfo(const Collider &other, CollisionInfo &outInfo) const;
 
+	/**
+	 * @brief 接触時刻が既知の衝突詳細情報を計算
+	 * @param other 衝突判定対象となるコライダー
+	 * @param timeOfImpact 接触時刻（移動判定なしの場合は1）
+	 * @param outInfo 接触点などの詳細情報を出力
+	 * @note 検出済みの接触に使用し、接触時刻を解き直さない（CollisionManager::GetCollisionInfo から呼ばれる）
+	 */
+	void GetCollisionInfo(const Collider &other, float timeOfImpact, CollisionInfo &outInfo) const;
+
+private:
+	/// \brief 移動判定の接触時刻を計算
+	bool CalculateTimeOfImpact(const Collider &other, float &outTime) const;
+
 private:
 	// 位置
 	Vector3 position_ = {0.0f, 0.0f, 0.0f};
 
+	// 前フレームの位置（移動判定用）
+	Vector3 previousPosition_ = {0.0f, 0.0f, 0.0f};
+
+	// 移動判定の有効/無効
+	bool isSwept_ = false;
+
 	// 半径（球体コライダーを想定）
 	float radius_ = 1.0f;
 
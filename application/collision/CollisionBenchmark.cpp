@@ -0,0 +1,104 @@
+#include "CollisionBenchmark.h"
+#include "BaseObject.h"
+#include "CollisionDetector.h"
+#include "JobSystem.h"
+#include <chrono>
+#include <memory>
+#include <random>
+
+namespace {
+	///=============================================================================
+	///						計測用ダミーオブジェクト
+	class BenchmarkObject : public BaseObject {
+	public:
+		void OnCollisionEnter(BaseObject *) override {
+		}
+		void OnCollisionStay(BaseObject *) override {
+		}
+		void OnCollisionExit(BaseObject *) override {
+		}
+	};
+
+	// 大型オブジェクト（セルサイズを超える半径）の割合
+	constexpr size_t kLargeObjectInterval = 100;
+	constexpr float kLargeObjectRadius = CollisionConstants::kDefaultCellSize * 1.5f;
+}
+
+///=============================================================================
+///						単一条件で計測
+CollisionBenchmark::Result CollisionBenchmark::Run(size_t objectCount, float areaHalfExtent, float radius, bool parallel, uint32_t seed, int frames) {
+	Result result;
+	result.objectCount = objectCount;
+	result.threadCount = parallel ? MagEngine::JobSystem::GetInstance()->GetThreadCount() : 1u;
+	if (objectCount == 0 || frames <= 0) {
+		return result;
+	}
+
+	//========================================
+	// オブジェクト生成（シード固定で再現可能に）
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> posDist(-areaHalfExtent, areaHalfExtent);
+
+	std::vector<std::unique_ptr<BenchmarkObject>> objects;
+	std::vector<BaseObject *> objectPtrs;
+	objects.reserve(objectCount);
+	objectPtrs.reserve(objectCount);
+	for (size_t i = 0; i < objectCount; ++i) {
+		auto obj = std::make_unique<BenchmarkObject>();
+		// 一定間隔でセルを跨ぐ大型オブジェクトを混ぜる
+		float r = (i % kLargeObjectInterval == 0) ? kLargeObjectRadius : radius;
+		obj->Initialize({posDist(rng), posDist(rng), posDist(rng)}, r);
+		// NOTE: CollisionManagerを介さないため衝突IDを直接割り当てる
+		obj->SetCollisionId(static_cast<uint32_t>(i));
+		objectPtrs.push_back(obj.get());
+		objects.push_back(std::move(obj));
+	}
+
+	CollisionDetector detector;
+	detector.Initialize(CollisionConstants::kDefaultCellSize, static_cast<int>(objectCount));
+	detector.SetParallelEnabled(parallel);
+	std::vector<uint64_t> contacts;
+
+	//========================================
+	// 計測
+	double buildMs = 0.0;
+	double detectMs = 0.0;
+	for (int frame = 0; frame < frames; ++frame) {
+		auto start = std::chrono::high_resolution_clock::now();
+		detector.Build(objectPtrs);
+		auto built = std::chrono::high_resolution_clock::now();
+		detector.Detect(contacts);
+		auto end = std::chrono::high_resolution_clock::now();
+		buildMs += std::chrono::duration<double, std::milli>(built - start).count();
+		detectMs += std::chrono::duration<double, std::milli>(end - built).count();
+	}
+
+	result.candidatePairs = detector.GetCollisionChecks();
+	result.hitPairs = contacts.size();
+	result.buildMs = buildMs / frames;
+	result.detectMs = detectMs / frames;
+	return result;
+}
+
+///=============================================================================
+///						標準スイートを計測
+std::vector<CollisionBenchmark::Result> CollisionBenchmark::RunStandardSuite() {
+	// 弾の密度がおおむね一定になるよう配置領域を調整
+	struct Case {
+		size_t count;
+		float halfExtent;
+	};
+	const Case cases[] = {
+		{1000, 150.0f},
+		{10000, 320.0f},
+		{50000, 550.0f},
+	};
+
+	std::vector<Result> results;
+	for (const Case &c : cases) {
+		for (bool parallel : {false, true}) {
+			results.push_back(Run(c.count, c.halfExtent, 1.0f, parallel));
+		}
+	}
+	return results;
+}
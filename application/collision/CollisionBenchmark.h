@@ -0,0 +1,42 @@
+/*********************************************************************
+ * \file   CollisionBenchmark.h
+ * \brief  当たり判定ブロードフェーズの計測ハーネス
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   弾幕規模（1k/10k/50k）でのペア数と処理時間を計測する
+ *         CollisionDetectorのみを使うため、D3D12やウィンドウなしで実行できる
+ *         コンソールからは benchmarks/ の MagEngineBenchmarks で計測できる
+ *********************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///=============================================================================
+///						当たり判定ベンチマーク
+class CollisionBenchmark {
+public:
+	//========================================
+	// 計測結果
+	struct Result {
+		size_t objectCount = 0;	   ///< オブジェクト数
+		size_t candidatePairs = 0; ///< 判定したペア数（ブロードフェーズ通過数）
+		size_t hitPairs = 0;	   ///< 衝突したペア数
+		uint32_t threadCount = 1;  ///< 検出に使用したスレッド数
+		double buildMs = 0.0;	   ///< 1フレームあたりの平均構築時間（ミリ秒）
+		double detectMs = 0.0;	   ///< 1フレームあたりの平均検出時間（ミリ秒）
+	};
+
+	/// \brief 単一条件で計測
+	/// \param objectCount 弾の数
+	/// \param areaHalfExtent 配置領域の半径（立方体の半辺）
+	/// \param radius 弾の半径
+	/// \param parallel ジョブシステムで並列検出するか
+	/// \param seed 乱数シード（結果の再現用）
+	/// \param frames 計測フレーム数
+	static Result Run(size_t objectCount, float areaHalfExtent, float radius, bool parallel, uint32_t seed = 12345u, int frames = 4);
+
+	/// \brief 標準スイート（1k/10k/50k × 直列/並列）を計測
+	static std::vector<Result> RunStandardSuite();
+};
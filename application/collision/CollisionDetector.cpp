@@ -0,0 +1,685 @@
+#include "CollisionDetector.h"
+#include "CollisionKernel.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+using namespace MagEngine;
+
+///=============================================================================
+///						初期化
+void CollisionDetector::Initialize(float cellSize, int maxObjects) {
+	SetCellSize(cellSize);
+
+	// COMMENT: メモリ予約（パフォーマンス最適化）アロケーション回数を削減
+	colliders_.Reserve(maxObjects);
+	proxies_.reserve(maxObjects);
+	entryOffsets_.reserve(maxObjects + 1);
+	gridEntries_.reserve(maxObjects * 2); // 複数セル登録分を見込む
+	sortedEntries_.reserve(maxObjects * 2);
+	sortedX_.reserve(maxObjects * 2);
+	sortedY_.reserve(maxObjects * 2);
+	sortedZ_.reserve(maxObjects * 2);
+	sortedRadius_.reserve(maxObjects * 2);
+	bucketStarts_.reserve(maxObjects * 4 + 1);
+	bucketCount_ = 0;
+	activeBucketCount_ = 0;
+
+	// グループ衝突マトリクスを初期化（デフォルトはすべて衝突可能）
+	ResetGroupCollisions();
+}
+
+///=============================================================================
+///						構築したデータを破棄
+void CollisionDetector::Clear() {
+	colliders_.Clear();
+	proxies_.clear();
+	oversizedProxies_.clear();
+	entryOffsets_.clear();
+	gridEntries_.clear();
+	sortedEntries_.clear();
+	sweptContacts_.clear();
+	bucketCount_ = 0;
+	activeBucketCount_ = 0;
+	collisionChecks_ = 0;
+	collisionHits_ = 0;
+}
+
+///=============================================================================
+///						分割実行
+template <typename Func>
+void CollisionDetector::ForEachChunk(uint32_t count, uint32_t chunkSize, const Func &func) {
+	if (isParallelEnabled_) {
+		JobSystem::GetInstance()->ParallelFor(count, chunkSize, func);
+		return;
+	}
+	uint32_t chunkCount = JobSystem::GetChunkCount(count, chunkSize);
+	for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+		uint32_t begin = chunk * chunkSize;
+		func(begin, std::min(begin + chunkSize, count), chunk);
+	}
+}
+
+///=============================================================================
+///						コライダーテーブルと空間ハッシュを構築
+void CollisionDetector::Build(const std::vector<BaseObject *> &objects) {
+	const uint32_t objectCount = static_cast<uint32_t>(objects.size());
+	colliders_.Resize(objectCount);
+	proxies_.resize(objectCount);
+	entryOffsets_.resize(objectCount + 1);
+
+	//========================================
+	// 1. コライダー毎にSoAテーブルとセル範囲を並列に埋める
+	// NOTE: Colliderを辿るのはここで1回だけ。以降はSoAテーブルを参照
+	ForEachChunk(objectCount, CollisionConstants::kColliderChunkSize, [&](uint32_t begin, uint32_t end, uint32_t) {
+		for (uint32_t i = begin; i < end; ++i) {
+			// NOTE: objectsにnullptrは含まれない（登録時に除外済み）
+			BaseObject *obj = objects[i];
+			Collider *collider = obj->GetCollider().get();
+			CollisionProxy &proxy = proxies_[i];
+
+			if (!collider) {
+				// コライダーのないオブジェクトはどことも衝突しない
+				colliders_.Set(i, obj, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, 0.0f, false, false);
+				proxy.isOversized = false;
+				entryOffsets_[i] = 0;
+				continue;
+			}
+
+			const Vector3 &position = collider->GetPosition();
+			float radius = collider->GetRadius();
+			bool isSwept = collider->IsSwept();
+			// NOTE: 移動判定は前フレーム位置から現在位置までの掃引AABBをグリッドに登録
+			const Vector3 &start = isSwept ? collider->GetPreviousPosition() : position;
+			colliders_.Set(i, obj, start, position, radius, obj->IsCollisionEnabled(), isSwept);
+			CalculateCellRange(start, position, radius, proxy.minCell, proxy.maxCell);
+
+			// 覆うセル数が上限を超える場合はグリッドに登録しない
+			int64_t spanX = static_cast<int64_t>(proxy.maxCell.x) - proxy.minCell.x + 1;
+			int64_t spanY = static_cast<int64_t>(proxy.maxCell.y) - proxy.minCell.y + 1;
+			int64_t spanZ = static_cast<int64_t>(proxy.maxCell.z) - proxy.minCell.z + 1;
+			int64_t cellCount = spanX * spanY * spanZ;
+			proxy.isOversized = cellCount > CollisionConstants::kMaxCellsPerObject;
+			entryOffsets_[i] = proxy.isOversized ? 0 : static_cast<uint32_t>(cellCount);
+		}
+	});
+
+	//========================================
+	// 2. エントリ数の累積和で書き込み位置を決定（大型オブジェクトもここで収集）
+	oversizedProxies_.clear();
+	uint32_t totalEntries = 0;
+	for (uint32_t i = 0; i < objectCount; ++i) {
+		uint32_t count = entryOffsets_[i];
+		entryOffsets_[i] = totalEntries;
+		totalEntries += count;
+		if (proxies_[i].isOversized) {
+			oversizedProxies_.push_back(i);
+		}
+	}
+	entryOffsets_[objectCount] = totalEntries;
+
+	//========================================
+	// 3. AABBが覆う全セルのエントリを並列に書き込む
+	gridEntries_.resize(totalEntries);
+	ForEachChunk(objectCount, CollisionConstants::kColliderChunkSize, [&](uint32_t begin, uint32_t end, uint32_t) {
+		for (uint32_t i = begin; i < end; ++i) {
+			uint32_t write = entryOffsets_[i];
+			if (write == entryOffsets_[i + 1])
+				continue;
+
+			const CollisionProxy &proxy = proxies_[i];
+			for (int x = proxy.minCell.x; x <= proxy.maxCell.x; ++x) {
+				for (int y = proxy.minCell.y; y <= proxy.maxCell.y; ++y) {
+					for (int z = proxy.minCell.z; z <= proxy.maxCell.z; ++z) {
+						gridEntries_[write++] = {GridCoord(x, y, z), i, 0};
+					}
+				}
+			}
+		}
+	});
+
+	BuildSpatialHash();
+}
+
+///=============================================================================
+///						グリッド座標計算（改良版）
+///						ハッシュではなく直接座標を使用
+GridCoord CollisionDetector::CalculateGridCoord(const Vector3 &position) const {
+	// NOTE: 座標を直接計算。復元の問題なし
+	int x = static_cast<int>(std::floor(position.x * invCellSize_));
+	int y = static_cast<int>(std::floor(position.y * invCellSize_));
+	int z = static_cast<int>(std::floor(position.z * invCellSize_));
+
+	return GridCoord(x, y, z);
+}
+
+///=============================================================================
+///						AABBが覆うセル範囲を計算
+void CollisionDetector::CalculateCellRange(const Vector3 &start, const Vector3 &position, float radius, GridCoord &outMin, GridCoord &outMax) const {
+	Vector3 minPoint = {std::min(start.x, position.x) - radius, std::min(start.y, position.y) - radius, std::min(start.z, position.z) - radius};
+	Vector3 maxPoint = {std::max(start.x, position.x) + radius, std::max(start.y, position.y) + radius, std::max(start.z, position.z) + radius};
+	outMin = CalculateGridCoord(minPoint);
+	outMax = CalculateGridCoord(maxPoint);
+}
+
+///=============================================================================
+///						空間ハッシュ構築（計数ソート）
+void CollisionDetector::BuildSpatialHash() {
+	//========================================
+	// バケット数はエントリ数の2倍以上の2の累乗（負荷率0.5以下）
+	uint32_t entryCount = static_cast<uint32_t>(gridEntries_.size());
+	uint32_t bucketCount = CollisionConstants::kMinBucketCount;
+	while (bucketCount < entryCount * 2) {
+		bucketCount <<= 1;
+	}
+	bucketCount_ = bucketCount;
+	const uint32_t bucketMask = bucketCount - 1;
+
+	//========================================
+	// 1. バケット番号を並列に計算し、個数を数える
+	ForEachChunk(entryCount, CollisionConstants::kEntryChunkSize, [&](uint32_t begin, uint32_t end, uint32_t) {
+		for (uint32_t i = begin; i < end; ++i) {
+			gridEntries_[i].bucket = HashGridCoord(gridEntries_[i].cell) & bucketMask;
+		}
+	});
+	bucketStarts_.assign(bucketCount + 1, 0);
+	for (const GridEntry &entry : gridEntries_) {
+		++bucketStarts_[entry.bucket + 1];
+	}
+
+	//========================================
+	// 2. 累積和で各バケットの開始位置を求める
+	activeBucketCount_ = 0;
+	for (uint32_t b = 0; b < bucketCount; ++b) {
+		if (bucketStarts_[b + 1] > 0) {
+			++activeBucketCount_;
+		}
+		bucketStarts_[b + 1] += bucketStarts_[b];
+	}
+
+	//========================================
+	// 3. 散布（安定ソートのため登録順を維持）
+	// NOTE: bucketStarts_[b]を書き込みカーソルとして進めた後、1つずらして元に戻す
+	sortedEntries_.resize(entryCount);
+	for (const GridEntry &entry : gridEntries_) {
+		sortedEntries_[bucketStarts_[entry.bucket]++] = entry;
+	}
+	for (uint32_t b = bucketCount; b > 0; --b) {
+		bucketStarts_[b] = bucketStarts_[b - 1];
+	}
+	bucketStarts_[0] = 0;
+
+	//========================================
+	// 4. 狭域判定用に位置・半径をソート順で並べる
+	sortedX_.resize(entryCount);
+	sortedY_.resize(entryCount);
+	sortedZ_.resize(entryCount);
+	sortedRadius_.resize(entryCount);
+	ForEachChunk(entryCount, CollisionConstants::kEntryChunkSize, [&](uint32_t begin, uint32_t end, uint32_t) {
+		for (uint32_t i = begin; i < end; ++i) {
+			uint32_t index = sortedEntries_[i].proxyIndex;
+			sortedX_[i] = colliders_.x[index];
+			sortedY_[i] = colliders_.y[index];
+			sortedZ_[i] = colliders_.z[index];
+			sortedRadius_[i] = colliders_.radius[index];
+		}
+	});
+}
+
+///=============================================================================
+///						接触ペアを検出
+void CollisionDetector::Detect(std::vector<uint64_t> &outContacts) {
+	//========================================
+	// バケット範囲毎にチャンク専用の出力へ書き込む
+	// NOTE: オブジェクトはAABBが覆う全セルに登録済みのため、重なり得るペアは必ずセルを共有する
+	//       隣接セルの走査は不要で、各ペアは担当セルで1回だけ判定される
+	uint32_t chunkCount = JobSystem::GetChunkCount(bucketCount_, CollisionConstants::kBucketChunkSize);
+	// 最後の1つは大型オブジェクト用
+	if (chunkOutputs_.size() < chunkCount + 1) {
+		chunkOutputs_.resize(chunkCount + 1);
+	}
+	for (uint32_t c = 0; c <= chunkCount; ++c) {
+		chunkOutputs_[c].contacts.clear();
+		chunkOutputs_[c].sweptContacts.clear();
+		chunkOutputs_[c].checks = 0;
+		chunkOutputs_[c].hits = 0;
+	}
+
+	ForEachChunk(bucketCount_, CollisionConstants::kBucketChunkSize, [&](uint32_t begin, uint32_t end, uint32_t chunk) {
+		ChunkOutput &out = chunkOutputs_[chunk];
+		for (uint32_t b = begin; b < end; ++b) {
+			CheckCollisionsInBucket(bucketStarts_[b], bucketStarts_[b + 1], out);
+		}
+	});
+
+	// セル上限を超えた大型オブジェクト
+	CheckOversizedCollisions(chunkOutputs_[chunkCount]);
+
+	//========================================
+	// チャンク順に結合してソート（スレッド数や実行順に依らず同じ結果になる）
+	collisionChecks_ = 0;
+	collisionHits_ = 0;
+	size_t total = 0;
+	for (uint32_t c = 0; c <= chunkCount; ++c) {
+		total += chunkOutputs_[c].contacts.size();
+		collisionChecks_ += chunkOutputs_[c].checks;
+		collisionHits_ += chunkOutputs_[c].hits;
+	}
+	outContacts.resize(total);
+	size_t write = 0;
+	for (uint32_t c = 0; c <= chunkCount; ++c) {
+		const std::vector<uint64_t> &contacts = chunkOutputs_[c].contacts;
+		std::copy(contacts.begin(), contacts.end(), outContacts.begin() + write);
+		write += contacts.size();
+	}
+
+	// NOTE: 各ペアは1回だけ記録されるため重複はなく、ソートのみで良い
+	std::sort(outContacts.begin(), outContacts.end());
+
+	//========================================
+	// 移動判定の接触時刻も同様に結合し、キーで引けるようにソート
+	sweptContacts_.clear();
+	for (uint32_t c = 0; c <= chunkCount; ++c) {
+		const std::vector<SweptContact> &swept = chunkOutputs_[c].sweptContacts;
+		sweptContacts_.insert(sweptContacts_.end(), swept.begin(), swept.end());
+	}
+	std::sort(sweptContacts_.begin(), sweptContacts_.end(),
+			  [](const SweptContact &lhs, const SweptContact &rhs) { return lhs.key < rhs.key; });
+}
+
+///=============================================================================
+///						接触時刻の取得
+bool CollisionDetector::FindTimeOfImpact(uint64_t key, float &outTime) const {
+	auto it = std::lower_bound(sweptContacts_.begin(), sweptContacts_.end(), key,
+							   [](const SweptContact &contact, uint64_t value) { return contact.key < value; });
+	if (it == sweptContacts_.end() || it->key != key) {
+		outTime = 1.0f;
+		return false;
+	}
+	outTime = it->timeOfImpact;
+	return true;
+}
+
+///=============================================================================
+///						バケット内の当たり判定をチェック
+void CollisionDetector::CheckCollisionsInBucket(uint32_t begin, uint32_t end, ChunkOutput &out) const {
+	if (end - begin < 2)
+		return;
+
+	for (uint32_t i = begin; i < end; ++i) {
+		const GridEntry &entryA = sortedEntries_[i];
+		const CollisionProxy &proxyA = proxies_[entryA.proxyIndex];
+
+		// NOTE: 候補を最大8件ずつまとめて球判定し、結果のビットマスクで後段を振り分ける
+		for (uint32_t batchBegin = i + 1; batchBegin < end; batchBegin += CollisionKernel::kBatchWidth) {
+			uint32_t count = std::min(CollisionKernel::kBatchWidth, end - batchBegin);
+			uint32_t hitMask = CollisionKernel::SphereBatch(
+				sortedX_[i], sortedY_[i], sortedZ_[i], sortedRadius_[i],
+				&sortedX_[batchBegin], &sortedY_[batchBegin], &sortedZ_[batchBegin], &sortedRadius_[batchBegin],
+				count);
+
+			for (uint32_t k = 0; k < count; ++k) {
+				const GridEntry &entryB = sortedEntries_[batchBegin + k];
+				// 同じバケットでも異なるセル（ハッシュ衝突）は対象外
+				if (entryB.cell != entryA.cell)
+					continue;
+
+				const CollisionProxy &proxyB = proxies_[entryB.proxyIndex];
+
+				// NOTE: 両者のセル範囲が重なる領域の最小角セルを担当セルとする
+				//       共有セルを持つペアは必ずちょうど1つの担当セルを持つため、重複判定が発生しない
+				GridCoord owner(std::max(proxyA.minCell.x, proxyB.minCell.x),
+								std::max(proxyA.minCell.y, proxyB.minCell.y),
+								std::max(proxyA.minCell.z, proxyB.minCell.z));
+				if (owner != entryA.cell)
+					continue;
+
+				TestPair(entryA.proxyIndex, entryB.proxyIndex, (hitMask >> k) & 1u, out);
+			}
+		}
+	}
+}
+
+///=============================================================================
+///						大型オブジェクトの総当たり判定
+void CollisionDetector::CheckOversizedCollisions(ChunkOutput &out) const {
+	for (size_t i = 0; i < oversizedProxies_.size(); ++i) {
+		uint32_t largeIndex = oversizedProxies_[i];
+
+		for (uint32_t other = 0; other < proxies_.size(); ++other) {
+			if (other == largeIndex)
+				continue;
+			// 大型同士は片側（インデックスの小さい側）からのみ判定
+			if (proxies_[other].isOversized && other < largeIndex)
+				continue;
+
+			TestPair(largeIndex, other, FastIntersects(largeIndex, other), out);
+		}
+	}
+}
+
+///=============================================================================
+///						ペアの判定結果を記録
+void CollisionDetector::TestPair(uint32_t a, uint32_t b, bool sphereHit, ChunkOutput &out) const {
+	++out.checks;
+	const bool isSwept = colliders_.swept[a] || colliders_.swept[b];
+	float timeOfImpact = 1.0f;
+	if (sphereHit && isSwept) {
+		sphereHit = SweptIntersects(a, b, timeOfImpact);
+	}
+	if (sphereHit && CanCollideByGroupAndMask(a, b)) {
+		uint64_t key = MakeContactKey(colliders_.ids[a], colliders_.ids[b]);
+		out.contacts.push_back(key);
+		// 接触時刻は衝突詳細の計算で再利用する
+		if (isSwept) {
+			out.sweptContacts.push_back({key, timeOfImpact});
+		}
+		++out.hits;
+	}
+}
+
+///=============================================================================
+///						球同士の判定
+bool CollisionDetector::FastIntersects(uint32_t a, uint32_t b) const {
+	float dx = colliders_.x[a] - colliders_.x[b];
+	float dy = colliders_.y[a] - colliders_.y[b];
+	float dz = colliders_.z[a] - colliders_.z[b];
+	float radiusSum = colliders_.radius[a] + colliders_.radius[b];
+
+	float distanceSquared = dx * dx + dy * dy + dz * dz;
+	return distanceSquared <= (radiusSum * radiusSum);
+}
+
+///=============================================================================
+///						移動球同士の判定
+bool CollisionDetector::SweptIntersects(uint32_t a, uint32_t b, float &outTime) const {
+	return CollisionKernel::SweptSphereTimeOfImpact(
+		colliders_.startX[a] - colliders_.startX[b],
+		colliders_.startY[a] - colliders_.startY[b],
+		colliders_.startZ[a] - colliders_.startZ[b],
+		colliders_.moveX[a] - colliders_.moveX[b],
+		colliders_.moveY[a] - colliders_.moveY[b],
+		colliders_.moveZ[a] - colliders_.moveZ[b],
+		colliders_.shapeRadius[a] + colliders_.shapeRadius[b], outTime);
+}
+
+///=============================================================================
+///						AABB内のコライダーを訪問
+template <typename Func>
+void CollisionDetector::ForEachInBox(const Vector3 &minPoint, const Vector3 &maxPoint, uint16_t groupMask, const Func &func) const {
+	if (bucketCount_ == 0)
+		return;
+
+	GridCoord queryMin = CalculateGridCoord(minPoint);
+	GridCoord queryMax = CalculateGridCoord(maxPoint);
+	int64_t spanX = static_cast<int64_t>(queryMax.x) - queryMin.x + 1;
+	int64_t spanY = static_cast<int64_t>(queryMax.y) - queryMin.y + 1;
+	int64_t spanZ = static_cast<int64_t>(queryMax.z) - queryMin.z + 1;
+
+	//========================================
+	// 覆うセル数がコライダー数より多い場合はテーブルを線形に走査した方が速い
+	if (spanX * spanY * spanZ > static_cast<int64_t>(colliders_.Size())) {
+		for (uint32_t i = 0; i < colliders_.Size(); ++i) {
+			if (IsQueryTarget(i, groupMask)) {
+				func(i);
+			}
+		}
+		return;
+	}
+
+	//========================================
+	// セル毎にバケットを走査
+	const uint32_t bucketMask = bucketCount_ - 1;
+	for (int x = queryMin.x; x <= queryMax.x; ++x) {
+		for (int y = queryMin.y; y <= queryMax.y; ++y) {
+			for (int z = queryMin.z; z <= queryMax.z; ++z) {
+				GridCoord cell(x, y, z);
+				uint32_t bucket = HashGridCoord(cell) & bucketMask;
+				for (uint32_t e = bucketStarts_[bucket]; e < bucketStarts_[bucket + 1]; ++e) {
+					const GridEntry &entry = sortedEntries_[e];
+					if (entry.cell != cell)
+						continue;
+
+					const CollisionProxy &proxy = proxies_[entry.proxyIndex];
+					GridCoord owner(std::max(proxy.minCell.x, queryMin.x),
+									std::max(proxy.minCell.y, queryMin.y),
+									std::max(proxy.minCell.z, queryMin.z));
+					if (owner != cell)
+						continue;
+
+					if (IsQueryTarget(entry.proxyIndex, groupMask)) {
+						func(entry.proxyIndex);
+					}
+				}
+			}
+		}
+	}
+
+	// グリッドに登録されていない大型オブジェクト
+	for (uint32_t index : oversizedProxies_) {
+		if (IsQueryTarget(index, groupMask)) {
+			func(index);
+		}
+	}
+}
+
+///=============================================================================
+///						球と重なるコライダーを列挙
+void CollisionDetector::QuerySphere(const Vector3 &center, float radius, uint16_t groupMask, std::vector<uint32_t> &outIndices) const {
+	outIndices.clear();
+	Vector3 extent = {radius, radius, radius};
+	ForEachInBox(center - extent, center + extent, groupMask, [&](uint32_t index) {
+		Vector3 diff = GetCurrentPosition(index) - center;
+		float radiusSum = radius + colliders_.shapeRadius[index];
+		if (diff.x * diff.x + diff.y * diff.y + diff.z * diff.z <= radiusSum * radiusSum) {
+			outIndices.push_back(index);
+		}
+	});
+}
+
+///=============================================================================
+///						円錐内のコライダーを列挙
+void CollisionDetector::QueryCone(const Vector3 &apex, const Vector3 &direction, float range, float cosHalfAngle, uint16_t groupMask, std::vector<uint32_t> &outIndices) const {
+	outIndices.clear();
+	Vector3 extent = {range, range, range};
+	ForEachInBox(apex - extent, apex + extent, groupMask, [&](uint32_t index) {
+		Vector3 toTarget = GetCurrentPosition(index) - apex;
+		float distanceSquared = toTarget.x * toTarget.x + toTarget.y * toTarget.y + toTarget.z * toTarget.z;
+		if (distanceSquared > range * range)
+			return;
+
+		// NOTE: 頂点とほぼ重なる対象は視野内とみなす
+		float distance = std::sqrt(distanceSquared);
+		if (distance >= 0.001f) {
+			float dot = toTarget.x * direction.x + toTarget.y * direction.y + toTarget.z * direction.z;
+			if (dot < cosHalfAngle * distance)
+				return;
+		}
+		outIndices.push_back(index);
+	});
+}
+
+///=============================================================================
+///						レイキャスト
+bool CollisionDetector::Raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, uint16_t groupMask, uint32_t &outIndex, float &outDistance) const {
+	if (bucketCount_ == 0)
+		return false;
+
+	float bestDistance = maxDistance;
+	bool isHit = false;
+
+	// 1つのコライダーとの交差判定（最も近い交差を更新）
+	auto testCollider = [&](uint32_t index) {
+		if (!IsQueryTarget(index, groupMask))
+			return;
+		Vector3 m = origin - GetCurrentPosition(index);
+		float r = colliders_.shapeRadius[index];
+		float b = m.x * direction.x + m.y * direction.y + m.z * direction.z;
+		float c = m.x * m.x + m.y * m.y + m.z * m.z - r * r;
+		// レイの始点が球の外で、球から離れる向き
+		if (c > 0.0f && b > 0.0f)
+			return;
+		float discriminant = b * b - c;
+		if (discriminant < 0.0f)
+			return;
+		// 始点が球の内側の場合は距離0
+		float t = std::max(0.0f, -b - std::sqrt(discriminant));
+		if (t <= bestDistance) {
+			bestDistance = t;
+			outIndex = index;
+			isHit = true;
+		}
+	};
+
+	//========================================
+	// 通過するセル数がコライダー数より多い場合は線形に走査
+	float cellsAlongRay = maxDistance * invCellSize_;
+	if (cellsAlongRay * 3.0f + 3.0f > static_cast<float>(colliders_.Size())) {
+		for (uint32_t i = 0; i < colliders_.Size(); ++i) {
+			testCollider(i);
+		}
+		outDistance = bestDistance;
+		return isHit;
+	}
+
+	//========================================
+	// 3D-DDAでレイが通過するセルを近い順に辿る
+	GridCoord cell = CalculateGridCoord(origin);
+	const float dirs[3] = {direction.x, direction.y, direction.z};
+	const float origins[3] = {origin.x, origin.y, origin.z};
+	int coords[3] = {cell.x, cell.y, cell.z};
+	int steps[3];
+	float tMax[3];
+	float tDelta[3];
+	for (int axis = 0; axis < 3; ++axis) {
+		if (dirs[axis] > 0.0f) {
+			steps[axis] = 1;
+			tMax[axis] = ((coords[axis] + 1) * cellSize_ - origins[axis]) / dirs[axis];
+			tDelta[axis] = cellSize_ / dirs[axis];
+		} else if (dirs[axis] < 0.0f) {
+			steps[axis] = -1;
+			tMax[axis] = (coords[axis] * cellSize_ - origins[axis]) / dirs[axis];
+			tDelta[axis] = -cellSize_ / dirs[axis];
+		} else {
+			steps[axis] = 0;
+			tMax[axis] = FLT_MAX;
+			tDelta[axis] = FLT_MAX;
+		}
+	}
+
+	const uint32_t bucketMask = bucketCount_ - 1;
+	while (true) {
+		GridCoord current(coords[0], coords[1], coords[2]);
+		uint32_t bucket = HashGridCoord(current) & bucketMask;
+		for (uint32_t e = bucketStarts_[bucket]; e < bucketStarts_[bucket + 1]; ++e) {
+			if (sortedEntries_[e].cell == current) {
+				testCollider(sortedEntries_[e].proxyIndex);
+			}
+		}
+
+		// NOTE: 交差点は必ずその点を含むセルに登録されているため、
+		//       現在のセルを出る前に交差していれば以降のセルにより近い交差はない
+		int axis = (tMax[0] < tMax[1]) ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+		float cellExit = tMax[axis];
+		if ((isHit && bestDistance <= cellExit) || cellExit > maxDistance)
+			break;
+		coords[axis] += steps[axis];
+		tMax[axis] += tDelta[axis];
+	}
+
+	// グリッドに登録されていない大型オブジェクト
+	for (uint32_t index : oversizedProxies_) {
+		testCollider(index);
+	}
+
+	outDistance = bestDistance;
+	return isHit;
+}
+
+///=============================================================================
+///						近い順にk個を列挙
+void CollisionDetector::QueryNearest(const Vector3 &position, uint32_t k, float maxDistance, uint16_t groupMask, std::vector<uint32_t> &outIndices) const {
+	outIndices.clear();
+	nearestScratch_.clear();
+	if (k == 0)
+		return;
+
+	Vector3 extent = {maxDistance, maxDistance, maxDistance};
+	float maxDistanceSquared = maxDistance * maxDistance;
+	ForEachInBox(position - extent, position + extent, groupMask, [&](uint32_t index) {
+		Vector3 diff = GetCurrentPosition(index) - position;
+		float distanceSquared = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
+		if (distanceSquared <= maxDistanceSquared) {
+			nearestScratch_.emplace_back(distanceSquared, index);
+		}
+	});
+
+	// 上位k個のみを距離順に並べる（同距離はインデックス順）
+	size_t count = std::min<size_t>(k, nearestScratch_.size());
+	std::partial_sort(nearestScratch_.begin(), nearestScratch_.begin() + count, nearestScratch_.end());
+	for (size_t i = 0; i < count; ++i) {
+		outIndices.push_back(nearestScratch_[i].second);
+	}
+}
+
+///=============================================================================
+///						グループ間衝突設定
+void CollisionDetector::SetGroupCollision(uint16_t groupA, uint16_t groupB, bool canCollide) {
+	if (groupA >= 16 || groupB >= 16)
+		return;
+
+	groupCollisionMatrix_[groupA][groupB] = canCollide;
+	groupCollisionMatrix_[groupB][groupA] = canCollide; // 双方向
+}
+
+///=============================================================================
+///						グループ衝突設定リセット
+void CollisionDetector::ResetGroupCollisions() {
+	// すべてのグループが衝突可能に
+	for (int i = 0; i < 16; ++i) {
+		for (int j = 0; j < 16; ++j) {
+			groupCollisionMatrix_[i][j] = true;
+		}
+	}
+}
+
+///=============================================================================
+///						グループ衝突可能性を問い合わせ
+bool CollisionDetector::CanGroupsCollide(uint16_t groupA, uint16_t groupB) const {
+	if (groupA >= 16 || groupB >= 16)
+		return false;
+
+	return groupCollisionMatrix_[groupA][groupB];
+}
+
+///=============================================================================
+///						グループ・レイヤーマスクによる衝突可否判定
+bool CollisionDetector::CanCollideByGroupAndMask(uint32_t a, uint32_t b) const {
+	// 有効/無効チェック
+	if (!colliders_.enabled[a] || !colliders_.enabled[b])
+		return false;
+	// 衝突応答を止めたオブジェクトは空間クエリのみ対象
+	if (!colliders_.responsive[a] || !colliders_.responsive[b])
+		return false;
+
+	uint16_t groupA = colliders_.group[a];
+	uint16_t groupB = colliders_.group[b];
+
+	// グループIDが範囲外
+	if (groupB >= 16 || groupA >= 16)
+		return false;
+
+	// グループマトリクスで許可されているか確認
+	if (!groupCollisionMatrix_[groupA][groupB])
+		return false;
+
+	// objAがobjBのグループと衝突可能か
+	if ((colliders_.mask[a] & (1 << groupB)) == 0)
+		return false;
+
+	// objBがobjAのグループと衝突可能か
+	if ((colliders_.mask[b] & (1 << groupA)) == 0)
+		return false;
+
+	return true;
+}
@@ -0,0 +1,419 @@
+/*********************************************************************
+ * \file   CollisionDetector.h
+ * \brief  当たり判定の検出部（ブロードフェーズ＋ナローフェーズ）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   描画やD3D12に依存しないため、ベンチマーク等から単体で利用できる
+ *         イベントの発火はCollisionManagerが担当し、ここでは接触ペアの列挙のみ行う
+ *********************************************************************/
+#pragma once
+#include "MagMath.h"
+using namespace MagMath;
+#include "BaseObject.h"
+#include "Collider.h"
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//========================================
+// コリジョンシステム定数
+namespace CollisionConstants {
+	// グリッドセルのデフォルトサイズ（単位：ゲーム座標）
+	constexpr float kDefaultCellSize = 32.0f;
+	// グリッド内の最大オブジェクト数
+	constexpr int kDefaultMaxObjects = 1024;
+	// 1オブジェクトが占有できる最大セル数（超えた場合は大型オブジェクトとして総当たり）
+	constexpr int kMaxCellsPerObject = 64;
+	// 空間ハッシュの最小バケット数（2の累乗）
+	constexpr uint32_t kMinBucketCount = 64;
+	// 並列処理の分割単位（コライダー数 / エントリ数 / バケット数）
+	constexpr uint32_t kColliderChunkSize = 512;
+	constexpr uint32_t kEntryChunkSize = 2048;
+	constexpr uint32_t kBucketChunkSize = 512;
+	// 空間クエリの余裕（空間ハッシュは前回の判定時点の位置のため、1フレームの移動量より大きく取る）
+	// NOTE: 現在位置で判定し直す呼び出し側は、この分だけ広げて問い合わせる
+	constexpr float kQueryPositionMargin = 4.0f;
+}
+
+//========================================
+// グリッド座標構造体（ハッシュ問題を解決）
+struct GridCoord {
+	int x, y, z;
+
+	GridCoord() : x(0), y(0), z(0) {
+	}
+	GridCoord(int x_, int y_, int z_) : x(x_), y(y_), z(z_) {
+	}
+
+	bool operator==(const GridCoord &other) const {
+		return x == other.x && y == other.y && z == other.z;
+	}
+	bool operator!=(const GridCoord &other) const {
+		return !(*this == other);
+	}
+};
+
+//========================================
+// グリッド座標のハッシュ（空間ハッシュのバケット決定用）
+// NOTE: 各軸を符号なしに変換してから乗算し、最後にビットを撹拌するため負の座標でも偏らない
+inline uint32_t HashGridCoord(const GridCoord &coord) {
+	uint32_t h = static_cast<uint32_t>(coord.x) * 0x8DA6B343u;
+	h ^= static_cast<uint32_t>(coord.y) * 0xD8163841u;
+	h ^= static_cast<uint32_t>(coord.z) * 0xCB1AB31Fu;
+	h ^= h >> 16;
+	h *= 0x7FEB352Du;
+	h ^= h >> 15;
+	return h;
+}
+
+//========================================
+// フレーム毎のコライダー代理データ
+// NOTE: AABBが覆うセル範囲を保持し、ペアの担当セル判定に使用
+struct CollisionProxy {
+	GridCoord minCell; ///< AABB最小点のセル
+	GridCoord maxCell; ///< AABB最大点のセル
+	bool isOversized;  ///< セル上限を超える大型オブジェクトか
+};
+
+//========================================
+// コライダーのSoAテーブル（毎フレーム一括更新）
+// NOTE: 狭域判定でBaseObject→Colliderのポインタを辿らないよう、判定に必要な値を連続配列に複製
+//       x/y/z/radiusは粗判定用の包含球（移動判定の場合は掃引範囲全体を包む球）
+struct ColliderTable {
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> radius;
+	std::vector<float> startX; ///< 移動開始位置（移動判定なしは現在位置）
+	std::vector<float> startY;
+	std::vector<float> startZ;
+	std::vector<float> moveX; ///< 1フレームの移動量（移動判定なしは0）
+	std::vector<float> moveY;
+	std::vector<float> moveZ;
+	std::vector<float> shapeRadius; ///< コライダー本来の半径
+	std::vector<uint16_t> group;
+	std::vector<uint16_t> mask;
+	std::vector<uint8_t> enabled;
+	std::vector<uint8_t> responsive; ///< 衝突応答が有効か（無効でも空間クエリの対象）
+	std::vector<uint8_t> swept;
+	std::vector<uint32_t> ids;
+	std::vector<BaseObject *> objects;
+
+	void Clear() {
+		Resize(0);
+	}
+	void Reserve(size_t capacity) {
+		x.reserve(capacity);
+		y.reserve(capacity);
+		z.reserve(capacity);
+		radius.reserve(capacity);
+		startX.reserve(capacity);
+		startY.reserve(capacity);
+		startZ.reserve(capacity);
+		moveX.reserve(capacity);
+		moveY.reserve(capacity);
+		moveZ.reserve(capacity);
+		shapeRadius.reserve(capacity);
+		group.reserve(capacity);
+		mask.reserve(capacity);
+		enabled.reserve(capacity);
+		responsive.reserve(capacity);
+		swept.reserve(capacity);
+		ids.reserve(capacity);
+		objects.reserve(capacity);
+	}
+	void Resize(size_t size) {
+		x.resize(size);
+		y.resize(size);
+		z.resize(size);
+		radius.resize(size);
+		startX.resize(size);
+		startY.resize(size);
+		startZ.resize(size);
+		moveX.resize(size);
+		moveY.resize(size);
+		moveZ.resize(size);
+		shapeRadius.resize(size);
+		group.resize(size);
+		mask.resize(size);
+		enabled.resize(size);
+		responsive.resize(size);
+		swept.resize(size);
+		ids.resize(size);
+		objects.resize(size);
+	}
+	size_t Size() const {
+		return objects.size();
+	}
+	/// NOTE: 各スレッドが異なるインデックスへ書き込むため並列に呼び出して良い
+	void Set(size_t index, BaseObject *obj, const Vector3 &start, const Vector3 &position, float r, bool isEnabled, bool isSwept) {
+		float mx = isSwept ? position.x - start.x : 0.0f;
+		float my = isSwept ? position.y - start.y : 0.0f;
+		float mz = isSwept ? position.z - start.z : 0.0f;
+		// 包含球：移動区間の中点を中心に、半径を移動量の半分だけ広げる
+		x[index] = position.x - mx * 0.5f;
+		y[index] = position.y - my * 0.5f;
+		z[index] = position.z - mz * 0.5f;
+		radius[index] = isSwept ? r + 0.5f * std::sqrt(mx * mx + my * my + mz * mz) : r;
+		startX[index] = position.x - mx;
+		startY[index] = position.y - my;
+		startZ[index] = position.z - mz;
+		moveX[index] = mx;
+		moveY[index] = my;
+		moveZ[index] = mz;
+		shapeRadius[index] = r;
+		group[index] = obj->GetGroup();
+		mask[index] = obj->GetCollisionLayerMask();
+		enabled[index] = isEnabled ? 1 : 0;
+		responsive[index] = obj->IsCollisionResponseEnabled() ? 1 : 0;
+		swept[index] = isSwept ? 1 : 0;
+		ids[index] = obj->GetCollisionId();
+		objects[index] = obj;
+	}
+};
+
+//========================================
+// 空間ハッシュのエントリ（1セル×1コライダー）
+// NOTE: 毎フレーム全エントリを生成し、バケット順に計数ソートして連続配列に並べる
+struct GridEntry {
+	GridCoord cell;		 ///< 登録セル
+	uint32_t proxyIndex; ///< proxies_へのインデックス
+	uint32_t bucket;	 ///< ハッシュバケット
+};
+
+//========================================
+// 接触ペアのキー（上位32bit: 小さい衝突ID / 下位32bit: 大きい衝突ID）
+// NOTE: ソート済み配列同士のマージで開始/継続/終了を求めるため整数キーで保持
+inline uint64_t MakeContactKey(uint32_t idA, uint32_t idB) {
+	uint32_t lo = idA < idB ? idA : idB;
+	uint32_t hi = idA < idB ? idB : idA;
+	return (static_cast<uint64_t>(lo) << 32) | hi;
+}
+
+//========================================
+// 移動判定で確定した接触の接触時刻
+// NOTE: 判定時に求めた時刻を保持し、衝突詳細の計算で解き直さないようにする
+struct SweptContact {
+	uint64_t key;		///< 接触キー
+	float timeOfImpact; ///< 接触時刻（0=前フレーム位置, 1=現在位置）
+};
+
+///=============================================================================
+///						当たり判定検出器
+class CollisionDetector {
+public:
+	/// \brief 初期化
+	void Initialize(float cellSize, int maxObjects);
+
+	/// \brief 構築したデータを破棄
+	void Clear();
+
+	/// \brief コライダーテーブルと空間ハッシュを構築
+	/// \param objects 判定対象（衝突IDが割り当て済みであること）
+	void Build(const std::vector<BaseObject *> &objects);
+
+	/// \brief 接触ペアを検出
+	/// \param outContacts 接触キー（昇順ソート済み、重複なし）
+	/// COMMENT: バケット範囲毎のタスクがチャンク専用バッファへ書き込み、最後にチャンク順で結合する
+	void Detect(std::vector<uint64_t> &outContacts);
+
+	/// \brief 直近のDetectで確定した接触の接触時刻を取得
+	/// \return 移動判定で確定した接触ならtrue（それ以外はoutTimeに1を格納してfalse）
+	bool FindTimeOfImpact(uint64_t key, float &outTime) const;
+
+	//========================================
+	// 空間クエリ（直近のBuild時点の配置が対象）
+	// NOTE: 結果はコライダーテーブルのインデックス。出力配列はクリアして再利用するため確保は初回のみ
+	//       groupMaskのビットiがグループiを対象に含める。無効なコライダーは対象外
+	//========================================
+
+	/// \brief 球と重なるコライダーを列挙
+	void QuerySphere(const Vector3 &center, float radius, uint16_t groupMask, std::vector<uint32_t> &outIndices) const;
+
+	/// \brief 視錐（円錐）内に中心があるコライダーを列挙
+	/// \param direction 円錐の軸（正規化済み）
+	/// \param cosHalfAngle 半頂角の余弦
+	void QueryCone(const Vector3 &apex, const Vector3 &direction, float range, float cosHalfAngle, uint16_t groupMask, std::vector<uint32_t> &outIndices) const;
+
+	/// \brief レイと最初に交差するコライダーを取得
+	/// \param direction レイの向き（正規化済み）
+	/// \return 交差した場合true
+	bool Raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, uint16_t groupMask, uint32_t &outIndex, float &outDistance) const;
+
+	/// \brief 中心が近い順に最大k個を列挙
+	void QueryNearest(const Vector3 &position, uint32_t k, float maxDistance, uint16_t groupMask, std::vector<uint32_t> &outIndices) const;
+
+	//========================================
+	// 設定
+	//========================================
+
+	/// \brief セルサイズの設定
+	void SetCellSize(float size) {
+		cellSize_ = size;
+		invCellSize_ = 1.0f / cellSize_;
+	}
+	float GetCellSize() const {
+		return cellSize_;
+	}
+
+	/// \brief ジョブシステムによる並列処理の有効/無効
+	void SetParallelEnabled(bool enabled) {
+		isParallelEnabled_ = enabled;
+	}
+	bool IsParallelEnabled() const {
+		return isParallelEnabled_;
+	}
+
+	/// @brief グループ間の衝突設定（双方向）
+	void SetGroupCollision(uint16_t groupA, uint16_t groupB, bool canCollide);
+
+	/// @brief すべての衝突設定をリセット（すべて衝突するようにする）
+	void ResetGroupCollisions();
+
+	/// @brief グループAがグループBと衝突するかを問い合わせ
+	bool CanGroupsCollide(uint16_t groupA, uint16_t groupB) const;
+
+	//========================================
+	// 統計（デバッグ用）
+	//========================================
+	size_t GetCollisionChecks() const {
+		return collisionChecks_;
+	}
+	size_t GetCollisionHits() const {
+		return collisionHits_;
+	}
+	size_t GetActiveBucketCount() const {
+		return activeBucketCount_;
+	}
+	uint32_t GetBucketCount() const {
+		return bucketCount_;
+	}
+	size_t GetEntryCount() const {
+		return sortedEntries_.size();
+	}
+	size_t GetOversizedCount() const {
+		return oversizedProxies_.size();
+	}
+	const ColliderTable &GetColliders() const {
+		return colliders_;
+	}
+
+private:
+	//========================================
+	// チャンク毎の出力（スレッド間で共有しない）
+	struct ChunkOutput {
+		std::vector<uint64_t> contacts;
+		std::vector<SweptContact> sweptContacts;
+		size_t checks = 0;
+		size_t hits = 0;
+	};
+
+	/// \brief [0,count)を分割して実行（並列無効時は直列）
+	template <typename Func>
+	void ForEachChunk(uint32_t count, uint32_t chunkSize, const Func &func);
+
+	/// \brief AABBと重なるセルに登録されたコライダーを1回ずつ訪問
+	/// COMMENT: 複数セルに跨るコライダーはクエリ範囲との重なりの最小角セルでのみ訪問し、重複排除に追加メモリを使わない
+	template <typename Func>
+	void ForEachInBox(const Vector3 &minPoint, const Vector3 &maxPoint, uint16_t groupMask, const Func &func) const;
+
+	/// \brief クエリ対象か（有効かつグループがマスクに含まれる）
+	bool IsQueryTarget(uint32_t index, uint16_t groupMask) const {
+		return colliders_.enabled[index] && ((groupMask >> colliders_.group[index]) & 1u);
+	}
+
+	/// \brief 現在位置（移動判定の場合は移動後の位置）
+	Vector3 GetCurrentPosition(uint32_t index) const {
+		return {colliders_.startX[index] + colliders_.moveX[index],
+				colliders_.startY[index] + colliders_.moveY[index],
+				colliders_.startZ[index] + colliders_.moveZ[index]};
+	}
+
+	/// \brief グリッド座標計算
+	GridCoord CalculateGridCoord(const Vector3 &position) const;
+
+	/// \brief AABBが覆うセル範囲を計算
+	/// \param start 移動開始位置（移動判定なしは現在位置と同じ）
+	void CalculateCellRange(const Vector3 &start, const Vector3 &position, float radius, GridCoord &outMin, GridCoord &outMax) const;
+
+	/// \brief エントリをバケット順に計数ソート
+	/// COMMENT: バケット毎の個数→累積和→散布の3パスで、確保済み配列のみを使用
+	void BuildSpatialHash();
+
+	/// \brief バケット内衝突判定
+	/// COMMENT: 複数セルに跨るペアは担当セル（両者のセル範囲の最小角）でのみ判定し、重複を排除
+	void CheckCollisionsInBucket(uint32_t begin, uint32_t end, ChunkOutput &out) const;
+
+	/// \brief 大型オブジェクトの総当たり判定
+	void CheckOversizedCollisions(ChunkOutput &out) const;
+
+	/// \brief ペアの判定結果を記録
+	/// \param sphereHit 包含球判定の結果（フィルタ前）
+	/// COMMENT: どちらかが移動判定の場合は、包含球が重なったペアのみ接触時刻を計算して確定する
+	void TestPair(uint32_t a, uint32_t b, bool sphereHit, ChunkOutput &out) const;
+
+	/// \brief 球同士の判定（SoAテーブル参照）
+	bool FastIntersects(uint32_t a, uint32_t b) const;
+
+	/// \brief 移動球同士の判定（SoAテーブル参照）
+	/// \param outTime 接触時刻（接触した場合のみ有効）
+	bool SweptIntersects(uint32_t a, uint32_t b, float &outTime) const;
+
+	/// \brief 有効フラグ・衝突応答・グループ・レイヤーマスクの衝突判定（SoAテーブル参照）
+	bool CanCollideByGroupAndMask(uint32_t a, uint32_t b) const;
+
+private:
+	//========================================
+	// グリッドシステム（フラットな空間ハッシュ）
+	float cellSize_ = CollisionConstants::kDefaultCellSize;
+	float invCellSize_ = 1.0f / CollisionConstants::kDefaultCellSize; // 1/cellSize_（除算回避）
+	/// COMMENT: コライダー毎のエントリ数と書き込み開始位置
+	std::vector<uint32_t> entryOffsets_;
+	/// COMMENT: 登録順のエントリ（未ソート）
+	std::vector<GridEntry> gridEntries_;
+	/// COMMENT: バケット順に並べたエントリ
+	std::vector<GridEntry> sortedEntries_;
+	/// COMMENT: sortedEntries_と同じ並びの位置・半径（SIMDで連続ロードする）
+	std::vector<float> sortedX_;
+	std::vector<float> sortedY_;
+	std::vector<float> sortedZ_;
+	std::vector<float> sortedRadius_;
+	/// COMMENT: バケット毎の開始位置（要素数 bucketCount_ + 1）
+	std::vector<uint32_t> bucketStarts_;
+	uint32_t bucketCount_ = 0;
+	size_t activeBucketCount_ = 0;
+
+	//========================================
+	// コライダー
+	/// COMMENT: フレーム毎に再構築するコライダーテーブル（SoA）
+	ColliderTable colliders_;
+	/// COMMENT: colliders_と同じ並びのセル範囲
+	std::vector<CollisionProxy> proxies_;
+	/// COMMENT: セル上限を超える大型オブジェクト（グリッドに登録せず総当たり）
+	std::vector<uint32_t> oversizedProxies_;
+
+	//========================================
+	// 並列処理
+	bool isParallelEnabled_ = true;
+	/// COMMENT: チャンク毎の出力（フレームを跨いで再利用）
+	std::vector<ChunkOutput> chunkOutputs_;
+	/// COMMENT: 移動判定で確定した接触の接触時刻（キーの昇順）
+	std::vector<SweptContact> sweptContacts_;
+
+	//========================================
+	// 空間クエリ
+	/// COMMENT: 近傍探索の作業領域（距離の二乗, インデックス）。メインスレッドからのみ使用
+	mutable std::vector<std::pair<float, uint32_t>> nearestScratch_;
+
+	//========================================
+	// グループ間の衝突フラグマトリクス（16x16 = 256フラグ）
+	// groupCollisionMatrix[i][j] = グループiがグループjと衝突するかどうか
+	bool groupCollisionMatrix_[16][16];
+
+	//========================================
+	// 統計
+	size_t collisionChecks_ = 0;
+	size_t collisionHits_ = 0;
+};
@@ -0,0 +1,25 @@
+/*********************************************************************
+ * \file   CollisionGroup.h
+ * \brief  ゲーム内の当たり判定グループ定義
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   グループ間の衝突可否はCollisionManagerのマトリクス、
+ *         空間クエリの対象はグループマスクで指定する
+ *********************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace CollisionGroup {
+	//========================================
+	// グループID（0〜15）
+	constexpr uint16_t kPlayer = 0;		  // プレイヤー
+	constexpr uint16_t kPlayerBullet = 1; // プレイヤーの弾・ミサイル
+	constexpr uint16_t kEnemy = 2;		  // 敵
+	constexpr uint16_t kEnemyBullet = 3;  // 敵の弾
+
+	/// \brief グループIDをクエリ用のマスクに変換
+	constexpr uint16_t ToMask(uint16_t group) {
+		return static_cast<uint16_t>(1u << group);
+	}
+}
@@ -0,0 +1,182 @@
+#include "CollisionKernel.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define COLLISION_KERNEL_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_1__) || defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__)
+// NOTE: x64はSSE2が必ず使えるため、SSEパスを既定とする
+#define COLLISION_KERNEL_SSE
+#include <immintrin.h>
+#endif
+
+namespace CollisionKernel {
+
+	///=============================================================================
+	///						スカラー版
+	uint32_t SphereBatchScalar(float ax, float ay, float az, float ar,
+							   const float *bx, const float *by, const float *bz, const float *br,
+							   uint32_t count) {
+		uint32_t mask = 0;
+		for (uint32_t k = 0; k < count; ++k) {
+			float dx = ax - bx[k];
+			float dy = ay - by[k];
+			float dz = az - bz[k];
+			float rs = ar + br[k];
+			float distanceSquared = dx * dx + dy * dy + dz * dz;
+			if (distanceSquared <= rs * rs) {
+				mask |= 1u << k;
+			}
+		}
+		return mask;
+	}
+
+	///=============================================================================
+	///						移動球同士の衝突時刻
+	bool SweptSphereTimeOfImpact(float dx, float dy, float dz,
+								 float vx, float vy, float vz,
+								 float radiusSum, float &outTime) {
+		// |d + t*v|^2 = R^2 を t について解く（a*t^2 + 2*b*t + c = 0）
+		float c = dx * dx + dy * dy + dz * dz - radiusSum * radiusSum;
+		if (c <= 0.0f) {
+			// 開始時点で既に重なっている
+			outTime = 0.0f;
+			return true;
+		}
+
+		float a = vx * vx + vy * vy + vz * vz;
+		float b = dx * vx + dy * vy + dz * vz;
+		// 相対速度がない、または離れていく方向
+		if (a <= 0.0f || b >= 0.0f) {
+			return false;
+		}
+
+		float discriminant = b * b - a * c;
+		if (discriminant < 0.0f) {
+			return false;
+		}
+
+		// NOTE: 小さい方の解が最初に接触する時刻
+		float t = (-b - std::sqrt(discriminant)) / a;
+		if (t > 1.0f) {
+			return false;
+		}
+		outTime = t;
+		return true;
+	}
+
+#if defined(COLLISION_KERNEL_AVX2) || defined(COLLISION_KERNEL_SSE)
+	namespace {
+		//========================================
+		// 端数用のパディング（遠方に置いて必ず非衝突にする）
+		constexpr float kPaddingPosition = 1.0e18f;
+
+		struct alignas(32) PaddedBatch {
+			float x[kBatchWidth];
+			float y[kBatchWidth];
+			float z[kBatchWidth];
+			float r[kBatchWidth];
+		};
+
+		inline void FillPadded(PaddedBatch &batch, const float *bx, const float *by, const float *bz, const float *br, uint32_t count) {
+			for (uint32_t k = 0; k < kBatchWidth; ++k) {
+				batch.x[k] = kPaddingPosition;
+				batch.y[k] = kPaddingPosition;
+				batch.z[k] = kPaddingPosition;
+				batch.r[k] = 0.0f;
+			}
+			std::memcpy(batch.x, bx, sizeof(float) * count);
+			std::memcpy(batch.y, by, sizeof(float) * count);
+			std::memcpy(batch.z, bz, sizeof(float) * count);
+			std::memcpy(batch.r, br, sizeof(float) * count);
+		}
+	}
+#endif
+
+#if defined(COLLISION_KERNEL_AVX2)
+	///=============================================================================
+	///						AVX2版（8件同時）
+	uint32_t SphereBatch(float ax, float ay, float az, float ar,
+						 const float *bx, const float *by, const float *bz, const float *br,
+						 uint32_t count) {
+		PaddedBatch padded;
+		if (count < kBatchWidth) {
+			FillPadded(padded, bx, by, bz, br, count);
+			bx = padded.x;
+			by = padded.y;
+			bz = padded.z;
+			br = padded.r;
+		}
+
+		__m256 dx = _mm256_sub_ps(_mm256_set1_ps(ax), _mm256_loadu_ps(bx));
+		__m256 dy = _mm256_sub_ps(_mm256_set1_ps(ay), _mm256_loadu_ps(by));
+		__m256 dz = _mm256_sub_ps(_mm256_set1_ps(az), _mm256_loadu_ps(bz));
+		__m256 rs = _mm256_add_ps(_mm256_set1_ps(ar), _mm256_loadu_ps(br));
+
+		__m256 distanceSquared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+		__m256 hit = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(rs, rs), _CMP_LE_OQ);
+
+		return static_cast<uint32_t>(_mm256_movemask_ps(hit)) & ((1u << count) - 1u);
+	}
+
+	const char *GetInstructionSetName() {
+		return "AVX2";
+	}
+
+#elif defined(COLLISION_KERNEL_SSE)
+	namespace {
+		inline uint32_t SphereBatch4(__m128 ax, __m128 ay, __m128 az, __m128 ar,
+									 const float *bx, const float *by, const float *bz, const float *br) {
+			__m128 dx = _mm_sub_ps(ax, _mm_loadu_ps(bx));
+			__m128 dy = _mm_sub_ps(ay, _mm_loadu_ps(by));
+			__m128 dz = _mm_sub_ps(az, _mm_loadu_ps(bz));
+			__m128 rs = _mm_add_ps(ar, _mm_loadu_ps(br));
+
+			__m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(rs, rs))));
+		}
+	}
+
+	///=============================================================================
+	///						SSE版（4件×2）
+	uint32_t SphereBatch(float ax, float ay, float az, float ar,
+						 const float *bx, const float *by, const float *bz, const float *br,
+						 uint32_t count) {
+		PaddedBatch padded;
+		if (count < kBatchWidth) {
+			FillPadded(padded, bx, by, bz, br, count);
+			bx = padded.x;
+			by = padded.y;
+			bz = padded.z;
+			br = padded.r;
+		}
+
+		__m128 vx = _mm_set1_ps(ax);
+		__m128 vy = _mm_set1_ps(ay);
+		__m128 vz = _mm_set1_ps(az);
+		__m128 vr = _mm_set1_ps(ar);
+
+		uint32_t lo = SphereBatch4(vx, vy, vz, vr, bx, by, bz, br);
+		uint32_t hi = SphereBatch4(vx, vy, vz, vr, bx + 4, by + 4, bz + 4, br + 4);
+		return (lo | (hi << 4)) & ((1u << count) - 1u);
+	}
+
+	const char *GetInstructionSetName() {
+		return "SSE";
+	}
+
+#else
+	///=============================================================================
+	///						フォールバック
+	uint32_t SphereBatch(float ax, float ay, float az, float ar,
+						 const float *bx, const float *by, const float *bz, const float *br,
+						 uint32_t count) {
+		return SphereBatchScalar(ax, ay, az, ar, bx, by, bz, br, count);
+	}
+
+	const char *GetInstructionSetName() {
+		return "Scalar";
+	}
+#endif
+}
@@ -0,0 +1,43 @@
+/*********************************************************************
+ * \file   CollisionKernel.h
+ * \brief  球同士の一括判定カーネル（SIMD）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   AVX2で8件、SSEで4件×2、非対応環境ではスカラーで判定
+ *********************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace CollisionKernel {
+	// 1回の呼び出しで判定する最大候補数
+	constexpr uint32_t kBatchWidth = 8;
+
+	/// \brief 1つの球と最大8個の候補球を一括判定
+	/// \param ax,ay,az,ar 判定元の中心と半径
+	/// \param bx,by,bz,br 候補のSoA配列（連続した count 個を読む）
+	/// \param count 候補数（1〜kBatchWidth）
+	/// \return ヒットした候補のビットマスク（ビットkが候補kに対応）
+	/// \note 判定式は距離の二乗 <= 半径和の二乗（スカラー版と同一）
+	uint32_t SphereBatch(float ax, float ay, float az, float ar,
+						 const float *bx, const float *by, const float *bz, const float *br,
+						 uint32_t count);
+
+	/// \brief スカラー版（比較・フォールバック用）
+	uint32_t SphereBatchScalar(float ax, float ay, float az, float ar,
+							   const float *bx, const float *by, const float *bz, const float *br,
+							   uint32_t count);
+
+	/// \brief 移動する球同士の最初の接触時刻を求める（連続衝突判定）
+	/// \param dx,dy,dz 開始時点の相対位置（A - B）
+	/// \param vx,vy,vz 1ステップ分の相対移動量（Aの移動量 - Bの移動量）
+	/// \param radiusSum 半径の和
+	/// \param outTime 接触時刻（0=開始位置, 1=終了位置）
+	/// \return ステップ内で接触する場合true
+	bool SweptSphereTimeOfImpact(float dx, float dy, float dz,
+								 float vx, float vy, float vz,
+								 float radiusSum, float &outTime);
+
+	/// \brief 使用中の命令セット名（デバッグ表示用）
+	const char *GetInstructionSetName();
+}
@@ -1,44 +1,43 @@
 #include "CollisionManager.h"
 #include "BaseObject.h"
+#include "CollisionKernel.h"
 #include "ImguiSetup.h"
+#include "JobSystem.h"
 #include "LineManager.h"
 #include <algorithm>
+#include <cmath>
 using namespace MagEngine;
 
 ///=============================================================================
 ///						初期化
 void CollisionManager::Initialize(float cellSize, int maxObjects) {
-	cellSize_ = cellSize;
-	invCellSize_ = 1.0f / cellSize; // 除算回避用
 	enableDebugDraw_ = false;
 	enableGroupFilter_ = false;
 	debugGroupFilter_ = 0;
-	collisionChecksThisFrame_ = 0;
+
+	// 検出部の初期化（グループ衝突マトリクスはすべて衝突可能で初期化される）
+	detector_.Initialize(cellSize, maxObjects);
 
 	// COMMENT: メモリ予約（パフォーマンス最適化）アロケーション回数を削減
 	activeObjects_.reserve(maxObjects);
-	objectPool_.reserve(maxObjects);
-	grid_.reserve(maxObjects / 8);			  // より小さい初期容量
-	collisionStates_.reserve(maxObjects * 2); // 衝突ペア予約
-
-	// グループ衝突マトリクスを初期化（デフォルトはすべて衝突可能）
-	ResetGroupCollisions();
+	slots_.reserve(maxObjects);
+	previousContacts_.reserve(maxObjects * 2); // 衝突ペア予約
+	currentContacts_.reserve(maxObjects * 2);
+	events_.reserve(maxObjects * 2);
 }
 
 ///=============================================================================
 ///						更新処理
 void CollisionManager::Update() {
-	collisionChecksThisFrame_ = 0;
-
 	//========================================
-	// グリッドクリアと再配置
-	for (auto &pair : grid_) {
-		pair.second.Clear();
-	}
-
-	AssignObjectsToGrid();
+	// 検出（グリッドは毎フレーム作り直すため古いセルは残らない）
 	CheckAllCollisions();
 
+	//========================================
+	// 接触リストの差分からイベントを生成し、検出完了後にまとめて発火
+	BuildCollisionEvents();
+	DispatchCollisionEvents();
+
 	//========================================
 	// デバッグ描画
 	if (enableDebugDraw_) {
@@ -60,9 +59,15 @@ void CollisionManager::DrawImGui() {
 	//========================================
 	// システム情報
 	ImGui::Text("Active Objects: %zu", activeObjects_.size());
-	ImGui::Text("Active Grids: %zu", grid_.size());
-	ImGui::Text("Collision Checks: %zu", collisionChecksThisFrame_);
-	ImGui::Text("Cell Size: %.1f", cellSize_);
+	ImGui::Text("Active Grids: %zu / %u buckets", detector_.GetActiveBucketCount(), detector_.GetBucketCount());
+	ImGui::Text("Grid Entries: %zu", detector_.GetEntryCount());
+	ImGui::Text("Collision Checks: %zu", detector_.GetCollisionChecks());
+	ImGui::Text("Collision Hits: %zu", detector_.GetCollisionHits());
+	ImGui::Text("Contacts: %zu (events %zu)", previousContacts_.size(), events_.size());
+	ImGui::Text("Oversized Objects: %zu", detector_.GetOversizedCount());
+	ImGui::Text("Narrowphase: %s", CollisionKernel::GetInstructionSetName());
+	ImGui::Text("Threads: %u", detector_.IsParallelEnabled() ? JobSystem::GetInstance()->GetThreadCount() : 1u);
+	ImGui::Text("Cell Size: %.1f", detector_.GetCellSize());
 
 	ImGui::Separator();
 
@@ -70,6 +75,10 @@ void CollisionManager::DrawImGui() {
 	// 有効/無効と主要設定
 	ImGui::Checkbox("Debug Draw", &enableDebugDraw_);
 	ImGui::Checkbox("Group Filter", &enableGroupFilter_);
+	bool parallel = detector_.IsParallelEnabled();
+	if (ImGui::Checkbox("Parallel Detection", &parallel)) {
+		detector_.SetParallelEnabled(parallel);
+	}
 
 	if (enableGroupFilter_) {
 		int filterGroupInt = static_cast<int>(debugGroupFilter_);
@@ -78,12 +87,10 @@ void CollisionManager::DrawImGui() {
 		}
 	}
 
-	if (ImGui::SliderFloat("Cell Size", &cellSize_, 16.0f, 128.0f)) {
-		SetCellSize(cellSize_);
-		// セルサイズ変更時にグリッドを再構築
-		for (auto &pair : grid_) {
-			pair.second.Clear();
-		}
+	float cellSize = detector_.GetCellSize();
+	if (ImGui::SliderFloat("Cell Size", &cellSize, 16.0f, 128.0f)) {
+		// NOTE: グリッドは毎フレーム再構築されるため、設定の反映のみで良い
+		SetCellSize(cellSize);
 	}
 
 	ImGui::Separator();
@@ -101,13 +108,28 @@ void CollisionManager::DrawImGui() {
 		for (int i = 0; i < 16; ++i) {
 			for (int j = i; j < 16; ++j) {
 				std::string label = "G" + std::to_string(i) + "-G" + std::to_string(j);
-				ImGui::Checkbox(label.c_str(), &groupCollisionMatrix_[i][j]);
+				bool canCollide = CanGroupsCollide(static_cast<uint16_t>(i), static_cast<uint16_t>(j));
+				if (ImGui::Checkbox(label.c_str(), &canCollide)) {
+					SetGroupCollision(static_cast<uint16_t>(i), static_cast<uint16_t>(j), canCollide);
+				}
 				if (j < 15)
 					ImGui::SameLine();
 			}
 		}
 	}
 
+	//========================================
+	// ベンチマーク
+	if (ImGui::CollapsingHeader("Benchmark")) {
+		if (ImGui::Button("Run 1k/10k/50k")) {
+			benchmarkResults_ = CollisionBenchmark::RunStandardSuite();
+		}
+		for (const auto &result : benchmarkResults_) {
+			ImGui::Text("%6zu objects x%u threads: pairs=%zu hits=%zu build=%.3fms detect=%.3fms",
+						result.objectCount, result.threadCount, result.candidatePairs, result.hitPairs, result.buildMs, result.detectMs);
+		}
+	}
+
 	//========================================
 	// オブジェクト一覧表示
 	if (ImGui::CollapsingHeader("Active Objects")) {
@@ -151,217 +173,202 @@ void CollisionManager::DrawImGui() {
 ///						リセット
 void CollisionManager::Reset() {
 	activeObjects_.clear();
-	for (auto &pair : grid_) {
-		pair.second.Clear();
-	}
-	collisionStates_.clear();
+	detector_.Clear();
+
+	// NOTE: 登録済みオブジェクトは既に解放されている可能性があるため参照しない
+	//       古い衝突IDや接触一覧は再登録時に破棄される
+	slots_.clear();
+	freeIds_.clear();
+	pendingFreeIds_.clear();
+	previousContacts_.clear();
+	currentContacts_.clear();
+	events_.clear();
 }
 
 ///=============================================================================
 ///						オブジェクト登録
 void CollisionManager::RegisterObject(BaseObject *obj) {
-	if (obj && std::find(activeObjects_.begin(), activeObjects_.end(), obj) == activeObjects_.end()) {
-		activeObjects_.push_back(obj);
-	}
-}
+	if (!obj)
+		return;
 
-///=============================================================================
-///						オブジェクト登録解除
-void CollisionManager::UnregisterObject(BaseObject *obj) {
-	auto it = std::find(activeObjects_.begin(), activeObjects_.end(), obj);
-	if (it != activeObjects_.end()) {
-		activeObjects_.erase(it);
-
-		// 衝突イベントを全て終了させる
-		auto collidingCopy = obj->GetCollidingObjects();
-		for (BaseObject *collidingObj : collidingCopy) {
-			ProcessCollision(obj, collidingObj, false);
-		}
+	// 登録済みならなにもしない
+	uint32_t id = obj->GetCollisionId();
+	if (id < slots_.size() && slots_[id].object == obj)
+		return;
 
-		// 関連する衝突状態も削除
-		auto stateIt = collisionStates_.begin();
-		while (stateIt != collisionStates_.end()) {
-			if (stateIt->first.objA == obj || stateIt->first.objB == obj) {
-				stateIt = collisionStates_.erase(stateIt);
-			} else {
-				++stateIt;
-			}
-		}
+	// 衝突IDを割り当て
+	if (!freeIds_.empty()) {
+		id = freeIds_.back();
+		freeIds_.pop_back();
+	} else {
+		id = static_cast<uint32_t>(slots_.size());
+		slots_.emplace_back();
 	}
-}
+	slots_[id].object = obj;
+	slots_[id].activeIndex = static_cast<uint32_t>(activeObjects_.size());
+	obj->SetCollisionId(id);
 
-///=============================================================================
-///						グリッド座標計算（改良版）
-///						ハッシュではなく直接座標を使用
-GridCoord CollisionManager::CalculateGridCoord(const Vector3 &position) const {
-	// NOTE: 座標を直接計算。復元の問題なし
-	int x = static_cast<int>(std::floor(position.x * invCellSize_));
-	int y = static_cast<int>(std::floor(position.y * invCellSize_));
-	int z = static_cast<int>(std::floor(position.z * invCellSize_));
-
-	return GridCoord(x, y, z);
+	// 未登録状態で接触中の相手は存在しない
+	obj->ClearCollidingObjects();
+	activeObjects_.push_back(obj);
 }
 
 ///=============================================================================
-///						セル内の当たり判定をチェック
-void CollisionManager::CheckCollisionsInCell(const GridCell &cell) {
-	if (cell.Size() < 2)
+///						オブジェクト登録解除
+void CollisionManager::UnregisterObject(BaseObject *obj) {
+	if (!obj)
 		return;
-
-	// セル内のオブジェクト同士をチェック
-	for (size_t i = 0; i < cell.Size(); ++i) {
-		for (size_t j = i + 1; j < cell.Size(); ++j) {
-			BaseObject *objA = cell.objects[i];
-			BaseObject *objB = cell.objects[j];
-
-			if (objA && objB) {
-				bool isColliding = FastIntersects(objA, objB);
-				ProcessCollision(objA, objB, isColliding);
-				++collisionChecksThisFrame_;
-			}
-		}
-	}
-}
-
-///=============================================================================
-///						隣接セル間衝突判定（改良版）
-///						座標から隣接セルを直接計算
-void CollisionManager::CheckAdjacentCellCollisions(const GridCoord &coord, const GridCell &cell) {
-	if (cell.IsEmpty())
+	uint32_t id = obj->GetCollisionId();
+	if (id >= slots_.size() || slots_[id].object != obj)
 		return;
 
-	// 隣接セルを逐一生成（3x3x3グリッド、自分除外）
-	for (int dx = -1; dx <= 1; ++dx) {
-		for (int dy = -1; dy <= 1; ++dy) {
-			for (int dz = -1; dz <= 1; ++dz) {
-				if (dx == 0 && dy == 0 && dz == 0)
-					continue; // 自分自身をスキップ
-
-				GridCoord adjCoord(coord.x + dx, coord.y + dy, coord.z + dz);
-				auto adjIt = grid_.find(adjCoord);
-
-				if (adjIt != grid_.end() && !adjIt->second.IsEmpty()) {
-					const GridCell &adjCell = adjIt->second;
-
-					// 両セルのオブジェクト同士をチェック
-					for (BaseObject *objA : cell.objects) {
-						for (BaseObject *objB : adjCell.objects) {
-							if (objA && objB) {
-								bool isColliding = FastIntersects(objA, objB);
-								ProcessCollision(objA, objB, isColliding);
-								++collisionChecksThisFrame_;
-							}
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-///=============================================================================
-///						すべての当たり判定をチェック（改良版）
-void CollisionManager::CheckAllCollisions() {
-	// セル内衝突判定
-	for (auto &pair : grid_) {
-		CheckCollisionsInCell(pair.second);
+	//========================================
+	// 接触中の相手にのみ終了イベントを発火
+	// NOTE: コールバック内で一覧が変化しても良いようにコピーして走査
+	std::vector<BaseObject *> collidingCopy = obj->GetCollidingObjects();
+	for (BaseObject *collidingObj : collidingCopy) {
+		obj->OnCollisionExit(collidingObj);
+		collidingObj->OnCollisionExit(obj);
+		collidingObj->RemoveCollidingObject(obj);
 	}
+	obj->ClearCollidingObjects();
 
-	// 隣接セル間衝突判定（座標ベース）
-	// NOTE: 重複チェック回避のため、各セルは一度だけ処理
-	std::vector<GridCoord> processedCoords;
-	processedCoords.reserve(grid_.size());
-
-	for (const auto &pair : grid_) {
-		const GridCoord &coord = pair.first;
-		const GridCell &cell = pair.second;
+	//========================================
+	// アクティブリストから末尾と入れ替えて削除
+	uint32_t activeIndex = slots_[id].activeIndex;
+	BaseObject *last = activeObjects_.back();
+	activeObjects_[activeIndex] = last;
+	slots_[last->GetCollisionId()].activeIndex = activeIndex;
+	activeObjects_.pop_back();
 
-		CheckAdjacentCellCollisions(coord, cell);
-	}
+	//========================================
+	// IDは前フレームの接触リストに残っているため、次のマージ後に解放
+	// NOTE: それまでは空スロットとなり、該当する接触キーはマージ時に無視される
+	slots_[id].object = nullptr;
+	pendingFreeIds_.push_back(id);
+	obj->SetCollisionId(kInvalidCollisionId);
 }
 
 ///=============================================================================
-///						高速衝突判定
-bool CollisionManager::FastIntersects(BaseObject *objA, BaseObject *objB) const {
-	auto colliderA = objA->GetCollider();
-	auto colliderB = objB->GetCollider();
-
-	if (!colliderA || !colliderB)
+///						衝突詳細の取得
+bool CollisionManager::GetCollisionInfo(const BaseObject *objA, const BaseObject *objB, CollisionInfo &outInfo) const {
+	if (!objA || !objB || !objA->GetCollider() || !objB->GetCollider())
 		return false;
-
-	// 有効/無効チェック
-	if (!objA->IsCollisionEnabled() || !objB->IsCollisionEnabled())
+	uint32_t idA = objA->GetCollisionId();
+	uint32_t idB = objB->GetCollisionId();
+	if (idA >= slots_.size() || idB >= slots_.size() || slots_[idA].object != objA || slots_[idB].object != objB)
 		return false;
 
-	// グループ・レイヤーマスク経由の衝突可否判定
-	if (!CanCollideByGroupAndMask(objA, objB))
+	// 直近に確定した接触のみ対象
+	uint64_t key = MakeContactKey(idA, idB);
+	if (!std::binary_search(previousContacts_.begin(), previousContacts_.end(), key))
 		return false;
 
-	// 早期リターン：ざっくりした距離チェック
-	Vector3 diff = colliderA->GetPosition() - colliderB->GetPosition();
-	float radiusSum = colliderA->GetRadius() + colliderB->GetRadius();
-
-	// まずX軸だけでチェック（最も高速）
-	if (std::abs(diff.x) > radiusSum)
-		return false;
-	if (std::abs(diff.y) > radiusSum)
-		return false;
-	if (std::abs(diff.z) > radiusSum)
-		return false;
+	// 接触時刻は検出時に求めた値を使う（移動判定なしは1）
+	float timeOfImpact = 1.0f;
+	detector_.FindTimeOfImpact(key, timeOfImpact);
+	objA->GetCollider()->GetCollisionInfo(*objB->GetCollider(), timeOfImpact, outInfo);
+	return true;
+}
 
-	// 詳細な距離計算
-	float distanceSquared = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
-	return distanceSquared <= (radiusSum * radiusSum);
+///=============================================================================
+///						すべての当たり判定をチェック
+void CollisionManager::CheckAllCollisions() {
+	// NOTE: 検出は読み取り専用でコールバックを呼ばないため、ジョブシステムで並列化している
+	detector_.Build(activeObjects_);
+	detector_.Detect(currentContacts_);
 }
 
 ///=============================================================================
-///						オブジェクトをグリッドに配置
-void CollisionManager::AssignObjectsToGrid() {
-	for (BaseObject *obj : activeObjects_) {
-		if (obj && obj->GetCollider()) {
-			GridCoord coord = CalculateGridCoord(obj->GetCollider()->GetPosition());
-			grid_[coord].objects.push_back(obj);
+///						接触リストの差分からイベントを生成
+void CollisionManager::BuildCollisionEvents() {
+	events_.clear();
+
+	// 登録解除済み（空スロット）のIDを含む接触は無視する
+	auto isAlive = [this](uint64_t key) {
+		uint32_t lo = static_cast<uint32_t>(key >> 32);
+		uint32_t hi = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+		return slots_[lo].object != nullptr && slots_[hi].object != nullptr;
+	};
+	auto push = [this](CollisionEventType type, uint64_t key) {
+		events_.push_back({type, static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & 0xFFFFFFFFu)});
+	};
+
+	//========================================
+	// ソート済みリスト同士の線形マージ
+	// 前のみ→終了、両方→継続、今のみ→開始
+	size_t prev = 0;
+	size_t curr = 0;
+	while (prev < previousContacts_.size() || curr < currentContacts_.size()) {
+		if (curr >= currentContacts_.size() ||
+			(prev < previousContacts_.size() && previousContacts_[prev] < currentContacts_[curr])) {
+			uint64_t key = previousContacts_[prev++];
+			if (isAlive(key)) {
+				push(CollisionEventType::Exit, key);
+			}
+		} else if (prev >= previousContacts_.size() || currentContacts_[curr] < previousContacts_[prev]) {
+			uint64_t key = currentContacts_[curr++];
+			if (isAlive(key)) {
+				push(CollisionEventType::Enter, key);
+			}
+		} else {
+			uint64_t key = currentContacts_[curr];
+			++prev;
+			++curr;
+			if (isAlive(key)) {
+				push(CollisionEventType::Stay, key);
+			}
 		}
 	}
+
+	//========================================
+	// 今フレームの接触を確定し、前フレームを参照し終えたIDを解放
+	std::swap(previousContacts_, currentContacts_);
+	freeIds_.insert(freeIds_.end(), pendingFreeIds_.begin(), pendingFreeIds_.end());
+	pendingFreeIds_.clear();
 }
 
 ///=============================================================================
-///						衝突処理実行（改良版）
-void CollisionManager::ProcessCollision(BaseObject *objA, BaseObject *objB, bool isColliding) {
-	CollisionPair pair(objA, objB);
-	auto it = collisionStates_.find(pair);
-	bool wasColliding = (it != collisionStates_.end()) ? it->second : false;
-
-	if (isColliding && !wasColliding) {
-		// 衝突開始
-		objA->OnCollisionEnter(objB);
-		objB->OnCollisionEnter(objA);
-
-		// collidingObjects_セットに追加
-		objA->GetCollidingObjects().insert(objB);
-		objB->GetCollidingObjects().insert(objA);
-
-		collisionStates_[pair] = true;
-	} else if (isColliding && wasColliding) {
-		// 衝突継続
-		objA->OnCollisionStay(objB);
-		objB->OnCollisionStay(objA);
-	} else if (!isColliding && wasColliding) {
-		// 衝突終了
-		objA->OnCollisionExit(objB);
-		objB->OnCollisionExit(objA);
-
-		// collidingObjects_セットから削除
-		objA->GetCollidingObjects().erase(objB);
-		objB->GetCollidingObjects().erase(objA);
-
-		collisionStates_.erase(pair);
+///						衝突イベントをまとめて発火
+void CollisionManager::DispatchCollisionEvents() {
+	// NOTE: コールバック内で登録解除されたオブジェクトは以降のイベントから除外する
+	for (size_t i = 0; i < events_.size(); ++i) {
+		const CollisionEvent &event = events_[i];
+		BaseObject *objA = slots_[event.idA].object;
+		BaseObject *objB = slots_[event.idB].object;
+		if (!objA || !objB)
+			continue;
+
+		switch (event.type) {
+		case CollisionEventType::Enter:
+			// 衝突開始
+			objA->OnCollisionEnter(objB);
+			objB->OnCollisionEnter(objA);
+			if (slots_[event.idA].object == objA && slots_[event.idB].object == objB) {
+				objA->AddCollidingObject(objB);
+				objB->AddCollidingObject(objA);
+			}
+			break;
+		case CollisionEventType::Stay:
+			// 衝突継続
+			objA->OnCollisionStay(objB);
+			objB->OnCollisionStay(objA);
+			break;
+		case CollisionEventType::Exit:
+			// 衝突終了
+			objA->OnCollisionExit(objB);
+			objB->OnCollisionExit(objA);
+			objA->RemoveCollidingObject(objB);
+			objB->RemoveCollidingObject(objA);
+			break;
+		}
 	}
 }
 
 ///=============================================================================
 ///						デバッグ描画（最適化版）
 void CollisionManager::DrawDebugColliders() {
+	LineManager::CallerScope lineCaller("Collision");
 	for (const auto &obj : activeObjects_) {
 		if (obj && obj->GetCollider()) {
 			Vector3 position = obj->GetCollider()->GetPosition();
@@ -387,61 +394,90 @@ void CollisionManager::DrawDebugColliders() {
 			}
 
 			LineManager::GetInstance()->DrawSphere(position, radius, color);
+			// 移動判定は前フレーム位置からの移動経路も表示
+			if (obj->IsSweptCollisionEnabled()) {
+				LineManager::GetInstance()->DrawLine(obj->GetCollider()->GetPreviousPosition(), position, color);
+			}
 		}
 	}
 }
 
 ///=============================================================================
-///						グループ間衝突設定
-void CollisionManager::SetGroupCollision(uint16_t groupA, uint16_t groupB, bool canCollide) {
-	if (groupA >= 16 || groupB >= 16)
-		return;
-
-	groupCollisionMatrix_[groupA][groupB] = canCollide;
-	groupCollisionMatrix_[groupB][groupA] = canCollide; // 双方向
+///						球と重なるオブジェクトを列挙
+size_t CollisionManager::QuerySphere(const Vector3 &center, float radius, uint16_t groupMask, std::vector<BaseObject *> &outObjects) {
+	detector_.QuerySphere(center, radius, groupMask, queryIndices_);
+	return ResolveQueryResults(outObjects);
 }
 
 ///=============================================================================
-///						グループ衝突設定リセット
-void CollisionManager::ResetGroupCollisions() {
-	// すべてのグループが衝突可能に
-	for (int i = 0; i < 16; ++i) {
-		for (int j = 0; j < 16; ++j) {
-			groupCollisionMatrix_[i][j] = true;
-		}
-	}
+///						円錐内のオブジェクトを列挙
+size_t CollisionManager::QueryCone(const Vector3 &apex, const Vector3 &direction, float range, float halfAngle, uint16_t groupMask, std::vector<BaseObject *> &outObjects) {
+	detector_.QueryCone(apex, direction, range, std::cos(halfAngle), groupMask, queryIndices_);
+	return ResolveQueryResults(outObjects);
 }
 
 ///=============================================================================
-///						グループ衝突可能性を問い合わせ
-bool CollisionManager::CanGroupsCollide(uint16_t groupA, uint16_t groupB) const {
-	if (groupA >= 16 || groupB >= 16)
+///						レイキャスト
+bool CollisionManager::Raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, uint16_t groupMask, RaycastHit &outHit) {
+	uint32_t index = 0;
+	float distance = 0.0f;
+	if (!detector_.Raycast(origin, direction, maxDistance, groupMask, index, distance))
+		return false;
+
+	// 登録解除済みのオブジェクトは返さない
+	const ColliderTable &colliders = detector_.GetColliders();
+	uint32_t id = colliders.ids[index];
+	if (id >= slots_.size() || slots_[id].object != colliders.objects[index])
 		return false;
 
-	return groupCollisionMatrix_[groupA][groupB];
+	outHit.object = colliders.objects[index];
+	outHit.distance = distance;
+	outHit.point = origin + direction * distance;
+	Vector3 center = {colliders.startX[index] + colliders.moveX[index],
+					  colliders.startY[index] + colliders.moveY[index],
+					  colliders.startZ[index] + colliders.moveZ[index]};
+	Vector3 diff = outHit.point - center;
+	float length = std::sqrt(diff.x * diff.x + diff.y * diff.y + diff.z * diff.z);
+	outHit.normal = length > 0.0001f ? diff * (1.0f / length) : direction * -1.0f;
+	return true;
 }
 
 ///=============================================================================
-///						グループ・レイヤーマスクによる衝突可否判定
-bool CollisionManager::CanCollideByGroupAndMask(BaseObject *objA, BaseObject *objB) const {
-	uint16_t groupA = objA->GetGroup();
-	uint16_t groupB = objB->GetGroup();
-
-	// グループマトリクスで許可されているか確認
-	if (!CanGroupsCollide(groupA, groupB))
-		return false;
+///						近い順にk個を列挙
+size_t CollisionManager::QueryNearest(const Vector3 &position, uint32_t k, float maxDistance, uint16_t groupMask, std::vector<BaseObject *> &outObjects) {
+	detector_.QueryNearest(position, k, maxDistance, groupMask, queryIndices_);
+	return ResolveQueryResults(outObjects);
+}
 
-	// グループIDがレイヤーマスク内か確認（ビット単位）
-	if (groupB >= 16 || groupA >= 16)
-		return false; // グループIDが範囲外
+///=============================================================================
+///						クエリ結果をオブジェクトに変換
+size_t CollisionManager::ResolveQueryResults(std::vector<BaseObject *> &outObjects) {
+	outObjects.clear();
+	const ColliderTable &colliders = detector_.GetColliders();
+	for (uint32_t index : queryIndices_) {
+		// NOTE: 構築後に登録解除されたオブジェクトは解放済みの可能性があるため、参照せずスロットで照合
+		uint32_t id = colliders.ids[index];
+		if (id < slots_.size() && slots_[id].object == colliders.objects[index]) {
+			outObjects.push_back(colliders.objects[index]);
+		}
+	}
+	return outObjects.size();
+}
 
-	// objAがobjBのグループと衝突可能か
-	if ((objA->GetCollisionLayerMask() & (1 << groupB)) == 0)
-		return false;
+///=============================================================================
+///						グループ間衝突設定
+void CollisionManager::SetGroupCollision(uint16_t groupA, uint16_t groupB, bool canCollide) {
+	detector_.SetGroupCollision(groupA, groupB, canCollide);
+}
 
-	// objBがobjAのグループと衝突可能か
-	if ((objB->GetCollisionLayerMask() & (1 << groupA)) == 0)
-		return false;
+///=============================================================================
+///						グループ衝突設定リセット
+void CollisionManager::ResetGroupCollisions() {
+	detector_.ResetGroupCollisions();
+}
 
-	return true;
+///=============================================================================
+///						グループ衝突可能性を問い合わせ
+bool CollisionManager::CanGroupsCollide(uint16_t groupA, uint16_t groupB) const {
+	return detector_.CanGroupsCollide(groupA, groupB);
 }
@@ -11,88 +11,32 @@
 using namespace MagMath;
 #include "BaseObject.h"
 #include "Collider.h"
-#include <bitset>
+#include "CollisionBenchmark.h"
+#include "CollisionDetector.h"
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 //========================================
-// コリジョンシステム定数
-namespace CollisionConstants {
-	// グリッドセルのデフォルトサイズ（単位：ゲーム座標）
-	constexpr float kDefaultCellSize = 32.0f;
-	// グリッド内の最大オブジェクト数
-	constexpr int kDefaultMaxObjects = 1024;
-}
-
-//========================================
-// グリッド座標構造体（ハッシュ問題を解決）
-struct GridCoord {
-	int x, y, z;
-
-	GridCoord() : x(0), y(0), z(0) {
-	}
-	GridCoord(int x_, int y_, int z_) : x(x_), y(y_), z(z_) {
-	}
-
-	bool operator==(const GridCoord &other) const {
-		return x == other.x && y == other.y && z == other.z;
-	}
-};
-
-//========================================
-// ハッシュ関数（GridCoord専用）
-struct GridCoordHash {
-	std::size_t operator()(const GridCoord &coord) const {
-		// Cantor pairing をベースにした3D座標ハッシュ
-		static constexpr int PRIME1 = 73856093;
-		static constexpr int PRIME2 = 19349663;
-		static constexpr int PRIME3 = 83492791;
-		return (coord.x * PRIME1) ^ (coord.y * PRIME2) ^ (coord.z * PRIME3);
-	}
+// 衝突イベント（検出後にまとめて発火）
+enum class CollisionEventType : uint8_t {
+	Enter,
+	Stay,
+	Exit
 };
 
-//========================================
-// 最適化されたグリッドセル
-struct GridCell {
-	std::vector<BaseObject *> objects;
-
-	void Clear() {
-		objects.clear();
-	}
-	bool IsEmpty() const {
-		return objects.empty();
-	}
-	size_t Size() const {
-		return objects.size();
-	}
-	void Reserve(size_t capacity) {
-		objects.reserve(capacity);
-	}
+struct CollisionEvent {
+	CollisionEventType type;
+	uint32_t idA; ///< 衝突ID（発火時にオブジェクトへ解決）
+	uint32_t idB;
 };
 
 //========================================
-// コリジョンペア（軽量化）
-struct CollisionPair {
-	BaseObject *objA;
-	BaseObject *objB;
-
-	CollisionPair(BaseObject *a, BaseObject *b)
-		: objA(a < b ? a : b), objB(a < b ? b : a) {
-	}
-
-	bool operator==(const CollisionPair &other) const {
-		return objA == other.objA && objB == other.objB;
-	}
-};
-
-//========================================
-// ハッシュ関数（CollisionPair専用）
-struct CollisionPairHash {
-	std::size_t operator()(const CollisionPair &pair) const {
-		return std::hash<uintptr_t>{}(reinterpret_cast<uintptr_t>(pair.objA)) ^
-			   (std::hash<uintptr_t>{}(reinterpret_cast<uintptr_t>(pair.objB)) << 1);
-	}
+// レイキャストの結果
+struct RaycastHit {
+	BaseObject *object = nullptr;		 ///< 交差したオブジェクト
+	float distance = 0.0f;				 ///< 始点からの距離
+	Vector3 point = {0.0f, 0.0f, 0.0f};	 ///< 交差点
+	Vector3 normal = {0.0f, 1.0f, 0.0f}; ///< 交差点の法線
 };
 
 ///=============================================================================
@@ -115,33 +59,78 @@ public:
 	void Reset();
 
 	/// \brief オブジェクト登録
-	/// COMMENT: 衝突判定対象に追加。内部的にはアクティブリストと検索キャッシュを更新
+	/// COMMENT: 衝突IDを割り当ててアクティブリストに追加。登録済みかの判定はIDでO(1)
 	void RegisterObject(BaseObject *obj);
 
 	/// \brief オブジェクト登録解除
-	/// COMMENT: メモリ解放の前に必ず呼び出し。オブジェクトプール（再利用ポール）から削除
+	/// COMMENT: メモリ解放の前に必ず呼び出し。接触中の相手にのみ終了イベントを発火（O(接触数)）
 	void UnregisterObject(BaseObject *obj);
 
+	/// \brief 接触中のオブジェクト同士の衝突詳細を取得
+	/// \return 直近のUpdateで接触していた場合true
+	/// COMMENT: 移動判定の接触時刻は検出時の値を再利用する（衝突イベントのコールバック内で使用）
+	bool GetCollisionInfo(const BaseObject *objA, const BaseObject *objB, CollisionInfo &outInfo) const;
+
 	/// \brief 全ての当たり判定をチェック
+	/// COMMENT: 検出のみ行い、接触リストを更新する（イベントはUpdateで発火）
 	void CheckAllCollisions();
 
 	/// \brief セルサイズの設定
 	void SetCellSize(float size) {
-		cellSize_ = size;
-		invCellSize_ = 1.0f / cellSize_;
+		detector_.SetCellSize(size);
+	}
+
+	/// \brief 並列検出の有効/無効
+	void SetParallelEnabled(bool enabled) {
+		detector_.SetParallelEnabled(enabled);
 	}
 
 	/// \brief グリッド情報取得（デバッグ用）
 	size_t GetActiveGridCount() const {
-		return grid_.size();
+		return detector_.GetActiveBucketCount();
 	}
 	size_t GetTotalObjectCount() const {
 		return activeObjects_.size();
 	}
 	size_t GetCollisionChecksThisFrame() const {
-		return collisionChecksThisFrame_;
+		return detector_.GetCollisionChecks();
+	}
+	size_t GetCollisionHitsThisFrame() const {
+		return detector_.GetCollisionHits();
+	}
+	size_t GetContactCount() const {
+		return previousContacts_.size();
 	}
 
+	//========================================
+	// 空間クエリ
+	// NOTE: 直近のUpdateで構築した空間ハッシュを再利用する（位置は1フレーム前の判定時点）
+	//       現在位置で判定し直す場合は CollisionConstants::kQueryPositionMargin だけ広げて問い合わせる
+	//       衝突応答を止めたオブジェクト（SetCollisionResponseEnabled(false)）も対象に含む
+	//       出力配列はクリアして再利用するため、呼び出し側で保持すれば毎フレームの確保は発生しない
+	//       groupMaskのビットiがグループiを対象に含める。登録解除済み・無効なオブジェクトは返さない
+	//========================================
+
+	/// @brief 球と重なるオブジェクトを列挙
+	/// @return 見つかった数
+	size_t QuerySphere(const Vector3 &center, float radius, uint16_t groupMask, std::vector<BaseObject *> &outObjects);
+
+	/// @brief 視錐（円錐）内に中心があるオブジェクトを列挙
+	/// @param direction 円錐の軸（正規化済み）
+	/// @param range 距離
+	/// @param halfAngle 半頂角（ラジアン）
+	/// @return 見つかった数
+	size_t QueryCone(const Vector3 &apex, const Vector3 &direction, float range, float halfAngle, uint16_t groupMask, std::vector<BaseObject *> &outObjects);
+
+	/// @brief レイと最初に交差するオブジェクトを取得
+	/// @param direction レイの向き（正規化済み）
+	/// @return 交差した場合true
+	bool Raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, uint16_t groupMask, RaycastHit &outHit);
+
+	/// @brief 中心が近い順に最大k個のオブジェクトを列挙
+	/// @return 見つかった数
+	size_t QueryNearest(const Vector3 &position, uint32_t k, float maxDistance, uint16_t groupMask, std::vector<BaseObject *> &outObjects);
+
 	//========================================
 	// グループ/レイヤー管理
 	//========================================
@@ -159,57 +148,59 @@ public:
 	bool CanGroupsCollide(uint16_t groupA, uint16_t groupB) const;
 
 private:
-	/// \brief グリッド座標計算（改良版）
-	GridCoord CalculateGridCoord(const Vector3 &position) const;
-
-	/// \brief オブジェクトをグリッドに配置
-	void AssignObjectsToGrid();
+	/// \brief 前フレームと今フレームの接触リストをマージしてイベントを生成
+	void BuildCollisionEvents();
 
-	/// \brief セル内衝突判定
-	void CheckCollisionsInCell(const GridCell &cell);
+	/// \brief 衝突イベントをまとめて発火
+	void DispatchCollisionEvents();
 
-	/// \brief 隣接セル間衝突判定（改良版）
-	void CheckAdjacentCellCollisions(const GridCoord &coord, const GridCell &cell);
-
-	/// \brief 衝突処理実行
-	void ProcessCollision(BaseObject *objA, BaseObject *objB, bool isColliding);
-
-	/// \brief 高速衝突判定（AABB事前チェック付き）
-	bool FastIntersects(BaseObject *objA, BaseObject *objB) const;
+	/// \brief クエリ結果のインデックスをオブジェクトに変換（登録中のもののみ）
+	size_t ResolveQueryResults(std::vector<BaseObject *> &outObjects);
 
 	/// \brief デバッグ描画（最適化版）
 	void DrawDebugColliders();
 
-	/// \brief グループとレイヤーマスクの衝突判定
-	bool CanCollideByGroupAndMask(BaseObject *objA, BaseObject *objB) const;
-
 private:
 	//========================================
-	// グリッドシステム（改良版）
-	std::unordered_map<GridCoord, GridCell, GridCoordHash> grid_;
-	float cellSize_;
-	float invCellSize_; // 1/cellSize_（除算回避）
+	// 検出部（空間ハッシュ・SoAテーブル・ナローフェーズ）
+	CollisionDetector detector_;
 
 	//========================================
 	// オブジェクト管理
 	/// COMMENT: アクティブなオブジェクトリスト（衝突判定対象）
 	std::vector<BaseObject *> activeObjects_;
-	/// COMMENT: 削除されたオブジェクトの再利用プール（メモリ割り当て最適化）
-	std::vector<BaseObject *> objectPool_;
+	/// COMMENT: 衝突ID毎の登録情報（IDはBaseObjectに保持）
+	struct RegisteredSlot {
+		BaseObject *object = nullptr;
+		uint32_t activeIndex = 0; ///< activeObjects_内の位置
+	};
+	std::vector<RegisteredSlot> slots_;
+	/// COMMENT: 解放済みの衝突ID（再利用）
+	std::vector<uint32_t> freeIds_;
+	/// COMMENT: 登録解除されたID。前フレームの接触リストに残るため次のマージ後に解放
+	std::vector<uint32_t> pendingFreeIds_;
 
 	//========================================
-	// 衝突状態管理（軽量化）
-	std::unordered_map<CollisionPair, bool, CollisionPairHash> collisionStates_;
+	// 衝突状態管理（ソート済み接触キー）
+	/// COMMENT: 直近に確定したフレームの接触ペア（昇順）
+	std::vector<uint64_t> previousContacts_;
+	/// COMMENT: 検出中のフレームの接触ペア（検出後に昇順ソート）
+	std::vector<uint64_t> currentContacts_;
+	/// COMMENT: 発火待ちのイベント
+	std::vector<CollisionEvent> events_;
 
 	//========================================
-	// グループ間の衝突フラグマトリクス（16x16 = 256フラグ）
-	// groupCollisionMatrix[i][j] = グループiがグループjと衝突するかどうか
-	bool groupCollisionMatrix_[16][16];
+	// 空間クエリ
+	/// COMMENT: 検出器が返すインデックスの作業領域（フレームを跨いで再利用）
+	std::vector<uint32_t> queryIndices_;
 
 	//========================================
 	// デバッグ情報
 	bool enableDebugDraw_;
 	bool enableGroupFilter_;	///< グループフィルタリングの有効/無効
 	uint16_t debugGroupFilter_; ///< デバッグ表示用のグループフィルタ
-	size_t collisionChecksThisFrame_;
+
+	//========================================
+	// ベンチマーク結果（ImGui表示用）
+	std::vector<CollisionBenchmark::Result> benchmarkResults_;
 };
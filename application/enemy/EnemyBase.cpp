@@ -2,6 +2,7 @@
 #define NOMINMAX
 #include "EnemyBase.h"
 #include "BaseObject.h"
+#include "CollisionGroup.h"
 #include "ImguiSetup.h"
 #include "Particle.h"
 #include "Player.h"
@@ -21,6 +22,52 @@ namespace {
 	constexpr float kKnockbackStrength = 3.0f;
 	constexpr int kDefaultMaxHP = 3;
 	constexpr float kOutOfBoundsDistance = 150.0f;
+
+	//========================================
+	// パーティクルの生成設定
+	ParticleConfig MakeRingConfig(const MagMath::Vector4 &colorMin, const MagMath::Vector4 &colorMax,
+								  float lifetimeMin, float lifetimeMax,
+								  float initialScaleMin, float initialScaleMax, float endScaleMin, float endScaleMax) {
+		ParticleConfig config;
+		config.billboard = false;
+		config.velocityMin = {0.0f, 0.0f, 0.0f};
+		config.velocityMax = {0.0f, 0.0f, 0.0f};
+		config.colorMin = colorMin;
+		config.colorMax = colorMax;
+		config.lifetimeMin = lifetimeMin;
+		config.lifetimeMax = lifetimeMax;
+		config.initialScaleMin = {initialScaleMin, initialScaleMin, initialScaleMin};
+		config.initialScaleMax = {initialScaleMax, initialScaleMax, initialScaleMax};
+		config.endScaleMin = {endScaleMin, endScaleMin, endScaleMin};
+		config.endScaleMax = {endScaleMax, endScaleMax, endScaleMax};
+		config.gravity = {0.0f, 0.0f, 0.0f};
+		config.fadeInRatio = 0.0f;
+		config.fadeOutRatio = 1.0f;
+		return config;
+	}
+
+	ParticleConfig MakeSparksConfig(const MagMath::Vector3 &velocityMin, const MagMath::Vector3 &velocityMax,
+									const MagMath::Vector4 &colorMin, const MagMath::Vector4 &colorMax,
+									float lifetimeMin, float lifetimeMax,
+									float initialScaleMin, float initialScaleMax, float endScaleMin, float endScaleMax,
+									float gravityY, float fadeInRatio) {
+		ParticleConfig config;
+		config.billboard = true;
+		config.velocityMin = velocityMin;
+		config.velocityMax = velocityMax;
+		config.colorMin = colorMin;
+		config.colorMax = colorMax;
+		config.lifetimeMin = lifetimeMin;
+		config.lifetimeMax = lifetimeMax;
+		config.initialScaleMin = {initialScaleMin, initialScaleMin, initialScaleMin};
+		config.initialScaleMax = {initialScaleMax, initialScaleMax, initialScaleMax};
+		config.endScaleMin = {endScaleMin, endScaleMin, endScaleMin};
+		config.endScaleMax = {endScaleMax, endScaleMax, endScaleMax};
+		config.gravity = {0.0f, gravityY, 0.0f};
+		config.fadeInRatio = fadeInRatio;
+		config.fadeOutRatio = 0.8f;
+		return config;
+	}
 }
 
 ///=============================================================================
@@ -28,7 +75,7 @@ namespace {
 void EnemyBase::Initialize(MagEngine::Object3dSetup *object3dSetup, const std::string &modelPath, const Vector3 &position) {
 	// 3Dオブジェクトの初期化
 	obj_ = std::make_unique<Object3d>();
-	obj_->Initialize(object3dSetup);
+	obj_->InitializeInstanced(object3dSetup);
 	obj_->SetModel(modelPath);
 
 	// トランスフォームの初期設定
@@ -77,7 +124,7 @@ void EnemyBase::Initialize(MagEngine::Object3dSetup *object3dSetup, const std::s
 	currentVelocity_ = {0.0f, 0.0f, 0.0f};
 
 	// BaseObjectの初期化
-	BaseObject::Initialize(transform_.translate, radius_);
+	BaseObject::Initialize(transform_.translate, radius_, CollisionType::DYNAMIC, CollisionGroup::kEnemy);
 }
 
 ///=============================================================================
@@ -86,6 +133,24 @@ void EnemyBase::SetParticleSystem(MagEngine::Particle *particle,
 								  MagEngine::ParticleSetup *particleSetup) {
 	particle_ = particle;
 	particleSetup_ = particleSetup;
+	if (!particle_)
+		return;
+
+	// 生成設定の登録（同名の設定は全ての敵で共有される）
+	// 衝撃波
+	hitRingConfigId_ = particle_->RegisterConfig("ExplosionRing", "EnemyHitRing",
+												 MakeRingConfig({1.0f, 0.9f, 0.2f, 1.0f}, {1.0f, 0.6f, 0.0f, 1.0f}, 0.25f, 0.35f, 0.5f, 0.8f, 2.5f, 3.5f));
+	// 火花
+	hitSparksConfigId_ = particle_->RegisterConfig("ExplosionSparks", "EnemyHitSparks",
+												   MakeSparksConfig({-5.0f, -3.0f, -5.0f}, {5.0f, 5.0f, 5.0f}, {1.0f, 0.9f, 0.3f, 1.0f}, {1.0f, 0.5f, 0.1f, 1.0f},
+																	0.2f, 0.4f, 0.4f, 0.7f, 0.1f, 0.2f, -5.0f, 0.0f));
+	// 大規模な衝撃波
+	destroyRingConfigId_ = particle_->RegisterConfig("ExplosionRing", "EnemyDestroyRing",
+													 MakeRingConfig({1.0f, 0.9f, 0.0f, 1.0f}, {1.0f, 0.5f, 0.0f, 1.0f}, 0.3f, 0.5f, 1.0f, 1.5f, 4.0f, 6.0f));
+	// 大量の火花
+	destroySparksConfigId_ = particle_->RegisterConfig("ExplosionSparks", "EnemyDestroySparks",
+													   MakeSparksConfig({-15.0f, -10.0f, -15.0f}, {15.0f, 15.0f, 15.0f}, {1.0f, 0.5f, 0.0f, 1.0f}, {1.0f, 1.0f, 0.3f, 1.0f},
+																		0.5f, 1.5f, 0.5f, 1.2f, 0.1f, 0.3f, -8.0f, 0.02f));
 }
 
 ///=============================================================================
@@ -189,6 +254,8 @@ void EnemyBase::StartHitReaction() {
 
 	isHitReacting_ = true;
 	isInvincible_ = true;
+	// ヒットリアクション中は衝突応答のみ止める（ロックオン・ミサイルの空間クエリには残す）
+	SetCollisionResponseEnabled(false);
 	hitReactionTimer_ = 0.0f;
 	hitFlashCount_ = 0;
 	hitStartPosition_ = transform_.translate;
@@ -270,6 +337,7 @@ void EnemyBase::UpdateHitReaction() {
 	if (hitReactionTimer_ >= hitReactionDuration_) {
 		isHitReacting_ = false;
 		isInvincible_ = false;
+		SetCollisionResponseEnabled(true);
 		hitReactionTimer_ = 0.0f;
 		transform_.scale = originalScale_;
 		shouldRenderThisFrame_ = true;
@@ -325,27 +393,9 @@ void EnemyBase::CreateHitParticle() {
 
 	Vector3 enemyPos = transform_.translate;
 
-	// 衝撃波
-	particle_->SetBillboard(false);
-	particle_->SetVelocityRange({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
-	particle_->SetColorRange({1.0f, 0.9f, 0.2f, 1.0f}, {1.0f, 0.6f, 0.0f, 1.0f});
-	particle_->SetLifetimeRange(0.25f, 0.35f);
-	particle_->SetInitialScaleRange({0.5f, 0.5f, 0.5f}, {0.8f, 0.8f, 0.8f});
-	particle_->SetEndScaleRange({2.5f, 2.5f, 2.5f}, {3.5f, 3.5f, 3.5f});
-	particle_->SetGravity({0.0f, 0.0f, 0.0f});
-	particle_->SetFadeInOut(0.0f, 1.0f);
-	particle_->Emit("ExplosionRing", enemyPos, 2);
-
-	// 火花
-	particle_->SetBillboard(true);
-	particle_->SetVelocityRange({-5.0f, -3.0f, -5.0f}, {5.0f, 5.0f, 5.0f});
-	particle_->SetColorRange({1.0f, 0.9f, 0.3f, 1.0f}, {1.0f, 0.5f, 0.1f, 1.0f});
-	particle_->SetLifetimeRange(0.2f, 0.4f);
-	particle_->SetInitialScaleRange({0.4f, 0.4f, 0.4f}, {0.7f, 0.7f, 0.7f});
-	particle_->SetEndScaleRange({0.1f, 0.1f, 0.1f}, {0.2f, 0.2f, 0.2f});
-	particle_->SetGravity({0.0f, -5.0f, 0.0f});
-	particle_->SetFadeInOut(0.0f, 0.8f);
-	particle_->Emit("ExplosionSparks", enemyPos, 20);
+	// 衝撃波と火花（生成は次のパーティクル更新でまとめて行われる）
+	particle_->EnqueueEmit(hitRingConfigId_, enemyPos, 2);
+	particle_->EnqueueEmit(hitSparksConfigId_, enemyPos, 20);
 }
 
 ///=============================================================================
@@ -356,27 +406,9 @@ void EnemyBase::CreateDestroyParticle() {
 
 	Vector3 enemyPos = transform_.translate;
 
-	// 大規模な衝撃波
-	particle_->SetBillboard(false);
-	particle_->SetVelocityRange({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
-	particle_->SetColorRange({1.0f, 0.9f, 0.0f, 1.0f}, {1.0f, 0.5f, 0.0f, 1.0f});
-	particle_->SetLifetimeRange(0.3f, 0.5f);
-	particle_->SetInitialScaleRange({1.0f, 1.0f, 1.0f}, {1.5f, 1.5f, 1.5f});
-	particle_->SetEndScaleRange({4.0f, 4.0f, 4.0f}, {6.0f, 6.0f, 6.0f});
-	particle_->SetGravity({0.0f, 0.0f, 0.0f});
-	particle_->SetFadeInOut(0.0f, 1.0f);
-	particle_->Emit("ExplosionRing", enemyPos, 3);
-
-	// 大量の火花
-	particle_->SetBillboard(true);
-	particle_->SetVelocityRange({-15.0f, -10.0f, -15.0f}, {15.0f, 15.0f, 15.0f});
-	particle_->SetColorRange({1.0f, 0.5f, 0.0f, 1.0f}, {1.0f, 1.0f, 0.3f, 1.0f});
-	particle_->SetLifetimeRange(0.5f, 1.5f);
-	particle_->SetInitialScaleRange({0.5f, 0.5f, 0.5f}, {1.2f, 1.2f, 1.2f});
-	particle_->SetEndScaleRange({0.1f, 0.1f, 0.1f}, {0.3f, 0.3f, 0.3f});
-	particle_->SetGravity({0.0f, -8.0f, 0.0f});
-	particle_->SetFadeInOut(0.02f, 0.8f);
-	particle_->Emit("ExplosionSparks", enemyPos, 60);
+	// 大規模な衝撃波と大量の火花
+	particle_->EnqueueEmit(destroyRingConfigId_, enemyPos, 3);
+	particle_->EnqueueEmit(destroySparksConfigId_, enemyPos, 60);
 
 	particleCreated_ = true;
 }
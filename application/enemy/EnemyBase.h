@@ -154,6 +154,11 @@ protected:
 	MagEngine::Particle *particle_;
 	MagEngine::ParticleSetup *particleSetup_;
 	bool particleCreated_;
+	// 生成設定ID（SetParticleSystemで登録）
+	uint32_t hitRingConfigId_ = MagEngine::Particle::kInvalidConfigId;
+	uint32_t hitSparksConfigId_ = MagEngine::Particle::kInvalidConfigId;
+	uint32_t destroyRingConfigId_ = MagEngine::Particle::kInvalidConfigId;
+	uint32_t destroySparksConfigId_ = MagEngine::Particle::kInvalidConfigId;
 
 	//========================================
 	// 破壊演出関連
@@ -1,5 +1,6 @@
 #define _USE_MATH_DEFINES
 #include "EnemyBullet.h"
+#include "CollisionGroup.h"
 #include "Object3dSetup.h"
 #include "Particle.h"
 #include "Player.h"
@@ -10,7 +11,7 @@ using namespace MagEngine;
 ///                        初期化
 void EnemyBullet::Initialize(MagEngine::Object3dSetup *object3dSetup, const std::string &modelPath, const Vector3 &position, const Vector3 &direction) {
 	obj_ = std::make_unique<Object3d>();
-	obj_->Initialize(object3dSetup);
+	obj_->InitializeInstanced(object3dSetup);
 	obj_->SetModel(modelPath);
 
 	transform_.translate = position;
@@ -37,7 +38,9 @@ void EnemyBullet::Initialize(MagEngine::Object3dSetup *object3dSetup, const std:
 	particle_ = nullptr;
 	particleSetup_ = nullptr;
 
-	BaseObject::Initialize(transform_.translate, radius_);
+	BaseObject::Initialize(transform_.translate, radius_, CollisionType::DYNAMIC, CollisionGroup::kEnemyBullet);
+	// 1フレームの移動量が半径より大きいため、移動判定ですり抜けを防ぐ
+	SetSweptCollisionEnabled(true);
 }
 
 ///=============================================================================
@@ -45,6 +48,26 @@ void EnemyBullet::Initialize(MagEngine::Object3dSetup *object3dSetup, const std:
 void EnemyBullet::SetParticleSystem(MagEngine::Particle *particle, MagEngine::ParticleSetup *particleSetup) {
 	particle_ = particle;
 	particleSetup_ = particleSetup;
+	if (!particle_)
+		return;
+
+	// 着弾時の火花（同名の設定は全ての弾で共有される）
+	ParticleConfig config;
+	config.billboard = true;
+	config.velocityMin = {-3.0f, -2.0f, -3.0f};
+	config.velocityMax = {3.0f, 3.0f, 3.0f};
+	config.colorMin = {1.0f, 0.3f, 0.0f, 1.0f};
+	config.colorMax = {1.0f, 0.6f, 0.2f, 1.0f};
+	config.lifetimeMin = 0.2f;
+	config.lifetimeMax = 0.4f;
+	config.initialScaleMin = {0.3f, 0.3f, 0.3f};
+	config.initialScaleMax = {0.6f, 0.6f, 0.6f};
+	config.endScaleMin = {0.1f, 0.1f, 0.1f};
+	config.endScaleMax = {0.2f, 0.2f, 0.2f};
+	config.gravity = {0.0f, -3.0f, 0.0f};
+	config.fadeInRatio = 0.0f;
+	config.fadeOutRatio = 0.8f;
+	hitSparksConfigId_ = particle_->RegisterConfig("ExplosionSparks", "EnemyBulletHitSparks", config);
 }
 
 ///=============================================================================
@@ -91,15 +114,7 @@ void EnemyBullet::OnCollisionEnter(BaseObject *other) {
 	if (dynamic_cast<Player *>(other) != nullptr) {
 		// パーティクル生成
 		if (particle_) {
-			particle_->SetBillboard(true);
-			particle_->SetVelocityRange({-3.0f, -2.0f, -3.0f}, {3.0f, 3.0f, 3.0f});
-			particle_->SetColorRange({1.0f, 0.3f, 0.0f, 1.0f}, {1.0f, 0.6f, 0.2f, 1.0f});
-			particle_->SetLifetimeRange(0.2f, 0.4f);
-			particle_->SetInitialScaleRange({0.3f, 0.3f, 0.3f}, {0.6f, 0.6f, 0.6f});
-			particle_->SetEndScaleRange({0.1f, 0.1f, 0.1f}, {0.2f, 0.2f, 0.2f});
-			particle_->SetGravity({0.0f, -3.0f, 0.0f});
-			particle_->SetFadeInOut(0.0f, 0.8f);
-			particle_->Emit("ExplosionSparks", transform_.translate, 10);
+			particle_->EnqueueEmit(hitSparksConfigId_, transform_.translate, 10);
 		}
 		// 弾を消滅させる
 		isAlive_ = false;
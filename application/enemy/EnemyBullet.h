@@ -64,4 +64,5 @@ private:
 	bool isAlive_;
 	MagEngine::Particle *particle_;
 	MagEngine::ParticleSetup *particleSetup_;
+	uint32_t hitSparksConfigId_ = MagEngine::Particle::kInvalidConfigId; // 着弾時の火花の生成設定ID
 };
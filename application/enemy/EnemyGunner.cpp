@@ -1,5 +1,6 @@
 #define _USE_MATH_DEFINES
 #include "EnemyGunner.h"
+#include "CollisionManager.h"
 #include "ImguiSetup.h"
 #include "Player.h"
 #include <algorithm>
@@ -30,14 +31,7 @@ void EnemyGunner::Update() {
 	EnemyBase::Update();
 
 	if (destroyState_ != DestroyState::Alive || isHitReacting_) {
-		for (auto &bullet : bullets_) {
-			if (bullet)
-				bullet->Update();
-		}
-		bullets_.erase(
-			std::remove_if(bullets_.begin(), bullets_.end(),
-						   [](const std::unique_ptr<EnemyBullet> &b) { return !b || !b->IsAlive(); }),
-			bullets_.end());
+		UpdateBullets();
 		return;
 	}
 
@@ -117,6 +111,9 @@ void EnemyGunner::Update() {
 			auto bullet = std::make_unique<EnemyBullet>();
 			bullet->Initialize(object3dSetup_, "Missile.obj", transform_.translate, shootDir);
 			bullet->SetParticleSystem(particle_, particleSetup_);
+			if (collisionManager_) {
+				collisionManager_->RegisterObject(bullet.get());
+			}
 			bullets_.push_back(std::move(bullet));
 
 			shootTimer_ = 0.0f;
@@ -132,16 +129,40 @@ void EnemyGunner::Update() {
 	}
 
 	// 弾の更新・削除
+	UpdateBullets();
+}
+
+///=============================================================================
+///                        弾の更新と削除
+void EnemyGunner::UpdateBullets() {
 	for (auto &bullet : bullets_) {
 		if (bullet)
 			bullet->Update();
 	}
 	bullets_.erase(
 		std::remove_if(bullets_.begin(), bullets_.end(),
-					   [](const std::unique_ptr<EnemyBullet> &b) { return !b || !b->IsAlive(); }),
+					   [this](const std::unique_ptr<EnemyBullet> &b) {
+						   if (b && b->IsAlive())
+							   return false;
+						   // 解放前に当たり判定の登録を解除
+						   if (b && collisionManager_)
+							   collisionManager_->UnregisterObject(b.get());
+						   return true;
+					   }),
 		bullets_.end());
 }
 
+///=============================================================================
+///                        全弾の当たり判定の登録解除
+void EnemyGunner::UnregisterBulletCollisions() {
+	if (!collisionManager_)
+		return;
+	for (auto &bullet : bullets_) {
+		if (bullet)
+			collisionManager_->UnregisterObject(bullet.get());
+	}
+}
+
 ///=============================================================================
 ///                        描画
 void EnemyGunner::Draw() {
@@ -6,6 +6,9 @@ using namespace MagMath;
 #include <memory>
 #include <vector>
 
+// 前方宣言
+class CollisionManager;
+
 namespace EnemyGunnerConstants {
 	constexpr int kDefaultHP = 2;
 	constexpr float kDefaultSpeed = 15.0f;
@@ -49,6 +52,20 @@ public:
 		return bullets_;
 	}
 
+	/// \brief 当たり判定マネージャーの設定（弾の登録・登録解除に使用）
+	void SetCollisionManager(CollisionManager *collisionManager) {
+		collisionManager_ = collisionManager;
+	}
+
+	/// \brief 全弾の当たり判定の登録解除（ガンナーを削除する前に呼ぶ）
+	void UnregisterBulletCollisions();
+
+	///--------------------------------------------------------------
+	///							静的メンバ関数
+private:
+	/// \brief 弾の更新と死んだ弾の削除（登録解除してから削除）
+	void UpdateBullets();
+
 	///--------------------------------------------------------------
 	///							メンバ変数
 private:
@@ -66,4 +83,5 @@ private:
 	Vector3 combatCenter_;
 	std::vector<std::unique_ptr<EnemyBullet>> bullets_;
 	MagEngine::Object3dSetup *object3dSetup_;
+	CollisionManager *collisionManager_ = nullptr;
 };
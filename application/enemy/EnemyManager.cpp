@@ -29,10 +29,14 @@ void EnemyManager::Initialize(MagEngine::Object3dSetup *object3dSetup,
 	particle_ = particle;
 	particleSetup_ = particleSetup;
 	player_ = nullptr;
+	collisionManager_ = nullptr;
 
 	gameTime_ = 0.0f;
 	defeatedCount_ = 0;
 
+	// スポーン配置用の乱数ストリーム（セッションシードから決定的に作成）
+	random_ = MagEngine::Random::CreateStream("EnemyManager");
+
 	//========================================
 	// ウェーブ定義（5ウェーブ固定）
 	waveConfigs_ = {
@@ -127,19 +131,24 @@ void EnemyManager::DrawImGui() {
 }
 
 ///=============================================================================
-///                        当たり判定登録
-void EnemyManager::RegisterCollisions(CollisionManager *collisionManager) {
+///                        全敵削除
+void EnemyManager::Clear() {
 	for (auto &enemy : enemies_) {
-		if (enemy && enemy->IsAlive() && !enemy->IsInHitReaction()) {
-			collisionManager->RegisterObject(enemy.get());
-		}
+		UnregisterCollisions(enemy.get());
 	}
+	enemies_.clear();
 }
 
 ///=============================================================================
-///                        全敵削除
-void EnemyManager::Clear() {
-	enemies_.clear();
+///                        当たり判定の登録解除
+void EnemyManager::UnregisterCollisions(EnemyBase *enemy) {
+	if (!enemy || !collisionManager_)
+		return;
+	collisionManager_->UnregisterObject(enemy);
+	// 敵の弾は敵と一緒に解放されるため、まとめて登録解除
+	if (EnemyGunner *gunner = dynamic_cast<EnemyGunner *>(enemy)) {
+		gunner->UnregisterBulletCollisions();
+	}
 }
 
 ///=============================================================================
@@ -213,6 +222,9 @@ void EnemyManager::SpawnEnemy(const Vector3 &position) {
 	enemy->SetDefeatCallback([this]() {
 		defeatedCount_++;
 	});
+	if (collisionManager_) {
+		collisionManager_->RegisterObject(enemy.get());
+	}
 	enemies_.push_back(std::move(enemy));
 }
 
@@ -226,44 +238,48 @@ void EnemyManager::SpawnGunner(const Vector3 &position) {
 	gunner->SetDefeatCallback([this]() {
 		defeatedCount_++;
 	});
+	gunner->SetCollisionManager(collisionManager_);
+	if (collisionManager_) {
+		collisionManager_->RegisterObject(gunner.get());
+	}
 	enemies_.push_back(std::move(gunner));
 }
 
 ///=============================================================================
 ///                        スポーン位置の生成
-Vector3 EnemyManager::GenerateSpawnPosition() const {
+Vector3 EnemyManager::GenerateSpawnPosition() {
 	Vector3 spawnPos = {0.0f, 0.0f, -30.0f};
 	if (!player_)
 		return spawnPos;
 
 	Vector3 playerPos = player_->GetPosition();
-	int pattern = rand() % 4;
-	float distance = 50.0f + static_cast<float>(rand() % 20);
+	int pattern = random_.RangeInt(0, 3);
+	float distance = 50.0f + static_cast<float>(random_.RangeInt(0, 19));
 
 	switch (pattern) {
 	case 0: // 左から
 		spawnPos = {
 			playerPos.x - distance,
-			playerPos.y + static_cast<float>((rand() % 10) - 5),
-			playerPos.z + static_cast<float>((rand() % 30) - 15)};
+			playerPos.y + static_cast<float>(random_.RangeInt(-5, 4)),
+			playerPos.z + static_cast<float>(random_.RangeInt(-15, 14))};
 		break;
 	case 1: // 右から
 		spawnPos = {
 			playerPos.x + distance,
-			playerPos.y + static_cast<float>((rand() % 10) - 5),
-			playerPos.z + static_cast<float>((rand() % 30) - 15)};
+			playerPos.y + static_cast<float>(random_.RangeInt(-5, 4)),
+			playerPos.z + static_cast<float>(random_.RangeInt(-15, 14))};
 		break;
 	case 2: // 上から
 		spawnPos = {
-			playerPos.x + static_cast<float>((rand() % 30) - 15),
+			playerPos.x + static_cast<float>(random_.RangeInt(-15, 14)),
 			playerPos.y + distance * 0.6f,
-			playerPos.z + static_cast<float>((rand() % 30) - 15)};
+			playerPos.z + static_cast<float>(random_.RangeInt(-15, 14))};
 		break;
 	default: { // 斜め前方から
-		float angle = static_cast<float>(rand() % 360) * 3.14159f / 180.0f;
+		float angle = static_cast<float>(random_.RangeInt(0, 359)) * 3.14159f / 180.0f;
 		spawnPos = {
 			playerPos.x + std::sin(angle) * distance,
-			playerPos.y + static_cast<float>((rand() % 10) - 5),
+			playerPos.y + static_cast<float>(random_.RangeInt(-5, 4)),
 			playerPos.z + std::cos(angle) * distance * 0.5f + 40.0f};
 		break;
 	}
@@ -276,8 +292,12 @@ Vector3 EnemyManager::GenerateSpawnPosition() const {
 void EnemyManager::RemoveDeadEnemies() {
 	enemies_.erase(
 		std::remove_if(enemies_.begin(), enemies_.end(),
-					   [](const std::unique_ptr<EnemyBase> &enemy) {
-						   return !enemy || !enemy->IsAlive();
+					   [this](const std::unique_ptr<EnemyBase> &enemy) {
+						   if (enemy && enemy->IsAlive())
+							   return false;
+						   // 解放前に当たり判定の登録を解除
+						   UnregisterCollisions(enemy.get());
+						   return true;
 					   }),
 		enemies_.end());
 }
@@ -290,20 +310,3 @@ size_t EnemyManager::GetAliveEnemyCount() const {
 							 return enemy && enemy->IsAlive();
 						 });
 }
-
-///=============================================================================
-///                        敵の弾をすべて取得
-std::vector<EnemyBullet *> EnemyManager::GetAllEnemyBullets() {
-	std::vector<EnemyBullet *> allBullets;
-	for (auto &enemy : enemies_) {
-		if (enemy && enemy->IsAlive()) {
-			if (EnemyGunner *gunner = dynamic_cast<EnemyGunner *>(enemy.get())) {
-				for (auto &bullet : gunner->GetBullets()) {
-					if (bullet && bullet->IsAlive())
-						allBullets.push_back(bullet.get());
-				}
-			}
-		}
-	}
-	return allBullets;
-}
@@ -9,6 +9,7 @@
 #include "MagMath.h"
 using namespace MagMath;
 #include "EnemyBase.h"
+#include "Random.h"
 #include <memory>
 #include <vector>
 
@@ -53,8 +54,11 @@ public:
 	/// \brief ImGui描画
 	void DrawImGui();
 
-	/// \brief 当たり判定登録
-	void RegisterCollisions(CollisionManager *collisionManager);
+	/// \brief 当たり判定マネージャーの設定
+	/// \note 以降にスポーンした敵と敵の弾はスポーン時に登録し、削除時に登録解除する
+	void SetCollisionManager(CollisionManager *collisionManager) {
+		collisionManager_ = collisionManager;
+	}
 
 	/// \brief 全敵削除
 	void Clear();
@@ -95,9 +99,6 @@ public:
 		return enemies_;
 	}
 
-	/// \brief 敵の弾をすべて取得
-	std::vector<EnemyBullet *> GetAllEnemyBullets();
-
 	///--------------------------------------------------------------
 	///							静的メンバ関数
 private:
@@ -111,11 +112,14 @@ private:
 	void SpawnGunner(const Vector3 &position);
 
 	/// \brief スポーン位置の生成
-	Vector3 GenerateSpawnPosition() const;
+	Vector3 GenerateSpawnPosition();
 
 	/// \brief 死んだ敵の削除
 	void RemoveDeadEnemies();
 
+	/// \brief 敵と敵の弾の当たり判定の登録解除（敵を削除する前に呼ぶ）
+	void UnregisterCollisions(EnemyBase *enemy);
+
 	///--------------------------------------------------------------
 	///							メンバ変数
 private:
@@ -142,6 +146,10 @@ private:
 	int defeatedCount_;		  // 撃破数
 	int targetDefeatedCount_; // 目標撃破数（全ウェーブ合計）
 
+	//========================================
+	// 乱数
+	MagEngine::RandomStream random_; // スポーン配置用
+
 	//========================================
 	// ゲーム経過時間
 	float gameTime_;
@@ -152,4 +160,5 @@ private:
 	MagEngine::Particle *particle_;
 	MagEngine::ParticleSetup *particleSetup_;
 	Player *player_;
+	CollisionManager *collisionManager_;
 };
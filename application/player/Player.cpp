@@ -9,6 +9,7 @@
 // 以下はstd::maxを使用する場合に必要
 #define NOMINMAX
 #include "Player.h"
+#include "CollisionGroup.h"
 #include "EnemyBase.h"
 #include "EnemyBullet.h"
 #include "EnemyManager.h"
@@ -63,7 +64,7 @@ void Player::Initialize(MagEngine::Object3dSetup *object3dSetup, const std::stri
 	if (MagMath::Transform *transform = GetTransformSafe()) {
 		transform->translate = zero;
 		transform->rotate = zero;
-		BaseObject::Initialize(transform->translate, 1.0f);
+		BaseObject::Initialize(transform->translate, 1.0f, CollisionType::DYNAMIC, CollisionGroup::kPlayer);
 	}
 
 	// === システム参照初期化 ===
@@ -327,6 +328,7 @@ void Player::Draw() {
 
 #ifdef _DEBUG
 	// ロックオン範囲の描画（コンポーネント情報を使用）
+	LineManager::CallerScope lineCaller("Player");
 	LineManager *lineManager = LineManager::GetInstance();
 	Vector3 playerPos = GetPosition();
 	Vector3 playerForward = GetForwardVector();
@@ -390,14 +392,6 @@ void Player::DrawMissiles() {
 	combatComponent_.DrawMissiles();
 }
 
-void Player::DrawBulletsTrails() {
-	combatComponent_.DrawBulletsTrails();
-}
-
-void Player::DrawMissilesTrails() {
-	combatComponent_.DrawMissilesTrails();
-}
-
 //=============================================================================
 // ImGui描画
 void Player::DrawImGui() {
@@ -38,6 +38,7 @@
 // 前方宣言
 class Object3dSetup;
 class EnemyManager;
+class CollisionManager;
 class EnemyBase; // Enemy から EnemyBase に変更
 class EnemyBullet;
 
@@ -87,10 +88,6 @@ public:
 	void DrawBullets();
 	/// @brief ミサイル描画
 	void DrawMissiles();
-	/// @brief 弾のトレイル描画
-	void DrawBulletsTrails();
-	/// @brief ミサイルのトレイル描画
-	void DrawMissilesTrails();
 
 	//========================================
 	// EnemyManager設定（ミサイル・ロックオン用）
@@ -100,6 +97,11 @@ public:
 		combatComponent_.SetEnemyManager(enemyManager);
 		lockedOnComponent_.SetEnemyManager(enemyManager);
 	}
+	/// @brief 当たり判定マネージャーの設定（ロックオン・ミサイルの空間クエリ用）
+	void SetCollisionManager(CollisionManager *collisionManager) {
+		combatComponent_.SetCollisionManager(collisionManager);
+		lockedOnComponent_.SetCollisionManager(collisionManager);
+	}
 	/// @brief 敵マネージャーの取得（HUD用）
 	EnemyManager *GetEnemyManager() const {
 		return enemyManager_;
@@ -1,15 +1,21 @@
 #include "PlayerBullet.h"
+#include "CollisionGroup.h"
 #include "Object3d.h"
-#include "TrailEffectManager.h"
 using namespace MagEngine;
 
+PlayerBullet::~PlayerBullet() {
+	if (trailEffectManager_) {
+		trailEffectManager_->ReleaseTrail(trailHandle_);
+	}
+}
+
 void PlayerBullet::Initialize(MagEngine::Object3dSetup *object3dSetup,
 							  MagEngine::TrailEffectManager *trailEffectManager,
 							  const std::string &modelPath, const Vector3 &position, const Vector3 &direction) {
 
 	// Object3dの初期化
 	obj_ = std::make_unique<Object3d>();
-	obj_->Initialize(object3dSetup);
+	obj_->InitializeInstanced(object3dSetup);
 	obj_->SetModel(modelPath);
 
 	// 初期設定
@@ -33,13 +39,14 @@ void PlayerBullet::Initialize(MagEngine::Object3dSetup *object3dSetup,
 
 	// BaseObjectの初期化（当たり判定）
 	Vector3 pos = position;
-	BaseObject::Initialize(pos, radius_);
+	BaseObject::Initialize(pos, radius_, CollisionType::DYNAMIC, CollisionGroup::kPlayerBullet);
+	// 1フレームの移動量が半径より大きいため、移動判定ですり抜けを防ぐ
+	SetSweptCollisionEnabled(true);
 
 	// トレイルエフェクトの初期化
-	if (trailEffectManager) {
-		trailEffect_ = std::make_unique<TrailEffect>();
-		TrailEffectPreset bulletPreset = *trailEffectManager->GetPreset("Bullet");
-		trailEffect_->Initialize(trailEffectManager->GetSetup(), bulletPreset);
+	trailEffectManager_ = trailEffectManager;
+	if (trailEffectManager_) {
+		trailHandle_ = trailEffectManager_->AcquireTrail("Bullet");
 	}
 }
 
@@ -68,11 +75,11 @@ void PlayerBullet::Update() {
 	// BaseObjectのコライダー位置を更新
 	BaseObject::Update(transform->translate);
 
-	// トレイルエフェクトの更新
-	if (trailEffect_) {
-		trailEffect_->Update(frameTime);
-		// 現在位置で軌跡を発生させる
-		trailEffect_->EmitAt(transform->translate, velocity_);
+	// トレイルエフェクトの更新（現在位置で軌跡を発生させる）
+	if (trailEffectManager_) {
+		if (TrailEffect *trail = trailEffectManager_->GetTrail(trailHandle_)) {
+			trail->EmitAt(transform->translate, velocity_);
+		}
 	}
 
 	// Object3dの更新
@@ -85,12 +92,6 @@ void PlayerBullet::Draw() {
 	}
 }
 
-void PlayerBullet::DrawTrail() {
-	if (trailEffect_) {
-		trailEffect_->Draw();
-	}
-}
-
 Vector3 PlayerBullet::GetPosition() const {
 	if (obj_) {
 		return obj_->GetPosition();
@@ -1,7 +1,7 @@
 #pragma once
 #include "BaseObject.h" // BaseObjectを継承
 #include "Object3d.h"
-#include "TrailEffect.h"
+#include "TrailEffectManager.h"
 #include "Transform.h"
 #include "Vector3.h"
 #include <memory>
@@ -9,12 +9,12 @@
 
 // Forward declarations
 class Object3dSetup;
-namespace MagEngine {
-	class TrailEffectManager;
-}
 
 class PlayerBullet : public BaseObject {
 public:
+	/// \brief デストラクタ（トレイルをプールに返す）
+	~PlayerBullet() override;
+
 	/// \brief 初期化
 	void Initialize(MagEngine::Object3dSetup *object3dSetup,
 					MagEngine::TrailEffectManager *trailEffectManager,
@@ -26,9 +26,6 @@ public:
 	/// \brief 描画
 	void Draw();
 
-	/// \brief トレイル描画
-	void DrawTrail();
-
 	/// \brief 生存フラグの取得
 	bool IsAlive() const {
 		return isAlive_;
@@ -58,8 +55,9 @@ private:
 	std::unique_ptr<MagEngine::Object3d> obj_;
 
 	//========================================
-	//  トレイルエフェクト
-	std::unique_ptr<MagEngine::TrailEffect> trailEffect_;
+	//  トレイルエフェクト（描画・フェードは TrailEffectManager が行う）
+	MagEngine::TrailEffectManager *trailEffectManager_ = nullptr;
+	MagEngine::TrailHandle trailHandle_;
 
 	//========================================
 	//  位置情報
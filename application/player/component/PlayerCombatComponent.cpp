@@ -2,6 +2,7 @@
 // 以下はstd::maxを使用する場合に必要
 #define NOMINMAX
 #include "PlayerCombatComponent.h"
+#include "CollisionManager.h"
 #include "EnemyManager.h"
 #include "LineManager.h"
 #include <algorithm>
@@ -9,7 +10,7 @@
 
 namespace {
 	template <class T>
-	void UpdateProjectileList(std::vector<std::unique_ptr<T>> &items) {
+	void UpdateProjectileList(std::vector<std::unique_ptr<T>> &items, CollisionManager *collisionManager) {
 		for (auto &item : items) {
 			if (item) {
 				item->Update();
@@ -17,7 +18,16 @@ namespace {
 		}
 		items.erase(
 			std::remove_if(items.begin(), items.end(),
-						   [](const std::unique_ptr<T> &item) { return !item || !item->IsAlive(); }),
+						   [collisionManager](const std::unique_ptr<T> &item) {
+							   if (item && item->IsAlive()) {
+								   return false;
+							   }
+							   // 解放前に当たり判定の登録を解除
+							   if (item && collisionManager) {
+								   collisionManager->UnregisterObject(item.get());
+							   }
+							   return true;
+						   }),
 			items.end());
 	}
 } // namespace
@@ -29,6 +39,7 @@ void PlayerCombatComponent::Initialize(MagEngine::Object3dSetup *object3dSetup,
 	object3dSetup_ = object3dSetup;
 	trailEffectManager_ = trailEffectManager;
 	enemyManager_ = nullptr;
+	collisionManager_ = nullptr;
 
 	bullets_.clear();
 	missiles_.clear();
@@ -76,6 +87,9 @@ void PlayerCombatComponent::ShootBullet(const Vector3 &position, const Vector3 &
 
 	auto bullet = std::make_unique<PlayerBullet>();
 	bullet->Initialize(object3dSetup_, trailEffectManager_, bulletModelPath_, position, direction);
+	if (collisionManager_) {
+		collisionManager_->RegisterObject(bullet.get());
+	}
 	bullets_.push_back(std::move(bullet));
 	shootCoolTime_ = maxShootCoolTime_;
 }
@@ -90,12 +104,16 @@ void PlayerCombatComponent::ShootMissile(const Vector3 &position, const Vector3
 	auto missile = std::make_unique<PlayerMissile>();
 	missile->Initialize(object3dSetup_, trailEffectManager_, missileModelPath_, position, direction);
 	missile->SetEnemyManager(enemyManager_);
+	missile->SetCollisionManager(collisionManager_);
 
 	if (target) {
 		missile->SetTarget(target);
 		missile->StartLockOn();
 	}
 
+	if (collisionManager_) {
+		collisionManager_->RegisterObject(missile.get());
+	}
 	missiles_.push_back(std::move(missile));
 	missileAmmo_--;				  // 残弾を消費
 	missileRecoveryTimer_ = 0.0f; // 回復タイマーをリセット
@@ -104,11 +122,11 @@ void PlayerCombatComponent::ShootMissile(const Vector3 &position, const Vector3
 //=============================================================================
 // 弾の更新
 void PlayerCombatComponent::UpdateBullets() {
-	UpdateProjectileList(bullets_);
+	UpdateProjectileList(bullets_, collisionManager_);
 }
 
 void PlayerCombatComponent::UpdateMissiles() {
-	UpdateProjectileList(missiles_);
+	UpdateProjectileList(missiles_, collisionManager_);
 }
 
 //=============================================================================
@@ -128,18 +146,6 @@ void PlayerCombatComponent::DrawMissiles() {
 	}
 }
 
-void PlayerCombatComponent::DrawBulletsTrails() {
-	for (auto &bullet : bullets_) {
-		bullet->DrawTrail();
-	}
-}
-
-void PlayerCombatComponent::DrawMissilesTrails() {
-	for (auto &missile : missiles_) {
-		missile->DrawTrail();
-	}
-}
-
 //=============================================================================
 // マルチロックオンで複数敵に同時発射（1体につき1ミサイル）
 void PlayerCombatComponent::ShootMultipleMissiles(const Vector3 &position, const Vector3 &direction,
@@ -166,6 +172,7 @@ void PlayerCombatComponent::ShootMultipleMissiles(const Vector3 &position, const
 		auto missile = std::make_unique<PlayerMissile>();
 		missile->Initialize(object3dSetup_, trailEffectManager_, missileModelPath_, position, direction);
 		missile->SetEnemyManager(enemyManager_);
+		missile->SetCollisionManager(collisionManager_);
 		missile->SetTarget(targets[i]);
 		missile->StartLockOn();
 
@@ -190,6 +197,9 @@ void PlayerCombatComponent::ShootMultipleMissiles(const Vector3 &position, const
 			missile->SetLaunchVelocityOffset(velocityOffset, 0.2f);
 		}
 
+		if (collisionManager_) {
+			collisionManager_->RegisterObject(missile.get());
+		}
 		missiles_.push_back(std::move(missile));
 		++firedMissileCount;
 	}
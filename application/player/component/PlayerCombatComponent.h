@@ -9,6 +9,7 @@
 // 前方宣言
 class Object3dSetup;
 class EnemyManager;
+class CollisionManager;
 class EnemyBase; // Enemy から EnemyBase に変更
 namespace MagEngine {
 	class TrailEffectManager;
@@ -43,8 +44,6 @@ public:
 	///                        描画
 	void DrawBullets();
 	void DrawMissiles();
-	void DrawBulletsTrails();
-	void DrawMissilesTrails();
 
 	///--------------------------------------------------------------
 	///                        ゲッター
@@ -84,6 +83,9 @@ public:
 	void SetEnemyManager(EnemyManager *enemyManager) {
 		enemyManager_ = enemyManager;
 	}
+	void SetCollisionManager(CollisionManager *collisionManager) {
+		collisionManager_ = collisionManager;
+	}
 	void SetMaxShootCoolTime(float coolTime) {
 		maxShootCoolTime_ = coolTime;
 	}
@@ -110,6 +112,7 @@ private:
 	MagEngine::Object3dSetup *object3dSetup_;			// オブジェクト設定（弾生成用）
 	MagEngine::TrailEffectManager *trailEffectManager_; // トレイルエフェクト管理
 	EnemyManager *enemyManager_;						// 敵管理への参照（ミサイルターゲット用）
+	CollisionManager *collisionManager_;				// 当たり判定管理への参照（弾の登録・ミサイルのターゲット検索用）
 
 	std::vector<std::unique_ptr<PlayerBullet>> bullets_;   // 弾のリスト
 	std::vector<std::unique_ptr<PlayerMissile>> missiles_; // ミサイルリスト
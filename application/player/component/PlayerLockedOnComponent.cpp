@@ -9,6 +9,8 @@
 // 以下はstd::maxを使用する場合に必要
 #define NOMINMAX
 #include "PlayerLockedOnComponent.h"
+#include "CollisionGroup.h"
+#include "CollisionManager.h"
 #include "EnemyBase.h"
 #include "EnemyManager.h"
 #include "MagMath.h"
@@ -19,6 +21,7 @@
 // 初期化
 void PlayerLockedOnComponent::Initialize(EnemyManager *enemyManager) {
 	enemyManager_ = enemyManager;
+	collisionManager_ = nullptr;
 	lockOnTargets_.clear();
 	primaryLockOnTarget_ = nullptr;
 	aimingTarget_ = nullptr;
@@ -102,14 +105,30 @@ void PlayerLockedOnComponent::EndLockOn() {
 
 //=============================================================================
 // 範囲内の敵を取得
-std::vector<EnemyBase *> PlayerLockedOnComponent::GetEnemiesInRange(
+const std::vector<EnemyBase *> &PlayerLockedOnComponent::GetEnemiesInRange(
 	const Vector3 &playerPos,
 	const Vector3 &playerForward) {
 
-	std::vector<EnemyBase *> enemiesInRange;
+	enemiesInRange_.clear();
+
+	//========================================
+	// 候補の収集
+	queryResults_.clear();
+	if (collisionManager_) {
+		// 空間クエリで周囲の敵のみを候補にする（全敵の走査を避ける）
+		// NOTE: 空間ハッシュは前回の判定時点の位置のため、移動分の余裕を持たせて取得し、現在位置で判定し直す
+		collisionManager_->QuerySphere(playerPos, lockOnRange_ + CollisionConstants::kQueryPositionMargin,
+									   CollisionGroup::ToMask(CollisionGroup::kEnemy), queryResults_);
+	} else {
+		// CollisionManager未設定時は全敵を候補にする
+		for (const auto &enemy : enemyManager_->GetEnemies()) {
+			queryResults_.push_back(enemy.get());
+		}
+	}
 
-	const auto &enemies = enemyManager_->GetEnemies();
-	for (const auto &enemy : enemies) {
+	for (BaseObject *candidate : queryResults_) {
+		// NOTE: kEnemyグループにはEnemyBaseのみが属する
+		EnemyBase *enemy = static_cast<EnemyBase *>(candidate);
 		if (!enemy || !enemy->IsAlive() || !enemy->IsCollisionEnabled()) {
 			continue;
 		}
@@ -133,20 +152,10 @@ std::vector<EnemyBase *> PlayerLockedOnComponent::GetEnemiesInRange(
 			continue;
 		}
 
-		// 重複チェック
-		bool alreadyInList = false;
-		for (const auto *target : enemiesInRange) {
-			if (target == enemy.get()) {
-				alreadyInList = true;
-				break;
-			}
-		}
-		if (!alreadyInList) {
-			enemiesInRange.push_back(enemy.get());
-		}
+		enemiesInRange_.push_back(enemy);
 	}
 
-	return enemiesInRange;
+	return enemiesInRange_;
 }
 
 //=============================================================================
@@ -194,12 +203,8 @@ EnemyBase *PlayerLockedOnComponent::GetNearestEnemy(
 	EnemyBase *nearestEnemy = nullptr;
 	float bestScore = -1.0f;
 
-	const auto &enemies = enemyManager_->GetEnemies();
-	for (const auto &enemy : enemies) {
-		if (!enemy || !enemy->IsAlive() || !enemy->IsCollisionEnabled()) {
-			continue;
-		}
-
+	// 範囲・視野角の判定は空間クエリで済ませる
+	for (EnemyBase *enemy : GetEnemiesInRange(playerPos, playerForward)) {
 		const Vector3 enemyPos = enemy->GetPosition();
 		const Vector3 toEnemy = {
 			enemyPos.x - playerPos.x,
@@ -208,16 +213,6 @@ EnemyBase *PlayerLockedOnComponent::GetNearestEnemy(
 
 		float distance = std::sqrt(toEnemy.x * toEnemy.x + toEnemy.y * toEnemy.y + toEnemy.z * toEnemy.z);
 
-		// ロックオン範囲外はスキップ
-		if (distance > lockOnRange_) {
-			continue;
-		}
-
-		// 視野角チェック
-		if (!IsEnemyInFOV(playerPos, playerForward, enemyPos)) {
-			continue;
-		}
-
 		// スコア = 前方への角度（高いほど前方）- 距離ペナルティ
 		float normalizedX = toEnemy.x / (distance + 0.001f);
 		float normalizedY = toEnemy.y / (distance + 0.001f);
@@ -231,7 +226,7 @@ EnemyBase *PlayerLockedOnComponent::GetNearestEnemy(
 
 		if (score > bestScore) {
 			bestScore = score;
-			nearestEnemy = enemy.get();
+			nearestEnemy = enemy;
 		}
 	}
 
@@ -246,13 +241,8 @@ EnemyBase *PlayerLockedOnComponent::FindBestTargetInReticle(
 	EnemyBase *bestTarget = nullptr;
 	float bestScore = -10000.0f;
 
-	const auto &enemies = enemyManager_->GetEnemies();
-	for (const auto &enemy : enemies) {
-		if (!enemy || !enemy->IsAlive() || !enemy->IsCollisionEnabled()) {
-			continue;
-		}
-
-		EnemyBase *candidate = enemy.get();
+	// 範囲・視野角の判定は空間クエリで済ませる
+	for (EnemyBase *candidate : GetEnemiesInRange(playerPos, playerForward)) {
 		if (IsAlreadyLocked(candidate)) {
 			continue;
 		}
@@ -264,11 +254,7 @@ EnemyBase *PlayerLockedOnComponent::FindBestTargetInReticle(
 			enemyPos.z - playerPos.z};
 
 		const float distance = std::sqrt(toEnemy.x * toEnemy.x + toEnemy.y * toEnemy.y + toEnemy.z * toEnemy.z);
-		if (distance > lockOnRange_ || distance < 0.001f) {
-			continue;
-		}
-
-		if (!IsEnemyInFOV(playerPos, playerForward, enemyPos)) {
+		if (distance < 0.001f) {
 			continue;
 		}
 
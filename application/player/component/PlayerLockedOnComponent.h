@@ -18,6 +18,8 @@ using namespace MagMath;
 // 前方宣言
 class EnemyBase;
 class EnemyManager;
+class CollisionManager;
+class BaseObject;
 
 ///=============================================================================
 ///                    プレイヤーロックオン管理コンポーネント
@@ -118,11 +120,17 @@ public:
 		enemyManager_ = enemyManager;
 	}
 
+	/// @brief 当たり判定マネージャーを設定（候補の空間クエリ用）
+	void SetCollisionManager(CollisionManager *collisionManager) {
+		collisionManager_ = collisionManager;
+	}
+
 private:
 	///--------------------------------------------------------------
 	///                        内部処理
 	/// @brief 範囲内の敵を取得
-	std::vector<EnemyBase *> GetEnemiesInRange(const Vector3 &playerPos, const Vector3 &playerForward);
+	/// @note 結果はメンバの配列を再利用するため、次の呼び出しまで有効
+	const std::vector<EnemyBase *> &GetEnemiesInRange(const Vector3 &playerPos, const Vector3 &playerForward);
 
 	/// @brief 視野角チェック（敵が視野内か判定）
 	bool IsEnemyInFOV(const Vector3 &playerPos, const Vector3 &playerForward, const Vector3 &enemyPos);
@@ -139,6 +147,9 @@ private:
 	///--------------------------------------------------------------
 	///                        メンバ変数
 	EnemyManager *enemyManager_;			 // 敵管理マネージャーへの参照
+	CollisionManager *collisionManager_;	 // 当たり判定マネージャーへの参照（空間クエリ用）
+	std::vector<BaseObject *> queryResults_; // 候補（空間クエリの結果を再利用）
+	std::vector<EnemyBase *> enemiesInRange_; // 範囲内の敵（再利用）
 	std::vector<EnemyBase *> lockOnTargets_; // ロックオン対象敵のリスト
 	EnemyBase *primaryLockOnTarget_;		 // メインのロックオン対象
 
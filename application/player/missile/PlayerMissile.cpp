@@ -10,12 +10,13 @@
 // 以下はstd::maxを使用する場合に必要
 #define NOMINMAX
 #include "PlayerMissile.h"
+#include "CollisionGroup.h"
+#include "CollisionManager.h"
 #include "EnemyManager.h"
 #include "ImguiSetup.h"
 #include "LineManager.h"
 #include "ModelManager.h"
 #include "Object3d.h"
-#include "TrailEffectManager.h"
 #include <algorithm>
 #include <cmath>
 using namespace MagEngine;
@@ -40,6 +41,14 @@ namespace {
 	}
 }
 
+//=============================================================================
+// デストラクタ
+PlayerMissile::~PlayerMissile() {
+	if (trailEffectManager_) {
+		trailEffectManager_->ReleaseTrail(trailHandle_);
+	}
+}
+
 //=============================================================================
 // 初期化
 void PlayerMissile::Initialize(
@@ -80,6 +89,7 @@ void PlayerMissile::Initialize(
 	isLockedOn_ = false;
 	lockOnTime_ = 0.0f;
 	enemyManager_ = nullptr;
+	collisionManager_ = nullptr;
 
 	//========================================
 	// 回転関連初期化
@@ -115,7 +125,9 @@ void PlayerMissile::Initialize(
 			objTransform->scale = {1.0f, 1.0f, 1.0f};
 
 			Vector3 pos = position;
-			BaseObject::Initialize(pos, 1.0f);
+			BaseObject::Initialize(pos, 1.0f, CollisionType::DYNAMIC, CollisionGroup::kPlayerBullet);
+			// 1フレームの移動量が半径より大きいため、移動判定ですり抜けを防ぐ
+			SetSweptCollisionEnabled(true);
 		}
 	}
 
@@ -132,10 +144,9 @@ void PlayerMissile::Initialize(
 
 	//========================================
 	// トレイルエフェクトの初期化
-	if (trailEffectManager) {
-		trailEffect_ = std::make_unique<TrailEffect>();
-		TrailEffectPreset missilePreset = *trailEffectManager->GetPreset("Missile");
-		trailEffect_->Initialize(trailEffectManager->GetSetup(), missilePreset);
+	trailEffectManager_ = trailEffectManager;
+	if (trailEffectManager_) {
+		trailHandle_ = trailEffectManager_->AcquireTrail("Missile");
 	}
 }
 
@@ -179,12 +190,11 @@ void PlayerMissile::Update() {
 		BaseObject::Update(objTransform->translate);
 		obj_->Update();
 
-		// トレイルエフェクトの更新
-		if (trailEffect_) {
-			const float frameTime = 1.0f / 60.0f;
-			trailEffect_->Update(frameTime);
-			// 現在位置で軌跡を発生させる
-			trailEffect_->EmitAt(objTransform->translate, velocity_);
+		// トレイルエフェクトの更新（現在位置で軌跡を発生させる）
+		if (trailEffectManager_) {
+			if (TrailEffect *trail = trailEffectManager_->GetTrail(trailHandle_)) {
+				trail->EmitAt(objTransform->translate, velocity_);
+			}
 		}
 	}
 }
@@ -368,12 +378,26 @@ EnemyBase *PlayerMissile::FindNearestTarget() { // Enemy* から EnemyBase* に
 	EnemyBase *nearestEnemy = nullptr; // Enemy* から EnemyBase* に変更
 	float bestScore = -1.0f;
 
-	// EnemyManagerから敵リストを取得
-	const auto &enemies = enemyManager_->GetEnemies();
-
 	float fovRadians = lockOnFOV_ * 0.5f * MagMath::PI / 180.0f; // 視野角をラジアンに
 
-	for (const auto &enemy : enemies) {
+	//========================================
+	// 候補の収集（空間クエリで周囲の敵のみ）
+	// NOTE: 空間ハッシュは前回の判定時点の位置のため、移動分の余裕を持たせて取得し、
+	//       距離と視野角は以下で現在位置から判定し直す
+	targetCandidates_.clear();
+	if (collisionManager_) {
+		collisionManager_->QuerySphere(missilePos, lockOnRange_ + CollisionConstants::kQueryPositionMargin,
+									   CollisionGroup::ToMask(CollisionGroup::kEnemy), targetCandidates_);
+	} else {
+		// CollisionManager未設定時は全敵を候補にする
+		for (const auto &enemy : enemyManager_->GetEnemies()) {
+			targetCandidates_.push_back(enemy.get());
+		}
+	}
+
+	for (BaseObject *candidate : targetCandidates_) {
+		// NOTE: kEnemyグループにはEnemyBaseのみが属する
+		EnemyBase *enemy = static_cast<EnemyBase *>(candidate);
 		if (!enemy || !enemy->IsAlive() || !enemy->IsCollisionEnabled()) {
 			continue;
 		}
@@ -406,7 +430,7 @@ EnemyBase *PlayerMissile::FindNearestTarget() { // Enemy* から EnemyBase* に
 
 		if (score > bestScore) {
 			bestScore = score;
-			nearestEnemy = enemy.get();
+			nearestEnemy = enemy;
 		}
 	}
 
@@ -426,17 +450,12 @@ void PlayerMissile::Draw() {
 	}
 }
 
-void PlayerMissile::DrawTrail() {
-	if (trailEffect_) {
-		trailEffect_->Draw();
-	}
-}
-
 void PlayerMissile::DrawDebugInfo() {
 #ifdef _DEBUG
 	if (!showDebugInfo_ || !obj_)
 		return;
 
+	LineManager::CallerScope lineCaller("PlayerMissile");
 	LineManager *lineManager = LineManager::GetInstance();
 	Vector3 missilePos = obj_->GetPosition();
 
@@ -11,7 +11,7 @@
 using namespace MagMath;
 #include "BaseObject.h"
 #include "Object3d.h"
-#include "TrailEffect.h"
+#include "TrailEffectManager.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,9 +20,7 @@ using namespace MagMath;
 class Object3dSetup;
 class EnemyBase;
 class EnemyManager; // 前方宣言を追加
-namespace MagEngine {
-	class TrailEffectManager;
-}
+class CollisionManager;
 
 ///=============================================================================
 ///                        プレイヤーミサイルクラス
@@ -30,6 +28,8 @@ class PlayerMissile : public BaseObject {
 public:
 	//========================================
 	// 初期化・更新・描画
+	/// @brief デストラクタ（トレイルをプールに返す）
+	~PlayerMissile() override;
 	/// @brief Initialize 初期化
 	/// @param object3dSetup オブジェクト設定
 	/// @param trailEffectManager トレイルエフェクト管理
@@ -46,8 +46,6 @@ public:
 	void Update();
 	/// @brief Draw 描画
 	void Draw();
-	/// @brief DrawTrail トレイル描画
-	void DrawTrail();
 	/// @brief DrawDebugInfo デバッグ情報描画
 	void DrawDebugInfo();
 	/// @brief DrawImGui ImGui描画
@@ -88,6 +86,10 @@ public:
 	void SetEnemyManager(EnemyManager *enemyManager) { // 引数を追加
 		enemyManager_ = enemyManager;
 	}
+	/// @brief SetCollisionManager CollisionManager設定（ターゲット検索の空間クエリ用）
+	void SetCollisionManager(CollisionManager *collisionManager) {
+		collisionManager_ = collisionManager;
+	}
 
 	//========================================
 	// ロックオン機能
@@ -154,7 +156,8 @@ private:
 
 	//========================================
 	// トレイルエフェクト
-	std::unique_ptr<MagEngine::TrailEffect> trailEffect_; // トレイルエフェクト
+	MagEngine::TrailEffectManager *trailEffectManager_ = nullptr; // トレイルエフェクト管理（描画・フェードを行う）
+	MagEngine::TrailHandle trailHandle_;						  // プールから借りたトレイル
 
 	//========================================
 	// 物理関連
@@ -176,6 +179,8 @@ private:
 	bool isLockedOn_;
 	float lockOnTime_;
 	EnemyManager *enemyManager_; // EnemyManager参照
+	CollisionManager *collisionManager_;		// CollisionManager参照（空間クエリ用）
+	std::vector<BaseObject *> targetCandidates_; // ターゲット候補（空間クエリの結果を再利用）
 	float desiredHitTime_;		 // 目標着弾時間（着弾タイミング分散用）
 
 	//========================================
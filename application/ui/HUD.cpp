@@ -364,6 +364,7 @@ void HUD::Update(const Player *player) {
 ///=============================================================================
 ///                        描画
 void HUD::Draw() {
+	LineManager::CallerScope lineCaller("HUD");
 	MagEngine::Camera *currentCamera = nullptr;
 
 	if (followCamera_) {
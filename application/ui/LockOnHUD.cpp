@@ -57,6 +57,7 @@ void LockOnHUD::Draw() {
 	if (!isVisible_ || !player_ || !enemyManager_ || !lineManager_) {
 		return;
 	}
+	LineManager::CallerScope lineCaller("LockOnHUD");
 
 	// カメラを取得
 	MagEngine::Camera *camera = CameraManager::GetInstance()->GetCamera("FollowCamera");
@@ -0,0 +1,49 @@
+/*********************************************************************
+ * \file   BenchmarkMain.cpp
+ * \brief  ベンチマークのエントリーポイント
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   ウィンドウ・D3D12デバイス・ImGuiを使わずに計測し、結果を標準出力へ書き出す
+ *         引数なしで全て、"collision" / "particle" で指定したものだけを計測する
+ *********************************************************************/
+#include "CollisionBenchmark.h"
+#include "JobSystem.h"
+#include "ParticleBenchmark.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace MagEngine;
+
+///=============================================================================
+///						当たり判定
+static void RunCollision() {
+	std::printf("CollisionBenchmark\n");
+	for (const CollisionBenchmark::Result &r : CollisionBenchmark::RunStandardSuite()) {
+		std::printf("  objects=%zu threads=%u pairs=%zu hits=%zu build=%.3fms detect=%.3fms\n",
+					r.objectCount, r.threadCount, r.candidatePairs, r.hitPairs, r.buildMs, r.detectMs);
+	}
+}
+
+///=============================================================================
+///						パーティクル
+static void RunParticle() {
+	std::printf("ParticleBenchmark\n");
+	for (const ParticleBenchmark::Result &r : ParticleBenchmark::RunStandardSuite()) {
+		std::printf("  particles=%zu list=%.3fms pool=%.3fms parallel(x%u)=%.3fms\n",
+					r.particleCount, r.listMs, r.poolMs, r.threadCount, r.parallelMs);
+	}
+}
+
+int main(int argc, char **argv) {
+	const char *target = argc > 1 ? argv[1] : nullptr;
+	std::printf("threads: %u\n", JobSystem::GetInstance()->GetThreadCount());
+	if (!target || std::strcmp(target, "collision") == 0) {
+		RunCollision();
+	}
+	if (!target || std::strcmp(target, "particle") == 0) {
+		RunParticle();
+	}
+	JobSystem::GetInstance()->Finalize();
+	return 0;
+}
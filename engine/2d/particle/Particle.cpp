@@ -1,9 +1,14 @@
+#define NOMINMAX
 #include "Particle.h"
 #include "Camera.h"
+#include "CullingManager.h"
+#include "ImguiSetup.h"
+#include "JobSystem.h"
 #include "TextureManager.h"
 //---------------------------------------
 // 数学関数　
 #include "MagMath.h"
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 ///=============================================================================
@@ -15,8 +20,8 @@ namespace MagEngine {
 		//========================================
 		// 引数からSetupを受け取る
 		this->particleSetup_ = particleSetup;
-		// RandomEngineの初期化
-		randomEngine_.seed(std::random_device()( ));
+		// 乱数ストリームの作成
+		random_ = Random::CreateStream("Particle");
 		//========================================
 		// 頂点データの作成
 		CreateVertexData();
@@ -39,7 +44,7 @@ namespace MagEngine {
 		MagMath::Matrix4x4 cameraMatrix = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f },
 			camera->GetRotate(), camera->GetTranslate());
 // ビュー行列の取得
-		MagMath::Matrix4x4 viewMatrix = Inverse4x4(cameraMatrix);
+		MagMath::Matrix4x4 viewMatrix = InverseAffine4x4(cameraMatrix);
 		// プロジェクション行列の取得
 		MagMath::Matrix4x4 projectionMatrix = MagMath::MakePerspectiveFovMatrix(0.45f,
 			float(particleSetup_->GetDXManager()->GetWinApp().kWindowWidth_) / float(particleSetup_->GetDXManager()->GetWinApp().kWindowHeight_),
@@ -49,88 +54,121 @@ namespace MagEngine {
 
 		//========================================
 		// ビルボード行列の取得
+		// NOTE: ビルボードの有無はグループごとに異なるため、両方の行列を用意する
 		MagMath::Matrix4x4 backToFrontMatrix = MagMath::MakeRotateYMatrix(std::numbers::pi_v<float>);
-		MagMath::Matrix4x4 billboardMatrix{};
-		if(isUsedBillboard) {
-			billboardMatrix = Multiply4x4(backToFrontMatrix, cameraMatrix);
-			// 平行移動成分は無視
-			billboardMatrix.m[3][0] = 0.0f;
-			billboardMatrix.m[3][1] = 0.0f;
-			billboardMatrix.m[3][2] = 0.0f;
-		} else {
-			billboardMatrix = MagMath::Identity4x4();
-		}
+		MagMath::Matrix4x4 billboardMatrix = Multiply4x4(backToFrontMatrix, cameraMatrix);
+		// 平行移動成分は無視
+		billboardMatrix.m[3][0] = 0.0f;
+		billboardMatrix.m[3][1] = 0.0f;
+		billboardMatrix.m[3][2] = 0.0f;
 
 		// スケール調整用の倍率を設定
 		// constexpr float scaleMultiplier = 0.01f; // 必要に応じて調整
 
 		//========================================
-		// パーティクルの更新
+		// 更新パラメータ（ビルボードあり / なし）
+		ParticleUpdateParams billboardParams;
+		billboardParams.billboardMatrix = billboardMatrix;
+		billboardParams.viewProjectionMatrix = viewProjectionMatrix;
+		billboardParams.deltaTime = kDeltaTime;
+		ParticleUpdateParams flatParams = billboardParams;
+		flatParams.billboardMatrix = MagMath::Identity4x4();
+
+		//========================================
+		// カリングの視錐台（描画と同じビュープロジェクション行列から求める）
+		CullingManager *cullingManager = CullingManager::GetInstance();
+		const Frustum frustum = Frustum::FromViewProjection(viewProjectionMatrix);
+		const bool isCullingEnabled = cullingManager->IsEnabled();
+
+		//========================================
+		// キューに積まれた生成要求をまとめて処理
+		FlushEmitQueue();
+
+		//========================================
+		// 寿命の尽きたパーティクルを削除し、更新ジョブを作成
+		// NOTE: 削除後は生存パーティクルが先頭から詰まっているため、チャンクはインデックスで分割できる
+		DirectXCore *dxCore = particleSetup_->GetDXManager();
+		updateJobs_.clear();
+		uint32_t totalParticles = 0;
 		for(auto &group : particleGroups) {
-			// テクスチャサイズの取得
-			MagMath::Vector2 textureSize = group.second.textureSize;
-			// インスタンス数の初期化
-			for(auto it = group.second.particleList.begin(); it != group.second.particleList.end();) {
-				// パーティクルの参照
-				ParticleStr &particle = *it;
-				// パーティクルの寿命が尽きた場合は削除
-				if(particle.lifeTime <= particle.currentTime) {
-					it = group.second.particleList.erase(it);
-					continue;
-				}
+			ParticlePool &pool = group.second.pool;
+			pool.RemoveExpired();
+			group.second.instanceCount = std::min(pool.GetSize(), static_cast<uint32_t>( kNumMaxInstance ));
+			group.second.visibleCount = 0;
+			group.second.instancingDataPtr = nullptr;
+			group.second.instancingAddress = 0;
+			totalParticles += pool.GetSize();
+
+			const ParticleUpdateParams *params = group.second.useBillboard ? &billboardParams : &flatParams;
+			const ParticleCullParams cull = { &frustum, camera->GetTranslate(), cullingManager->GetMaxDistance(CullingCategory::Particle), shapeRadius_ };
+			for(uint32_t begin = 0; begin < pool.GetSize(); begin += kParticleUpdateChunkSize) {
+				updateJobs_.push_back({ &group.second, params, cull, begin, begin + kParticleUpdateChunkSize, CullResult{}, 0 });
+			}
+		}
+		const uint32_t jobCount = static_cast<uint32_t>( updateJobs_.size() );
+		const bool isParallel = totalParticles >= kParallelUpdateThreshold;
+
+		//========================================
+		// 積分とカリング（グループ・チャンク単位で並列実行）
+		auto integrateJobs = [&](uint32_t begin, uint32_t end, uint32_t) {
+			for(uint32_t i = begin; i < end; ++i) {
+				UpdateJob &job = updateJobs_[i];
+				job.result = job.group->pool.IntegrateRange(*job.params, job.begin, job.end, job.group->instanceCount,
+															isCullingEnabled ? &job.cull : nullptr);
+			}
+		};
+		if(isParallel) {
+			JobSystem::GetInstance()->ParallelFor(jobCount, 1, integrateJobs);
+		} else {
+			integrateJobs(0, jobCount, 0);
+		}
+
+		//========================================
+		// チャンクごとの書き込み位置を決め、描画する分だけアップロードリングから確保
+		// NOTE: チャンクの描画数を前から足し合わせた位置に書き込むことで、グループの描画分を連続させる
+		for(UpdateJob &job : updateJobs_) {
+			job.writeOffset = job.group->visibleCount;
+			job.group->visibleCount += job.result.visibleCount;
+		}
+		for(auto &group : particleGroups) {
+			if(group.second.visibleCount == 0) {
+				continue;
+			}
+			// 確保できない場合はこのフレームの描画だけを省く
+			UploadAllocation allocation = dxCore->AllocateUpload(sizeof(ParticleForGPU) * group.second.visibleCount);
+			if(!allocation.cpuAddress) {
+				group.second.visibleCount = 0;
+				continue;
+			}
+			group.second.instancingDataPtr = static_cast<ParticleForGPU *>( allocation.cpuAddress );
+			group.second.instancingAddress = allocation.gpuAddress;
+			group.second.instancingFrame = dxCore->GetUploadFrameSerial();
+		}
 
-				// 経過時間に対する割合
-				float timeRatio = particle.currentTime / particle.lifeTime;
-
-				// スケールの線形補間
-				particle.transform.scale.x = std::lerp(particle.initialScale.x, particle.endScale.x, timeRatio);
-				particle.transform.scale.y = std::lerp(particle.initialScale.y, particle.endScale.y, timeRatio);
-				particle.transform.scale.z = std::lerp(particle.initialScale.z, particle.endScale.z, timeRatio);
-
-				// 回転の線形補間
-				particle.transform.rotate.x = std::lerp(particle.initialRotation.x, particle.endRotation.x, timeRatio);
-				particle.transform.rotate.y = std::lerp(particle.initialRotation.y, particle.endRotation.y, timeRatio);
-				particle.transform.rotate.z = std::lerp(particle.initialRotation.z, particle.endRotation.z, timeRatio);
-
-				// 重力の適用
-				particle.velocity = AddVec3(particle.velocity, MultiplyVec3(kDeltaTime, gravity_));
-
-				// 位置の更新
-				particle.transform.translate = AddVec3(particle.transform.translate, MultiplyVec3(kDeltaTime, particle.velocity));
-				// 経過時間を更新
-				particle.currentTime += kDeltaTime;
-				// ワールド行列の計算a
-				MagMath::Matrix4x4 worldMatrix = Multiply4x4(
-					billboardMatrix,
-					MakeAffineMatrix(particle.transform.scale, particle.transform.rotate, particle.transform.translate));
-				// ビュー・プロジェクションを掛け合わせて最終行列を計算
-				MagMath::Matrix4x4 worldviewProjectionMatrix = Multiply4x4(worldMatrix, viewProjectionMatrix);
-				//---------------------------------------
-				// インスタンシングデータの設定
-				if(group.second.instanceCount < kNumMaxInstance) {
-					group.second.instancingDataPtr[group.second.instanceCount].WVP = worldviewProjectionMatrix;
-					group.second.instancingDataPtr[group.second.instanceCount].World = worldMatrix;
-					// カラーを設定し、フェードイン・アウトを適用
-					group.second.instancingDataPtr[group.second.instanceCount].color = particle.color;
-
-					// フェードイン・アウトの計算
-					float alpha = 1.0f;
-					if(timeRatio < fadeInRatio_) {
-						// フェードイン
-						alpha = timeRatio / fadeInRatio_;
-					} else if(timeRatio > fadeOutRatio_) {
-						// フェードアウト
-						alpha = 1.0f - ( ( timeRatio - fadeOutRatio_ ) / ( 1.0f - fadeOutRatio_ ) );
-					}
-					alpha = std::clamp(alpha, 0.0f, 1.0f);
-
-					group.second.instancingDataPtr[group.second.instanceCount].color.w = particle.color.w * alpha;
-					// インスタンス数を増やす
-					++group.second.instanceCount;
+		//========================================
+		// インスタンシングデータの書き込み（グループ・チャンク単位で並列実行）
+		// COMMENT: 各チャンクはアップロードリング上の書き込み位置へ直接書き込む
+		auto writeJobs = [&](uint32_t begin, uint32_t end, uint32_t) {
+			for(uint32_t i = begin; i < end; ++i) {
+				UpdateJob &job = updateJobs_[i];
+				if(!job.group->instancingDataPtr || job.result.visibleCount == 0) {
+					continue;
 				}
-				// 次のパーティクルへ
-				++it;
+				job.group->pool.WriteRange(*job.params, job.begin, job.end, job.group->instanceCount, job.group->instancingDataPtr + job.writeOffset);
 			}
+		};
+		if(isParallel) {
+			JobSystem::GetInstance()->ParallelFor(jobCount, 1, writeJobs);
+		} else {
+			writeJobs(0, jobCount, 0);
+		}
+
+		//========================================
+		// カリングの集計（ジョブの結果をメインスレッドでまとめる）
+		for(const UpdateJob &job : updateJobs_) {
+			const CullResult &result = job.result;
+			cullingManager->RecordResult(CullingCategory::Particle,
+										 result.visibleCount + result.frustumCulledCount + result.distanceCulledCount, result);
 		}
 	}
 
@@ -147,25 +185,61 @@ namespace MagEngine {
 		commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
 
 		// 全てのパーティクルグループを処理
+		const uint64_t uploadFrame = particleSetup_->GetDXManager()->GetUploadFrameSerial();
 		for(auto &groupPair : particleGroups) {
 			ParticleGroup &group = groupPair.second; // グループへの参照を取得
-			if(group.instanceCount == 0)
-				continue; // インスタンスが無い場合はスキップ
+			if(group.visibleCount == 0)
+				continue; // 描画するインスタンスが無い場合はスキップ
+			if(group.instancingFrame != uploadFrame)
+				continue; // このフレームに更新されていない（確保した領域は再利用済み）
 
 			// マテリアルCBufferの場所を設定
 			commandList->SetGraphicsRootConstantBufferView(0, materialBuffer_->GetGPUVirtualAddress());
 
 			// テクスチャのSRVのDescriptorTableを設定
-			commandList->SetGraphicsRootDescriptorTable(2, particleSetup_->GetSrvSetup()->GetSRVGPUDescriptorHandle(group.srvIndex));
+			commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(group.textureHandle));
 
-			// インスタンシングデータのSRVのDescriptorTableを設定
-			commandList->SetGraphicsRootDescriptorTable(1, particleSetup_->GetSrvSetup()->GetSRVGPUDescriptorHandle(group.instancingSrvIndex));
+			// インスタンシングデータのSRVを設定（アップロードリング上に詰めた描画分の先頭）
+			commandList->SetGraphicsRootShaderResourceView(1, group.instancingAddress);
 
 			// Draw Call (インスタンシング描画) - グループごとの頂点数とオフセットを使用
-			commandList->DrawInstanced(group.vertexCount, group.instanceCount, group.vertexOffset, 0);
+			commandList->DrawInstanced(group.vertexCount, group.visibleCount, group.vertexOffset, 0);
 
 			// インスタンスカウントをリセット
 			group.instanceCount = 0;
+			group.visibleCount = 0;
+		}
+	}
+
+	///=============================================================================
+	///						ImGui描画
+	void Particle::DrawImGui() {
+		//========================================
+		// グループごとのパーティクル数
+		for(const auto &group : particleGroups) {
+			ImGui::Text("%s: %u / %u", group.first.c_str(), group.second.pool.GetSize(), group.second.pool.GetCapacity());
+		}
+
+		//========================================
+		// アップロードリングの使用量（現フレーム / 最大）
+		const FrameUploadAllocator &upload = particleSetup_->GetDXManager()->GetUploadAllocator();
+		ImGui::Text("Upload ring: %zu KB / peak %zu KB / %zu KB", upload.GetUsedBytes() / 1024, upload.GetPeakBytes() / 1024, upload.GetRegionSize() / 1024);
+
+		//========================================
+		// ベンチマーク
+		if(ImGui::CollapsingHeader("Benchmark")) {
+			ImGui::Text("Kernel: %s", ParticleKernel::GetInstructionSetName());
+			if(ImGui::Button("Run 2k/20k/200k")) {
+				benchmarkAccuracy_ = ParticleBenchmark::VerifyKernel();
+				benchmarkResults_ = ParticleBenchmark::RunStandardSuite();
+			}
+			if(benchmarkAccuracy_.comparedInstances > 0) {
+				ImGui::Text("Accuracy: compared=%u expired=%u maxError=%g (%s)", benchmarkAccuracy_.comparedInstances, benchmarkAccuracy_.expiredInstances,
+							benchmarkAccuracy_.maxError, benchmarkAccuracy_.passed ? "pass" : "FAIL");
+			}
+			for(const auto &result : benchmarkResults_) {
+				ImGui::Text("%7zu particles: list=%.3fms pool=%.3fms parallel(x%u)=%.3fms", result.particleCount, result.listMs, result.poolMs, result.threadCount, result.parallelMs);
+			}
 		}
 	}
 
@@ -180,15 +254,85 @@ namespace MagEngine {
 		// 指定されたパーティクルグループが存在する場合、そのグループにパーティクルを追加
 		ParticleGroup &group = particleGroups[name];
 
-		// すでにkNumMaxInstanceに達している場合、新しいパーティクルの追加をスキップする
-		if(group.particleList.size() >= count) {
+		// 設定値が変更されていれば生成設定を作り直す
+		if(isEmitRangesDirty_) {
+			emitRanges_ = ParticleSpawnRanges::FromConfig(MakeConfigFromSettings());
+			isEmitRangesDirty_ = false;
+		}
+
+		// 現在の設定で指定された数のパーティクルを生成して追加（プールが満杯になった分は生成しない）
+		group.pool.Spawn(emitRanges_, position, count, random_);
+	}
+
+	///=============================================================================
+	///						生成設定の登録
+	uint32_t Particle::RegisterConfig(const std::string &groupName, const std::string &configName, const ParticleConfig &config) {
+		// 登録済みの設定はそのIDを返す
+		auto found = configIds_.find(configName);
+		if(found != configIds_.end()) {
+			return found->second;
+		}
+
+		auto groupIt = particleGroups.find(groupName);
+		if(groupIt == particleGroups.end()) {
+			assert(false && "Specified particle group does not exist!");
+			return kInvalidConfigId;
+		}
+
+		// ビルボードの有無はグループ単位で描画に反映するため、作成時の設定と一致している必要がある
+		assert(config.billboard == groupIt->second.useBillboard && "Config billboard setting does not match the particle group!");
+
+		uint32_t configId = static_cast<uint32_t>( configs_.size() );
+		configs_.push_back({ &groupIt->second, ParticleSpawnRanges::FromConfig(config) });
+		configIds_.emplace(configName, configId);
+		return configId;
+	}
+
+	///=============================================================================
+	///						生成要求をキューに追加
+	void Particle::EnqueueEmit(uint32_t configId, const MagMath::Vector3 &position, uint32_t count) {
+		if(configId >= configs_.size() || count == 0) {
 			return;
 		}
+		emitQueue_.push_back({ configId, position, count });
+	}
 
-		// 指定された数のパーティクルを生成して追加
-		for(uint32_t i = 0; i < count; ++i) {
-			group.particleList.push_back(CreateNewParticle(randomEngine_, position));
+	///=============================================================================
+	///						生成要求をまとめて処理
+	void Particle::FlushEmitQueue() {
+		for(const EmitCommand &command : emitQueue_) {
+			const RegisteredConfig &config = configs_[command.configId];
+			config.group->pool.Spawn(config.ranges, command.position, command.count, random_);
 		}
+		// COMMENT: clear は容量を保持するため、次フレーム以降の追加で再確保しない
+		emitQueue_.clear();
+	}
+
+	///=============================================================================
+	///						現在の設定値から生成設定を作成
+	ParticleConfig Particle::MakeConfigFromSettings() const {
+		ParticleConfig config;
+		config.translateMin = translateMin_;
+		config.translateMax = translateMax_;
+		config.velocityMin = velocityMin_;
+		config.velocityMax = velocityMax_;
+		config.initialScaleMin = initialScaleMin_;
+		config.initialScaleMax = initialScaleMax_;
+		config.endScaleMin = endScaleMin_;
+		config.endScaleMax = endScaleMax_;
+		config.initialRotationMin = initialRotationMin_;
+		config.initialRotationMax = initialRotationMax_;
+		config.endRotationMin = endRotationMin_;
+		config.endRotationMax = endRotationMax_;
+		config.colorMin = colorMin_;
+		config.colorMax = colorMax_;
+		config.lifetimeMin = lifetimeRange_.min;
+		config.lifetimeMax = lifetimeRange_.max;
+		config.gravity = gravity_;
+		config.fadeInRatio = fadeInRatio_;
+		config.fadeOutRatio = fadeOutRatio_;
+		config.billboard = isUsedBillboard;
+		return config;
 	}
 
 	///=============================================================================
@@ -210,6 +354,8 @@ namespace MagEngine {
 		ParticleGroup newGroup;
 		newGroup.materialFilePath = textureFilePath;
 		newGroup.shape = shape;
+		// ビルボードの有無はグループ作成時に固定する
+		newGroup.useBillboard = isUsedBillboard;
 
 		// 形状に応じた頂点オフセットとカウントを設定
 		const uint32_t kBoardVertexCount = 6;
@@ -231,14 +377,14 @@ namespace MagEngine {
 			// assert(false && "Cylinder shape not yet fully implemented for vertex data."); // 実装したのでコメントアウト解除または削除
 		}
 
-		// テクスチャのSRVインデックスを取得して設定
-		TextureManager::GetInstance()->LoadTexture(textureFilePath);
+		// テクスチャの読み込み
+		TextureHandle textureHandle = TextureManager::GetInstance()->LoadTexture(textureFilePath);
 
-		// テクスチャのSRVインデックスを取得して設定
-		newGroup.srvIndex = TextureManager::GetInstance()->GetTextureIndex(textureFilePath);
+		// テクスチャのハンドルを設定
+		newGroup.textureHandle = textureHandle;
 
 		// テクスチャサイズを取得
-		const DirectX::TexMetadata &metadata = TextureManager::GetInstance()->GetMetadata(textureFilePath);
+		const DirectX::TexMetadata &metadata = TextureManager::GetInstance()->GetMetadata(textureHandle);
 		MagMath::Vector2 textureSize = { static_cast<float>( metadata.width ), static_cast<float>( metadata.height ) };
 		// カスタムサイズが指定されているかどうか
 		// newGroup.textureSize = textureSize;
@@ -253,31 +399,13 @@ namespace MagEngine {
 		//// テクスチャサイズを設定
 		// AdjustTextureSize(newGroup, textureFilePath);
 
-		// インスタンシング用リソースの生成
-		// newGroup.instancingResource =
-		//	dxCommon_->CreateBufferResource(sizeof(ParticleForGPU) * kNumMaxInstance);
-		newGroup.instancingResource =
-			particleSetup_->GetDXManager()->CreateBufferResource(sizeof(ParticleForGPU) * kNumMaxInstance);
-
-		newGroup.instancingResource->Map(0, nullptr, reinterpret_cast<void **>( &newGroup.instancingDataPtr ));
-		for(uint32_t index = 0; index < kNumMaxInstance; ++index) {
-			newGroup.instancingDataPtr[index].WVP = MagMath::Identity4x4();
-			newGroup.instancingDataPtr[index].World = MagMath::Identity4x4();
-			// newGroup.instancingDataPtr[index].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-		}
-
-		// 最大インスタンシング用リソースの生成
-		// InstancingMaxResource();
-
-		// インスタンシング用SRVを確保してSRVインデックスを記録
-		// newGroup.instancingSrvIndex =　srvManager_->Allocate() + 1;
-		newGroup.instancingSrvIndex = particleSetup_->GetSrvSetup()->Allocate() + 1;
-		// 作成したSRVをインスタンシング用リソースに設定
-		// srvManager_->CreateSRVforStructuredBuffer(newGroup.instancingSrvIndex, newGroup.instancingResource.Get(), kNumMaxInstance, sizeof(ParticleForGPU));
-		particleSetup_->GetSrvSetup()->CreateSRVStructuredBuffer(newGroup.instancingSrvIndex, newGroup.instancingResource.Get(), kNumMaxInstance, sizeof(ParticleForGPU));
+		// NOTE: インスタンシングデータは Update で毎フレームアップロードリングから確保するため、
+		//       グループ専用のリソースとSRVは作成しない
 
 		// パーティクルグループをリストに追加
-		particleGroups.emplace(name, newGroup);
+		// NOTE: プールはコピーを避けるため、登録後に容量分を確保する
+		ParticleGroup &group = particleGroups.emplace(name, newGroup).first->second;
+		group.pool.Initialize(kNumMaxInstance);
 
 		// マテリアルデータの初期化
 		CreateMaterialData();
@@ -418,6 +546,13 @@ namespace MagEngine {
 				modelData_.vertices.push_back({ bottomP1, {uSide1, 1.0f}, sideNormalP1 });
 			}
 		}
+
+		// カリング用の形状の半径（全形状で最も遠い頂点までの距離）
+		shapeRadius_ = 0.0f;
+		for(const MagMath::VertexData &vertex : modelData_.vertices) {
+			const float length = std::sqrt(vertex.position.x * vertex.position.x + vertex.position.y * vertex.position.y + vertex.position.z * vertex.position.z);
+			shapeRadius_ = std::max(shapeRadius_, length);
+		}
 	}
 
 	///--------------------------------------------------------------
@@ -450,134 +585,4 @@ namespace MagEngine {
 		materialData_->enableLighting = false;
 		materialData_->uvTransform = MagMath::Identity4x4();
 	}
-
-	///=============================================================================
-	///						新しいパーティクルを生成
-	ParticleStr Particle::CreateNewParticle(std::mt19937 &randomEngine, const MagMath::Vector3 &position) {
-		// 範囲の安全性チェック（min > maxの場合はスワップ）
-		auto safeRange = [](float &min, float &max) {
-			if(min > max) {
-				std::swap(min, max);
-			}
-			// 同じ値の場合は微小な差を追加
-			if(std::abs(max - min) < 0.0001f) {
-				max = min + 0.0001f;
-			}
-			};
-
-			// 各範囲の安全性チェック
-		MagMath::Vector3 safeTranslateMin = translateMin_;
-		MagMath::Vector3 safeTranslateMax = translateMax_;
-		safeRange(safeTranslateMin.x, safeTranslateMax.x);
-		safeRange(safeTranslateMin.y, safeTranslateMax.y);
-		safeRange(safeTranslateMin.z, safeTranslateMax.z);
-
-		MagMath::Vector3 safeVelocityMin = velocityMin_;
-		MagMath::Vector3 safeVelocityMax = velocityMax_;
-		safeRange(safeVelocityMin.x, safeVelocityMax.x);
-		safeRange(safeVelocityMin.y, safeVelocityMax.y);
-		safeRange(safeVelocityMin.z, safeVelocityMax.z);
-
-		MagMath::Vector4 safeColorMin = colorMin_;
-		MagMath::Vector4 safeColorMax = colorMax_;
-		safeRange(safeColorMin.x, safeColorMax.x);
-		safeRange(safeColorMin.y, safeColorMax.y);
-		safeRange(safeColorMin.z, safeColorMax.z);
-		safeRange(safeColorMin.w, safeColorMax.w);
-
-		float safeLifeMin = lifetimeRange_.min;
-		float safeLifeMax = lifetimeRange_.max;
-		safeRange(safeLifeMin, safeLifeMax);
-
-		MagMath::Vector3 safeInitialScaleMin = initialScaleMin_;
-		MagMath::Vector3 safeInitialScaleMax = initialScaleMax_;
-		safeRange(safeInitialScaleMin.x, safeInitialScaleMax.x);
-		safeRange(safeInitialScaleMin.y, safeInitialScaleMax.y);
-		safeRange(safeInitialScaleMin.z, safeInitialScaleMax.z);
-
-		MagMath::Vector3 safeEndScaleMin = endScaleMin_;
-		MagMath::Vector3 safeEndScaleMax = endScaleMax_;
-		safeRange(safeEndScaleMin.x, safeEndScaleMax.x);
-		safeRange(safeEndScaleMin.y, safeEndScaleMax.y);
-		safeRange(safeEndScaleMin.z, safeEndScaleMax.z);
-
-		MagMath::Vector3 safeInitialRotationMin = initialRotationMin_;
-		MagMath::Vector3 safeInitialRotationMax = initialRotationMax_;
-		safeRange(safeInitialRotationMin.x, safeInitialRotationMax.x);
-		safeRange(safeInitialRotationMin.y, safeInitialRotationMax.y);
-		safeRange(safeInitialRotationMin.z, safeInitialRotationMax.z);
-
-		MagMath::Vector3 safeEndRotationMin = endRotationMin_;
-		MagMath::Vector3 safeEndRotationMax = endRotationMax_;
-		safeRange(safeEndRotationMin.x, safeEndRotationMax.x);
-		safeRange(safeEndRotationMin.y, safeEndRotationMax.y);
-		safeRange(safeEndRotationMin.z, safeEndRotationMax.z);
-
-		// カラーと寿命のランダム分布（安全な範囲を使用）
-		std::uniform_real_distribution<float> distTranslateX(safeTranslateMin.x, safeTranslateMax.x);
-		std::uniform_real_distribution<float> distTranslateY(safeTranslateMin.y, safeTranslateMax.y);
-		std::uniform_real_distribution<float> distTranslateZ(safeTranslateMin.z, safeTranslateMax.z);
-		std::uniform_real_distribution<float> distVelocityX(safeVelocityMin.x, safeVelocityMax.x);
-		std::uniform_real_distribution<float> distVelocityY(safeVelocityMin.y, safeVelocityMax.y);
-		std::uniform_real_distribution<float> distVelocityZ(safeVelocityMin.z, safeVelocityMax.z);
-		std::uniform_real_distribution<float> distColorR(safeColorMin.x, safeColorMax.x);
-		std::uniform_real_distribution<float> distColorG(safeColorMin.y, safeColorMax.y);
-		std::uniform_real_distribution<float> distColorB(safeColorMin.z, safeColorMax.z);
-		std::uniform_real_distribution<float> distColorA(safeColorMin.w, safeColorMax.w);
-		std::uniform_real_distribution<float> distTime(safeLifeMin, safeLifeMax);
-		std::uniform_real_distribution<float> distInitialScaleX(safeInitialScaleMin.x, safeInitialScaleMax.x);
-		std::uniform_real_distribution<float> distInitialScaleY(safeInitialScaleMin.y, safeInitialScaleMax.y);
-		std::uniform_real_distribution<float> distInitialScaleZ(safeInitialScaleMin.z, safeInitialScaleMax.z);
-		std::uniform_real_distribution<float> distEndScaleX(safeEndScaleMin.x, safeEndScaleMax.x);
-		std::uniform_real_distribution<float> distEndScaleY(safeEndScaleMin.y, safeEndScaleMax.y);
-		std::uniform_real_distribution<float> distEndScaleZ(safeEndScaleMin.z, safeEndScaleMax.z);
-		std::uniform_real_distribution<float> distInitialRotationX(safeInitialRotationMin.x, safeInitialRotationMax.x);
-		std::uniform_real_distribution<float> distInitialRotationY(safeInitialRotationMin.y, safeInitialRotationMax.y);
-		std::uniform_real_distribution<float> distInitialRotationZ(safeInitialRotationMin.z, safeInitialRotationMax.z);
-		std::uniform_real_distribution<float> distEndRotationX(safeEndRotationMin.x, safeEndRotationMax.x);
-		std::uniform_real_distribution<float> distEndRotationY(safeEndRotationMin.y, safeEndRotationMax.y);
-		std::uniform_real_distribution<float> distEndRotationZ(safeEndRotationMin.z, safeEndRotationMax.z);
-
-		// 新たなパーティクルの生成
-		ParticleStr particle = {};
-		particle.transform.translate = {
-			position.x + distTranslateX(randomEngine),
-			position.y + distTranslateY(randomEngine),
-			position.z + distTranslateZ(randomEngine) };
-		particle.velocity = {
-			distVelocityX(randomEngine),
-			distVelocityY(randomEngine),
-			distVelocityZ(randomEngine) };
-		particle.color = {
-			distColorR(randomEngine),
-			distColorG(randomEngine),
-			distColorB(randomEngine),
-			distColorA(randomEngine) };
-		particle.lifeTime = distTime(randomEngine);
-		particle.currentTime = 0.0f;
-
-		particle.initialScale = {
-			distInitialScaleX(randomEngine),
-			distInitialScaleY(randomEngine),
-			distInitialScaleZ(randomEngine) };
-		particle.endScale = {
-			distEndScaleX(randomEngine),
-			distEndScaleY(randomEngine),
-			distEndScaleZ(randomEngine) };
-		particle.initialRotation = {
-			distInitialRotationX(randomEngine),
-			distInitialRotationY(randomEngine),
-			distInitialRotationZ(randomEngine) };
-		particle.endRotation = {
-			distEndRotationX(randomEngine),
-			distEndRotationY(randomEngine),
-			distEndRotationZ(randomEngine) };
-
-		// 初期回転をtransformに設定
-		particle.transform.rotate = particle.initialRotation;
-		// 初期スケールをtransformに設定
-		particle.transform.scale = particle.initialScale;
-
-		return particle;
-	}
-}
\ No newline at end of file
+}
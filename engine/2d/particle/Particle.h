@@ -7,20 +7,14 @@
  * \note
  *********************************************************************/
 #pragma once
-// パーティクルの形状を定義する列挙型 (ヘッダの先頭近くに移動)
-enum class ParticleShape {
-	Board,	 // 現在のボード形状
-	Ring,	 // リング形状
-	Cylinder // シリンダー形状
-};
-
 #include "MagMath.h"
 #include "ModelData.h"
+#include "ParticleBenchmark.h"
+#include "ParticleConfig.h"
+#include "ParticlePool.h"
 #include "ParticleSetup.h"
-
-//========================================
-// 標準ライブラリ
-#include <random>
+#include "Random.h"
+#include "TextureHandle.h"
 
 //========================================
 // DX12include
@@ -37,40 +31,25 @@ enum class ParticleShape {
 ///=============================================================================
 ///                        namespace MagEngine
 namespace MagEngine {
-	// Particle構造体
-	struct ParticleStr {
-		MagMath::Transform transform;
-		MagMath::Vector3 velocity;
-		MagMath::Vector4 color;
-		float lifeTime;
-		float currentTime;
-		MagMath::Vector3 initialScale;	  // 初期スケール
-		MagMath::Vector3 endScale;		  // 終了スケール
-		MagMath::Vector3 initialRotation; // 初期回転
-		MagMath::Vector3 endRotation;	  // 終了回転
-	};
-
-	struct ParticleForGPU {
-		MagMath::Matrix4x4 WVP;
-		MagMath::Matrix4x4 World;
-		MagMath::Vector4 color;
-	};
-
 	// パーティクルグループ構造体の定義
 	struct ParticleGroup {
 		// マテリアルデータ
 		std::string materialFilePath;
-		int srvIndex = 0;
-		// パーティクルのリスト (std::list<ParticleStr>型)
-		std::list<ParticleStr> particleList = {};
-		// インスタンシングデータ用SRVインデックス
-		int instancingSrvIndex = 0;
-		// インスタンシングリソース
-		Microsoft::WRL::ComPtr<ID3D12Resource> instancingResource = nullptr;
+		// テクスチャ（差し替えでSRVが変わるため、描画時にハンドルから引く）
+		TextureHandle textureHandle;
+		// パーティクルのプール（固定容量のSoA。生成・消滅でヒープ確保しない）
+		ParticlePool pool;
+		// ビルボードを使用するか（グループ作成時に固定）
+		bool useBillboard = false;
 		// インスタンス数
 		UINT instanceCount = 0;
-		// インスタンシングデータを書き込むためのポインタ
+		// 描画するインスタンス数（カリング後の全チャンクの合計）
+		UINT visibleCount = 0;
+		// インスタンシングデータ（毎フレーム DirectXCore のアップロードリングから描画数分を確保し、連続して書き込む）
 		ParticleForGPU *instancingDataPtr = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS instancingAddress = 0;
+		// インスタンシングデータを確保したフレーム（描画時に同じフレームか確認する）
+		uint64_t instancingFrame = 0;
 
 		MagMath::Vector2 textureLeftTop = {0.0f, 0.0f}; // テクスチャ左上座標
 		MagMath::Vector2 textureSize = {0.0f, 0.0f};	// テクスチャサイズを追加
@@ -95,6 +74,9 @@ namespace MagEngine {
 		/// \brief 描画
 		void Draw();
 
+		/// \brief ImGui描画（グループごとのパーティクル数と計測）
+		void DrawImGui();
+
 		/**----------------------------------------------------------------------------
 		 * \brief  Emit
 		 * \param  name
@@ -111,6 +93,27 @@ namespace MagEngine {
 		 */
 		void CreateParticleGroup(const std::string &name, const std::string &textureFilePath, ParticleShape shape);
 
+		/**----------------------------------------------------------------------------
+		 * \brief  RegisterConfig 生成設定をグループに登録
+		 * \param  groupName 登録先のパーティクルグループ名
+		 * \param  configName 設定名（同名の設定が登録済みの場合はそのIDを返す）
+		 * \param  config 生成設定（ビルボードの有無はグループ作成時の設定と一致させること）
+		 * \return 設定ID
+		 */
+		uint32_t RegisterConfig(const std::string &groupName, const std::string &configName, const ParticleConfig &config);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  EnqueueEmit 生成要求をキューに積む
+		 * \param  configId RegisterConfig で取得した設定ID
+		 * \param  position 生成位置
+		 * \param  count 生成数
+		 * \note   生成は次の Update の先頭でまとめて行う。衝突コールバック等から呼んでも生成コストはかからない
+		 */
+		void EnqueueEmit(uint32_t configId, const MagMath::Vector3 &position, uint32_t count);
+
+		// 無効な設定ID
+		static constexpr uint32_t kInvalidConfigId = UINT32_MAX;
+
 		// 形状設定用の関数 (注意: CreateVertexDataが固定形状を生成するため、現状これらの動的変更は限定的)
 		void SetParticleShape(ParticleShape shape) { /* particleShape_ = shape; */
 			shape = shape;
@@ -126,6 +129,7 @@ namespace MagEngine {
 		/**----------------------------------------------------------------------------
 		 * \brief  SetBillboard ビルボードの使用/不使用を設定
 		 * \param  enable trueで使用、falseで不使用
+		 * \note   以降に作成するグループに反映される（作成済みのグループは変わらない）
 		 */
 		void SetBillboard(bool enable) {
 			isUsedBillboard = enable;
@@ -139,6 +143,7 @@ namespace MagEngine {
 		void SetTranslateRange(const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
 			translateMin_ = min;
 			translateMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -149,6 +154,7 @@ namespace MagEngine {
 		void SetVelocityRange(const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
 			velocityMin_ = min;
 			velocityMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -159,6 +165,7 @@ namespace MagEngine {
 		void SetColorRange(const MagMath::Vector4 &min, const MagMath::Vector4 &max) {
 			colorMin_ = min;
 			colorMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -168,6 +175,7 @@ namespace MagEngine {
 		 */
 		void SetLifetimeRange(float min, float max) {
 			lifetimeRange_ = {min, max};
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -178,6 +186,7 @@ namespace MagEngine {
 		void SetInitialScaleRange(const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
 			initialScaleMin_ = min;
 			initialScaleMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -188,6 +197,7 @@ namespace MagEngine {
 		void SetEndScaleRange(const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
 			endScaleMin_ = min;
 			endScaleMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -198,6 +208,7 @@ namespace MagEngine {
 		void SetInitialRotationRange(const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
 			initialRotationMin_ = min;
 			initialRotationMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -208,6 +219,7 @@ namespace MagEngine {
 		void SetEndRotationRange(const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
 			endRotationMin_ = min;
 			endRotationMax_ = max;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -216,6 +228,7 @@ namespace MagEngine {
 		 */
 		void SetGravity(const MagMath::Vector3 &gravity) {
 			gravity_ = gravity;
+			isEmitRangesDirty_ = true;
 		}
 
 		/**----------------------------------------------------------------------------
@@ -234,6 +247,7 @@ namespace MagEngine {
 		void SetFadeInOut(float fadeInRatio, float fadeOutRatio) {
 			fadeInRatio_ = fadeInRatio;
 			fadeOutRatio_ = fadeOutRatio;
+			isEmitRangesDirty_ = true;
 		}
 
 		///--------------------------------------------------------------
@@ -255,11 +269,14 @@ namespace MagEngine {
 		void CreateMaterialData();
 
 		/**----------------------------------------------------------------------------
-		 * \brief  CreateNewParticle 新しいパーティクルを生成
-		 * \param  randomEngine 乱数生成器
-		 * \param  position 生成位置
+		 * \brief  FlushEmitQueue キューに積まれた生成要求をまとめて処理
+		 */
+		void FlushEmitQueue();
+
+		/**----------------------------------------------------------------------------
+		 * \brief  MakeConfigFromSettings 現在の設定値（Set〜で設定したもの）から生成設定を作成
 		 */
-		ParticleStr CreateNewParticle(std::mt19937 &randomEngine, const MagMath::Vector3 &position);
+		ParticleConfig MakeConfigFromSettings() const;
 
 		///--------------------------------------------------------------
 		///							入出力関数
@@ -279,6 +296,40 @@ namespace MagEngine {
 		//---------------------------------------
 		// パーティクルグループ
 		std::unordered_map<std::string, ParticleGroup> particleGroups;
+		// 計測結果
+		std::vector<ParticleBenchmark::Result> benchmarkResults_;
+		ParticleBenchmark::Accuracy benchmarkAccuracy_;
+
+		//---------------------------------------
+		// 並列更新のジョブ（グループ内のチャンク単位）
+		struct UpdateJob {
+			ParticleGroup *group;
+			const ParticleUpdateParams *params;
+			ParticleCullParams cull;
+			uint32_t begin;
+			uint32_t end;
+			CullResult result;	  // カリングの結果（ジョブが書き込む）
+			uint32_t writeOffset; // インスタンシングデータ上の書き込み位置
+		};
+		std::vector<UpdateJob> updateJobs_;
+
+		//---------------------------------------
+		// 登録済みの生成設定（IDは配列のインデックス）
+		struct RegisteredConfig {
+			ParticleGroup *group;
+			ParticleSpawnRanges ranges;
+		};
+		std::vector<RegisteredConfig> configs_;
+		std::unordered_map<std::string, uint32_t> configIds_;
+
+		//---------------------------------------
+		// 生成要求のキュー（Update の先頭で処理）
+		struct EmitCommand {
+			uint32_t configId;
+			MagMath::Vector3 position;
+			uint32_t count;
+		};
+		std::vector<EmitCommand> emitQueue_;
 
 		//---------------------------------------
 		// モデルデータ
@@ -303,9 +354,8 @@ namespace MagEngine {
 		Microsoft::WRL::ComPtr<ID3D12Resource> instancingBuffer_;
 
 		//---------------------------------------
-		// 乱数生成器の初期化
-		std::random_device seedGenerator_;
-		std::mt19937 randomEngine_;
+		// 乱数ストリーム（セッションシードから決定的に作成）
+		RandomStream random_;
 
 		//---------------------------------------
 		// その他
@@ -313,6 +363,8 @@ namespace MagEngine {
 		bool isUsedBillboard = false; // デフォルトを false に変更
 		// 最大インスタンス数
 		static const uint32_t kNumMaxInstance = 2048;
+		// 並列更新を行う総パーティクル数の下限（これ未満は直列の方が速い）
+		static const uint32_t kParallelUpdateThreshold = 1024;
 		//
 		const float kDeltaTime = 1.0f / 60.0f;
 		// 乱数範囲の調整用
@@ -321,6 +373,10 @@ namespace MagEngine {
 			float max;
 		};
 
+		// Emit で使う生成設定（Set〜で設定値を変更したときだけ作り直す）
+		ParticleSpawnRanges emitRanges_;
+		bool isEmitRangesDirty_ = true;
+
 		// パーティクルの設定
 		MagMath::Vector3 translateMin_ = {0.0f, 0.0f, 0.0f};
 		MagMath::Vector3 translateMax_ = {0.0f, 0.0f, 0.0f};
@@ -353,5 +409,7 @@ namespace MagEngine {
 		float ringRadius_ = 1.0f;	  // リングの半径
 		float cylinderHeight_ = 1.0f; // シリンダーの高さ
 		float cylinderRadius_ = 0.5f; // シリンダーの半径
+		// カリング用の形状の半径（CreateVertexData で全形状の頂点から求める）
+		float shapeRadius_ = 1.0f;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "ParticleBenchmark.h"
+#include "JobSystem.h"
+#include "ParticlePool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <numbers>
+#include <random>
+
+namespace {
+	using namespace MagEngine;
+
+	constexpr float kDeltaTime = 1.0f / 60.0f;
+
+	///=============================================================================
+	///						計測用パーティクル生成
+	/// NOTE: 半数は回転なし・等倍スケールの板ポリゴン（高速パス）、残りは回転・非等倍スケール（汎用パス）
+	ParticleStr MakeParticle(std::mt19937 &rng, float minLife = 0.5f, float maxLife = 2.0f) {
+		std::uniform_real_distribution<float> posDist(-10.0f, 10.0f);
+		std::uniform_real_distribution<float> velDist(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> lifeDist(minLife, maxLife);
+
+		ParticleStr particle = {};
+		particle.transform.translate = {posDist(rng), posDist(rng), posDist(rng)};
+		particle.velocity = {velDist(rng), velDist(rng), velDist(rng)};
+		particle.color = {1.0f, 1.0f, 1.0f, 1.0f};
+		particle.lifeTime = lifeDist(rng);
+		particle.currentTime = 0.0f;
+		particle.initialScale = {1.0f, 1.0f, 1.0f};
+		particle.endScale = {0.0f, 0.0f, 0.0f};
+		particle.initialRotation = {0.0f, 0.0f, 0.0f};
+		particle.endRotation = {0.0f, 0.0f, 0.0f};
+		particle.gravity = {0.0f, -9.8f, 0.0f};
+		particle.fadeInRatio = 0.1f;
+		particle.fadeOutRatio = 0.8f;
+		if (rng() & 1u) {
+			particle.endScale = {velDist(rng), velDist(rng), velDist(rng)};
+			particle.initialRotation = {velDist(rng), velDist(rng), velDist(rng)};
+			particle.endRotation = {velDist(rng), velDist(rng), velDist(rng)};
+		}
+		return particle;
+	}
+
+	///=============================================================================
+	///						従来方式（std::list）の更新
+	/// NOTE: 置き換え前の Particle::Update と同じ処理内容
+	uint32_t UpdateList(std::list<ParticleStr> &particles, const ParticleUpdateParams &params, ParticleForGPU *outInstances, uint32_t maxInstances) {
+		uint32_t instanceCount = 0;
+		for (auto it = particles.begin(); it != particles.end();) {
+			ParticleStr &particle = *it;
+			if (particle.lifeTime <= particle.currentTime) {
+				it = particles.erase(it);
+				continue;
+			}
+
+			float timeRatio = particle.currentTime / particle.lifeTime;
+			particle.transform.scale.x = std::lerp(particle.initialScale.x, particle.endScale.x, timeRatio);
+			particle.transform.scale.y = std::lerp(particle.initialScale.y, particle.endScale.y, timeRatio);
+			particle.transform.scale.z = std::lerp(particle.initialScale.z, particle.endScale.z, timeRatio);
+			particle.transform.rotate.x = std::lerp(particle.initialRotation.x, particle.endRotation.x, timeRatio);
+			particle.transform.rotate.y = std::lerp(particle.initialRotation.y, particle.endRotation.y, timeRatio);
+			particle.transform.rotate.z = std::lerp(particle.initialRotation.z, particle.endRotation.z, timeRatio);
+
+			particle.velocity = MagMath::AddVec3(particle.velocity, MagMath::MultiplyVec3(params.deltaTime, particle.gravity));
+			particle.transform.translate = MagMath::AddVec3(particle.transform.translate, MagMath::MultiplyVec3(params.deltaTime, particle.velocity));
+			particle.currentTime += params.deltaTime;
+
+			if (instanceCount < maxInstances) {
+				MagMath::Matrix4x4 worldMatrix = MagMath::Multiply4x4(
+					params.billboardMatrix,
+					MagMath::MakeAffineMatrix(particle.transform.scale, particle.transform.rotate, particle.transform.translate));
+				ParticleForGPU &instance = outInstances[instanceCount];
+				instance.WVP = MagMath::Multiply4x4(worldMatrix, params.viewProjectionMatrix);
+				instance.World = worldMatrix;
+
+				float alpha = 1.0f;
+				if (timeRatio < particle.fadeInRatio) {
+					alpha = timeRatio / particle.fadeInRatio;
+				} else if (timeRatio > particle.fadeOutRatio) {
+					alpha = 1.0f - ((timeRatio - particle.fadeOutRatio) / (1.0f - particle.fadeOutRatio));
+				}
+				alpha = std::clamp(alpha, 0.0f, 1.0f);
+				instance.color = particle.color;
+				instance.color.w = particle.color.w * alpha;
+				++instanceCount;
+			}
+			++it;
+		}
+		return instanceCount;
+	}
+}
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						単一条件で計測
+	ParticleBenchmark::Result ParticleBenchmark::Run(size_t particleCount, uint32_t seed, int frames) {
+		Result result;
+		result.particleCount = particleCount;
+		if (particleCount == 0 || frames <= 0) {
+			return result;
+		}
+
+		ParticleUpdateParams params;
+		params.billboardMatrix = MagMath::Identity4x4();
+		params.viewProjectionMatrix = MagMath::Identity4x4();
+		params.deltaTime = kDeltaTime;
+
+		const uint32_t capacity = static_cast<uint32_t>(particleCount);
+		std::vector<ParticleForGPU> instances(particleCount);
+
+		//========================================
+		// 従来方式（std::list）
+		// NOTE: 両方式とも同じシードで生成し、消滅分を毎フレーム再生成して生存数を維持する
+		{
+			std::mt19937 rng(seed);
+			std::list<ParticleStr> particles;
+			for (size_t i = 0; i < particleCount; ++i) {
+				particles.push_back(MakeParticle(rng));
+			}
+			double totalMs = 0.0;
+			for (int frame = 0; frame < frames; ++frame) {
+				auto start = std::chrono::high_resolution_clock::now();
+				UpdateList(particles, params, instances.data(), capacity);
+				while (particles.size() < particleCount) {
+					particles.push_back(MakeParticle(rng));
+				}
+				auto end = std::chrono::high_resolution_clock::now();
+				totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+			}
+			result.listMs = totalMs / frames;
+		}
+
+		//========================================
+		// ParticlePool方式
+		{
+			std::mt19937 rng(seed);
+			ParticlePool pool;
+			pool.Initialize(capacity);
+			for (size_t i = 0; i < particleCount; ++i) {
+				pool.Push(MakeParticle(rng));
+			}
+			double totalMs = 0.0;
+			for (int frame = 0; frame < frames; ++frame) {
+				auto start = std::chrono::high_resolution_clock::now();
+				pool.Update(params, instances.data(), capacity);
+				while (!pool.IsFull()) {
+					pool.Push(MakeParticle(rng));
+				}
+				auto end = std::chrono::high_resolution_clock::now();
+				totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+			}
+			result.poolMs = totalMs / frames;
+		}
+
+		//========================================
+		// ParticlePool方式（チャンク並列）
+		{
+			JobSystem *jobSystem = JobSystem::GetInstance();
+			result.threadCount = jobSystem->GetThreadCount();
+
+			std::mt19937 rng(seed);
+			ParticlePool pool;
+			pool.Initialize(capacity);
+			for (size_t i = 0; i < particleCount; ++i) {
+				pool.Push(MakeParticle(rng));
+			}
+			double totalMs = 0.0;
+			for (int frame = 0; frame < frames; ++frame) {
+				auto start = std::chrono::high_resolution_clock::now();
+				pool.RemoveExpired();
+				jobSystem->ParallelFor(pool.GetSize(), kParticleUpdateChunkSize, [&](uint32_t begin, uint32_t end, uint32_t) {
+					pool.UpdateRange(params, begin, end, instances.data(), capacity);
+				});
+				while (!pool.IsFull()) {
+					pool.Push(MakeParticle(rng));
+				}
+				auto end = std::chrono::high_resolution_clock::now();
+				totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+			}
+			result.parallelMs = totalMs / frames;
+		}
+		return result;
+	}
+
+	///=============================================================================
+	///						カーネルの精度検証
+	ParticleBenchmark::Accuracy ParticleBenchmark::VerifyKernel(uint32_t particleCount, int frames, float tolerance, uint32_t seed) {
+		Accuracy accuracy;
+
+		// 実際の描画に近い、平行移動を除いたビルボード行列と透視投影
+		ParticleUpdateParams params;
+		params.billboardMatrix = MagMath::Multiply4x4(MagMath::MakeRotateYMatrix(std::numbers::pi_v<float>), MagMath::MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.3f, -0.7f, 0.1f}, {0.0f, 0.0f, 0.0f}));
+		params.viewProjectionMatrix = MagMath::Multiply4x4(
+			MagMath::Inverse4x4(MagMath::MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.3f, -0.7f, 0.1f}, {5.0f, 3.0f, -20.0f})),
+			MagMath::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+		params.deltaTime = kDeltaTime;
+
+		//========================================
+		// 同じ乱数列で両方式に同じパーティクルを生成する
+		// NOTE: 比較期間の途中で寿命が尽きる設定にして、消滅処理も比較する
+		//       消滅後は方式ごとに並び順が変わるため、色のRにパーティクル固有の番号を入れて対応を取る
+		//       （色のRは積分・行列生成で変化しない）
+		const float maxLife = kDeltaTime * static_cast<float>(frames) * 2.0f;
+		std::mt19937 rng(seed);
+		std::list<ParticleStr> particles;
+		ParticlePool pool;
+		pool.Initialize(particleCount);
+		for (uint32_t i = 0; i < particleCount; ++i) {
+			ParticleStr particle = MakeParticle(rng, kDeltaTime, maxLife);
+			particle.color.x = static_cast<float>(i + 1);
+			particles.push_back(particle);
+			pool.Push(particle);
+		}
+
+		//========================================
+		// 毎フレームの出力を比較
+		std::vector<ParticleForGPU> expected(particleCount);
+		std::vector<ParticleForGPU> actual(particleCount);
+		auto compare = [&](float a, float b) {
+			float error = std::fabs(a - b) / std::max(1.0f, std::fabs(a));
+			accuracy.maxError = std::max(accuracy.maxError, error);
+		};
+		auto byId = [](const ParticleForGPU &a, const ParticleForGPU &b) {
+			return a.color.x < b.color.x;
+		};
+		for (int frame = 0; frame < frames; ++frame) {
+			uint32_t expectedCount = UpdateList(particles, params, expected.data(), particleCount);
+			uint32_t actualCount = pool.Update(params, actual.data(), particleCount);
+			accuracy.expiredInstances = particleCount - static_cast<uint32_t>(particles.size());
+			if (expectedCount != actualCount) {
+				accuracy.maxError = std::numeric_limits<float>::infinity();
+				return accuracy;
+			}
+			std::sort(expected.begin(), expected.begin() + expectedCount, byId);
+			std::sort(actual.begin(), actual.begin() + actualCount, byId);
+			for (uint32_t i = 0; i < actualCount; ++i) {
+				if (expected[i].color.x != actual[i].color.x) {
+					accuracy.maxError = std::numeric_limits<float>::infinity();
+					return accuracy;
+				}
+				for (int row = 0; row < 4; ++row) {
+					for (int col = 0; col < 4; ++col) {
+						compare(expected[i].WVP.m[row][col], actual[i].WVP.m[row][col]);
+						compare(expected[i].World.m[row][col], actual[i].World.m[row][col]);
+					}
+				}
+				compare(expected[i].color.y, actual[i].color.y);
+				compare(expected[i].color.z, actual[i].color.z);
+				compare(expected[i].color.w, actual[i].color.w);
+			}
+			accuracy.comparedInstances += actualCount;
+		}
+		accuracy.passed = accuracy.maxError <= tolerance;
+		return accuracy;
+	}
+
+	///=============================================================================
+	///						標準スイートを計測
+	std::vector<ParticleBenchmark::Result> ParticleBenchmark::RunStandardSuite() {
+		std::vector<Result> results;
+		for (size_t count : {size_t(2000), size_t(20000), size_t(200000)}) {
+			results.push_back(Run(count));
+		}
+		return results;
+	}
+}
@@ -0,0 +1,60 @@
+/*********************************************************************
+ * \file   ParticleBenchmark.h
+ * \brief  パーティクル更新の計測ハーネス
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   従来の std::list 方式と ParticlePool（SoA）方式を同条件で比較する
+ *         SIMDカーネルの出力が従来の行列計算と許容誤差内で一致するかも検証する
+ *         並列更新はジョブシステムでチャンク単位に分割して計測する
+ *         ParticlePoolのみを使うため、D3D12やウィンドウなしで実行できる
+ *         精度検証は tests/ のテストから自動で実行する
+ *         コンソールからは benchmarks/ の MagEngineBenchmarks で計測できる
+ *********************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						パーティクルベンチマーク
+	class ParticleBenchmark {
+	public:
+		//========================================
+		// 計測結果
+		struct Result {
+			size_t particleCount = 0; ///< 生存パーティクル数
+			double listMs = 0.0;	  ///< 1フレームあたりの平均更新時間（std::list方式、ミリ秒）
+			double poolMs = 0.0;	  ///< 1フレームあたりの平均更新時間（ParticlePool方式、ミリ秒）
+			double parallelMs = 0.0;  ///< 1フレームあたりの平均更新時間（ParticlePool方式をチャンク並列、ミリ秒）
+			uint32_t threadCount = 1; ///< 並列更新に使用したスレッド数
+		};
+
+		//========================================
+		// カーネルの精度検証結果
+		struct Accuracy {
+			uint32_t comparedInstances = 0; ///< 比較したインスタンス数（フレーム累計）
+			uint32_t expiredInstances = 0;	///< 比較期間中に寿命が尽きたパーティクル数
+			float maxError = 0.0f;			///< 行列・色の最大誤差（1未満の値は絶対誤差、それ以外は相対誤差）
+			bool passed = false;			///< 許容誤差内か
+		};
+
+		/// \brief 単一条件で計測
+		/// \param particleCount 生存パーティクル数（消滅分は毎フレーム再生成して維持する）
+		/// \param seed 乱数シード（結果の再現用）
+		/// \param frames 計測フレーム数
+		static Result Run(size_t particleCount, uint32_t seed = 12345u, int frames = 60);
+
+		/// \brief ParticleKernel の出力を従来の行列計算と比較する
+		/// \param particleCount パーティクル数
+		/// \param frames 比較フレーム数（この間に一部の寿命が尽きる設定で生成し、消滅処理も比較する）
+		/// \param tolerance 許容誤差
+		static Accuracy VerifyKernel(uint32_t particleCount = 4096, int frames = 30, float tolerance = 1.0e-4f, uint32_t seed = 12345u);
+
+		/// \brief 標準スイート（2k/20k/200k）を計測
+		static std::vector<Result> RunStandardSuite();
+	};
+}
@@ -0,0 +1,332 @@
+#include "ParticleKernel.h"
+#include "ParticlePool.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define PARTICLE_KERNEL_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_1__) || defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__)
+// NOTE: x64はSSE2が必ず使えるため、SSEパスを既定とする
+#define PARTICLE_KERNEL_SSE
+#include <immintrin.h>
+#endif
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	namespace ParticleKernel {
+		namespace {
+			//========================================
+			// 回転・スケール行列（S * Rx * Ry * Rz の3x3部分）
+			// NOTE: MakeAffineMatrix と同じ回転順を閉じた式で展開したもの
+			inline void MakeScaleRotate3x3(float sx, float sy, float sz, float rx, float ry, float rz, float out[3][3]) {
+				const float cx = MagMath::Cos(rx), snx = MagMath::Sin(rx);
+				const float cy = MagMath::Cos(ry), sny = MagMath::Sin(ry);
+				const float cz = MagMath::Cos(rz), snz = MagMath::Sin(rz);
+
+				out[0][0] = sx * (cy * cz);
+				out[0][1] = sx * (cy * snz);
+				out[0][2] = sx * (-sny);
+				out[1][0] = sy * (-cx * snz + snx * sny * cz);
+				out[1][1] = sy * (cx * cz + snx * sny * snz);
+				out[1][2] = sy * (snx * cy);
+				out[2][0] = sz * (snx * snz + cx * sny * cz);
+				out[2][1] = sz * (-snx * cz + cx * sny * snz);
+				out[2][2] = sz * (cx * cy);
+			}
+
+			//========================================
+			// 高速パスの判定（回転なし・等倍スケール）
+			inline bool IsUniformUnrotated(const Streams &s, uint32_t i) {
+				return s.rotateX[i] == 0.0f && s.rotateY[i] == 0.0f && s.rotateZ[i] == 0.0f &&
+					   s.scaleX[i] == s.scaleY[i] && s.scaleY[i] == s.scaleZ[i];
+			}
+		}
+
+		///=============================================================================
+		///						フレーム共通の行列を準備
+		FrameMatrices MakeFrameMatrices(const MagMath::Matrix4x4 &billboard, const MagMath::Matrix4x4 &viewProjection) {
+			FrameMatrices frame;
+			frame.billboard = billboard;
+			frame.viewProjection = viewProjection;
+			frame.billboardViewProjection = MagMath::Multiply4x4(billboard, viewProjection);
+			return frame;
+		}
+
+		///=============================================================================
+		///						スカラー版の積分
+		void IntegrateScalar(const Streams &s, const IntegrateParams &params, uint32_t begin, uint32_t end) {
+			const float dt = params.deltaTime;
+			for (uint32_t i = begin; i < end; ++i) {
+				// 経過時間に対する割合
+				float timeRatio = s.currentTime[i] / s.lifeTime[i];
+
+				// スケール・回転の線形補間
+				s.scaleX[i] = std::lerp(s.initialScaleX[i], s.endScaleX[i], timeRatio);
+				s.scaleY[i] = std::lerp(s.initialScaleY[i], s.endScaleY[i], timeRatio);
+				s.scaleZ[i] = std::lerp(s.initialScaleZ[i], s.endScaleZ[i], timeRatio);
+				s.rotateX[i] = std::lerp(s.initialRotationX[i], s.endRotationX[i], timeRatio);
+				s.rotateY[i] = std::lerp(s.initialRotationY[i], s.endRotationY[i], timeRatio);
+				s.rotateZ[i] = std::lerp(s.initialRotationZ[i], s.endRotationZ[i], timeRatio);
+
+				// 重力の適用と位置の更新
+				s.velocityX[i] += dt * s.gravityX[i];
+				s.velocityY[i] += dt * s.gravityY[i];
+				s.velocityZ[i] += dt * s.gravityZ[i];
+				s.positionX[i] += dt * s.velocityX[i];
+				s.positionY[i] += dt * s.velocityY[i];
+				s.positionZ[i] += dt * s.velocityZ[i];
+				s.currentTime[i] += dt;
+
+				// フェードイン・アウトの計算
+				float alpha = 1.0f;
+				if (timeRatio < s.fadeInRatio[i]) {
+					alpha = timeRatio / s.fadeInRatio[i];
+				} else if (timeRatio > s.fadeOutRatio[i]) {
+					alpha = 1.0f - ((timeRatio - s.fadeOutRatio[i]) / (1.0f - s.fadeOutRatio[i]));
+				}
+				s.alpha[i] = std::clamp(alpha, 0.0f, 1.0f);
+			}
+		}
+
+#if defined(PARTICLE_KERNEL_AVX2)
+		///=============================================================================
+		///						AVX2版の積分（8件同時）
+		void Integrate(const Streams &s, const IntegrateParams &params, uint32_t count) {
+			const __m256 dt = _mm256_set1_ps(params.deltaTime);
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 zero = _mm256_setzero_ps();
+
+			auto lerp = [](const float *a, const float *b, __m256 t, uint32_t i) {
+				__m256 va = _mm256_loadu_ps(a + i);
+				return _mm256_add_ps(va, _mm256_mul_ps(t, _mm256_sub_ps(_mm256_loadu_ps(b + i), va)));
+			};
+
+			uint32_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256 current = _mm256_loadu_ps(s.currentTime + i);
+				__m256 t = _mm256_div_ps(current, _mm256_loadu_ps(s.lifeTime + i));
+
+				// スケール・回転の線形補間
+				_mm256_storeu_ps(s.scaleX + i, lerp(s.initialScaleX, s.endScaleX, t, i));
+				_mm256_storeu_ps(s.scaleY + i, lerp(s.initialScaleY, s.endScaleY, t, i));
+				_mm256_storeu_ps(s.scaleZ + i, lerp(s.initialScaleZ, s.endScaleZ, t, i));
+				_mm256_storeu_ps(s.rotateX + i, lerp(s.initialRotationX, s.endRotationX, t, i));
+				_mm256_storeu_ps(s.rotateY + i, lerp(s.initialRotationY, s.endRotationY, t, i));
+				_mm256_storeu_ps(s.rotateZ + i, lerp(s.initialRotationZ, s.endRotationZ, t, i));
+
+				// 重力の適用と位置の更新
+				__m256 vx = _mm256_add_ps(_mm256_loadu_ps(s.velocityX + i), _mm256_mul_ps(dt, _mm256_loadu_ps(s.gravityX + i)));
+				__m256 vy = _mm256_add_ps(_mm256_loadu_ps(s.velocityY + i), _mm256_mul_ps(dt, _mm256_loadu_ps(s.gravityY + i)));
+				__m256 vz = _mm256_add_ps(_mm256_loadu_ps(s.velocityZ + i), _mm256_mul_ps(dt, _mm256_loadu_ps(s.gravityZ + i)));
+				_mm256_storeu_ps(s.velocityX + i, vx);
+				_mm256_storeu_ps(s.velocityY + i, vy);
+				_mm256_storeu_ps(s.velocityZ + i, vz);
+				_mm256_storeu_ps(s.positionX + i, _mm256_add_ps(_mm256_loadu_ps(s.positionX + i), _mm256_mul_ps(dt, vx)));
+				_mm256_storeu_ps(s.positionY + i, _mm256_add_ps(_mm256_loadu_ps(s.positionY + i), _mm256_mul_ps(dt, vy)));
+				_mm256_storeu_ps(s.positionZ + i, _mm256_add_ps(_mm256_loadu_ps(s.positionZ + i), _mm256_mul_ps(dt, vz)));
+				_mm256_storeu_ps(s.currentTime + i, _mm256_add_ps(current, dt));
+
+				// フェードイン・アウトの計算
+				// NOTE: 選ばれなかった側のゼロ除算結果はブレンドで捨てられる
+				__m256 fadeIn = _mm256_loadu_ps(s.fadeInRatio + i);
+				__m256 fadeOut = _mm256_loadu_ps(s.fadeOutRatio + i);
+				__m256 fadeOutRange = _mm256_sub_ps(one, fadeOut);
+				__m256 fadeInAlpha = _mm256_div_ps(t, fadeIn);
+				__m256 fadeOutAlpha = _mm256_sub_ps(one, _mm256_div_ps(_mm256_sub_ps(t, fadeOut), fadeOutRange));
+				__m256 alpha = _mm256_blendv_ps(one, fadeOutAlpha, _mm256_cmp_ps(t, fadeOut, _CMP_GT_OQ));
+				alpha = _mm256_blendv_ps(alpha, fadeInAlpha, _mm256_cmp_ps(t, fadeIn, _CMP_LT_OQ));
+				_mm256_storeu_ps(s.alpha + i, _mm256_min_ps(_mm256_max_ps(alpha, zero), one));
+			}
+			// 端数はスカラーで処理
+			IntegrateScalar(s, params, i, count);
+		}
+
+		const char *GetInstructionSetName() {
+			return "AVX2";
+		}
+
+#elif defined(PARTICLE_KERNEL_SSE)
+		///=============================================================================
+		///						SSE版の積分（4件同時）
+		void Integrate(const Streams &s, const IntegrateParams &params, uint32_t count) {
+			const __m128 dt = _mm_set1_ps(params.deltaTime);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 zero = _mm_setzero_ps();
+
+			auto lerp = [](const float *a, const float *b, __m128 t, uint32_t i) {
+				__m128 va = _mm_loadu_ps(a + i);
+				return _mm_add_ps(va, _mm_mul_ps(t, _mm_sub_ps(_mm_loadu_ps(b + i), va)));
+			};
+			// NOTE: SSE2にはblendvがないため論理演算で選択する
+			auto select = [](__m128 mask, __m128 a, __m128 b) {
+				return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+			};
+
+			uint32_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 current = _mm_loadu_ps(s.currentTime + i);
+				__m128 t = _mm_div_ps(current, _mm_loadu_ps(s.lifeTime + i));
+
+				// スケール・回転の線形補間
+				_mm_storeu_ps(s.scaleX + i, lerp(s.initialScaleX, s.endScaleX, t, i));
+				_mm_storeu_ps(s.scaleY + i, lerp(s.initialScaleY, s.endScaleY, t, i));
+				_mm_storeu_ps(s.scaleZ + i, lerp(s.initialScaleZ, s.endScaleZ, t, i));
+				_mm_storeu_ps(s.rotateX + i, lerp(s.initialRotationX, s.endRotationX, t, i));
+				_mm_storeu_ps(s.rotateY + i, lerp(s.initialRotationY, s.endRotationY, t, i));
+				_mm_storeu_ps(s.rotateZ + i, lerp(s.initialRotationZ, s.endRotationZ, t, i));
+
+				// 重力の適用と位置の更新
+				__m128 vx = _mm_add_ps(_mm_loadu_ps(s.velocityX + i), _mm_mul_ps(dt, _mm_loadu_ps(s.gravityX + i)));
+				__m128 vy = _mm_add_ps(_mm_loadu_ps(s.velocityY + i), _mm_mul_ps(dt, _mm_loadu_ps(s.gravityY + i)));
+				__m128 vz = _mm_add_ps(_mm_loadu_ps(s.velocityZ + i), _mm_mul_ps(dt, _mm_loadu_ps(s.gravityZ + i)));
+				_mm_storeu_ps(s.velocityX + i, vx);
+				_mm_storeu_ps(s.velocityY + i, vy);
+				_mm_storeu_ps(s.velocityZ + i, vz);
+				_mm_storeu_ps(s.positionX + i, _mm_add_ps(_mm_loadu_ps(s.positionX + i), _mm_mul_ps(dt, vx)));
+				_mm_storeu_ps(s.positionY + i, _mm_add_ps(_mm_loadu_ps(s.positionY + i), _mm_mul_ps(dt, vy)));
+				_mm_storeu_ps(s.positionZ + i, _mm_add_ps(_mm_loadu_ps(s.positionZ + i), _mm_mul_ps(dt, vz)));
+				_mm_storeu_ps(s.currentTime + i, _mm_add_ps(current, dt));
+
+				// フェードイン・アウトの計算
+				__m128 fadeIn = _mm_loadu_ps(s.fadeInRatio + i);
+				__m128 fadeOut = _mm_loadu_ps(s.fadeOutRatio + i);
+				__m128 fadeOutRange = _mm_sub_ps(one, fadeOut);
+				__m128 fadeInAlpha = _mm_div_ps(t, fadeIn);
+				__m128 fadeOutAlpha = _mm_sub_ps(one, _mm_div_ps(_mm_sub_ps(t, fadeOut), fadeOutRange));
+				__m128 alpha = select(_mm_cmpgt_ps(t, fadeOut), one, fadeOutAlpha);
+				alpha = select(_mm_cmplt_ps(t, fadeIn), alpha, fadeInAlpha);
+				_mm_storeu_ps(s.alpha + i, _mm_min_ps(_mm_max_ps(alpha, zero), one));
+			}
+			// 端数はスカラーで処理
+			IntegrateScalar(s, params, i, count);
+		}
+
+		const char *GetInstructionSetName() {
+			return "SSE";
+		}
+
+#else
+		///=============================================================================
+		///						非対応環境（スカラー）
+		void Integrate(const Streams &s, const IntegrateParams &params, uint32_t count) {
+			IntegrateScalar(s, params, 0, count);
+		}
+
+		const char *GetInstructionSetName() {
+			return "Scalar";
+		}
+#endif
+
+#if defined(PARTICLE_KERNEL_AVX2) || defined(PARTICLE_KERNEL_SSE)
+		///=============================================================================
+		///						インスタンシングデータの書き込み（行単位SSE）
+		void WriteInstances(const Streams &s, const FrameMatrices &frame, uint32_t count, ParticleForGPU *outInstances) {
+			const __m128 vp0 = _mm_loadu_ps(frame.viewProjection.m[0]);
+			const __m128 vp1 = _mm_loadu_ps(frame.viewProjection.m[1]);
+			const __m128 vp2 = _mm_loadu_ps(frame.viewProjection.m[2]);
+			const __m128 vp3 = _mm_loadu_ps(frame.viewProjection.m[3]);
+			const __m128 b0 = _mm_loadu_ps(frame.billboard.m[0]);
+			const __m128 b1 = _mm_loadu_ps(frame.billboard.m[1]);
+			const __m128 b2 = _mm_loadu_ps(frame.billboard.m[2]);
+			const __m128 bvp0 = _mm_loadu_ps(frame.billboardViewProjection.m[0]);
+			const __m128 bvp1 = _mm_loadu_ps(frame.billboardViewProjection.m[1]);
+			const __m128 bvp2 = _mm_loadu_ps(frame.billboardViewProjection.m[2]);
+			const MagMath::Matrix4x4 &b = frame.billboard;
+
+			// 行ベクトル × 行列の上3行（w成分は0）
+			auto rowTimesVP = [&](float x, float y, float z) {
+				return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(x), vp0), _mm_mul_ps(_mm_set1_ps(y), vp1)), _mm_mul_ps(_mm_set1_ps(z), vp2));
+			};
+
+			for (uint32_t i = 0; i < count; ++i) {
+				ParticleForGPU &instance = outInstances[i];
+
+				if (IsUniformUnrotated(s, i)) {
+					//---------------------------------------
+					// 高速パス: World = scale * billboard, WVP = scale * (billboard * VP)
+					__m128 scale = _mm_set1_ps(s.scaleX[i]);
+					_mm_storeu_ps(instance.World.m[0], _mm_mul_ps(scale, b0));
+					_mm_storeu_ps(instance.World.m[1], _mm_mul_ps(scale, b1));
+					_mm_storeu_ps(instance.World.m[2], _mm_mul_ps(scale, b2));
+					_mm_storeu_ps(instance.WVP.m[0], _mm_mul_ps(scale, bvp0));
+					_mm_storeu_ps(instance.WVP.m[1], _mm_mul_ps(scale, bvp1));
+					_mm_storeu_ps(instance.WVP.m[2], _mm_mul_ps(scale, bvp2));
+				} else {
+					//---------------------------------------
+					// 汎用パス: World(3x3) = billboard(3x3) * (S * R)
+					float sr[3][3];
+					MakeScaleRotate3x3(s.scaleX[i], s.scaleY[i], s.scaleZ[i], s.rotateX[i], s.rotateY[i], s.rotateZ[i], sr);
+					for (int row = 0; row < 3; ++row) {
+						float x = b.m[row][0] * sr[0][0] + b.m[row][1] * sr[1][0] + b.m[row][2] * sr[2][0];
+						float y = b.m[row][0] * sr[0][1] + b.m[row][1] * sr[1][1] + b.m[row][2] * sr[2][1];
+						float z = b.m[row][0] * sr[0][2] + b.m[row][1] * sr[1][2] + b.m[row][2] * sr[2][2];
+						_mm_storeu_ps(instance.World.m[row], _mm_set_ps(0.0f, z, y, x));
+						_mm_storeu_ps(instance.WVP.m[row], rowTimesVP(x, y, z));
+					}
+				}
+
+				//---------------------------------------
+				// 平行移動行（ビルボード行列は平行移動を持たないため位置そのもの）
+				float px = s.positionX[i], py = s.positionY[i], pz = s.positionZ[i];
+				_mm_storeu_ps(instance.World.m[3], _mm_set_ps(1.0f, pz, py, px));
+				_mm_storeu_ps(instance.WVP.m[3], _mm_add_ps(rowTimesVP(px, py, pz), vp3));
+
+				// カラー（フェードαを適用）
+				instance.color = {s.colorR[i], s.colorG[i], s.colorB[i], s.colorA[i] * s.alpha[i]};
+			}
+		}
+
+#else
+		///=============================================================================
+		///						インスタンシングデータの書き込み（スカラー）
+		void WriteInstances(const Streams &s, const FrameMatrices &frame, uint32_t count, ParticleForGPU *outInstances) {
+			const MagMath::Matrix4x4 &b = frame.billboard;
+			const MagMath::Matrix4x4 &vp = frame.viewProjection;
+			const MagMath::Matrix4x4 &bvp = frame.billboardViewProjection;
+
+			for (uint32_t i = 0; i < count; ++i) {
+				ParticleForGPU &instance = outInstances[i];
+
+				if (IsUniformUnrotated(s, i)) {
+					// 高速パス: World = scale * billboard, WVP = scale * (billboard * VP)
+					float scale = s.scaleX[i];
+					for (int row = 0; row < 3; ++row) {
+						for (int col = 0; col < 4; ++col) {
+							instance.World.m[row][col] = scale * b.m[row][col];
+							instance.WVP.m[row][col] = scale * bvp.m[row][col];
+						}
+					}
+				} else {
+					// 汎用パス: World(3x3) = billboard(3x3) * (S * R)
+					float sr[3][3];
+					MakeScaleRotate3x3(s.scaleX[i], s.scaleY[i], s.scaleZ[i], s.rotateX[i], s.rotateY[i], s.rotateZ[i], sr);
+					for (int row = 0; row < 3; ++row) {
+						for (int col = 0; col < 3; ++col) {
+							instance.World.m[row][col] = b.m[row][0] * sr[0][col] + b.m[row][1] * sr[1][col] + b.m[row][2] * sr[2][col];
+						}
+						instance.World.m[row][3] = 0.0f;
+						for (int col = 0; col < 4; ++col) {
+							instance.WVP.m[row][col] = instance.World.m[row][0] * vp.m[0][col] + instance.World.m[row][1] * vp.m[1][col] + instance.World.m[row][2] * vp.m[2][col];
+						}
+					}
+				}
+
+				// 平行移動行（ビルボード行列は平行移動を持たないため位置そのもの）
+				float p[3] = {s.positionX[i], s.positionY[i], s.positionZ[i]};
+				instance.World.m[3][0] = p[0];
+				instance.World.m[3][1] = p[1];
+				instance.World.m[3][2] = p[2];
+				instance.World.m[3][3] = 1.0f;
+				for (int col = 0; col < 4; ++col) {
+					instance.WVP.m[3][col] = p[0] * vp.m[0][col] + p[1] * vp.m[1][col] + p[2] * vp.m[2][col] + vp.m[3][col];
+				}
+
+				// カラー（フェードαを適用）
+				instance.color = {s.colorR[i], s.colorG[i], s.colorB[i], s.colorA[i] * s.alpha[i]};
+			}
+		}
+#endif
+	}
+}
@@ -0,0 +1,76 @@
+/*********************************************************************
+ * \file   ParticleKernel.h
+ * \brief  パーティクル更新・インスタンス行列生成カーネル（SIMD）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   積分はAVX2で8件、SSEで4件ずつ、非対応環境ではスカラーで処理する
+ *         行列生成は行単位のSSE演算で、4x4行列の積を使わずに組み立てる
+ *********************************************************************/
+#pragma once
+#include "MagMath.h"
+#include <cstdint>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	struct ParticleForGPU;
+
+	namespace ParticleKernel {
+		//========================================
+		// パーティクル属性の配列（SoA）
+		// NOTE: 各配列は count 個以上の要素を持つこと
+		struct Streams {
+			// 積分で更新する属性
+			float *positionX, *positionY, *positionZ;
+			float *velocityX, *velocityY, *velocityZ;
+			float *currentTime;
+			// 読み取りのみの属性
+			const float *lifeTime;
+			const float *initialScaleX, *initialScaleY, *initialScaleZ;
+			const float *endScaleX, *endScaleY, *endScaleZ;
+			const float *initialRotationX, *initialRotationY, *initialRotationZ;
+			const float *endRotationX, *endRotationY, *endRotationZ;
+			const float *colorR, *colorG, *colorB, *colorA;
+			const float *gravityX, *gravityY, *gravityZ;
+			const float *fadeInRatio, *fadeOutRatio;
+			// 積分結果（行列生成の入力）
+			float *scaleX, *scaleY, *scaleZ;
+			float *rotateX, *rotateY, *rotateZ;
+			float *alpha;
+		};
+
+		//========================================
+		// 積分パラメータ
+		// NOTE: 重力・フェード比率は生成時の設定ごとに異なるため、パーティクル単位で Streams に持つ
+		struct IntegrateParams {
+			float deltaTime; // 経過時間
+		};
+
+		//========================================
+		// フレーム共通の行列
+		// NOTE: ビルボード行列は平行移動成分を持たないアフィン行列であること
+		struct FrameMatrices {
+			MagMath::Matrix4x4 billboard;				  // ビルボード行列
+			MagMath::Matrix4x4 viewProjection;			  // ビュープロジェクション行列
+			MagMath::Matrix4x4 billboardViewProjection;	  // billboard * viewProjection（高速パス用）
+		};
+
+		/// \brief フレーム共通の行列を準備
+		FrameMatrices MakeFrameMatrices(const MagMath::Matrix4x4 &billboard, const MagMath::Matrix4x4 &viewProjection);
+
+		/// \brief 速度・位置・経過時間を積分し、スケール・回転・フェードαを求める
+		/// \note 経過割合は積分前の経過時間から求める（従来の Particle::Update と同じ順序）
+		void Integrate(const Streams &streams, const IntegrateParams &params, uint32_t count);
+
+		/// \brief スカラー版（比較・フォールバック用）
+		void IntegrateScalar(const Streams &streams, const IntegrateParams &params, uint32_t begin, uint32_t end);
+
+		/// \brief 積分結果からインスタンシングデータ（WVP・World・色）を書き込む
+		/// \note 回転なし・等倍スケールのパーティクルはビルボード行列のスケール倍で求める高速パスを使う
+		void WriteInstances(const Streams &streams, const FrameMatrices &frame, uint32_t count, ParticleForGPU *outInstances);
+
+		/// \brief 使用中の命令セット名（デバッグ表示用）
+		const char *GetInstructionSetName();
+	}
+}
@@ -0,0 +1,342 @@
+#include "ParticlePool.h"
+#include <algorithm>
+#include <cmath>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						生成設定の前処理
+	ParticleSpawnRanges ParticleSpawnRanges::FromConfig(const ParticleConfig &config) {
+		ParticleSpawnRanges ranges;
+		auto setRange = [&ranges](uint32_t attribute, float min, float max) {
+			// min > max の場合は入れ替え
+			if (min > max) {
+				std::swap(min, max);
+			}
+			// 同じ値の場合は微小な差を追加
+			if (std::abs(max - min) < 0.0001f) {
+				max = min + 0.0001f;
+			}
+			ranges.min[attribute] = min;
+			ranges.extent[attribute] = max - min;
+		};
+		auto setRange3 = [&setRange](uint32_t attribute, const MagMath::Vector3 &min, const MagMath::Vector3 &max) {
+			setRange(attribute + 0, min.x, max.x);
+			setRange(attribute + 1, min.y, max.y);
+			setRange(attribute + 2, min.z, max.z);
+		};
+
+		setRange3(kTranslateX, config.translateMin, config.translateMax);
+		setRange3(kVelocityX, config.velocityMin, config.velocityMax);
+		setRange(kColorR, config.colorMin.x, config.colorMax.x);
+		setRange(kColorG, config.colorMin.y, config.colorMax.y);
+		setRange(kColorB, config.colorMin.z, config.colorMax.z);
+		setRange(kColorA, config.colorMin.w, config.colorMax.w);
+		setRange(kLifeTime, config.lifetimeMin, config.lifetimeMax);
+		setRange3(kInitialScaleX, config.initialScaleMin, config.initialScaleMax);
+		setRange3(kEndScaleX, config.endScaleMin, config.endScaleMax);
+		setRange3(kInitialRotationX, config.initialRotationMin, config.initialRotationMax);
+		setRange3(kEndRotationX, config.endRotationMin, config.endRotationMax);
+
+		ranges.gravity = config.gravity;
+		ranges.fadeInRatio = config.fadeInRatio;
+		ranges.fadeOutRatio = config.fadeOutRatio;
+		return ranges;
+	}
+
+	///=============================================================================
+	///						初期化
+	void ParticlePool::Initialize(uint32_t capacity) {
+		capacity_ = capacity;
+		size_ = 0;
+
+		// COMMENT: 容量分を一括確保。以降は生成・消滅でヒープ確保を行わない
+		for (std::vector<float> *attribute : {
+				 &positionX_, &positionY_, &positionZ_,
+				 &velocityX_, &velocityY_, &velocityZ_,
+				 &colorR_, &colorG_, &colorB_, &colorA_,
+				 &lifeTime_, &currentTime_,
+				 &initialScaleX_, &initialScaleY_, &initialScaleZ_,
+				 &endScaleX_, &endScaleY_, &endScaleZ_,
+				 &initialRotationX_, &initialRotationY_, &initialRotationZ_,
+				 &endRotationX_, &endRotationY_, &endRotationZ_,
+				 &gravityX_, &gravityY_, &gravityZ_,
+				 &fadeInRatio_, &fadeOutRatio_,
+				 &scaleX_, &scaleY_, &scaleZ_,
+				 &rotateX_, &rotateY_, &rotateZ_,
+				 &alpha_}) {
+			attribute->assign(capacity, 0.0f);
+		}
+		visible_.assign(capacity, 0);
+	}
+
+	///=============================================================================
+	///						パーティクルを追加
+	bool ParticlePool::Push(const ParticleStr &particle) {
+		if (size_ >= capacity_) {
+			return false;
+		}
+
+		uint32_t i = size_++;
+		positionX_[i] = particle.transform.translate.x;
+		positionY_[i] = particle.transform.translate.y;
+		positionZ_[i] = particle.transform.translate.z;
+		velocityX_[i] = particle.velocity.x;
+		velocityY_[i] = particle.velocity.y;
+		velocityZ_[i] = particle.velocity.z;
+		colorR_[i] = particle.color.x;
+		colorG_[i] = particle.color.y;
+		colorB_[i] = particle.color.z;
+		colorA_[i] = particle.color.w;
+		lifeTime_[i] = particle.lifeTime;
+		currentTime_[i] = particle.currentTime;
+		initialScaleX_[i] = particle.initialScale.x;
+		initialScaleY_[i] = particle.initialScale.y;
+		initialScaleZ_[i] = particle.initialScale.z;
+		endScaleX_[i] = particle.endScale.x;
+		endScaleY_[i] = particle.endScale.y;
+		endScaleZ_[i] = particle.endScale.z;
+		initialRotationX_[i] = particle.initialRotation.x;
+		initialRotationY_[i] = particle.initialRotation.y;
+		initialRotationZ_[i] = particle.initialRotation.z;
+		endRotationX_[i] = particle.endRotation.x;
+		endRotationY_[i] = particle.endRotation.y;
+		endRotationZ_[i] = particle.endRotation.z;
+		gravityX_[i] = particle.gravity.x;
+		gravityY_[i] = particle.gravity.y;
+		gravityZ_[i] = particle.gravity.z;
+		fadeInRatio_[i] = particle.fadeInRatio;
+		fadeOutRatio_[i] = particle.fadeOutRatio;
+		return true;
+	}
+
+	///=============================================================================
+	///						パーティクルを削除（末尾と入れ替え）
+	void ParticlePool::Remove(uint32_t index) {
+		uint32_t last = --size_;
+		if (index == last) {
+			return;
+		}
+		positionX_[index] = positionX_[last];
+		positionY_[index] = positionY_[last];
+		positionZ_[index] = positionZ_[last];
+		velocityX_[index] = velocityX_[last];
+		velocityY_[index] = velocityY_[last];
+		velocityZ_[index] = velocityZ_[last];
+		colorR_[index] = colorR_[last];
+		colorG_[index] = colorG_[last];
+		colorB_[index] = colorB_[last];
+		colorA_[index] = colorA_[last];
+		lifeTime_[index] = lifeTime_[last];
+		currentTime_[index] = currentTime_[last];
+		initialScaleX_[index] = initialScaleX_[last];
+		initialScaleY_[index] = initialScaleY_[last];
+		initialScaleZ_[index] = initialScaleZ_[last];
+		endScaleX_[index] = endScaleX_[last];
+		endScaleY_[index] = endScaleY_[last];
+		endScaleZ_[index] = endScaleZ_[last];
+		initialRotationX_[index] = initialRotationX_[last];
+		initialRotationY_[index] = initialRotationY_[last];
+		initialRotationZ_[index] = initialRotationZ_[last];
+		endRotationX_[index] = endRotationX_[last];
+		endRotationY_[index] = endRotationY_[last];
+		endRotationZ_[index] = endRotationZ_[last];
+		gravityX_[index] = gravityX_[last];
+		gravityY_[index] = gravityY_[last];
+		gravityZ_[index] = gravityZ_[last];
+		fadeInRatio_[index] = fadeInRatio_[last];
+		fadeOutRatio_[index] = fadeOutRatio_[last];
+	}
+
+	///=============================================================================
+	///						設定に従ってまとめて生成
+	uint32_t ParticlePool::Spawn(const ParticleSpawnRanges &ranges, const MagMath::Vector3 &position, uint32_t count, RandomStream &random) {
+		// 属性ごとの書き込み先（ParticleSpawnRanges::Attribute の順）
+		static std::vector<float> ParticlePool::*const kColumns[ParticleSpawnRanges::kAttributeCount] = {
+			&ParticlePool::positionX_, &ParticlePool::positionY_, &ParticlePool::positionZ_,
+			&ParticlePool::velocityX_, &ParticlePool::velocityY_, &ParticlePool::velocityZ_,
+			&ParticlePool::colorR_, &ParticlePool::colorG_, &ParticlePool::colorB_, &ParticlePool::colorA_,
+			&ParticlePool::lifeTime_,
+			&ParticlePool::initialScaleX_, &ParticlePool::initialScaleY_, &ParticlePool::initialScaleZ_,
+			&ParticlePool::endScaleX_, &ParticlePool::endScaleY_, &ParticlePool::endScaleZ_,
+			&ParticlePool::initialRotationX_, &ParticlePool::initialRotationY_, &ParticlePool::initialRotationZ_,
+			&ParticlePool::endRotationX_, &ParticlePool::endRotationY_, &ParticlePool::endRotationZ_};
+
+		const uint32_t begin = size_;
+		const uint32_t spawnCount = std::min(count, capacity_ - size_);
+		if (spawnCount == 0) {
+			return 0;
+		}
+		const uint32_t end = begin + spawnCount;
+
+		//========================================
+		// 乱数で決まる属性を列ごとに生成
+		// COMMENT: 乱数の生成と範囲への変換を RandomStream::Fill でまとめて行う（SIMD）
+		for (uint32_t attribute = 0; attribute < ParticleSpawnRanges::kAttributeCount; ++attribute) {
+			float *column = (this->*kColumns[attribute]).data();
+			random.Fill(column + begin, spawnCount, ranges.min[attribute], ranges.extent[attribute]);
+		}
+
+		//========================================
+		// 生成位置と固定値
+		for (uint32_t i = begin; i < end; ++i) {
+			positionX_[i] += position.x;
+			positionY_[i] += position.y;
+			positionZ_[i] += position.z;
+			currentTime_[i] = 0.0f;
+			gravityX_[i] = ranges.gravity.x;
+			gravityY_[i] = ranges.gravity.y;
+			gravityZ_[i] = ranges.gravity.z;
+			fadeInRatio_[i] = ranges.fadeInRatio;
+			fadeOutRatio_[i] = ranges.fadeOutRatio;
+		}
+
+		size_ = end;
+		return spawnCount;
+	}
+
+	///=============================================================================
+	///						更新
+	uint32_t ParticlePool::Update(const ParticleUpdateParams &params, ParticleForGPU *outInstances, uint32_t maxInstances) {
+		RemoveExpired();
+		return UpdateRange(params, 0, size_, outInstances, maxInstances).visibleCount;
+	}
+
+	///=============================================================================
+	///						寿命の尽きたパーティクルを削除
+	void ParticlePool::RemoveExpired() {
+		// NOTE: 末尾のパーティクルが i に移動するため、インデックスは進めない
+		for (uint32_t i = 0; i < size_;) {
+			if (lifeTime_[i] <= currentTime_[i]) {
+				Remove(i);
+				continue;
+			}
+			++i;
+		}
+	}
+
+	///=============================================================================
+	///						範囲を積分・カリング
+	CullResult ParticlePool::IntegrateRange(const ParticleUpdateParams &params, uint32_t begin, uint32_t end, uint32_t maxInstances,
+											const ParticleCullParams *cull) {
+		CullResult result;
+		end = std::min(end, size_);
+		if (begin >= end) {
+			return result;
+		}
+
+		//========================================
+		// 積分
+		ParticleKernel::Streams streams = MakeStreams(begin);
+		ParticleKernel::IntegrateParams integrateParams = {params.deltaTime};
+		ParticleKernel::Integrate(streams, integrateParams, end - begin);
+
+		//========================================
+		// 描画するかの判定（描画できる最大数を超える分は判定しない）
+		if (begin >= maxInstances) {
+			return result;
+		}
+		const uint32_t drawEnd = std::min(end, maxInstances);
+		if (!cull) {
+			std::fill(visible_.begin() + begin, visible_.begin() + drawEnd, static_cast<uint8_t>(1));
+			result.visibleCount = drawEnd - begin;
+			return result;
+		}
+
+		float radius[kParticleUpdateChunkSize];
+		for (uint32_t blockBegin = begin; blockBegin < drawEnd; blockBegin += kParticleUpdateChunkSize) {
+			const uint32_t blockCount = std::min(drawEnd - blockBegin, kParticleUpdateChunkSize);
+			for (uint32_t i = 0; i < blockCount; ++i) {
+				const uint32_t index = blockBegin + i;
+				radius[i] = cull->shapeRadius * std::max({std::abs(scaleX_[index]), std::abs(scaleY_[index]), std::abs(scaleZ_[index])});
+			}
+			const SphereStreams spheres = {positionX_.data() + blockBegin, positionY_.data() + blockBegin, positionZ_.data() + blockBegin, radius};
+			const CullResult block = cull->frustum->CullSpheres(spheres, blockCount, cull->eyePosition, cull->maxDistance, visible_.data() + blockBegin);
+			result.visibleCount += block.visibleCount;
+			result.frustumCulledCount += block.frustumCulledCount;
+			result.distanceCulledCount += block.distanceCulledCount;
+		}
+		return result;
+	}
+
+	///=============================================================================
+	///						描画するものを書き込む
+	void ParticlePool::WriteRange(const ParticleUpdateParams &params, uint32_t begin, uint32_t end, uint32_t maxInstances, ParticleForGPU *outInstances) {
+		end = std::min({end, size_, maxInstances});
+		if (begin >= end) {
+			return;
+		}
+
+		// NOTE: 描画するものを連続区間ごとに詰めて書き込む
+		ParticleKernel::FrameMatrices frame = ParticleKernel::MakeFrameMatrices(params.billboardMatrix, params.viewProjectionMatrix);
+		ParticleForGPU *out = outInstances;
+		for (uint32_t i = begin; i < end;) {
+			if (!visible_[i]) {
+				++i;
+				continue;
+			}
+			uint32_t runEnd = i + 1;
+			while (runEnd < end && visible_[runEnd]) {
+				++runEnd;
+			}
+			ParticleKernel::WriteInstances(MakeStreams(i), frame, runEnd - i, out);
+			out += runEnd - i;
+			i = runEnd;
+		}
+	}
+
+	///=============================================================================
+	///						範囲を更新
+	CullResult ParticlePool::UpdateRange(const ParticleUpdateParams &params, uint32_t begin, uint32_t end, ParticleForGPU *outInstances, uint32_t maxInstances,
+										 const ParticleCullParams *cull) {
+		CullResult result = IntegrateRange(params, begin, end, maxInstances, cull);
+		if (result.visibleCount > 0) {
+			WriteRange(params, begin, end, maxInstances, outInstances + begin);
+		}
+		return result;
+	}
+
+	///=============================================================================
+	///						カーネル用の配列を取得
+	ParticleKernel::Streams ParticlePool::MakeStreams(uint32_t offset) {
+		ParticleKernel::Streams streams;
+		streams.positionX = positionX_.data() + offset;
+		streams.positionY = positionY_.data() + offset;
+		streams.positionZ = positionZ_.data() + offset;
+		streams.velocityX = velocityX_.data() + offset;
+		streams.velocityY = velocityY_.data() + offset;
+		streams.velocityZ = velocityZ_.data() + offset;
+		streams.currentTime = currentTime_.data() + offset;
+		streams.lifeTime = lifeTime_.data() + offset;
+		streams.initialScaleX = initialScaleX_.data() + offset;
+		streams.initialScaleY = initialScaleY_.data() + offset;
+		streams.initialScaleZ = initialScaleZ_.data() + offset;
+		streams.endScaleX = endScaleX_.data() + offset;
+		streams.endScaleY = endScaleY_.data() + offset;
+		streams.endScaleZ = endScaleZ_.data() + offset;
+		streams.initialRotationX = initialRotationX_.data() + offset;
+		streams.initialRotationY = initialRotationY_.data() + offset;
+		streams.initialRotationZ = initialRotationZ_.data() + offset;
+		streams.endRotationX = endRotationX_.data() + offset;
+		streams.endRotationY = endRotationY_.data() + offset;
+		streams.endRotationZ = endRotationZ_.data() + offset;
+		streams.colorR = colorR_.data() + offset;
+		streams.colorG = colorG_.data() + offset;
+		streams.colorB = colorB_.data() + offset;
+		streams.colorA = colorA_.data() + offset;
+		streams.gravityX = gravityX_.data() + offset;
+		streams.gravityY = gravityY_.data() + offset;
+		streams.gravityZ = gravityZ_.data() + offset;
+		streams.fadeInRatio = fadeInRatio_.data() + offset;
+		streams.fadeOutRatio = fadeOutRatio_.data() + offset;
+		streams.scaleX = scaleX_.data() + offset;
+		streams.scaleY = scaleY_.data() + offset;
+		streams.scaleZ = scaleZ_.data() + offset;
+		streams.rotateX = rotateX_.data() + offset;
+		streams.rotateY = rotateY_.data() + offset;
+		streams.rotateZ = rotateZ_.data() + offset;
+		streams.alpha = alpha_.data() + offset;
+		return streams;
+	}
+}
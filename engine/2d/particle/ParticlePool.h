@@ -0,0 +1,212 @@
+/*********************************************************************
+ * \file   ParticlePool.h
+ * \brief  固定容量のパーティクルプール（SoA）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   容量分の配列を初期化時に一括確保し、生成・消滅ではヒープ確保を行わない
+ *         消滅は末尾との入れ替えで削除するため、生存パーティクルは常に先頭から連続して並ぶ
+ *         積分と行列生成は ParticleKernel で一括処理する
+ *********************************************************************/
+#pragma once
+#include "Frustum.h"
+#include "MagMath.h"
+#include "ParticleConfig.h"
+#include "ParticleKernel.h"
+#include "Random.h"
+#include <cstdint>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	// Particle構造体
+	struct ParticleStr {
+		MagMath::Transform transform;
+		MagMath::Vector3 velocity;
+		MagMath::Vector4 color;
+		float lifeTime;
+		float currentTime;
+		MagMath::Vector3 initialScale;	  // 初期スケール
+		MagMath::Vector3 endScale;		  // 終了スケール
+		MagMath::Vector3 initialRotation; // 初期回転
+		MagMath::Vector3 endRotation;	  // 終了回転
+		MagMath::Vector3 gravity = {0.0f, -9.8f, 0.0f}; // 重力
+		float fadeInRatio = 0.1f;						 // フェードイン比率
+		float fadeOutRatio = 0.7f;						 // フェードアウト比率
+	};
+
+	struct ParticleForGPU {
+		MagMath::Matrix4x4 WVP;
+		MagMath::Matrix4x4 World;
+		MagMath::Vector4 color;
+	};
+
+	//========================================
+	// 並列更新の分割単位（パーティクル数）
+	constexpr uint32_t kParticleUpdateChunkSize = 512;
+
+	//========================================
+	// 更新パラメータ（グループ共通）
+	struct ParticleUpdateParams {
+		MagMath::Matrix4x4 billboardMatrix;		 // ビルボード行列（無効時は単位行列）
+		MagMath::Matrix4x4 viewProjectionMatrix; // ビュープロジェクション行列
+		float deltaTime;						 // 経過時間
+	};
+
+	//========================================
+	// カリングパラメータ（グループ共通）
+	// NOTE: 境界球はパーティクルの位置を中心に、形状の半径 * 最大スケールを半径とする
+	struct ParticleCullParams {
+		const Frustum *frustum;		  // 視錐台
+		MagMath::Vector3 eyePosition; // 描画距離の基準位置
+		float maxDistance;			  // 描画距離（0以下なら距離では除外しない）
+		float shapeRadius;			  // 形状の半径（スケール1のとき）
+	};
+
+	//========================================
+	// 生成用に前処理した設定（ParticleConfig から作成）
+	// NOTE: 乱数で決まる属性を「最小値 + 幅 * [0,1)の乱数」の形で列ごとにまとめる
+	struct ParticleSpawnRanges {
+		enum Attribute : uint32_t {
+			kTranslateX, kTranslateY, kTranslateZ,
+			kVelocityX, kVelocityY, kVelocityZ,
+			kColorR, kColorG, kColorB, kColorA,
+			kLifeTime,
+			kInitialScaleX, kInitialScaleY, kInitialScaleZ,
+			kEndScaleX, kEndScaleY, kEndScaleZ,
+			kInitialRotationX, kInitialRotationY, kInitialRotationZ,
+			kEndRotationX, kEndRotationY, kEndRotationZ,
+			kAttributeCount
+		};
+		float min[kAttributeCount];
+		float extent[kAttributeCount];
+		MagMath::Vector3 gravity;
+		float fadeInRatio;
+		float fadeOutRatio;
+
+		/// \brief 設定から作成（min > max の入れ替えと幅0の補正を行う）
+		static ParticleSpawnRanges FromConfig(const ParticleConfig &config);
+	};
+
+	///=============================================================================
+	///						パーティクルプール
+	class ParticlePool {
+		///--------------------------------------------------------------
+		///							メンバ関数
+	public:
+		/// \brief 初期化（容量分の配列を確保）
+		/// \param capacity 最大パーティクル数
+		void Initialize(uint32_t capacity);
+
+		/// \brief パーティクルを追加
+		/// \return 容量に空きがなく追加できなかった場合false
+		bool Push(const ParticleStr &particle);
+
+		/// \brief 設定に従ってパーティクルをまとめて生成
+		/// \param ranges 生成設定
+		/// \param position 生成位置
+		/// \param count 生成数（空きが足りない分は生成しない）
+		/// \param random 乱数ストリーム（属性ごとに spawnCount 個ずつ進む）
+		/// \return 生成した数
+		uint32_t Spawn(const ParticleSpawnRanges &ranges, const MagMath::Vector3 &position, uint32_t count, RandomStream &random);
+
+		/// \brief 指定インデックスのパーティクルを削除（末尾と入れ替え）
+		void Remove(uint32_t index);
+
+		/// \brief 全パーティクルを削除（確保済みの配列は保持）
+		void Clear() {
+			size_ = 0;
+		}
+
+		/// \brief 全パーティクルを更新し、インスタンシングデータを書き込む
+		/// \param params 更新パラメータ
+		/// \param outInstances 書き込み先（maxInstances 個まで）
+		/// \param maxInstances 書き込み先の容量
+		/// \return 書き込んだインスタンス数
+		/// \note 寿命の尽きたパーティクルは削除される
+		uint32_t Update(const ParticleUpdateParams &params, ParticleForGPU *outInstances, uint32_t maxInstances);
+
+		/// \brief 寿命の尽きたパーティクルを削除（末尾と入れ替え）
+		/// \note 並列更新の前に呼び出し、生存パーティクルを先頭から詰めておく
+		void RemoveExpired();
+
+		/// \brief [begin, end) のパーティクルを積分し、描画するかを判定する
+		/// \param params 更新パラメータ
+		/// \param begin 開始インデックス
+		/// \param end 終了インデックス（GetSize()を超える分は無視）
+		/// \param maxInstances 描画できる最大数（これ以降のインデックスは描画しない）
+		/// \param cull カリングパラメータ（nullptr ならカリングしない）
+		/// \return 描画する数と除外した数
+		/// \note 範囲が重ならなければ複数スレッドから同時に呼び出せる
+		CullResult IntegrateRange(const ParticleUpdateParams &params, uint32_t begin, uint32_t end, uint32_t maxInstances,
+								  const ParticleCullParams *cull = nullptr);
+
+		/// \brief IntegrateRange で描画すると判定した [begin, end) のパーティクルを書き込む
+		/// \param params 更新パラメータ（IntegrateRange と同じもの）
+		/// \param begin 開始インデックス
+		/// \param end 終了インデックス（IntegrateRange と同じもの）
+		/// \param maxInstances 描画できる最大数（IntegrateRange と同じもの）
+		/// \param outInstances 書き込み先（IntegrateRange が返した描画数だけ先頭から詰めて書き込む）
+		/// \note 範囲が重ならなければ複数スレッドから同時に呼び出せる
+		void WriteRange(const ParticleUpdateParams &params, uint32_t begin, uint32_t end, uint32_t maxInstances, ParticleForGPU *outInstances);
+
+		/// \brief [begin, end) のパーティクルを更新し、outInstances[begin, end) に書き込む
+		/// \param params 更新パラメータ
+		/// \param begin 開始インデックス
+		/// \param end 終了インデックス（GetSize()を超える分は無視）
+		/// \param outInstances 書き込み先の先頭（maxInstances 個まで）
+		/// \param maxInstances 書き込み先の容量
+		/// \param cull カリングパラメータ（nullptr ならカリングしない）
+		/// \return 書き込んだ数と除外した数（書き込みは outInstances[begin] から詰めて行う）
+		/// \note 範囲が重ならなければ複数スレッドから同時に呼び出せる
+		CullResult UpdateRange(const ParticleUpdateParams &params, uint32_t begin, uint32_t end, ParticleForGPU *outInstances, uint32_t maxInstances,
+							   const ParticleCullParams *cull = nullptr);
+
+	private:
+		/// \brief カーネルに渡す属性配列をまとめる
+		/// \param offset 先頭インデックス
+		ParticleKernel::Streams MakeStreams(uint32_t offset);
+
+		///--------------------------------------------------------------
+		///							入出力関数
+	public:
+		uint32_t GetSize() const {
+			return size_;
+		}
+		uint32_t GetCapacity() const {
+			return capacity_;
+		}
+		bool IsFull() const {
+			return size_ >= capacity_;
+		}
+
+		///--------------------------------------------------------------
+		///							メンバ変数
+	private:
+		uint32_t size_ = 0;
+		uint32_t capacity_ = 0;
+
+		//---------------------------------------
+		// パーティクルの属性（SoA）
+		std::vector<float> positionX_, positionY_, positionZ_;
+		std::vector<float> velocityX_, velocityY_, velocityZ_;
+		std::vector<float> colorR_, colorG_, colorB_, colorA_;
+		std::vector<float> lifeTime_;
+		std::vector<float> currentTime_;
+		std::vector<float> initialScaleX_, initialScaleY_, initialScaleZ_;
+		std::vector<float> endScaleX_, endScaleY_, endScaleZ_;
+		std::vector<float> initialRotationX_, initialRotationY_, initialRotationZ_;
+		std::vector<float> endRotationX_, endRotationY_, endRotationZ_;
+		std::vector<float> gravityX_, gravityY_, gravityZ_;
+		std::vector<float> fadeInRatio_, fadeOutRatio_;
+
+		//---------------------------------------
+		// 積分結果（毎フレーム上書きされる作業領域）
+		std::vector<float> scaleX_, scaleY_, scaleZ_;
+		std::vector<float> rotateX_, rotateY_, rotateZ_;
+		std::vector<float> alpha_;
+		// 描画するか（IntegrateRange が書き込み、WriteRange が読む）
+		std::vector<uint8_t> visible_;
+	};
+}
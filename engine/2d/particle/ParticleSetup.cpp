@@ -59,10 +59,10 @@ namespace MagEngine {
 		rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 		rootParameters[0].Descriptor.ShaderRegister = 0; // b0
 
-		rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+		// インスタンシングデータ（t0）はアップロードリング上のアドレスを直接渡す
+		rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
 		rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-		rootParameters[1].DescriptorTable.pDescriptorRanges = descriptorRangeForInstancing;
-		rootParameters[1].DescriptorTable.NumDescriptorRanges = _countof(descriptorRangeForInstancing);
+		rootParameters[1].Descriptor.ShaderRegister = 0; // t0
 
 		/// ===DescropterTable=== ///
 		rootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
@@ -32,7 +32,7 @@ namespace MagEngine {
 
 		// テクスチャの読み込みと設定
 		textureFilePath_ = textureFilePath;
-		TextureManager::GetInstance()->LoadTexture(textureFilePath);
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(textureFilePath);
 
 		// テクスチャのサイズに合わせて初期化
 		AdjustTextureSize();
@@ -106,12 +106,21 @@ namespace MagEngine {
 		commandList->SetGraphicsRootConstantBufferView(1, transformationMatrixBuffer_->GetGPUVirtualAddress());
 
 		// テクスチャの設定
-		commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureFilePath_));
+		commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_));
 
 		// 描画コール（インスタンス描画、6頂点 = 2三角形）
 		commandList->DrawIndexedInstanced(6, 1, 0, 0, 0);
 	}
 
+	///=============================================================================
+	///                        テクスチャの差し替え
+	Sprite *Sprite::SetTexture(const std::string &textureFilePath) {
+		textureFilePath_ = textureFilePath;
+		// NOTE: 文字列の検索はここで1度だけ行い、描画時はハンドルで参照する
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(textureFilePath);
+		return this;
+	}
+
 	///=============================================================================
 	///                        便利機能
 	///=============================================================================
@@ -312,7 +321,7 @@ namespace MagEngine {
 	///                    テクスチャ範囲の反映
 	void Sprite::ReflectTextureRange() {
 		// テクスチャメタデータの取得
-		const DirectX::TexMetadata &metadata = TextureManager::GetInstance()->GetMetadata(textureFilePath_);
+		const DirectX::TexMetadata &metadata = TextureManager::GetInstance()->GetMetadata(textureHandle_);
 
 		// テクスチャのサイズ
 		float textureWidth = static_cast<float>(metadata.width);
@@ -335,7 +344,7 @@ namespace MagEngine {
 	///                    テクスチャサイズをスプライトに統合
 	void Sprite::AdjustTextureSize() {
 		// テクスチャメタデータの取得
-		const DirectX::TexMetadata &metadata = TextureManager::GetInstance()->GetMetadata(textureFilePath_);
+		const DirectX::TexMetadata &metadata = TextureManager::GetInstance()->GetMetadata(textureHandle_);
 
 		// テクスチャの幅と高さ
 		float textureWidth = static_cast<float>(metadata.width);
@@ -28,6 +28,7 @@
 //========================================
 // 自作
 #include "MagMath.h"
+#include "TextureHandle.h"
 
 ///=============================================================================
 ///                        namespace MagEngine
@@ -179,12 +180,9 @@ namespace MagEngine {
 		 * \brief  SetTexture テクスチャの差し替え
 		 * \param  textureFilePath テクスチャファイルパス
 		 * \return this メソッドチェーン用
-		 * \note   動的にテクスチャを変更する場合に使用
+		 * \note   動的にテクスチャを変更する場合に使用。未読み込みのテクスチャは読み込む
 		 */
-		Sprite *SetTexture(const std::string &textureFilePath) {
-			this->textureFilePath_ = textureFilePath;
-			return this;
-		}
+		Sprite *SetTexture(const std::string &textureFilePath);
 
 		/**----------------------------------------------------------------------------
 		 * \brief  SetTextureRect テクスチャ矩形範囲の設定
@@ -408,6 +406,7 @@ namespace MagEngine {
 		///---------------------------------------
 		/// テクスチャ
 		std::string textureFilePath_ = "";	  // テクスチャファイルパス
+		TextureHandle textureHandle_;		  // テクスチャハンドル（描画時はこちらで参照）
 
 		///---------------------------------------
 		/// 表示設定
@@ -0,0 +1,26 @@
+/*********************************************************************
+ * \file   TextureHandle.h
+ * \brief  テクスチャハンドル
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   TextureManager のテクスチャ表の番号。読み込み時に1度だけ文字列で引き、以降はこの番号で参照する
+ *         テクスチャは解放しないため、番号はアプリケーション終了まで変わらない
+ *********************************************************************/
+#pragma once
+#include <cstdint>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						テクスチャハンドル
+	struct TextureHandle {
+		static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+		uint32_t index = kInvalidIndex; ///< テクスチャ表の番号
+
+		bool IsValid() const {
+			return index != kInvalidIndex;
+		}
+	};
+}
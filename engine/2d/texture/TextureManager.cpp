@@ -29,7 +29,8 @@ namespace MagEngine {
 	void TextureManager::Initialize(DirectXCore *dxCore, const std::string &textureDirectoryPath, SrvSetup *srvSetup) {
 		//---------------------------------------
 		// SRVの数と同期
-		textureDatas_.reserve(SrvSetup::kMaxSRVCount_);
+		textures_.reserve(SrvSetup::kMaxSRVCount_);
+		textureHandles_.reserve(SrvSetup::kMaxSRVCount_);
 		//---------------------------------------
 		// 引数でdxManagerを受取
 		dxCore_ = dxCore;
@@ -45,19 +46,67 @@ namespace MagEngine {
 
 	///=============================================================================
 	///						テクスチャファイルの読み込み
-	void TextureManager::LoadTexture(const std::string &filePath) {
+	TextureHandle TextureManager::LoadTexture(const std::string &filePath) {
 		// ディレクトリパスを追加
 		std::string fullPath = kTextureDirectoryPath + filePath;
 
 		//---------------------------------------
 		// 読み込み済みテクスチャを検索
-		if (textureDatas_.contains(fullPath)) {
-			return;
+		auto loaded = textureHandles_.find(fullPath);
+		if (loaded != textureHandles_.end()) {
+			return loaded->second;
+		}
+		//---------------------------------------
+		// 非同期読み込み中なら完了を待つ
+		auto pending = pendingTextures_.find(fullPath);
+		if (pending != pendingTextures_.end()) {
+			AssetLoadHandle handle = pending->second;
+			AssetLoader::GetInstance()->Wait(handle);
+			return textureHandles_.at(fullPath);
+		}
+
+		//---------------------------------------
+		// デコードして登録
+		DirectX::ScratchImage mipImages{};
+		DecodeTexture(filePath, mipImages);
+		return RegisterTexture(filePath, mipImages);
+	}
+
+	///=============================================================================
+	///						テクスチャファイルの非同期読み込み
+	AssetLoadHandle TextureManager::LoadTextureAsync(const std::string &filePath) {
+		// ディレクトリパスを追加
+		std::string fullPath = kTextureDirectoryPath + filePath;
+		//---------------------------------------
+		// 読み込み済み・読み込み中の場合はそのハンドル
+		if (textureHandles_.contains(fullPath)) {
+			return AssetLoadHandle::MakeReady();
+		}
+		auto pending = pendingTextures_.find(fullPath);
+		if (pending != pendingTextures_.end()) {
+			return pending->second;
 		}
 
 		//---------------------------------------
-		// SRVの空きがあるかチェック
-		assert(srvSetup_->IsFull() == false);
+		// デコードはワーカー、登録はメインスレッドで行う
+		auto image = std::make_shared<DirectX::ScratchImage>();
+		AssetLoadHandle handle = AssetLoader::GetInstance()->Enqueue(
+			[this, filePath, image]() {
+				DecodeTexture(filePath, *image);
+			},
+			[this, filePath, fullPath, image]() {
+				RegisterTexture(filePath, *image);
+				pendingTextures_.erase(fullPath);
+			});
+		pendingTextures_[fullPath] = handle;
+		return handle;
+	}
+
+	///=============================================================================
+	///						テクスチャのデコード
+	void TextureManager::DecodeTexture(const std::string &filePath, DirectX::ScratchImage &outImage) const {
+		// ディレクトリパスを追加
+		std::string fullPath = kTextureDirectoryPath + filePath;
 
 		//---------------------------------------
 		// テクスチャファイルを読んでプログラムを扱えるようにする
@@ -87,32 +136,122 @@ namespace MagEngine {
 
 		//---------------------------------------
 		// mipmapの作成
-		DirectX::ScratchImage mipImages{};
 		// 圧縮フォーマットまたはキューブマップの場合はミップマップ生成をスキップ
 		if (DirectX::IsCompressed(image.GetMetadata().format) || image.GetMetadata().IsCubemap()) {
-			mipImages = std::move(image);
+			outImage = std::move(image);
 		} else {
 			// mipmapの生成
-			hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 0, mipImages);
+			hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 0, outImage);
 			assert(SUCCEEDED(hr));
 		}
+	}
+
+	///=============================================================================
+	///						デコード済みテクスチャの登録
+	TextureHandle TextureManager::RegisterTexture(const std::string &filePath, DirectX::ScratchImage &mipImages) {
+		// ディレクトリパスを追加
+		std::string fullPath = kTextureDirectoryPath + filePath;
+		//---------------------------------------
+		// 読み込み済みテクスチャを検索
+		auto loaded = textureHandles_.find(fullPath);
+		if (loaded != textureHandles_.end()) {
+			return loaded->second;
+		}
+
+		//---------------------------------------
+		// SRVの確保（空きが無ければ登録しない）
+		uint32_t srvIndex = srvSetup_->Allocate(DescriptorCategory::Texture);
+		assert(srvIndex != DescriptorAllocator::kInvalidIndex);
+		if (srvIndex == DescriptorAllocator::kInvalidIndex) {
+			return TextureHandle{};
+		}
 
 		//---------------------------------------
-		// 追加したテクスチャデータの参照を取得する
-		TextureData &textureData = textureDatas_[fullPath];
+		// テクスチャ表の末尾に追加し、その番号をハンドルとする
+		TextureHandle handle{static_cast<uint32_t>(textures_.size())};
+		textures_.emplace_back();
+		{
+			std::lock_guard<std::mutex> lock(textureHandlesMutex_);
+			textureHandles_.emplace(fullPath, handle);
+		}
+		TextureData &textureData = textures_.back();
+
+		BuildTextureData(textureData, mipImages, srvIndex);
+		return handle;
+	}
+
+	///=============================================================================
+	///						テクスチャの差し替え
+	bool TextureManager::ReloadTexture(const std::string &filePath) {
+		// NOTE: レンダーテクスチャは差し替えない
+		TextureHandle handle = GetTextureHandle(filePath);
+		if (!handle.IsValid() || handle.index == renderTextureHandles_[0].index || handle.index == renderTextureHandles_[1].index) {
+			return false;
+		}
+
+		//---------------------------------------
+		// 新しいSRVを確保してから差し替える（確保できなければ元のテクスチャを残す）
+		DirectX::ScratchImage mipImages{};
+		DecodeTexture(filePath, mipImages);
+		uint32_t srvIndex = srvSetup_->Allocate(DescriptorCategory::Texture);
+		if (srvIndex == DescriptorAllocator::kInvalidIndex) {
+			return false;
+		}
 
+		//---------------------------------------
+		// 古いリソースとSRVは、記録済みのコマンドが参照し終えるまで再利用しない
+		ReleaseRetiredResources();
+		TextureData &textureData = textures_[handle.index];
+		retiredResources_.push_back({std::move(textureData.resource), std::move(textureData.interMediateResource), dxCore_->GetCurrentFrameFenceValue()});
+		srvSetup_->Free(textureData.srvIndex);
+
+		// ハンドルは変えずに中身を差し替える
+		BuildTextureData(textureData, mipImages, srvIndex);
+		return true;
+	}
+
+	///=============================================================================
+	///						読み込み済みテクスチャを全て差し替え
+	uint32_t TextureManager::ReloadAllTextures() {
+		// NOTE: 差し替え中に textureHandles_ は変わらないが、念のためパスを先に集める
+		std::vector<std::string> filePaths;
+		filePaths.reserve(textureHandles_.size());
+		for (const auto &[fullPath, handle] : textureHandles_) {
+			if (fullPath.starts_with(kTextureDirectoryPath)) {
+				filePaths.push_back(fullPath.substr(kTextureDirectoryPath.size()));
+			}
+		}
+		uint32_t reloadedCount = 0;
+		for (const std::string &filePath : filePaths) {
+			if (ReloadTexture(filePath)) {
+				++reloadedCount;
+			}
+		}
+		return reloadedCount;
+	}
+
+	///=============================================================================
+	///						GPUが参照し終えたリソースの解放
+	void TextureManager::ReleaseRetiredResources() {
+		const uint64_t completedFenceValue = dxCore_->GetCompletedFenceValue();
+		while (!retiredResources_.empty() && retiredResources_.front().fenceValue <= completedFenceValue) {
+			retiredResources_.pop_front();
+		}
+	}
+
+	///=============================================================================
+	///						テクスチャのリソースとSRVを作成
+	void TextureManager::BuildTextureData(TextureData &textureData, DirectX::ScratchImage &mipImages, uint32_t srvIndex) {
 		//---------------------------------------
 		// テクスチャデータの書き込
 		// テクスチャメタデータの取得
 		textureData.metadata = mipImages.GetMetadata();
 		// テクスチャリソースの作成
 		textureData.resource = dxCore_->CreateTextureResource(textureData.metadata);
-		// テクスチャデータの要素数番号をSRVのインデックスとする
-		// uint32_t srvIndex = srvSetup_->Allocate();
 		// 中間リソース
 		textureData.interMediateResource = dxCore_->UploadTextureData(textureData.resource, mipImages);
-		// SRVの確保
-		textureData.srvIndex = srvSetup_->Allocate();
+		// SRVのインデックス
+		textureData.srvIndex = srvIndex;
 		// 各ハンドルを取得
 		textureData.srvHandleCPU = srvSetup_->GetSRVCPUDescriptorHandle(textureData.srvIndex);
 		textureData.srvHandleGPU = srvSetup_->GetSRVGPUDescriptorHandle(textureData.srvIndex);
@@ -147,87 +286,79 @@ namespace MagEngine {
 	}
 
 	///=============================================================================
-	///					SRVテクスチャインデックスの開始番号
-	uint32_t TextureManager::GetTextureIndex(const std::string &filePath) {
-		// ディレクトリパスを追加
-		std::string fullPath = kTextureDirectoryPath + filePath;
+	///						登録済みか
+	bool TextureManager::IsTextureLoaded(const std::string &filePath) const {
+		std::lock_guard<std::mutex> lock(textureHandlesMutex_);
+		return textureHandles_.contains(kTextureDirectoryPath + filePath);
+	}
 
-		if (textureDatas_.contains(fullPath)) {
-			// 読み込み済みなら要素番号を返す
-			auto it = textureDatas_.find(fullPath);
-			uint32_t textureIndex = static_cast<uint32_t>(std::distance(textureDatas_.begin(), it));
-			return textureIndex;
+	///=============================================================================
+	///						ハンドルの取得
+	TextureHandle TextureManager::GetTextureHandle(const std::string &filePath) const {
+		// レンダーテクスチャは名前のまま、通常のテクスチャはディレクトリパスを追加
+		if (filePath == "RenderTexture0" || filePath == "RenderTexture1") {
+			return renderTextureHandles_[filePath.back() - '0'];
+		}
+		auto it = textureHandles_.find(kTextureDirectoryPath + filePath);
+		if (it == textureHandles_.end()) {
+			return TextureHandle{};
 		}
+		return it->second;
+	}
+
+	///=============================================================================
+	///					SRVテクスチャインデックスの取得
+	uint32_t TextureManager::GetTextureIndex(const std::string &filePath) {
+		TextureHandle handle = GetTextureHandle(filePath);
 		//---------------------------------------
 		// 検索化ヒットしない場合は停止
-		assert(0);
-		return 0;
+		assert(handle.IsValid());
+		return GetSrvIndex(handle);
 	}
 
 	///=============================================================================
 	///						GPUハンドルの取得
 	D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleGPU(const std::string &filePath) {
-		// ディレクトリパスを追加
-		std::string fullPath = kTextureDirectoryPath + filePath;
-		// レンダーテクスチャの場合は特別処理
-		if (filePath == "RenderTexture0" || filePath == "RenderTexture1") {
-			fullPath = filePath;
-		} else {
-			// 通常のテクスチャの場合はディレクトリパスを追加
-			fullPath = kTextureDirectoryPath + filePath;
-		}
+		TextureHandle handle = GetTextureHandle(filePath);
 		// 範囲外指定チェック
-		assert(textureDatas_.contains(fullPath));
-		// テクスチャデータの参照を取得
-		TextureData &textureData = textureDatas_[fullPath];
-		return textureData.srvHandleGPU;
+		assert(handle.IsValid());
+		return GetSrvHandleGPU(handle);
 	}
 
 	///=============================================================================
 	///						CPUハンドルの取得
 	D3D12_CPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleCPU(const std::string &filePath) {
-		// ディレクトリパスを追加
-		std::string fullPath = kTextureDirectoryPath + filePath;
-		// レンダーテクスチャの場合は特別処理
-		if (filePath == "RenderTexture0" || filePath == "RenderTexture1") {
-			fullPath = filePath;
-		} else {
-			// 通常のテクスチャの場合はディレクトリパスを追加
-			fullPath = kTextureDirectoryPath + filePath;
-		}
+		TextureHandle handle = GetTextureHandle(filePath);
 		// 範囲外指定チェック
-		assert(textureDatas_.contains(fullPath));
-		// テクスチャデータの参照を取得
-		TextureData &textureData = textureDatas_[fullPath];
-		return textureData.srvHandleCPU;
+		assert(handle.IsValid());
+		return GetSrvHandleCPU(handle);
 	}
 
 	///=============================================================================
 	///						メタデータの取得
 	const DirectX::TexMetadata &TextureManager::GetMetadata(const std::string &filePath) {
-		// ディレクトリパスを追加
-		std::string fullPath = kTextureDirectoryPath + filePath;
+		TextureHandle handle = GetTextureHandle(filePath);
 		// 範囲外指定チェック
-		assert(textureDatas_.contains(fullPath));
-		// テクスチャデータの参照を取得
-		TextureData &textureData = textureDatas_[fullPath];
-		return textureData.metadata;
+		assert(handle.IsValid());
+		return GetMetadata(handle);
 	}
 
 	///=============================================================================
 	///				レンダーテクスチャ用メタデータの作成
 	void TextureManager::CreateRenderTextureMetaData() {
-		TextureData &textureData1 = textureDatas_["RenderTexture0"];
+		renderTextureHandles_[0] = TextureHandle{static_cast<uint32_t>(textures_.size())};
+		TextureData &textureData1 = textures_.emplace_back();
 
-		textureData1.srvIndex = srvSetup_->Allocate();
+		textureData1.srvIndex = srvSetup_->Allocate(DescriptorCategory::RenderTexture);
 		textureData1.srvHandleCPU = srvSetup_->GetSRVCPUDescriptorHandle(textureData1.srvIndex);
 		textureData1.srvHandleGPU = srvSetup_->GetSRVGPUDescriptorHandle(textureData1.srvIndex);
 
 		srvSetup_->CreateOffScreenTexture(textureData1.srvIndex, 0);
 
-		TextureData &textureData2 = textureDatas_["RenderTexture1"];
+		renderTextureHandles_[1] = TextureHandle{static_cast<uint32_t>(textures_.size())};
+		TextureData &textureData2 = textures_.emplace_back();
 
-		textureData2.srvIndex = srvSetup_->Allocate();
+		textureData2.srvIndex = srvSetup_->Allocate(DescriptorCategory::RenderTexture);
 		textureData2.srvHandleCPU = srvSetup_->GetSRVCPUDescriptorHandle(textureData2.srvIndex);
 		textureData2.srvHandleGPU = srvSetup_->GetSRVGPUDescriptorHandle(textureData2.srvIndex);
 		srvSetup_->CreateOffScreenTexture(textureData2.srvIndex, 1);
@@ -4,13 +4,20 @@
  *
  * \author Harukichimaru
  * \date   October 2024
+ * \note   テクスチャは密な配列で持ち、TextureHandle（配列の番号）で O(1) に参照する
+ *         文字列での検索は読み込み時（ハンドルの取得時）だけにし、描画毎には行わないこと
  *********************************************************************/
 #pragma once
+#include "AssetLoader.h"
 #include "DirectXCore.h"
 #include "SrvSetup.h"
+#include "TextureHandle.h"
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 ///=============================================================================
 ///                        namespace MagEngine
 namespace MagEngine {
@@ -51,7 +58,83 @@ namespace MagEngine {
 
 		/// @brief LoadTexture テクスチャファイルの読み込み
 		/// @param filePath ファイルパス
-		void LoadTexture(const std::string &filePath);
+		/// @return テクスチャハンドル
+		/// @note 非同期読み込み中のテクスチャは完了を待つ。読み込み済みの場合はそのハンドルを返す
+		TextureHandle LoadTexture(const std::string &filePath);
+
+		/// @brief LoadTextureAsync テクスチャファイルの非同期読み込み
+		/// @param filePath ファイルパス
+		/// @return 読み込みハンドル（SRVの生成まで終わると Ready）
+		AssetLoadHandle LoadTextureAsync(const std::string &filePath);
+
+		/// @brief DecodeTexture テクスチャファイルをデコードしてミップマップを作成
+		/// @param filePath ファイルパス
+		/// @param outImage [out] デコード結果
+		/// @note GPUに触れないため、ワーカースレッドから呼んでよい
+		void DecodeTexture(const std::string &filePath, DirectX::ScratchImage &outImage) const;
+
+		/// @brief RegisterTexture デコード済みのテクスチャからリソースとSRVを作成して登録
+		/// @param filePath ファイルパス
+		/// @param image デコード結果
+		/// @return テクスチャハンドル
+		/// @note 登録済みの場合は何もしない。メインスレッドから呼ぶこと
+		TextureHandle RegisterTexture(const std::string &filePath, DirectX::ScratchImage &image);
+
+		/// @brief ReloadTexture 読み込み済みテクスチャをファイルから読み直して差し替える
+		/// @param filePath ファイルパス
+		/// @return 差し替えた場合 true（未読み込み・レンダーテクスチャ・SRVの空きが無い場合は false）
+		/// @note ハンドルは変わらない。古いリソースとSRVは現フレームのコマンド完了後に解放する
+		bool ReloadTexture(const std::string &filePath);
+
+		/// @brief ReloadAllTextures 読み込み済みテクスチャを全て差し替える
+		/// @return 差し替えた数
+		uint32_t ReloadAllTextures();
+
+		/// @brief IsTextureLoaded テクスチャが登録済みか
+		/// @param filePath ファイルパス
+		/// @note ワーカースレッドから呼んでよい（非同期読み込みで登録済みのテクスチャのデコードを省くため）
+		bool IsTextureLoaded(const std::string &filePath) const;
+
+		/// @brief GetTextureHandle 読み込み済みテクスチャのハンドルを取得
+		/// @param filePath ファイルパス（"RenderTexture0" / "RenderTexture1" も可）
+		/// @return テクスチャハンドル（未読み込みの場合は無効なハンドル）
+		/// @note 文字列を検索するため、描画毎ではなく読み込み時に呼ぶこと
+		TextureHandle GetTextureHandle(const std::string &filePath) const;
+
+		/// @brief GetRenderTextureHandle レンダーテクスチャのハンドルを取得
+		/// @param index レンダーテクスチャ番号（0 / 1）
+		TextureHandle GetRenderTextureHandle(uint32_t index) const {
+			assert(index < 2);
+			return renderTextureHandles_[index];
+		}
+
+		/// @brief GetSrvHandleGPU GPUハンドルの取得
+		/// @param handle テクスチャハンドル
+		D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(TextureHandle handle) const {
+			assert(handle.index < textures_.size());
+			return textures_[handle.index].srvHandleGPU;
+		}
+
+		/// @brief GetSrvHandleCPU CPUハンドルの取得
+		/// @param handle テクスチャハンドル
+		D3D12_CPU_DESCRIPTOR_HANDLE GetSrvHandleCPU(TextureHandle handle) const {
+			assert(handle.index < textures_.size());
+			return textures_[handle.index].srvHandleCPU;
+		}
+
+		/// @brief GetMetadata メタデータの取得
+		/// @param handle テクスチャハンドル
+		const DirectX::TexMetadata &GetMetadata(TextureHandle handle) const {
+			assert(handle.index < textures_.size());
+			return textures_[handle.index].metadata;
+		}
+
+		/// @brief GetSrvIndex SRVインデックスの取得
+		/// @param handle テクスチャハンドル
+		uint32_t GetSrvIndex(TextureHandle handle) const {
+			assert(handle.index < textures_.size());
+			return textures_[handle.index].srvIndex;
+		}
 
 		/// @brief Finalize 終了処理
 		void Finalize();
@@ -59,26 +142,41 @@ namespace MagEngine {
 		/// @brief GetTextureIndex テクスチャのSRVインデックスを取得
 		/// @param filePath ファイルパス
 		/// @return SRVインデックス
+		/// @note 文字列を検索する。描画毎に呼ぶ場合はハンドル版を使うこと
 		uint32_t GetTextureIndex(const std::string &filePath);
 
 		/// @brief GetSrvHandleGPU GPUハンドルの取得
 		/// @param filePath ファイルパス
 		/// @return GPUハンドル
+		/// @note 文字列を検索する。描画毎に呼ぶ場合はハンドル版を使うこと
 		D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(const std::string &filePath);
 
 		/// @brief GetSrvHandleCPU CPUハンドルの取得
 		/// @param filePath ファイルパス
 		/// @return CPUハンドル
+		/// @note 文字列を検索する。描画毎に呼ぶ場合はハンドル版を使うこと
 		D3D12_CPU_DESCRIPTOR_HANDLE GetSrvHandleCPU(const std::string &filePath);
 
 		/// @brief GetMetadata テクスチャのメタデータを取得
 		/// @param filePath ファイルパス
 		/// @return
+		/// @note 文字列を検索する。描画毎に呼ぶ場合はハンドル版を使うこと
 		const DirectX::TexMetadata &GetMetadata(const std::string &filePath);
 
 		/// @brief CreateRenderTextureMetaData レンダーテクスチャのメタデータを生成
 		void CreateRenderTextureMetaData();
 
+	private:
+		/// @brief BuildTextureData デコード結果からリソースとSRVを作成してテクスチャデータに書き込む
+		/// @param textureData [out] 書き込み先
+		/// @param mipImages デコード結果
+		/// @param srvIndex 確保済みのSRVインデックス
+		void BuildTextureData(TextureData &textureData, DirectX::ScratchImage &mipImages, uint32_t srvIndex);
+
+		/// @brief ReleaseRetiredResources GPUが参照し終えた差し替え前のリソースを解放
+		void ReleaseRetiredResources();
+
+	public:
 		///--------------------------------------------------------------
 		///							 メンバ変数
 		//========================================
@@ -100,8 +198,24 @@ namespace MagEngine {
 		// DirectXCoreポインタ
 		DirectXCore *dxCore_ = nullptr;
 		//========================================
-		// テクスチャデータ
-		std::unordered_map<std::string, TextureData> textureDatas_;
+		// テクスチャデータ（ハンドルの番号で参照する密な配列）
+		// NOTE: 参照を返すため、初期化時に SRV 上限まで reserve して再確保させない
+		std::vector<TextureData> textures_;
+		// パス（レンダーテクスチャは名前）からハンドルへの対応（読み込み時のみ使用）
+		std::unordered_map<std::string, TextureHandle> textureHandles_;
+		// textureHandles_ への追加とワーカースレッドからの検索を排他する（メインスレッドの検索には不要）
+		mutable std::mutex textureHandlesMutex_;
+		// レンダーテクスチャのハンドル
+		TextureHandle renderTextureHandles_[2];
+		// 非同期読み込み中のテクスチャ
+		std::unordered_map<std::string, AssetLoadHandle> pendingTextures_;
+		// 差し替え前のリソース（fenceValue の完了まで保持する）
+		struct RetiredResource {
+			Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+			Microsoft::WRL::ComPtr<ID3D12Resource> interMediateResource;
+			uint64_t fenceValue;
+		};
+		std::deque<RetiredResource> retiredResources_;
 		//========================================
 		// SRVインデックスの開始番号
 		// NOTE:ImGuiが使っている番号を開けてその後ろのSRVヒープ1番から使用する
@@ -0,0 +1,133 @@
+#include "CullingManager.h"
+#include "Camera.h"
+#include "ImguiSetup.h"
+#include <algorithm>
+#include <string>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						インスタンスの取得
+	CullingManager *CullingManager::GetInstance() {
+		static CullingManager instance;
+		return &instance;
+	}
+
+	///=============================================================================
+	///						フレーム開始
+	void CullingManager::BeginFrame(const Camera *camera) {
+		//========================================
+		// 前フレームの集計を保存してリセット
+		for (uint32_t i = 0; i < kCategoryCount; ++i) {
+			lastStats_[i] = currentStats_[i];
+			currentStats_[i] = Stats{};
+		}
+		//========================================
+		// 視錐台の更新
+		hasFrustum_ = camera != nullptr;
+		if (hasFrustum_) {
+			frustum_ = Frustum::FromViewProjection(camera->GetViewProjectionMatrix());
+			eyePosition_ = camera->GetTranslate();
+		}
+	}
+
+	///=============================================================================
+	///						境界球1件の判定
+	bool CullingManager::IsVisible(CullingCategory category, const MagMath::BoundingSphere &worldSphere) {
+		Stats &stats = currentStats_[static_cast<uint32_t>(category)];
+		++stats.testedCount;
+		if (!IsEnabled()) {
+			++stats.visibleCount;
+			return true;
+		}
+		const SphereStreams spheres = {&worldSphere.center.x, &worldSphere.center.y, &worldSphere.center.z, &worldSphere.radius};
+		uint8_t isVisible = 0;
+		const CullResult result = frustum_.CullSpheresScalar(spheres, 0, 1, eyePosition_, GetMaxDistance(category), &isVisible);
+		stats.visibleCount += result.visibleCount;
+		stats.frustumCulledCount += result.frustumCulledCount;
+		stats.distanceCulledCount += result.distanceCulledCount;
+		return isVisible != 0;
+	}
+
+	///=============================================================================
+	///						境界球の一括判定
+	uint32_t CullingManager::CullSpheres(CullingCategory category, const SphereStreams &spheres, uint32_t count, uint8_t *outVisible) {
+		CullResult result;
+		if (IsEnabled()) {
+			result = frustum_.CullSpheres(spheres, count, eyePosition_, GetMaxDistance(category), outVisible);
+		} else {
+			std::fill(outVisible, outVisible + count, uint8_t(1));
+			result.visibleCount = count;
+		}
+		RecordResult(category, count, result);
+		return result.visibleCount;
+	}
+
+	///=============================================================================
+	///						判定結果の集計
+	void CullingManager::RecordResult(CullingCategory category, uint32_t testedCount, const CullResult &result) {
+		Stats &stats = currentStats_[static_cast<uint32_t>(category)];
+		stats.testedCount += testedCount;
+		stats.visibleCount += result.visibleCount;
+		stats.frustumCulledCount += result.frustumCulledCount;
+		stats.distanceCulledCount += result.distanceCulledCount;
+	}
+
+	///=============================================================================
+	///						ImGuiの描画
+	void CullingManager::DrawImGui() {
+		ImGui::Begin("Culling");
+		ImGui::Checkbox("Enabled", &isEnabled_);
+		ImGui::SameLine();
+		ImGui::Text("(%s)", Frustum::GetInstructionSetName());
+		//========================================
+		// 描画距離
+		for (uint32_t i = 0; i < kCategoryCount; ++i) {
+			const std::string label = std::string("Max Distance ") + GetCategoryName(static_cast<CullingCategory>(i));
+			ImGui::DragFloat(label.c_str(), &maxDistances_[i], 1.0f, 0.0f, 1000.0f);
+		}
+		ImGui::Separator();
+		//========================================
+		// 用途ごとの除外数（前フレーム）
+		if (ImGui::BeginTable("CullingStats", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Category");
+			ImGui::TableSetupColumn("Tested");
+			ImGui::TableSetupColumn("Visible");
+			ImGui::TableSetupColumn("Frustum");
+			ImGui::TableSetupColumn("Distance");
+			ImGui::TableHeadersRow();
+			for (uint32_t i = 0; i < kCategoryCount; ++i) {
+				const Stats &stats = lastStats_[i];
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(GetCategoryName(static_cast<CullingCategory>(i)));
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.testedCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.visibleCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.frustumCulledCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.distanceCulledCount);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::End();
+	}
+
+	///=============================================================================
+	///						用途の表示名
+	const char *CullingManager::GetCategoryName(CullingCategory category) {
+		switch (category) {
+		case CullingCategory::Object3d:
+			return "Object3d";
+		case CullingCategory::Particle:
+			return "Particle";
+		case CullingCategory::Trail:
+			return "Trail";
+		default:
+			return "Unknown";
+		}
+	}
+}
@@ -0,0 +1,121 @@
+/*********************************************************************
+ * \file   CullingManager.h
+ * \brief  視錐台・描画距離カリングの管理
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   フレーム開始時（カメラ更新後）に現在のカメラから視錐台を1度だけ求め、
+ *         Object3d・パーティクル・トレイルの各描画処理が境界球の一括判定で描画リストを絞り込む
+ *         除外数は用途ごとに集計し、前フレームの値を ImGui に表示する
+ *********************************************************************/
+#pragma once
+#include "Frustum.h"
+#include <cstdint>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	class Camera;
+
+	///=============================================================================
+	///						カリングの用途（集計用）
+	enum class CullingCategory : uint32_t {
+		Object3d, // 3Dオブジェクト
+		Particle, // パーティクル
+		Trail,	  // トレイル
+		Count
+	};
+
+	///=============================================================================
+	///						カリング管理クラス
+	class CullingManager {
+		///--------------------------------------------------------------
+		///							メンバ関数
+	public:
+		/// \brief 用途ごとの集計
+		struct Stats {
+			uint32_t testedCount = 0;		  // 判定した数
+			uint32_t visibleCount = 0;		  // 描画した数
+			uint32_t frustumCulledCount = 0;  // 視錐台の外で除外した数
+			uint32_t distanceCulledCount = 0; // 描画距離の外で除外した数
+		};
+
+		/// \brief インスタンスの取得
+		static CullingManager *GetInstance();
+
+		/// \brief フレーム開始（視錐台の更新と集計のリセット）
+		/// \param camera 現在のカメラ（nullptr の場合はこのフレームは全て描画する）
+		/// \note カメラの更新後、各描画処理より前に1度だけ呼ぶ
+		void BeginFrame(const Camera *camera);
+
+		/// \brief 境界球1件の判定（集計に含める）
+		/// \param category 用途
+		/// \param worldSphere ワールド座標の境界球
+		/// \return 描画するなら true
+		bool IsVisible(CullingCategory category, const MagMath::BoundingSphere &worldSphere);
+
+		/// \brief 境界球の一括判定（集計に含める）
+		/// \param category 用途
+		/// \param spheres ワールド座標の境界球の配列
+		/// \param count 件数
+		/// \param outVisible [out] 描画するなら1、除外するなら0（count 個）
+		/// \return 描画する数
+		uint32_t CullSpheres(CullingCategory category, const SphereStreams &spheres, uint32_t count, uint8_t *outVisible);
+
+		/// \brief 独自の視錐台で判定した結果を集計に加える
+		/// \note ワーカースレッドで判定した結果は、メインスレッドでまとめてから渡すこと
+		void RecordResult(CullingCategory category, uint32_t testedCount, const CullResult &result);
+
+		/// \brief ImGuiの描画
+		void DrawImGui();
+
+		/// \brief 用途の表示名
+		static const char *GetCategoryName(CullingCategory category);
+
+		///--------------------------------------------------------------
+		///							入出力関数
+	public:
+		/// \brief カリングの有効/無効（無効の場合は判定せず全て描画する）
+		bool IsEnabled() const {
+			return isEnabled_ && hasFrustum_;
+		}
+		void SetEnabled(bool isEnabled) {
+			isEnabled_ = isEnabled;
+		}
+		/// \brief 現在のカメラの視錐台
+		const Frustum &GetFrustum() const {
+			return frustum_;
+		}
+		/// \brief 描画距離の基準位置（現在のカメラの位置）
+		const MagMath::Vector3 &GetEyePosition() const {
+			return eyePosition_;
+		}
+		/// \brief 描画距離（0以下なら距離では除外しない）
+		float GetMaxDistance(CullingCategory category) const {
+			return maxDistances_[static_cast<uint32_t>(category)];
+		}
+		void SetMaxDistance(CullingCategory category, float maxDistance) {
+			maxDistances_[static_cast<uint32_t>(category)] = maxDistance;
+		}
+		/// \brief 前フレームの集計
+		const Stats &GetStats(CullingCategory category) const {
+			return lastStats_[static_cast<uint32_t>(category)];
+		}
+
+		///--------------------------------------------------------------
+		///							メンバ変数
+	private:
+		static constexpr uint32_t kCategoryCount = static_cast<uint32_t>(CullingCategory::Count);
+
+		Frustum frustum_;
+		MagMath::Vector3 eyePosition_ = {0.0f, 0.0f, 0.0f};
+		bool hasFrustum_ = false;
+		bool isEnabled_ = true;
+
+		// NOTE: カメラのファー平面（既定100）で遠方は除外されるため、小さなパーティクルのみ手前で打ち切る
+		float maxDistances_[kCategoryCount] = {0.0f, 60.0f, 0.0f};
+
+		Stats currentStats_[kCategoryCount] = {};
+		Stats lastStats_[kCategoryCount] = {};
+	};
+}
@@ -0,0 +1,205 @@
+#include "Frustum.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE4_1__) || defined(__AVX2__) || defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__)
+// NOTE: x64はSSE2が必ず使えるため、SSEパスを既定とする
+#define FRUSTUM_CULLING_SSE
+#include <immintrin.h>
+#endif
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	namespace {
+		//========================================
+		// 行列の2列の和から平面を作り正規化する（法線の長さで d も割る）
+		// NOTE: 行ベクトル規約なのでクリップ座標の成分 j は列 j = (m[0][j], m[1][j], m[2][j], m[3][j]) との内積
+		inline MagMath::Vector4 MakePlane(const MagMath::Matrix4x4 &m, float sign0, int column0, float sign1, int column1) {
+			const float a = sign0 * m.m[0][column0] + sign1 * m.m[0][column1];
+			const float b = sign0 * m.m[1][column0] + sign1 * m.m[1][column1];
+			const float c = sign0 * m.m[2][column0] + sign1 * m.m[2][column1];
+			const float d = sign0 * m.m[3][column0] + sign1 * m.m[3][column1];
+			const float length = std::sqrt(a * a + b * b + c * c);
+			const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+			return {a * inverse, b * inverse, c * inverse, d * inverse};
+		}
+
+		//========================================
+		// 平面までの符号付き距離
+		inline float PlaneDistance(const MagMath::Vector4 &plane, float x, float y, float z) {
+			return plane.x * x + plane.y * y + plane.z * z + plane.w;
+		}
+	}
+
+	///=============================================================================
+	///						ビュープロジェクション行列から6平面を求める
+	Frustum Frustum::FromViewProjection(const MagMath::Matrix4x4 &viewProjection) {
+		// -w <= x <= w, -w <= y <= w, 0 <= z <= w
+		Frustum frustum;
+		frustum.planes_[kLeft] = MakePlane(viewProjection, 1.0f, 3, 1.0f, 0);
+		frustum.planes_[kRight] = MakePlane(viewProjection, 1.0f, 3, -1.0f, 0);
+		frustum.planes_[kBottom] = MakePlane(viewProjection, 1.0f, 3, 1.0f, 1);
+		frustum.planes_[kTop] = MakePlane(viewProjection, 1.0f, 3, -1.0f, 1);
+		frustum.planes_[kNear] = MakePlane(viewProjection, 0.0f, 3, 1.0f, 2);
+		frustum.planes_[kFar] = MakePlane(viewProjection, 1.0f, 3, -1.0f, 2);
+		return frustum;
+	}
+
+	///=============================================================================
+	///						境界球の判定（1件）
+	bool Frustum::IntersectsSphere(const MagMath::Vector3 &center, float radius) const {
+		for (const MagMath::Vector4 &plane : planes_) {
+			if (PlaneDistance(plane, center.x, center.y, center.z) < -radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	///=============================================================================
+	///						スカラー版の一括判定
+	CullResult Frustum::CullSpheresScalar(const SphereStreams &s, uint32_t begin, uint32_t end,
+										  const MagMath::Vector3 &eye, float maxDistance, uint8_t *outVisible) const {
+		CullResult result;
+		for (uint32_t i = begin; i < end; ++i) {
+			const float x = s.centerX[i], y = s.centerY[i], z = s.centerZ[i], r = s.radius[i];
+			//========================================
+			// 描画距離（球の手前側が描画距離より遠ければ除外）
+			if (maxDistance > 0.0f) {
+				const float dx = x - eye.x, dy = y - eye.y, dz = z - eye.z;
+				const float limit = maxDistance + r;
+				if (dx * dx + dy * dy + dz * dz > limit * limit) {
+					outVisible[i] = 0;
+					++result.distanceCulledCount;
+					continue;
+				}
+			}
+			//========================================
+			// 視錐台
+			bool isInside = true;
+			for (const MagMath::Vector4 &plane : planes_) {
+				if (PlaneDistance(plane, x, y, z) < -r) {
+					isInside = false;
+					break;
+				}
+			}
+			outVisible[i] = isInside ? 1 : 0;
+			if (isInside) {
+				++result.visibleCount;
+			} else {
+				++result.frustumCulledCount;
+			}
+		}
+		return result;
+	}
+
+	///=============================================================================
+	///						一括判定
+	CullResult Frustum::CullSpheres(const SphereStreams &s, uint32_t count,
+									const MagMath::Vector3 &eye, float maxDistance, uint8_t *outVisible) const {
+		uint32_t i = 0;
+		CullResult result;
+#if defined(FRUSTUM_CULLING_SSE)
+		//========================================
+		// 平面を4件分に展開しておく
+		__m128 planeX[kPlaneCount], planeY[kPlaneCount], planeZ[kPlaneCount], planeW[kPlaneCount];
+		for (uint32_t p = 0; p < kPlaneCount; ++p) {
+			planeX[p] = _mm_set1_ps(planes_[p].x);
+			planeY[p] = _mm_set1_ps(planes_[p].y);
+			planeZ[p] = _mm_set1_ps(planes_[p].z);
+			planeW[p] = _mm_set1_ps(planes_[p].w);
+		}
+		const __m128 eyeX = _mm_set1_ps(eye.x);
+		const __m128 eyeY = _mm_set1_ps(eye.y);
+		const __m128 eyeZ = _mm_set1_ps(eye.z);
+		const __m128 distance = _mm_set1_ps(maxDistance);
+		const __m128 zero = _mm_setzero_ps();
+		const bool useDistance = maxDistance > 0.0f;
+
+		for (; i + 4 <= count; i += 4) {
+			const __m128 x = _mm_loadu_ps(s.centerX + i);
+			const __m128 y = _mm_loadu_ps(s.centerY + i);
+			const __m128 z = _mm_loadu_ps(s.centerZ + i);
+			const __m128 r = _mm_loadu_ps(s.radius + i);
+
+			//========================================
+			// 描画距離
+			__m128 distanceCulled = zero;
+			if (useDistance) {
+				const __m128 dx = _mm_sub_ps(x, eyeX);
+				const __m128 dy = _mm_sub_ps(y, eyeY);
+				const __m128 dz = _mm_sub_ps(z, eyeZ);
+				const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+				const __m128 limit = _mm_add_ps(distance, r);
+				distanceCulled = _mm_cmpgt_ps(lengthSq, _mm_mul_ps(limit, limit));
+			}
+
+			//========================================
+			// 視錐台（いずれかの平面の外側にあれば除外）
+			const __m128 negativeRadius = _mm_sub_ps(zero, r);
+			__m128 outside = zero;
+			for (uint32_t p = 0; p < kPlaneCount; ++p) {
+				const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+											_mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negativeRadius));
+			}
+
+			//========================================
+			// 結果の書き出し
+			const int distanceMask = _mm_movemask_ps(distanceCulled);
+			const int frustumMask = _mm_movemask_ps(_mm_andnot_ps(distanceCulled, outside));
+			for (uint32_t lane = 0; lane < 4; ++lane) {
+				const int bit = 1 << lane;
+				if (distanceMask & bit) {
+					outVisible[i + lane] = 0;
+					++result.distanceCulledCount;
+				} else if (frustumMask & bit) {
+					outVisible[i + lane] = 0;
+					++result.frustumCulledCount;
+				} else {
+					outVisible[i + lane] = 1;
+					++result.visibleCount;
+				}
+			}
+		}
+#endif
+		//========================================
+		// 端数（またはSSE非対応環境の全件）
+		const CullResult rest = CullSpheresScalar(s, i, count, eye, maxDistance, outVisible);
+		result.visibleCount += rest.visibleCount;
+		result.frustumCulledCount += rest.frustumCulledCount;
+		result.distanceCulledCount += rest.distanceCulledCount;
+		return result;
+	}
+
+	///=============================================================================
+	///						使用中の命令セット名
+	const char *Frustum::GetInstructionSetName() {
+#if defined(FRUSTUM_CULLING_SSE)
+		return "SSE";
+#else
+		return "Scalar";
+#endif
+	}
+
+	///=============================================================================
+	///						境界球をワールド座標へ変換
+	MagMath::BoundingSphere TransformBoundingSphere(const MagMath::BoundingSphere &localSphere, const MagMath::Matrix4x4 &world) {
+		const auto &m = world.m;
+		const MagMath::Vector3 &c = localSphere.center;
+		MagMath::BoundingSphere sphere;
+		sphere.center = {
+			c.x * m[0][0] + c.y * m[1][0] + c.z * m[2][0] + m[3][0],
+			c.x * m[0][1] + c.y * m[1][1] + c.z * m[2][1] + m[3][1],
+			c.x * m[0][2] + c.y * m[1][2] + c.z * m[2][2] + m[3][2]};
+		//========================================
+		// 各軸（行）の長さの最大値をスケールとする
+		float maxScaleSq = 0.0f;
+		for (int row = 0; row < 3; ++row) {
+			maxScaleSq = std::max(maxScaleSq, m[row][0] * m[row][0] + m[row][1] * m[row][1] + m[row][2] * m[row][2]);
+		}
+		sphere.radius = localSphere.radius * std::sqrt(maxScaleSq);
+		return sphere;
+	}
+}
@@ -0,0 +1,93 @@
+/*********************************************************************
+ * \file   Frustum.h
+ * \brief  視錐台と境界球の判定（SIMD一括判定）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   平面はビュープロジェクション行列（行ベクトル規約、クリップ空間 z は 0～1）の列から求める
+ *         一括判定はSSEで4件ずつ、非対応環境ではスカラーで処理する
+ *         GPUリソースには触れないため、GPUなしで動作を確認できる
+ *********************************************************************/
+#pragma once
+#include "MagMath.h"
+#include <cstdint>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						境界球の配列（SoA）
+	/// NOTE: 各配列は count 個以上の要素を持つこと
+	struct SphereStreams {
+		const float *centerX, *centerY, *centerZ;
+		const float *radius;
+	};
+
+	///=============================================================================
+	///						一括判定の結果
+	struct CullResult {
+		uint32_t visibleCount = 0;		  // 描画する数
+		uint32_t frustumCulledCount = 0;  // 視錐台の外で除外した数
+		uint32_t distanceCulledCount = 0; // 描画距離の外で除外した数
+	};
+
+	///=============================================================================
+	///						視錐台
+	class Frustum {
+		///--------------------------------------------------------------
+		///							メンバ関数
+	public:
+		//========================================
+		// 平面の番号
+		enum PlaneIndex : uint32_t {
+			kLeft,
+			kRight,
+			kBottom,
+			kTop,
+			kNear,
+			kFar,
+			kPlaneCount
+		};
+
+		/// \brief ビュープロジェクション行列から6平面を求める
+		/// \note 各平面は (法線, d) で、法線・位置の内積 + d >= 0 が内側（法線は正規化済み）
+		static Frustum FromViewProjection(const MagMath::Matrix4x4 &viewProjection);
+
+		/// \brief 境界球が視錐台と交差するか（1件の判定）
+		bool IntersectsSphere(const MagMath::Vector3 &center, float radius) const;
+
+		/// \brief 境界球の一括判定
+		/// \param spheres 境界球の配列
+		/// \param count 件数
+		/// \param eyePosition 描画距離の基準位置
+		/// \param maxDistance 描画距離（0以下なら距離では除外しない）
+		/// \param outVisible [out] 描画するなら1、除外するなら0（count 個）
+		/// \note 距離の判定を先に行い、距離で除外したものは視錐台の除外数に含めない
+		CullResult CullSpheres(const SphereStreams &spheres, uint32_t count,
+							   const MagMath::Vector3 &eyePosition, float maxDistance, uint8_t *outVisible) const;
+
+		/// \brief スカラー版（比較・フォールバック用）
+		CullResult CullSpheresScalar(const SphereStreams &spheres, uint32_t begin, uint32_t end,
+									 const MagMath::Vector3 &eyePosition, float maxDistance, uint8_t *outVisible) const;
+
+		/// \brief 使用中の命令セット名（デバッグ表示用）
+		static const char *GetInstructionSetName();
+
+		///--------------------------------------------------------------
+		///							入出力関数
+	public:
+		const MagMath::Vector4 &GetPlane(PlaneIndex index) const {
+			return planes_[index];
+		}
+
+		///--------------------------------------------------------------
+		///							メンバ変数
+	private:
+		MagMath::Vector4 planes_[kPlaneCount] = {};
+	};
+
+	///=============================================================================
+	///						境界球をワールド座標へ変換
+	/// \note 半径は行列の各軸のスケールの最大値で拡大する（非一様スケールでも包含を保つ）
+	MagMath::BoundingSphere TransformBoundingSphere(const MagMath::BoundingSphere &localSphere, const MagMath::Matrix4x4 &world);
+}
@@ -6,12 +6,16 @@
  * \date   January 2025
  * \note
  *********************************************************************/
+#define NOMINMAX
 #include "Line.h"
 #include "Camera.h"
 #include "DirectXCore.h"
 #include "LineManager.h"
 #include "LineSetup.h"
+#include "Logger.h"
 #include "Object3dSetup.h"
+#include <algorithm>
+#include <string>
 //========================================
 // 数学関数のインクルード
 #define _USE_MATH_DEFINES
@@ -26,11 +30,13 @@ namespace MagEngine {
 		// ラインセットアップの取得
 		lineSetup_ = lineSetup;
 		//========================================
-		// 頂点バッファの作成
-		CreateVertexBuffer();
 		// トランスフォーメーションマトリックスバッファの作成
 		CreateTransformationMatrixBuffer();
 		//========================================
+		// 頂点ページの作成（最初は1ページ）
+		pages_.clear();
+		CreatePage();
+		//========================================
 		// ワールド行列の初期化
 		transform_ = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
 		//========================================
@@ -63,7 +69,7 @@ namespace MagEngine {
 		// 定数バッファへの書き込み
 		transformationMatrixData_->WVP = worldViewProjectionMatrix;
 		transformationMatrixData_->World = worldMatrix;
-		transformationMatrixData_->WorldInvTranspose = Inverse4x4(worldMatrix);
+		transformationMatrixData_->WorldInvTranspose = InverseAffine4x4(worldMatrix);
 	}
 
 	///=============================================================================
@@ -79,39 +85,37 @@ namespace MagEngine {
 	///                     描画
 	void Line::Draw() {
 		//========================================
-		// 描画するラインがない場合は何もしない
-		if (vertices_.empty())
-			return;
+		// 使用量を記録し、必要なページ数に合わせる
+		uint32_t vertexCount = static_cast<uint32_t>(vertices_.size());
+		lastVertexCount_ = vertexCount;
+		peakVertexCount_ = std::max(peakVertexCount_, vertexCount);
+		windowPeakVertexCount_ = std::max(windowPeakVertexCount_, vertexCount);
+		ResizePages((vertexCount + kPageVertexCount - 1) / kPageVertexCount);
 
 		//========================================
-		// バッファサイズを動的に拡張
-		if (vertices_.size() > maxVertexCount_) {
-			// バッファを拡張し直す必要があります
-			// 現在のフレームは描画をスキップして、次フレームに備える
+		// 描画するラインがない場合は何もしない
+		if (vertices_.empty())
 			return;
-		}
-
-		//========================================
-		// 描画設定
-		void *pData;
-		// バーテックスバッファのマップ（NO_DISCARD フラグでパフォーマンス向上）
-		D3D12_RANGE range = {0, 0}; // 読み込みなし
-		vertexBuffer_->Map(0, &range, &pData);
-		// メモリコピー
-		memcpy(pData, vertices_.data(), sizeof(LineVertex) * vertices_.size());
-		// バーテックスバッファのアンマップ
-		vertexBuffer_->Unmap(0, nullptr);
 
 		//========================================
 		// 描画設定
 		auto commandList = lineSetup_->GetDXManager()->GetCommandList();
 		// transformationMatrixBufferのセット
 		commandList->SetGraphicsRootConstantBufferView(0, transformationMatrixBuffer_->GetGPUVirtualAddress());
-		// vertexBufferの設定
-		commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+
 		//========================================
-		// 描画
-		commandList->DrawInstanced(static_cast<UINT>(vertices_.size()), 1, 0, 0);
+		// ページごとに頂点を書き込んで描画
+		uint32_t written = 0;
+		for (VertexPage &page : pages_) {
+			if (written >= vertexCount) {
+				break;
+			}
+			uint32_t count = std::min(kPageVertexCount, vertexCount - written);
+			memcpy(page.data, vertices_.data() + written, sizeof(LineVertex) * count);
+			commandList->IASetVertexBuffers(0, 1, &page.view);
+			commandList->DrawInstanced(count, 1, 0, 0);
+			written += count;
+		}
 		// NOTE:描画した後はラインをクリアするのを忘れるな
 	}
 
@@ -123,47 +127,52 @@ namespace MagEngine {
 	}
 
 	///=============================================================================
-	///						バーテックスバッファの作成
-	void Line::CreateVertexBuffer() {
+	///						ページ数の調整
+	void Line::ResizePages(uint32_t requiredPageCount) {
 		//========================================
-		// デバイスの取得
-		auto device = lineSetup_->GetDXManager()->GetDevice();
-		// バッファサイズ
-		// NOTE: 初期配置は50000ラインまで描画可能。必要に応じて動的に拡張。
-		maxVertexCount_ = 100000; // 50000ラインx2頂点
-		size_t bufferSize = sizeof(LineVertex) * maxVertexCount_;
-		//========================================
-		// バーテックスバッファの作成
-		D3D12_HEAP_PROPERTIES heapProps = {};
-		// ヒープタイプ
-		heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-		//========================================
-		// リソースの設定
-		D3D12_RESOURCE_DESC bufferDesc = {};
-		bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-		bufferDesc.Width = bufferSize;
-		bufferDesc.Height = 1;
-		bufferDesc.DepthOrArraySize = 1;
-		bufferDesc.MipLevels = 1;
-		bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
-		bufferDesc.SampleDesc.Count = 1;
-		bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-		//========================================
-		// リソースの作成
-		device->CreateCommittedResource(
-			&heapProps,
-			D3D12_HEAP_FLAG_NONE,
-			&bufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&vertexBuffer_));
+		// 足りない場合はページ単位で増やす
+		if (requiredPageCount > pages_.size()) {
+			while (pages_.size() < requiredPageCount) {
+				CreatePage();
+			}
+			++growCount_;
+			framesSinceResize_ = 0;
+			Logger::Log("Line vertex pages grown to " + std::to_string(pages_.size()) +
+							" (" + std::to_string(lastVertexCount_) + " vertices)",
+						Logger::LogLevel::Warning);
+			return;
+		}
+
 		//========================================
-		// バーテックスバッファビューの設定
-		vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
-		// バイトサイズ
-		vertexBufferView_.SizeInBytes = static_cast<UINT>(bufferSize);
-		// ストライド
-		vertexBufferView_.StrideInBytes = sizeof(LineVertex);
+		// 一定期間ごとに、その期間の最大使用量まで減らす（最低1ページ）
+		// NOTE: DirectXCore は毎フレーム GPU の完了を待つため、今フレーム使わないページは解放してよい
+		if (++framesSinceResize_ < kShrinkCooldownFrames) {
+			return;
+		}
+		uint32_t keepPageCount = std::max(1u, (windowPeakVertexCount_ + kPageVertexCount - 1) / kPageVertexCount);
+		keepPageCount = std::max(keepPageCount, requiredPageCount);
+		if (keepPageCount < pages_.size()) {
+			pages_.resize(keepPageCount);
+			++shrinkCount_;
+			Logger::Log("Line vertex pages shrunk to " + std::to_string(pages_.size()), Logger::LogLevel::Info);
+		}
+		framesSinceResize_ = 0;
+		windowPeakVertexCount_ = 0;
+	}
+
+	///=============================================================================
+	///						ページの作成
+	void Line::CreatePage() {
+		VertexPage page;
+		size_t bufferSize = sizeof(LineVertex) * kPageVertexCount;
+		page.resource = lineSetup_->GetDXManager()->CreateBufferResource(bufferSize);
+		// COMMENT: アップロードヒープは常時マップしたままで問題ない
+		D3D12_RANGE readRange{0, 0};
+		page.resource->Map(0, &readRange, reinterpret_cast<void **>(&page.data));
+		page.view.BufferLocation = page.resource->GetGPUVirtualAddress();
+		page.view.SizeInBytes = static_cast<UINT>(bufferSize);
+		page.view.StrideInBytes = sizeof(LineVertex);
+		pages_.push_back(std::move(page));
 	}
 
 	///=============================================================================
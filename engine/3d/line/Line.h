@@ -4,11 +4,13 @@
  *
  * \author Harukichimaru
  * \date   January 2025
- * \note
+ * \note   頂点は固定サイズのページ（アップロードバッファ）に分けて書き込み、足りなければページ単位で増やす
+ *         使用量が減った状態が続いたらページを解放する。頂点を切り捨てることはない
  *********************************************************************/
 #pragma once
 #include "Light.h"
 #include "MagMath.h"
+#include <cstdint>
 #include <vector>
 //========================================
 // DX12include
@@ -60,13 +62,24 @@ namespace MagEngine {
 		 */
 		void DrawLine(const MagMath::Vector3 &start, const MagMath::Vector3 &end, const MagMath::Vector4 &color, float thickness = 1.0f);
 
+		//========================================
+		// 頂点ページの設定
+		static constexpr uint32_t kPageVertexCount = 16384;		 // 1ページの頂点数（偶数なのでラインがページを跨がない）
+		static constexpr uint32_t kShrinkCooldownFrames = 300; // この期間の最大使用量に合わせてページを減らす
+
 		///--------------------------------------------------------------
 		///						 静的メンバ関数
 	private:
 		/**----------------------------------------------------------------------------
-		 * \brief  CreateVertexBuffer 頂点バッファの作成
+		 * \brief  ResizePages 必要なページ数に合わせてページを増減
+		 * \param  requiredPageCount 今フレームに必要なページ数
+		 */
+		void ResizePages(uint32_t requiredPageCount);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  CreatePage ページを1枚追加
 		 */
-		void CreateVertexBuffer();
+		void CreatePage();
 
 		/**----------------------------------------------------------------------------
 		 * \brief  CreateTransformationMatrixBuffer
@@ -153,6 +166,49 @@ namespace MagEngine {
 			this->camera_ = camera;
 		}
 
+		/**----------------------------------------------------------------------------
+		 * \brief  GetLastVertexCount 直前に描画した頂点数
+		 */
+		uint32_t GetLastVertexCount() const {
+			return lastVertexCount_;
+		}
+		/**----------------------------------------------------------------------------
+		 * \brief  GetPeakVertexCount 1フレームの頂点数の最大（起動から）
+		 */
+		uint32_t GetPeakVertexCount() const {
+			return peakVertexCount_;
+		}
+		/**----------------------------------------------------------------------------
+		 * \brief  GetWindowPeakVertexCount 1フレームの頂点数の最大（現在の縮小判定期間）
+		 */
+		uint32_t GetWindowPeakVertexCount() const {
+			return windowPeakVertexCount_;
+		}
+		/**----------------------------------------------------------------------------
+		 * \brief  GetPageCount 確保中のページ数
+		 */
+		uint32_t GetPageCount() const {
+			return static_cast<uint32_t>(pages_.size());
+		}
+		/**----------------------------------------------------------------------------
+		 * \brief  GetGrowCount / GetShrinkCount ページを増やした・減らした回数
+		 */
+		uint32_t GetGrowCount() const {
+			return growCount_;
+		}
+		uint32_t GetShrinkCount() const {
+			return shrinkCount_;
+		}
+
+		/**----------------------------------------------------------------------------
+		 * \brief  GetTransformationMatrixAddress 変換行列の定数バッファのアドレス
+		 * \return GPU仮想アドレス
+		 * \note   単位形状のインスタンス描画でも同じビュープロジェクションを使う
+		 */
+		D3D12_GPU_VIRTUAL_ADDRESS GetTransformationMatrixAddress() const {
+			return transformationMatrixBuffer_->GetGPUVirtualAddress();
+		}
+
 		///--------------------------------------------------------------
 		///							メンバ変数
 	private:
@@ -160,19 +216,27 @@ namespace MagEngine {
 		// オブジェクト3Dセットアップポインタ
 		LineSetup *lineSetup_ = nullptr;
 
-		//---------------------------------------
-		// 頂点データサイズ管理
-		size_t maxVertexCount_ = 100000; // バッファの最大頂点数
-
 		//---------------------------------------
 		// 頂点データ
 		std::vector<LineVertex> vertices_;
 
 		//---------------------------------------
-		// 頂点バッファ
-		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_ = nullptr;
-		// バッファリソースの使い道を指すポインタ
-		D3D12_VERTEX_BUFFER_VIEW vertexBufferView_ = {};
+		// 頂点ページ（常時マップ）
+		struct VertexPage {
+			Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+			LineVertex *data = nullptr;
+			D3D12_VERTEX_BUFFER_VIEW view = {};
+		};
+		std::vector<VertexPage> pages_;
+
+		//---------------------------------------
+		// 使用量の記録
+		uint32_t lastVertexCount_ = 0;
+		uint32_t peakVertexCount_ = 0;
+		uint32_t windowPeakVertexCount_ = 0;
+		uint32_t framesSinceResize_ = 0;
+		uint32_t growCount_ = 0;
+		uint32_t shrinkCount_ = 0;
 
 		//---------------------------------------
 		// トランスフォーメーションマトリックス
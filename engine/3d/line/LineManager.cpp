@@ -6,8 +6,12 @@
  * \date   January 2025
  * \note
  *********************************************************************/
+#define NOMINMAX
 #include "LineManager.h"
 #include "ImguiSetup.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cassert>
 //========================================
 // 数学関数のインクルード
 #define _USE_MATH_DEFINES
@@ -30,6 +34,18 @@ namespace MagEngine {
 		return instance_;
 	}
 
+	///=============================================================================
+	///						呼び出し元スコープ
+	LineManager::CallerScope::CallerScope(const char *name) {
+		LineManager *manager = LineManager::GetInstance();
+		previous_ = manager->currentCaller_;
+		manager->currentCaller_ = name;
+	}
+
+	LineManager::CallerScope::~CallerScope() {
+		LineManager::GetInstance()->currentCaller_ = previous_;
+	}
+
 	///=============================================================================
 	///						初期化
 	void LineManager::Initialize(DirectXCore *dxCore, SrvSetup *srvSetup) {
@@ -48,6 +64,14 @@ namespace MagEngine {
 		line_ = std::make_unique<Line>();
 		// ラインの初期化
 		line_->Initialize(lineSetup_.get());
+		//========================================
+		// 単位形状の頂点バッファ（形状の頂点は初回のみ転送し、毎フレーム送るのはインスタンスだけ）
+		size_t shapeBufferSize = sizeof(MagMath::Vector3) * kShapeVertexCapacity;
+		shapeVertexBuffer_ = dxCore_->CreateDefaultBufferResource(shapeBufferSize);
+		assert(shapeVertexBuffer_);
+		shapeVertexBufferView_.BufferLocation = shapeVertexBuffer_->GetGPUVirtualAddress();
+		shapeVertexBufferView_.SizeInBytes = static_cast<UINT>(shapeBufferSize);
+		shapeVertexBufferView_.StrideInBytes = sizeof(MagMath::Vector3);
 	}
 
 	///=============================================================================
@@ -82,6 +106,7 @@ namespace MagEngine {
 
 		// Gridの描画
 		if (isDrawGrid_) {
+			CallerScope lineCaller("Grid");
 			DrawGrid(gridSize_, gridDivisions_, gridColor_);
 		}
 		// ラインの更新
@@ -96,10 +121,14 @@ namespace MagEngine {
 		lineSetup_->CommonDrawSetup();
 		// ラインの描画
 		line_->Draw();
+		// 単位形状のインスタンス描画
+		DrawShapeInstances();
 
 		//========================================
 		// ラインのクリア
 		line_->ClearLines();
+		// 呼び出し元ごとの集計を確定
+		ResolveCallerStats();
 	}
 
 	///=============================================================================
@@ -128,6 +157,32 @@ namespace MagEngine {
 		//========================================
 		// Sphereの描画
 		ImGui::Checkbox("Sphere", &isDrawSphere_);
+		ImGui::Text("Shape Draws: %u (Instances: %u)", lastShapeDrawCount_, lastShapeInstanceCount_);
+		ImGui::Separator();
+		//========================================
+		// 頂点バッファの使用状況
+		ImGui::Text("Vertices: %u (Peak %u / Window Peak %u)",
+					line_->GetLastVertexCount(), line_->GetPeakVertexCount(), line_->GetWindowPeakVertexCount());
+		ImGui::Text("Pages: %u x %u (Grow %u / Shrink %u)",
+					line_->GetPageCount(), Line::kPageVertexCount, line_->GetGrowCount(), line_->GetShrinkCount());
+		//========================================
+		// 呼び出し元ごとの頂点数
+		if (ImGui::BeginTable("LineCallers", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Caller");
+			ImGui::TableSetupColumn("Vertices");
+			ImGui::TableSetupColumn("Peak");
+			ImGui::TableHeadersRow();
+			for (const CallerStats &stats : callerStats_) {
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::TextUnformatted(stats.name ? stats.name : "Untagged");
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%u", stats.lastVertexCount);
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%u", stats.peakVertexCount);
+			}
+			ImGui::EndTable();
+		}
 		ImGui::End();
 	}
 
@@ -136,6 +191,10 @@ namespace MagEngine {
 	void LineManager::ClearLines() {
 		// ラインのクリア
 		line_->ClearLines();
+		// 単位形状のインスタンスのクリア
+		for (auto &pair : shapeBatches_) {
+			pair.second.instances.clear();
+		}
 	}
 
 	///=============================================================================
@@ -146,6 +205,7 @@ namespace MagEngine {
 		}
 		// ラインの追加（太さを指定）
 		line_->DrawLine(start, end, color, thickness);
+		CountCallerVertices(2);
 	}
 
 	///=============================================================================
@@ -182,83 +242,24 @@ namespace MagEngine {
 		// 法線ベクトルから垂直な2つのベクトルを計算
 		MagMath::Vector3 perpVector1, perpVector2;
 		CalculatePerpendicularVectors(normal, perpVector1, perpVector2);
+		MagMath::Vector3 axisZ = MagMath::Cross(perpVector1, perpVector2);
 
-		const float angleStep = 2.0f * static_cast<float>(M_PI) / divisions;
-
-		// 円を描画
-		for (int i = 0; i < divisions; ++i) {
-			float angle1 = angleStep * i;
-			float angle2 = angleStep * (i + 1);
-
-			MagMath::Vector3 point1 = {
-				center.x + (perpVector1.x * cosf(angle1) + perpVector2.x * sinf(angle1)) * radius,
-				center.y + (perpVector1.y * cosf(angle1) + perpVector2.y * sinf(angle1)) * radius,
-				center.z + (perpVector1.z * cosf(angle1) + perpVector2.z * sinf(angle1)) * radius};
-
-			MagMath::Vector3 point2 = {
-				center.x + (perpVector1.x * cosf(angle2) + perpVector2.x * sinf(angle2)) * radius,
-				center.y + (perpVector1.y * cosf(angle2) + perpVector2.y * sinf(angle2)) * radius,
-				center.z + (perpVector1.z * cosf(angle2) + perpVector2.z * sinf(angle2)) * radius};
-
-			// 円周上の点同士を結ぶ
-			DrawLine(point1, point2, color, thickness);
-		}
+		// 単位円を半径倍して円の平面へ
+		DrawShapeInstance(LineShapeType::Circle, divisions,
+						  MakeShapeMatrix(perpVector1 * radius, perpVector2 * radius, axisZ, center), color, thickness);
 	}
 
 	///=============================================================================
 	///						球体の描画
 	void LineManager::DrawSphere(const MagMath::Vector3 &center, float radius, const MagMath::Vector4 &color,
 								 int divisions, float thickness) {
-		if (!isDrawSphere_ || divisions <= 0) {
+		if (!isDrawLine_ || !isDrawSphere_ || divisions <= 0) {
 			return;
 		}
 
-		// 緯度・経度方向の分割を計算
-		float latStep = static_cast<float>(M_PI) / divisions;		 // 緯度のステップ
-		float lonStep = 2.0f * static_cast<float>(M_PI) / divisions; // 経度のステップ
-
-		// 緯度方向のループ
-		for (int lat = 0; lat <= divisions; ++lat) {
-			float theta = lat * latStep; // 緯度角
-			float sinTheta = sinf(theta);
-			float cosTheta = cosf(theta);
-
-			// 経度方向のループ
-			for (int lon = 0; lon < divisions; ++lon) {
-				float phi = lon * lonStep; // 経度角
-				float nextPhi = (lon + 1) * lonStep;
-
-				// 現在の点
-				MagMath::Vector3 point1 = {
-					center.x + radius * sinTheta * cosf(phi),
-					center.y + radius * cosTheta,
-					center.z + radius * sinTheta * sinf(phi)};
-
-				// 次の経度の点
-				MagMath::Vector3 point2 = {
-					center.x + radius * sinTheta * cosf(nextPhi),
-					center.y + radius * cosTheta,
-					center.z + radius * sinTheta * sinf(nextPhi)};
-
-				// 次の緯度の点
-				if (lat < divisions) {
-					float nextTheta = (lat + 1) * latStep;
-					float sinNextTheta = sinf(nextTheta);
-					float cosNextTheta = cosf(nextTheta);
-
-					MagMath::Vector3 point3 = {
-						center.x + radius * sinNextTheta * cosf(phi),
-						center.y + radius * cosNextTheta,
-						center.z + radius * sinNextTheta * sinf(phi)};
-
-					// 緯度方向の線を描画
-					DrawLine(point1, point3, color, thickness);
-				}
-
-				// 経度方向の線を描画
-				DrawLine(point1, point2, color, thickness);
-			}
-		}
+		// 単位球を半径倍して中心へ
+		DrawShapeInstance(LineShapeType::Sphere, divisions,
+						  MakeShapeMatrix({radius, 0.0f, 0.0f}, {0.0f, radius, 0.0f}, {0.0f, 0.0f, radius}, center), color, thickness);
 	}
 
 	///=============================================================================
@@ -341,79 +342,29 @@ namespace MagEngine {
 	///=============================================================================
 	///						立方体の描画
 	void LineManager::DrawCube(const MagMath::Vector3 &center, float size, const MagMath::Vector4 &color, float thickness) {
-		// halfSize
-		float halfSize = size * 0.5f;
-
-		// 8つの頂点を計算
-		MagMath::Vector3 p1 = {center.x - halfSize, center.y - halfSize, center.z - halfSize};
-		MagMath::Vector3 p2 = {center.x + halfSize, center.y - halfSize, center.z - halfSize};
-		MagMath::Vector3 p3 = {center.x + halfSize, center.y - halfSize, center.z + halfSize};
-		MagMath::Vector3 p4 = {center.x - halfSize, center.y - halfSize, center.z + halfSize};
-		MagMath::Vector3 p5 = {center.x - halfSize, center.y + halfSize, center.z - halfSize};
-		MagMath::Vector3 p6 = {center.x + halfSize, center.y + halfSize, center.z - halfSize};
-		MagMath::Vector3 p7 = {center.x + halfSize, center.y + halfSize, center.z + halfSize};
-		MagMath::Vector3 p8 = {center.x - halfSize, center.y + halfSize, center.z + halfSize};
-
-		// 下面
-		DrawLine(p1, p2, color, thickness);
-		DrawLine(p2, p3, color, thickness);
-		DrawLine(p3, p4, color, thickness);
-		DrawLine(p4, p1, color, thickness);
-
-		// 上面
-		DrawLine(p5, p6, color, thickness);
-		DrawLine(p6, p7, color, thickness);
-		DrawLine(p7, p8, color, thickness);
-		DrawLine(p8, p5, color, thickness);
-
-		// 垂直な辺
-		DrawLine(p1, p5, color, thickness);
-		DrawLine(p2, p6, color, thickness);
-		DrawLine(p3, p7, color, thickness);
-		DrawLine(p4, p8, color, thickness);
+		DrawBox(center, {size, size, size}, color, thickness);
 	}
 
 	///=============================================================================
 	///						直方体の描画
 	void LineManager::DrawBox(const MagMath::Vector3 &center, const MagMath::Vector3 &size, const MagMath::Vector4 &color, float thickness) {
-		// halfSize
-		float halfSizeX = size.x * 0.5f;
-		float halfSizeY = size.y * 0.5f;
-		float halfSizeZ = size.z * 0.5f;
-
-		// 8つの頂点を計算
-		MagMath::Vector3 p1 = {center.x - halfSizeX, center.y - halfSizeY, center.z - halfSizeZ};
-		MagMath::Vector3 p2 = {center.x + halfSizeX, center.y - halfSizeY, center.z - halfSizeZ};
-		MagMath::Vector3 p3 = {center.x + halfSizeX, center.y - halfSizeY, center.z + halfSizeZ};
-		MagMath::Vector3 p4 = {center.x - halfSizeX, center.y - halfSizeY, center.z + halfSizeZ};
-		MagMath::Vector3 p5 = {center.x - halfSizeX, center.y + halfSizeY, center.z - halfSizeZ};
-		MagMath::Vector3 p6 = {center.x + halfSizeX, center.y + halfSizeY, center.z - halfSizeZ};
-		MagMath::Vector3 p7 = {center.x + halfSizeX, center.y + halfSizeY, center.z + halfSizeZ};
-		MagMath::Vector3 p8 = {center.x - halfSizeX, center.y + halfSizeY, center.z + halfSizeZ};
-
-		// 下面
-		DrawLine(p1, p2, color, thickness);
-		DrawLine(p2, p3, color, thickness);
-		DrawLine(p3, p4, color, thickness);
-		DrawLine(p4, p1, color, thickness);
-
-		// 上面
-		DrawLine(p5, p6, color, thickness);
-		DrawLine(p6, p7, color, thickness);
-		DrawLine(p7, p8, color, thickness);
-		DrawLine(p8, p5, color, thickness);
-
-		// 垂直な辺
-		DrawLine(p1, p5, color, thickness);
-		DrawLine(p2, p6, color, thickness);
-		DrawLine(p3, p7, color, thickness);
-		DrawLine(p4, p8, color, thickness);
+		if (!isDrawLine_) {
+			return;
+		}
+
+		// 単位立方体を各軸のサイズ倍して中心へ
+		DrawShapeInstance(LineShapeType::Box, 0,
+						  MakeShapeMatrix({size.x, 0.0f, 0.0f}, {0.0f, size.y, 0.0f}, {0.0f, 0.0f, size.z}, center), color, thickness);
 	}
 
 	///=============================================================================
 	///						円錐の描画
 	void LineManager::DrawCone(const MagMath::Vector3 &apex, const MagMath::Vector3 &direction, float height, float radius,
 							   const MagMath::Vector4 &color, int divisions, float thickness) {
+		if (!isDrawLine_ || divisions <= 0) {
+			return;
+		}
+
 		// 方向ベクトルを正規化
 		MagMath::Vector3 normalizedDir;
 		float dirLength = sqrtf(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
@@ -427,38 +378,23 @@ namespace MagEngine {
 			normalizedDir = {0.0f, -1.0f, 0.0f}; // デフォルト方向
 		}
 
-		// 底面の中心を計算
-		MagMath::Vector3 baseCenter = {
-			apex.x + normalizedDir.x * height,
-			apex.y + normalizedDir.y * height,
-			apex.z + normalizedDir.z * height};
-
 		// 方向ベクトルに垂直な2つのベクトルを計算
 		MagMath::Vector3 perpVector1, perpVector2;
 		CalculatePerpendicularVectors(normalizedDir, perpVector1, perpVector2);
 
-		// 底面の円を描画
-		DrawCircle(baseCenter, radius, color, thickness, normalizedDir, divisions);
-
-		// 頂点から底面の円周上の点への線を描画
-		const float angleStep = 2.0f * static_cast<float>(M_PI) / divisions;
-
-		for (int i = 0; i < divisions; ++i) {
-			float angle = angleStep * i;
-
-			MagMath::Vector3 point = {
-				baseCenter.x + (perpVector1.x * cosf(angle) + perpVector2.x * sinf(angle)) * radius,
-				baseCenter.y + (perpVector1.y * cosf(angle) + perpVector2.y * sinf(angle)) * radius,
-				baseCenter.z + (perpVector1.z * cosf(angle) + perpVector2.z * sinf(angle)) * radius};
-
-			DrawLine(apex, point, color, thickness);
-		}
+		// 単位円錐（底面 z=1）を底面半径・高さに合わせて頂点へ
+		DrawShapeInstance(LineShapeType::Cone, divisions,
+						  MakeShapeMatrix(perpVector1 * radius, perpVector2 * radius, normalizedDir * height, apex), color, thickness);
 	}
 
 	///=============================================================================
 	///						円柱の描画
 	void LineManager::DrawCylinder(const MagMath::Vector3 &center, const MagMath::Vector3 &direction, float height, float radius,
 								   const MagMath::Vector4 &color, int divisions, float thickness) {
+		if (!isDrawLine_ || divisions <= 0) {
+			return;
+		}
+
 		// 方向ベクトルを正規化
 		MagMath::Vector3 normalizedDir;
 		float dirLength = sqrtf(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
@@ -472,42 +408,13 @@ namespace MagEngine {
 			normalizedDir = {0.0f, 1.0f, 0.0f}; // デフォルト方向
 		}
 
-		// 上面と下面の中心を計算
-		float halfHeight = height * 0.5f;
-		MagMath::Vector3 topCenter = {
-			center.x + normalizedDir.x * halfHeight,
-			center.y + normalizedDir.y * halfHeight,
-			center.z + normalizedDir.z * halfHeight};
-
-		MagMath::Vector3 bottomCenter = {
-			center.x - normalizedDir.x * halfHeight,
-			center.y - normalizedDir.y * halfHeight,
-			center.z - normalizedDir.z * halfHeight};
-
-		// 上面と下面の円を描画
-		DrawCircle(topCenter, radius, color, thickness, normalizedDir, divisions);
-		DrawCircle(bottomCenter, radius, color, thickness, normalizedDir, divisions);
-
-		// 上面と下面を結ぶ線を描画
-		const float angleStep = 2.0f * static_cast<float>(M_PI) / divisions;
+		// 方向ベクトルに垂直な2つのベクトルを計算
 		MagMath::Vector3 perpVector1, perpVector2;
 		CalculatePerpendicularVectors(normalizedDir, perpVector1, perpVector2);
 
-		for (int i = 0; i < divisions; ++i) {
-			float angle = angleStep * i;
-
-			MagMath::Vector3 topPoint = {
-				topCenter.x + (perpVector1.x * cosf(angle) + perpVector2.x * sinf(angle)) * radius,
-				topCenter.y + (perpVector1.y * cosf(angle) + perpVector2.y * sinf(angle)) * radius,
-				topCenter.z + (perpVector1.z * cosf(angle) + perpVector2.z * sinf(angle)) * radius};
-
-			MagMath::Vector3 bottomPoint = {
-				bottomCenter.x + (perpVector1.x * cosf(angle) + perpVector2.x * sinf(angle)) * radius,
-				bottomCenter.y + (perpVector1.y * cosf(angle) + perpVector2.y * sinf(angle)) * radius,
-				bottomCenter.z + (perpVector1.z * cosf(angle) + perpVector2.z * sinf(angle)) * radius};
-
-			DrawLine(topPoint, bottomPoint, color, thickness);
-		}
+		// 単位円柱（z=-0.5～0.5）を半径・高さに合わせて中心へ
+		DrawShapeInstance(LineShapeType::Cylinder, divisions,
+						  MakeShapeMatrix(perpVector1 * radius, perpVector2 * radius, normalizedDir * height, center), color, thickness);
 	}
 
 	///=============================================================================
@@ -516,16 +423,17 @@ namespace MagEngine {
 		// 中心の円
 		DrawCircle(center, size * 0.4f, {1.0f, 1.0f, 0.5f, 1.0f}, thickness);
 
-		// 放射状の光線
+		// 放射状の光線（45度刻み）
+		const std::vector<MagMath::Vector2> &unitCircle = GetUnitCircle(8);
 		for (int i = 0; i < 8; i++) {
-			float angle = i * static_cast<float>(M_PI) / 4.0f;
+			const MagMath::Vector2 &cs = unitCircle[i];
 			MagMath::Vector3 inner = {
-				center.x + cosf(angle) * size * 0.5f,
-				center.y + sinf(angle) * size * 0.5f,
+				center.x + cs.x * size * 0.5f,
+				center.y + cs.y * size * 0.5f,
 				center.z};
 			MagMath::Vector3 outer = {
-				center.x + cosf(angle) * size,
-				center.y + sinf(angle) * size,
+				center.x + cs.x * size,
+				center.y + cs.y * size,
 				center.z};
 			DrawLine(inner, outer, color, thickness);
 		}
@@ -535,29 +443,42 @@ namespace MagEngine {
 	///						光線パターンの描画
 	void LineManager::DrawLightRays(const MagMath::Vector3 &center, float maxLength, const MagMath::Vector4 &color,
 									int rayCount, float decay, float thickness) {
-		// 球面上にランダムな方向の光線を描画
-		for (int i = 0; i < rayCount; i++) {
-			// 球面上の均等分布点を生成
-			float phi = static_cast<float>(M_PI * 2.0f) * (float)i / rayCount;
-			float theta = static_cast<float>(M_PI) * (float)i / rayCount;
-
-			MagMath::Vector3 direction = {
-				sinf(theta) * cosf(phi),
-				sinf(theta) * sinf(phi),
-				cosf(theta)};
-
-			// 減衰を反映した長さのグラデーション線
-			int segments = 5;
-			for (int j = 0; j < segments; j++) {
-				float t1 = (float)j / segments;
-				float t2 = (float)(j + 1) / segments;
+		if (rayCount <= 0) {
+			return;
+		}
 
-				// 減衰関数に基づく長さの調整
-				float len1 = maxLength * t1;
-				float len2 = maxLength * t2;
+		//========================================
+		// 光線の方向表（光線数ごとに初回のみ計算）
+		std::vector<MagMath::Vector3> &directions = lightRayCache_[rayCount];
+		if (directions.empty()) {
+			directions.reserve(rayCount);
+			for (int i = 0; i < rayCount; i++) {
+				// 球面上の均等分布点を生成
+				float phi = static_cast<float>(M_PI * 2.0f) * (float)i / rayCount;
+				float theta = static_cast<float>(M_PI) * (float)i / rayCount;
+				directions.push_back({
+					sinf(theta) * cosf(phi),
+					sinf(theta) * sinf(phi),
+					cosf(theta)});
+			}
+		}
+
+		//========================================
+		// 減衰はセグメント位置だけで決まるので、光線ごとではなく1度だけ計算
+		constexpr int kSegments = 5;
+		float alphas[kSegments];
+		for (int j = 0; j < kSegments; j++) {
+			float t1 = (float)j / kSegments;
+			// 距離による減衰効果の反映（減衰係数に応じた透明度）
+			alphas[j] = 1.0f / (1.0f + powf(t1 * 5.0f, decay));
+		}
 
-				// 距離による減衰効果の反映（減衰係数に応じた透明度）
-				float alpha1 = 1.0f / (1.0f + powf(t1 * 5.0f, decay));
+		// 減衰を反映した長さのグラデーション線
+		for (const MagMath::Vector3 &direction : directions) {
+			for (int j = 0; j < kSegments; j++) {
+				// 減衰関数に基づく長さの調整
+				float len1 = maxLength * (float)j / kSegments;
+				float len2 = maxLength * (float)(j + 1) / kSegments;
 
 				MagMath::Vector3 point1 = {
 					center.x + direction.x * len1,
@@ -573,11 +494,282 @@ namespace MagEngine {
 					color.x,
 					color.y,
 					color.z,
-					color.w * alpha1};
+					color.w * alphas[j]};
+
+				DrawLine(point1, point2, segmentColor, thickness * alphas[j]);
+			}
+		}
+	}
 
-				DrawLine(point1, point2, segmentColor, thickness * alpha1);
+	///=============================================================================
+	///						単位形状のインスタンスを追加
+	void LineManager::DrawShapeInstance(LineShapeType type, int divisions, const MagMath::Matrix4x4 &world, const MagMath::Vector4 &color,
+										float thickness) {
+		uint32_t key = (static_cast<uint32_t>(type) << 16) | (static_cast<uint32_t>(divisions) & 0xFFFFu);
+		LineShapeBatch &batch = shapeBatches_[key];
+		// 初めて使う形状はライン表を作成し、頂点バッファの末尾に場所を確保（転送は描画時に1度だけ）
+		if (batch.vertexCount == 0) {
+			BuildUnitShape(type, divisions, batch.unitVertices);
+			batch.vertexCount = static_cast<uint32_t>(batch.unitVertices.size());
+			if (shapeVertexCount_ + batch.vertexCount <= kShapeVertexCapacity) {
+				batch.firstVertex = shapeVertexCount_;
+				shapeVertexCount_ += batch.vertexCount;
+				pendingShapeUploads_.push_back(key);
+			} else {
+				// 容量を超える形状は転送せず、描画もしない
+				Logger::Log("LineManager: shape vertex buffer is full, shape " + std::to_string(key) + " is not drawn", Logger::LogLevel::Warning);
+				batch.unitVertices.clear();
+			}
+		}
+		batch.instances.push_back({world, color, thickness});
+		CountCallerVertices(batch.vertexCount);
+	}
+
+	///=============================================================================
+	///						呼び出し元の頂点数を加算
+	void LineManager::CountCallerVertices(uint32_t vertexCount) {
+		// NOTE: 呼び出し元は数種類なので線形探索で十分
+		for (CallerStats &stats : callerStats_) {
+			if (stats.name == currentCaller_) {
+				stats.vertexCount += vertexCount;
+				return;
+			}
+		}
+		CallerStats stats;
+		stats.name = currentCaller_;
+		stats.vertexCount = vertexCount;
+		callerStats_.push_back(stats);
+	}
+
+	///=============================================================================
+	///						呼び出し元ごとの集計を確定
+	void LineManager::ResolveCallerStats() {
+		for (CallerStats &stats : callerStats_) {
+			stats.lastVertexCount = stats.vertexCount;
+			stats.peakVertexCount = std::max(stats.peakVertexCount, stats.vertexCount);
+			stats.vertexCount = 0;
+		}
+		// 多い順に並べる（ImGui表示用）
+		std::sort(callerStats_.begin(), callerStats_.end(), [](const CallerStats &a, const CallerStats &b) {
+			return a.lastVertexCount > b.lastVertexCount;
+		});
+	}
+
+	///=============================================================================
+	///						単位円の表を取得
+	const std::vector<MagMath::Vector2> &LineManager::GetUnitCircle(int divisions) {
+		std::vector<MagMath::Vector2> &table = unitCircleCache_[divisions];
+		if (table.empty()) {
+			const float angleStep = 2.0f * static_cast<float>(M_PI) / divisions;
+			table.reserve(divisions + 1);
+			for (int i = 0; i <= divisions; ++i) {
+				float angle = angleStep * i;
+				table.push_back({cosf(angle), sinf(angle)});
 			}
 		}
+		return table;
+	}
+
+	///=============================================================================
+	///						単位形状のライン表を作成
+	void LineManager::BuildUnitShape(LineShapeType type, int divisions, std::vector<MagMath::Vector3> &outVertices) {
+		outVertices.clear();
+		switch (type) {
+		case LineShapeType::Sphere: {
+			// 緯度・経度方向の分割を計算
+			float latStep = static_cast<float>(M_PI) / divisions;
+			const std::vector<MagMath::Vector2> &lon = GetUnitCircle(divisions);
+			for (int lat = 0; lat <= divisions; ++lat) {
+				float sinTheta = sinf(lat * latStep);
+				float cosTheta = cosf(lat * latStep);
+				float sinNextTheta = sinf((lat + 1) * latStep);
+				float cosNextTheta = cosf((lat + 1) * latStep);
+				for (int i = 0; i < divisions; ++i) {
+					MagMath::Vector3 point1 = {sinTheta * lon[i].x, cosTheta, sinTheta * lon[i].y};
+					// 緯度方向の線
+					if (lat < divisions) {
+						outVertices.push_back(point1);
+						outVertices.push_back({sinNextTheta * lon[i].x, cosNextTheta, sinNextTheta * lon[i].y});
+					}
+					// 経度方向の線
+					outVertices.push_back(point1);
+					outVertices.push_back({sinTheta * lon[i + 1].x, cosTheta, sinTheta * lon[i + 1].y});
+				}
+			}
+			break;
+		}
+		case LineShapeType::Box: {
+			// 8つの頂点（下面4つ、上面4つ）
+			const MagMath::Vector3 p[8] = {
+				{-0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, 0.5f}, {-0.5f, -0.5f, 0.5f},
+				{-0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}};
+			for (int i = 0; i < 4; ++i) {
+				// 下面・上面・垂直な辺
+				outVertices.push_back(p[i]);
+				outVertices.push_back(p[(i + 1) % 4]);
+				outVertices.push_back(p[i + 4]);
+				outVertices.push_back(p[(i + 1) % 4 + 4]);
+				outVertices.push_back(p[i]);
+				outVertices.push_back(p[i + 4]);
+			}
+			break;
+		}
+		case LineShapeType::Cone:
+		case LineShapeType::Cylinder:
+		case LineShapeType::Circle: {
+			const std::vector<MagMath::Vector2> &circle = GetUnitCircle(divisions);
+			// 円（錐は底面 z=1、円柱は上下 z=±0.5、円は z=0）
+			float rings[2] = {0.0f, 0.0f};
+			int ringCount = 1;
+			if (type == LineShapeType::Cone) {
+				rings[0] = 1.0f;
+			} else if (type == LineShapeType::Cylinder) {
+				rings[0] = 0.5f;
+				rings[1] = -0.5f;
+				ringCount = 2;
+			}
+			for (int r = 0; r < ringCount; ++r) {
+				for (int i = 0; i < divisions; ++i) {
+					outVertices.push_back({circle[i].x, circle[i].y, rings[r]});
+					outVertices.push_back({circle[i + 1].x, circle[i + 1].y, rings[r]});
+				}
+			}
+			// 側面の線（錐は頂点から、円柱は上下を結ぶ）
+			if (type == LineShapeType::Cone) {
+				for (int i = 0; i < divisions; ++i) {
+					outVertices.push_back({0.0f, 0.0f, 0.0f});
+					outVertices.push_back({circle[i].x, circle[i].y, 1.0f});
+				}
+			} else if (type == LineShapeType::Cylinder) {
+				for (int i = 0; i < divisions; ++i) {
+					outVertices.push_back({circle[i].x, circle[i].y, 0.5f});
+					outVertices.push_back({circle[i].x, circle[i].y, -0.5f});
+				}
+			}
+			break;
+		}
+		}
+	}
+
+	///=============================================================================
+	///						新しい単位形状を頂点バッファへ転送
+	void LineManager::UploadPendingShapes() {
+		if (pendingShapeUploads_.empty()) {
+			return;
+		}
+
+		//========================================
+		// 形状の頂点をアップロードリングへ書き込む
+		// NOTE: 確保できない場合（リングの容量不足）は残りの形状を次のフレームで転送する
+		std::vector<std::pair<UploadAllocation, LineShapeBatch *>> uploads;
+		uploads.reserve(pendingShapeUploads_.size());
+		for (uint32_t key : pendingShapeUploads_) {
+			LineShapeBatch &batch = shapeBatches_[key];
+			size_t vertexSize = sizeof(MagMath::Vector3) * batch.unitVertices.size();
+			UploadAllocation allocation = dxCore_->AllocateUpload(vertexSize);
+			if (!allocation.cpuAddress) {
+				break;
+			}
+			memcpy(allocation.cpuAddress, batch.unitVertices.data(), vertexSize);
+			uploads.emplace_back(allocation, &batch);
+		}
+		if (uploads.empty()) {
+			return;
+		}
+		pendingShapeUploads_.erase(pendingShapeUploads_.begin(), pendingShapeUploads_.begin() + uploads.size());
+
+		//========================================
+		// このフレームで既に頂点バッファとして使った場合はコピー先の状態へ戻す
+		// NOTE: 未使用なら COMMON から COPY_DEST へ暗黙に昇格する
+		auto commandList = dxCore_->GetCommandList();
+		uint64_t frameSerial = dxCore_->GetUploadFrameSerial();
+		D3D12_RESOURCE_BARRIER barrier{};
+		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		barrier.Transition.pResource = shapeVertexBuffer_.Get();
+		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		if (shapeBufferReadSerial_ == frameSerial) {
+			barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+			barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
+			commandList->ResourceBarrier(1, &barrier);
+		}
+
+		//========================================
+		// 確保済みの位置へコピー（CPU側のライン表は以降不要）
+		for (auto &[allocation, batch] : uploads) {
+			dxCore_->CopyUploadToBuffer(allocation, shapeVertexBuffer_.Get(), sizeof(MagMath::Vector3) * batch->firstVertex);
+			batch->isUploaded = true;
+			batch->unitVertices.clear();
+			batch->unitVertices.shrink_to_fit();
+		}
+
+		//========================================
+		// 頂点バッファとして読める状態へ
+		barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+		commandList->ResourceBarrier(1, &barrier);
+		shapeBufferReadSerial_ = frameSerial;
+	}
+
+	///=============================================================================
+	///						単位形状のインスタンス描画
+	void LineManager::DrawShapeInstances() {
+		lastShapeDrawCount_ = 0;
+		lastShapeInstanceCount_ = 0;
+
+		//========================================
+		// 新しく作った形状の頂点を転送（以降のフレームは転送しない）
+		UploadPendingShapes();
+
+		bool isSetup = false;
+		auto commandList = dxCore_->GetCommandList();
+		for (auto &pair : shapeBatches_) {
+			LineShapeBatch &batch = pair.second;
+			if (batch.instances.empty()) {
+				continue;
+			}
+
+			//========================================
+			// インスタンスだけをアップロードリングへ書き込む
+			// NOTE: 頂点の転送が済んでいない形状と、確保できない場合（リングの容量不足）はこの形状を描画しない
+			size_t instanceSize = sizeof(LineShapeInstance) * batch.instances.size();
+			UploadAllocation instanceAllocation = batch.isUploaded ? dxCore_->AllocateUpload(instanceSize) : UploadAllocation{};
+			if (!instanceAllocation.cpuAddress) {
+				batch.instances.clear();
+				continue;
+			}
+			memcpy(instanceAllocation.cpuAddress, batch.instances.data(), instanceSize);
+
+			//========================================
+			// 描画設定（最初の形状でのみ行う。頂点バッファは全形状で共通）
+			if (!isSetup) {
+				lineSetup_->CommonDrawSetupInstanced();
+				commandList->SetGraphicsRootConstantBufferView(0, line_->GetTransformationMatrixAddress());
+				commandList->IASetVertexBuffers(0, 1, &shapeVertexBufferView_);
+				// COMMON から読み取り状態へ暗黙に昇格するため、このフレームの転送前に戻す必要がある
+				shapeBufferReadSerial_ = dxCore_->GetUploadFrameSerial();
+				isSetup = true;
+			}
+			commandList->SetGraphicsRootShaderResourceView(1, instanceAllocation.gpuAddress);
+
+			//========================================
+			// 描画（1つの形状につき1回）
+			commandList->DrawInstanced(batch.vertexCount, static_cast<UINT>(batch.instances.size()), batch.firstVertex, 0);
+			++lastShapeDrawCount_;
+			lastShapeInstanceCount_ += static_cast<uint32_t>(batch.instances.size());
+			batch.instances.clear();
+		}
+	}
+
+	///=============================================================================
+	///						基底ベクトルと原点から変換行列を作成
+	MagMath::Matrix4x4 LineManager::MakeShapeMatrix(const MagMath::Vector3 &axisX, const MagMath::Vector3 &axisY,
+													const MagMath::Vector3 &axisZ, const MagMath::Vector3 &origin) {
+		MagMath::Matrix4x4 result = {
+			axisX.x, axisX.y, axisX.z, 0.0f,
+			axisY.x, axisY.y, axisY.z, 0.0f,
+			axisZ.x, axisZ.y, axisZ.z, 0.0f,
+			origin.x, origin.y, origin.z, 1.0f};
+		return result;
 	}
 
 	///=============================================================================
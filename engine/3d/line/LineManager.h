@@ -4,7 +4,10 @@
  *
  * \author Harukichimaru
  * \date   January 2025
- * \note
+ * \note   球・箱・円錐・円柱・円は単位形状のライン表を1度だけ作り、
+ *         1つの形状を1インスタンス（変換行列+色+太さ）として形状ごとに1回の描画でまとめて描く
+ *         単位形状の頂点は初回のみ GPU 専用の頂点バッファへ転送し、毎フレーム送るのはインスタンスだけ
+ *         呼び出し元は CallerScope で名前を付けると、ImGui で呼び出し元ごとの頂点数を確認できる
  *********************************************************************/
 #pragma once
 #include "MagMath.h"
@@ -12,17 +15,52 @@
 #include "Line.h"
 #include "LineSetup.h"
 #include "SrvSetup.h"
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
  ///=============================================================================
  ///                        namespace MagEngine
 namespace MagEngine {
+	///=============================================================================
+	///						単位形状の種類
+	enum class LineShapeType : uint32_t {
+		Sphere,	  // 半径1の球（中心が原点）
+		Box,	  // 1辺1の立方体（中心が原点）
+		Cone,	  // 頂点が原点、底面が z=1 にある半径1の円錐
+		Cylinder, // z=-0.5～0.5 の半径1の円柱
+		Circle,	  // z=0 平面上の半径1の円
+	};
+
+	///=============================================================================
+	///						単位形状のインスタンス（GPU用）
+	struct LineShapeInstance {
+		MagMath::Matrix4x4 world;			// 単位形状からワールドへの変換
+		MagMath::Vector4 color;				// 色
+		float thickness = 1.0f;				// 線の太さ（LineVertex と同じくピクセルシェーダーへ渡す）
+		float padding[3]{0.0f, 0.0f, 0.0f}; // 16バイト境界にアライン
+	};
+
 ///=============================================================================
 ///						ラインマネージャ
 	class LineManager {
 		///--------------------------------------------------------------
 		///						 メンバ関数
 	public:
+		/// @brief 呼び出し元の名前を設定するスコープ（スコープ内のラインをその名前で集計する）
+		/// @note 名前は文字列リテラルなど、集計中に寿命が続くものを渡すこと
+		class CallerScope {
+		public:
+			explicit CallerScope(const char *name);
+			~CallerScope();
+			CallerScope(const CallerScope &) = delete;
+			CallerScope &operator=(const CallerScope &) = delete;
+
+		private:
+			const char *previous_ = nullptr;
+		};
+
 		/// @brief インスタンスの取得
 		/// @return LineManagerのインスタンス
 		static LineManager *GetInstance();
@@ -171,6 +209,15 @@ namespace MagEngine {
 /// @param perpVector2 [out] 垂直ベクトル2
 		void CalculatePerpendicularVectors(const MagMath::Vector3 &direction, MagMath::Vector3 &perpVector1, MagMath::Vector3 &perpVector2);
 
+		/// @brief 単位形状のインスタンスを追加
+		/// @param type 形状の種類
+		/// @param divisions 分割数（同じ種類・分割数ごとに1回の描画でまとめる）
+		/// @param world 単位形状からワールドへの変換
+		/// @param color 色
+		/// @param thickness 線の太さ
+		void DrawShapeInstance(LineShapeType type, int divisions, const MagMath::Matrix4x4 &world, const MagMath::Vector4 &color,
+							   float thickness = 1.0f);
+
 		/// @brief グリッドオフセットの設定
 		/// @param offset オフセット値
 		void SetGridOffset(const MagMath::Vector3 &offset) {
@@ -210,6 +257,51 @@ namespace MagEngine {
 			lineSetup_->SetDefaultCamera(camera);
 		}
 
+		///--------------------------------------------------------------
+		///						 単位形状
+	private:
+		/// @brief 同じ種類・分割数の形状をまとめたもの
+		struct LineShapeBatch {
+			std::vector<MagMath::Vector3> unitVertices; // 単位形状のライン（2頂点で1本。転送が済むまで保持）
+			uint32_t firstVertex = 0;					// 形状の頂点バッファ内の開始位置
+			uint32_t vertexCount = 0;					// 頂点数（0 は未作成）
+			bool isUploaded = false;					// 頂点バッファへの転送が済んだか
+			std::vector<LineShapeInstance> instances;	// 今フレームのインスタンス
+		};
+
+		/// @brief 単位円の (cos, sin) 表を取得（divisions + 1 個、初回のみ計算）
+		const std::vector<MagMath::Vector2> &GetUnitCircle(int divisions);
+
+		/// @brief 単位形状のライン表を作成
+		void BuildUnitShape(LineShapeType type, int divisions, std::vector<MagMath::Vector3> &outVertices);
+
+		/// @brief 新しく作った単位形状を頂点バッファへ転送するコマンドを積む
+		void UploadPendingShapes();
+
+		/// @brief インスタンスを形状ごとにまとめて描画し、インスタンスをクリア
+		void DrawShapeInstances();
+
+		///--------------------------------------------------------------
+		///						 呼び出し元ごとの集計
+	private:
+		/// @brief 呼び出し元ごとの頂点数
+		struct CallerStats {
+			const char *name = nullptr;
+			uint32_t vertexCount = 0;	  // 今フレーム
+			uint32_t lastVertexCount = 0; // 前フレーム
+			uint32_t peakVertexCount = 0; // 起動からの最大
+		};
+
+		/// @brief 現在の呼び出し元に頂点数を加算
+		void CountCallerVertices(uint32_t vertexCount);
+
+		/// @brief 今フレームの集計を確定
+		void ResolveCallerStats();
+
+		/// @brief 基底ベクトルと原点から変換行列を作成（行ベクトル形式）
+		static MagMath::Matrix4x4 MakeShapeMatrix(const MagMath::Vector3 &axisX, const MagMath::Vector3 &axisY,
+												  const MagMath::Vector3 &axisZ, const MagMath::Vector3 &origin);
+
 		///--------------------------------------------------------------
 		///						 メンバ変数
 	private:
@@ -258,5 +350,25 @@ namespace MagEngine {
 
 		// 球を描画するか
 		bool isDrawSphere_ = true;
+
+		//========================================
+		// 単位形状のキャッシュ（キーは種類と分割数）
+		std::unordered_map<uint32_t, LineShapeBatch> shapeBatches_;
+		// 単位形状の頂点バッファ（デフォルトヒープ。初期化時に作成し、形状を末尾に追記する）
+		static constexpr uint32_t kShapeVertexCapacity = 65536;
+		Microsoft::WRL::ComPtr<ID3D12Resource> shapeVertexBuffer_;
+		D3D12_VERTEX_BUFFER_VIEW shapeVertexBufferView_{};
+		uint32_t shapeVertexCount_ = 0;				  // 確保済みの頂点数
+		std::vector<uint32_t> pendingShapeUploads_;	  // 転送待ちの形状のキー
+		uint64_t shapeBufferReadSerial_ = UINT64_MAX; // 頂点バッファを読み取り状態にしたフレーム番号
+		std::unordered_map<int, std::vector<MagMath::Vector2>> unitCircleCache_;
+		std::unordered_map<int, std::vector<MagMath::Vector3>> lightRayCache_; // 光線数ごとの方向
+		uint32_t lastShapeDrawCount_ = 0;
+		uint32_t lastShapeInstanceCount_ = 0;
+
+		//========================================
+		// 呼び出し元ごとの集計（名前のポインタで区別する）
+		const char *currentCaller_ = nullptr;
+		std::vector<CallerStats> callerStats_;
 	};
 }
\ No newline at end of file
@@ -38,11 +38,20 @@ namespace MagEngine {
 		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
 	}
 
+	///=============================================================================
+	///						インスタンス描画の共通化処理
+	void LineSetup::CommonDrawSetupInstanced() {
+		auto commandList = dxCore_->GetCommandList();
+		commandList->SetGraphicsRootSignature(rootSignature_.Get());
+		commandList->SetPipelineState(instancedPipelineState_.Get());
+		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+	}
+
 	///=============================================================================
 	///						ルートシグネチャーの作成
 	void LineSetup::CreateRootSignature() {
 		// ルートパラメータの設定
-		D3D12_ROOT_PARAMETER rootParameters[1] = {};
+		D3D12_ROOT_PARAMETER rootParameters[2] = {};
 
 		// 定数バッファ（TransformationMatrix）の設定（b0、頂点シェーダーで使用）
 		rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -50,6 +59,12 @@ namespace MagEngine {
 		rootParameters[0].Descriptor.ShaderRegister = 0; // b0
 		rootParameters[0].Descriptor.RegisterSpace = 0;
 
+		// 単位形状のインスタンス（t0、インスタンス描画の頂点シェーダーでのみ使用）
+		rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+		rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+		rootParameters[1].Descriptor.ShaderRegister = 0; // t0
+		rootParameters[1].Descriptor.RegisterSpace = 0;
+
 		// ルートシグネチャの設定
 		D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
 		rootSignatureDesc.NumParameters = _countof(rootParameters);
@@ -175,5 +190,33 @@ namespace MagEngine {
 			throw std::runtime_error("Particle Failed to create graphics pipeline state :(");
 		}
 		Logger::Log("Particle Graphics pipeline state created successfully :)", Logger::LogLevel::Success);
+
+		//========================================
+		// 単位形状のインスタンス描画用PSO（頂点は位置のみ、色と変換はインスタンスから取る）
+		D3D12_INPUT_ELEMENT_DESC instancedElementDescs[1] = {};
+		instancedElementDescs[0].SemanticName = "POSITION";
+		instancedElementDescs[0].SemanticIndex = 0;
+		instancedElementDescs[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+		instancedElementDescs[0].InputSlot = 0;
+		instancedElementDescs[0].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+		instancedElementDescs[0].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+		instancedElementDescs[0].InstanceDataStepRate = 0;
+		graphicsPipelineStateDesc.InputLayout.pInputElementDescs = instancedElementDescs;
+		graphicsPipelineStateDesc.InputLayout.NumElements = _countof(instancedElementDescs);
+
+		Microsoft::WRL::ComPtr<IDxcBlob> instancedVertexShaderBlob = dxCore_->CompileShader(L"resources/shader/LineInstanced.VS.hlsl", L"vs_6_0");
+		if (!instancedVertexShaderBlob) {
+			Logger::Log("Line Failed to compile instanced vertex shader :(", Logger::LogLevel::Error);
+			throw std::runtime_error("Line Failed to compile instanced vertex shader :(");
+		}
+		graphicsPipelineStateDesc.VS = {instancedVertexShaderBlob->GetBufferPointer(), instancedVertexShaderBlob->GetBufferSize()};
+
+		hr = dxCore_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc,
+															   IID_PPV_ARGS(&instancedPipelineState_));
+		if (FAILED(hr)) {
+			Logger::Log("Line Failed to create instanced graphics pipeline state :(", Logger::LogLevel::Error);
+			throw std::runtime_error("Line Failed to create instanced graphics pipeline state :(");
+		}
+		Logger::Log("Line Instanced graphics pipeline state created successfully :)", Logger::LogLevel::Success);
 	}
 }
\ No newline at end of file
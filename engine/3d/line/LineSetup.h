@@ -30,6 +30,12 @@ namespace MagEngine {
 		*/
 		void CommonDrawSetup();
 
+		/**----------------------------------------------------------------------------
+		* \brief  CommonDrawSetupInstanced 単位形状のインスタンス描画用の共通描画設定
+		* \note   ルートシグネチャは共通（[0]:b0 変換行列 / [1]:t0 インスタンス）
+		*/
+		void CommonDrawSetupInstanced();
+
 		///--------------------------------------------------------------
 		///                         静的メンバ関数
 	private:
@@ -87,6 +93,8 @@ namespace MagEngine {
 		//========================================
 		// グラフィックスパイプライン
 		Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState_;
+		// 単位形状のインスタンス描画用
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> instancedPipelineState_;
 
 		//========================================
 		// デフォルトカメラ
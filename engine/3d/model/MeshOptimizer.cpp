@@ -0,0 +1,276 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	namespace MeshOptimizer {
+		namespace {
+			//========================================
+			// Forsyth のスコア定数
+			constexpr float kCacheDecayPower = 1.5f;
+			constexpr float kLastTriangleScore = 0.75f;
+			constexpr float kValenceBoostScale = 2.0f;
+			constexpr float kValenceBoostPower = 0.5f;
+			constexpr uint32_t kNotInCache = UINT32_MAX;
+
+			///=============================================================================
+			///						頂点のビット単位の比較・ハッシュ
+			static_assert(sizeof(MagMath::VertexData) == sizeof(float) * 9, "VertexData にパディングがあると比較できない");
+
+			struct VertexHash {
+				size_t operator()(const MagMath::VertexData &vertex) const {
+					// FNV-1a
+					const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&vertex);
+					uint64_t hash = 0xCBF29CE484222325ull;
+					for (size_t i = 0; i < sizeof(MagMath::VertexData); ++i) {
+						hash ^= bytes[i];
+						hash *= 0x100000001B3ull;
+					}
+					return static_cast<size_t>(hash);
+				}
+			};
+
+			struct VertexEqual {
+				bool operator()(const MagMath::VertexData &a, const MagMath::VertexData &b) const {
+					return std::memcmp(&a, &b, sizeof(MagMath::VertexData)) == 0;
+				}
+			};
+
+			///=============================================================================
+			///						頂点のスコア
+			float ComputeVertexScore(uint32_t cachePosition, uint32_t remainingTriangles) {
+				// 使い終わった頂点は選ばない
+				if (remainingTriangles == 0) {
+					return -1.0f;
+				}
+				float score = 0.0f;
+				if (cachePosition != kNotInCache) {
+					if (cachePosition < 3) {
+						// 直前の三角形の頂点は一律（同じ辺ばかり続くのを避ける）
+						score = kLastTriangleScore;
+					} else {
+						const float scaler = 1.0f / static_cast<float>(kVertexCacheSize - 3);
+						score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, kCacheDecayPower);
+					}
+				}
+				// 残りの三角形が少ない頂点を優先（取り残しを防ぐ）
+				score += kValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -kValenceBoostPower);
+				return score;
+			}
+		}
+
+		///=============================================================================
+		///						頂点の統合
+		void WeldVertices(const std::vector<MagMath::VertexData> &corners,
+						  std::vector<MagMath::VertexData> &outVertices, std::vector<uint32_t> &outIndices) {
+			outVertices.clear();
+			outIndices.clear();
+			outIndices.reserve(corners.size());
+			std::unordered_map<MagMath::VertexData, uint32_t, VertexHash, VertexEqual> lookup;
+			lookup.reserve(corners.size());
+			for (const MagMath::VertexData &corner : corners) {
+				auto [it, inserted] = lookup.try_emplace(corner, static_cast<uint32_t>(outVertices.size()));
+				if (inserted) {
+					outVertices.push_back(corner);
+				}
+				outIndices.push_back(it->second);
+			}
+		}
+
+		///=============================================================================
+		///						頂点キャッシュ最適化（Forsyth）
+		void OptimizeVertexCache(std::vector<uint32_t> &indices, uint32_t vertexCount) {
+			const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+			if (triangleCount == 0 || vertexCount == 0) {
+				return;
+			}
+
+			//========================================
+			// 頂点ごとの隣接三角形リスト（未使用の三角形を先頭側に詰めて持つ）
+			std::vector<uint32_t> remaining(vertexCount, 0);
+			for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+				++remaining[indices[i]];
+			}
+			std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+			for (uint32_t v = 0; v < vertexCount; ++v) {
+				adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+			}
+			std::vector<uint32_t> adjacency(adjacencyOffset[vertexCount]);
+			{
+				std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+				for (uint32_t t = 0; t < triangleCount; ++t) {
+					for (uint32_t k = 0; k < 3; ++k) {
+						adjacency[fill[indices[t * 3 + k]]++] = t;
+					}
+				}
+			}
+
+			//========================================
+			// スコアの初期化
+			std::vector<uint32_t> cachePosition(vertexCount, kNotInCache);
+			std::vector<float> vertexScore(vertexCount);
+			for (uint32_t v = 0; v < vertexCount; ++v) {
+				vertexScore[v] = ComputeVertexScore(kNotInCache, remaining[v]);
+			}
+			std::vector<float> triangleScore(triangleCount);
+			std::vector<uint8_t> emitted(triangleCount, 0);
+			uint32_t bestTriangle = 0;
+			for (uint32_t t = 0; t < triangleCount; ++t) {
+				triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+				if (triangleScore[t] > triangleScore[bestTriangle]) {
+					bestTriangle = t;
+				}
+			}
+
+			//========================================
+			// 三角形を1つずつ出力
+			std::vector<uint32_t> result;
+			result.reserve(triangleCount * 3);
+			std::vector<uint32_t> cache;
+			std::vector<uint32_t> nextCache;
+			cache.reserve(kVertexCacheSize + 3);
+			nextCache.reserve(kVertexCacheSize + 3);
+			uint32_t scanPosition = 0;
+
+			for (uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+				// 候補がない場合は未出力の三角形を先頭から探す
+				if (bestTriangle == kNotInCache) {
+					while (emitted[scanPosition]) {
+						++scanPosition;
+					}
+					bestTriangle = scanPosition;
+				}
+				const uint32_t *triangle = &indices[bestTriangle * 3];
+				emitted[bestTriangle] = 1;
+				result.insert(result.end(), triangle, triangle + 3);
+
+				//---------------------------------------
+				// 出力した三角形を各頂点の隣接リストから外す
+				for (uint32_t k = 0; k < 3; ++k) {
+					uint32_t v = triangle[k];
+					uint32_t *begin = &adjacency[adjacencyOffset[v]];
+					for (uint32_t i = 0; i < remaining[v]; ++i) {
+						if (begin[i] == bestTriangle) {
+							begin[i] = begin[remaining[v] - 1];
+							begin[remaining[v] - 1] = bestTriangle;
+							break;
+						}
+					}
+					--remaining[v];
+				}
+
+				//---------------------------------------
+				// キャッシュの更新（出力した頂点を先頭へ）
+				nextCache.assign(triangle, triangle + 3);
+				for (uint32_t v : cache) {
+					if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+						nextCache.push_back(v);
+					}
+				}
+				cache.swap(nextCache);
+				for (uint32_t i = 0; i < cache.size(); ++i) {
+					uint32_t v = cache[i];
+					cachePosition[v] = i < kVertexCacheSize ? i : kNotInCache;
+					vertexScore[v] = ComputeVertexScore(cachePosition[v], remaining[v]);
+				}
+
+				//---------------------------------------
+				// キャッシュ内の頂点に隣接する三角形のスコアを更新し、次の三角形を選ぶ
+				bestTriangle = kNotInCache;
+				float bestScore = -1.0f;
+				for (uint32_t v : cache) {
+					const uint32_t *begin = &adjacency[adjacencyOffset[v]];
+					for (uint32_t i = 0; i < remaining[v]; ++i) {
+						uint32_t t = begin[i];
+						const uint32_t *tri = &indices[t * 3];
+						triangleScore[t] = vertexScore[tri[0]] + vertexScore[tri[1]] + vertexScore[tri[2]];
+						if (triangleScore[t] > bestScore) {
+							bestScore = triangleScore[t];
+							bestTriangle = t;
+						}
+					}
+				}
+				// キャッシュからあふれた頂点を外す
+				if (cache.size() > kVertexCacheSize) {
+					cache.resize(kVertexCacheSize);
+				}
+			}
+
+			indices.swap(result);
+		}
+
+		///=============================================================================
+		///						頂点フェッチ最適化
+		void OptimizeVertexFetch(std::vector<MagMath::VertexData> &vertices, std::vector<uint32_t> &indices) {
+			std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+			std::vector<MagMath::VertexData> result;
+			result.reserve(vertices.size());
+			for (uint32_t &index : indices) {
+				if (remap[index] == UINT32_MAX) {
+					remap[index] = static_cast<uint32_t>(result.size());
+					result.push_back(vertices[index]);
+				}
+				index = remap[index];
+			}
+			// NOTE: どの三角形からも参照されない頂点はここで取り除かれる
+			vertices.swap(result);
+		}
+
+		///=============================================================================
+		///						平均キャッシュミス率
+		float ComputeACMR(const std::vector<uint32_t> &indices, uint32_t vertexCount, uint32_t cacheSize) {
+			const size_t triangleCount = indices.size() / 3;
+			if (triangleCount == 0) {
+				return 0.0f;
+			}
+			// FIFOキャッシュ：最後に読み込んだ時刻が cacheSize 以内ならヒット
+			std::vector<uint32_t> loadedAt(vertexCount, 0);
+			uint32_t time = cacheSize + 1;
+			uint32_t misses = 0;
+			for (uint32_t index : indices) {
+				if (time - loadedAt[index] > cacheSize) {
+					loadedAt[index] = time++;
+					++misses;
+				}
+			}
+			return static_cast<float>(misses) / static_cast<float>(triangleCount);
+		}
+
+		///=============================================================================
+		///						境界球
+		MagMath::BoundingSphere ComputeBoundingSphere(const std::vector<MagMath::VertexData> &vertices) {
+			MagMath::BoundingSphere sphere = {};
+			if (vertices.empty()) {
+				return sphere;
+			}
+			//========================================
+			// AABBの中心を球の中心にする
+			MagMath::Vector3 minPosition = {vertices[0].position.x, vertices[0].position.y, vertices[0].position.z};
+			MagMath::Vector3 maxPosition = minPosition;
+			for (const MagMath::VertexData &vertex : vertices) {
+				minPosition.x = std::min(minPosition.x, vertex.position.x);
+				minPosition.y = std::min(minPosition.y, vertex.position.y);
+				minPosition.z = std::min(minPosition.z, vertex.position.z);
+				maxPosition.x = std::max(maxPosition.x, vertex.position.x);
+				maxPosition.y = std::max(maxPosition.y, vertex.position.y);
+				maxPosition.z = std::max(maxPosition.z, vertex.position.z);
+			}
+			sphere.center = {(minPosition.x + maxPosition.x) * 0.5f, (minPosition.y + maxPosition.y) * 0.5f, (minPosition.z + maxPosition.z) * 0.5f};
+			//========================================
+			// 中心から最も遠い頂点までの距離を半径にする
+			float maxDistanceSq = 0.0f;
+			for (const MagMath::VertexData &vertex : vertices) {
+				const float dx = vertex.position.x - sphere.center.x;
+				const float dy = vertex.position.y - sphere.center.y;
+				const float dz = vertex.position.z - sphere.center.z;
+				maxDistanceSq = std::max(maxDistanceSq, dx * dx + dy * dy + dz * dz);
+			}
+			sphere.radius = std::sqrt(maxDistanceSq);
+			return sphere;
+		}
+	}
+}
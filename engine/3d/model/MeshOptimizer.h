@@ -0,0 +1,57 @@
+/*********************************************************************
+ * \file   MeshOptimizer.h
+ * \brief  メッシュの頂点統合と頂点キャッシュ最適化
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   三角形の角ごとに展開された頂点を同一頂点で統合してインデックス化し、
+ *         Forsyth の線形時間アルゴリズムで三角形の順番を並べ替える
+ *         GPUリソースには触れないため、GPUなしで動作を確認できる
+ *********************************************************************/
+#pragma once
+#include "BoundingSphere.h"
+#include "VertexData.h"
+#include <cstdint>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						メッシュ最適化
+	namespace MeshOptimizer {
+		//========================================
+		// 頂点キャッシュのサイズ（スコア計算と ACMR の計測に使う）
+		constexpr uint32_t kVertexCacheSize = 32;
+
+		/// \brief 同じ頂点を統合してインデックスリストを作成
+		/// \param corners 三角形の角ごとの頂点（3つで1三角形）
+		/// \param outVertices [out] 統合後の頂点
+		/// \param outIndices [out] 三角形リストのインデックス
+		/// \note 位置・UV・法線がビット単位で一致する頂点を同一とみなす
+		void WeldVertices(const std::vector<MagMath::VertexData> &corners,
+						  std::vector<MagMath::VertexData> &outVertices, std::vector<uint32_t> &outIndices);
+
+		/// \brief 頂点キャッシュのヒット率が上がるように三角形を並べ替える
+		/// \param indices [in,out] 三角形リストのインデックス
+		/// \param vertexCount 頂点数
+		void OptimizeVertexCache(std::vector<uint32_t> &indices, uint32_t vertexCount);
+
+		/// \brief インデックスで初めて参照される順に頂点を並べ替える（頂点フェッチの局所性向上）
+		/// \param vertices [in,out] 頂点
+		/// \param indices [in,out] 三角形リストのインデックス
+		void OptimizeVertexFetch(std::vector<MagMath::VertexData> &vertices, std::vector<uint32_t> &indices);
+
+		/// \brief 平均キャッシュミス率（1三角形あたりの頂点シェーダ実行数、FIFOキャッシュで計測）
+		/// \param indices 三角形リストのインデックス
+		/// \param vertexCount 頂点数
+		/// \param cacheSize キャッシュサイズ
+		/// \return 0.5～3.0（小さいほど良い）
+		float ComputeACMR(const std::vector<uint32_t> &indices, uint32_t vertexCount, uint32_t cacheSize = kVertexCacheSize);
+
+		/// \brief 頂点を包む境界球（AABBの中心から最も遠い頂点までの距離を半径とする）
+		/// \param vertices 頂点
+		/// \return ローカル座標の境界球（頂点が無い場合は半径0）
+		MagMath::BoundingSphere ComputeBoundingSphere(const std::vector<MagMath::VertexData> &vertices);
+	}
+}
@@ -7,6 +7,9 @@
  * \note
  *********************************************************************/
 #include "Model.h"
+#include "Logger.h"
+#include "MeshOptimizer.h"
+#include "ModelCache.h"
 #include "ModelSetup.h"
 //---------------------------------------
 // ファイル読み込み関数
@@ -22,18 +25,31 @@ namespace MagEngine {
 ///=============================================================================
 ///						初期化
 	void Model::Initialize(ModelSetup *modelSetup, const std::string &directorypath, const std::string &filename) {
-		// modelSetupから受け取る
-		modelSetup_ = modelSetup;
 		// モデルデータの読み込み
+		LoadData(directorypath, filename);
+		// GPUリソースの作成
+		CreateResources(modelSetup);
+	}
+
+	///=============================================================================
+	///						モデルデータの読み込み
+	void Model::LoadData(const std::string &directorypath, const std::string &filename) {
 		LoadModelFile(directorypath, filename);
+	}
+
+	///=============================================================================
+	///						GPUリソースの作成
+	void Model::CreateResources(ModelSetup *modelSetup) {
+		// modelSetupから受け取る
+		modelSetup_ = modelSetup;
 		// 頂点バッファの作成
 		CreateVertexBuffer();
+		// インデックスバッファの作成
+		CreateIndexBuffer();
 		// マテリアルバッファの作成
 		CreateMaterialBuffer();
-		// テクスチャの読み込み
-		TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
-		// テクスチャ番号を取得して、メンバ変数に格納
-		textureIndex_ = TextureManager::GetInstance()->GetTextureIndex(modelData_.material.textureFilePath);
+		// テクスチャの読み込み（ハンドルを保持し、描画時は文字列で検索しない）
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
 	}
 
 	///=============================================================================
@@ -45,7 +61,7 @@ namespace MagEngine {
 	///						描画
 	void Model::Draw() {
 
-		if(!vertexBuffer_ || !materialBuffer_) {
+		if(!vertexBuffer_ || !indexBuffer_ || !materialBuffer_) {
 			throw std::runtime_error("One or more buffers are not initialized.");
 		}
 		// コマンドリスト取得
@@ -53,48 +69,53 @@ namespace MagEngine {
 
 		// VertexBufferViewの設定
 		commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+		// IndexBufferViewの設定
+		commandList->IASetIndexBuffer(&indexBufferView_);
 		// マテリアルバッファの設定
 		commandList->SetGraphicsRootConstantBufferView(0, materialBuffer_->GetGPUVirtualAddress());
 
 		// SRVのDescriptorTableの設定
-		commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureFilePath));
+		commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_));
 
 		// 環境マップテクスチャの設定
 		if(modelSetup_->HasEnvironmentTexture()) {
-			commandList->SetGraphicsRootDescriptorTable(7, TextureManager::GetInstance()->GetSrvHandleGPU(modelSetup_->GetEnvironmentTexture()));
+			commandList->SetGraphicsRootDescriptorTable(7, TextureManager::GetInstance()->GetSrvHandleGPU(modelSetup_->GetEnvironmentTextureHandle()));
 		}
 
 		// 描画(DrawCall)
-		commandList->DrawInstanced(UINT(modelData_.vertices.size()), 1, 0, 0);
+		commandList->DrawIndexedInstanced(UINT(modelData_.indices.size()), 1, 0, 0, 0);
 	}
 
-	// TODO: この関数はどこで使われているのか？
 	///=============================================================================
 	///						インスタンシング描画
+	/// NOTE: インスタンスごとの変換行列は呼び出し側（Object3dSetup::FlushInstances）で設定する
 	void Model::InstancingDraw(uint32_t instanceCount) {
-		if(!vertexBuffer_ || !materialBuffer_) {
+		if(!vertexBuffer_ || !indexBuffer_ || !materialBuffer_) {
 			throw std::runtime_error("One or more buffers are not initialized.");
 		}
 		// コマンドリスト取得
 		auto commandList = modelSetup_->GetDXManager()->GetCommandList();
 		// VertexBufferViewの設定
 		commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+		// IndexBufferViewの設定
+		commandList->IASetIndexBuffer(&indexBufferView_);
 		// マテリアルバッファの設定
 		commandList->SetGraphicsRootConstantBufferView(0, materialBuffer_->GetGPUVirtualAddress());
 		// SRVのDescriptorTableの設定
-		commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureFilePath));
+		commandList->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_));
+		// 環境マップテクスチャの設定
+		if(modelSetup_->HasEnvironmentTexture()) {
+			commandList->SetGraphicsRootDescriptorTable(7, TextureManager::GetInstance()->GetSrvHandleGPU(modelSetup_->GetEnvironmentTextureHandle()));
+		}
 		// 描画(DrawCall)
-		commandList->DrawInstanced(6, instanceCount, 0, 0);
+		commandList->DrawIndexedInstanced(UINT(modelData_.indices.size()), instanceCount, 0, 0, 0);
 	}
 
 	///=============================================================================
 	///						テクスチャの変更
 	void Model::ChangeTexture(const std::string &textureFilePath) {
-		// 新しいテクスチャを読み込む
-		TextureManager::GetInstance()->LoadTexture(textureFilePath);
-
-		// 新しいテクスチャのインデックスを取得して設定
-		textureIndex_ = TextureManager::GetInstance()->GetTextureIndex(textureFilePath);
+		// 新しいテクスチャを読み込み、ハンドルを設定
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(textureFilePath);
 
 		// マテリアルデータを更新
 		modelData_.material.textureFilePath = textureFilePath;
@@ -125,12 +146,46 @@ namespace MagEngine {
 	}
 
 	///--------------------------------------------------------------
-	///						 OBJファイル読み込み関数
+	///						 モデルファイル読み込み関数
 	void Model::LoadModelFile(const std::string &directoryPath, const std::string &filename) {
+		const std::string filePath = directoryPath + "/" + filename;
+		//========================================
+		// キャッシュがあればそのまま使う
+		if(ModelCache::Load(filePath, modelData_)) {
+			modelData_.boundingSphere = MeshOptimizer::ComputeBoundingSphere(modelData_.vertices);
+			return;
+		}
+
+		//========================================
+		// Assimpで読み込み、頂点を統合してインデックス化
+		ImportModelFile(filePath);
+		const size_t cornerCount = modelData_.indices.size();
+		const float acmrBefore = MeshOptimizer::ComputeACMR(modelData_.indices, uint32_t(modelData_.vertices.size()));
+		//========================================
+		// 頂点キャッシュ・頂点フェッチの最適化
+		MeshOptimizer::OptimizeVertexCache(modelData_.indices, uint32_t(modelData_.vertices.size()));
+		MeshOptimizer::OptimizeVertexFetch(modelData_.vertices, modelData_.indices);
+		const float acmrAfter = MeshOptimizer::ComputeACMR(modelData_.indices, uint32_t(modelData_.vertices.size()));
+		//========================================
+		// カリング用の境界球
+		modelData_.boundingSphere = MeshOptimizer::ComputeBoundingSphere(modelData_.vertices);
+		Logger::Log("Model imported: " + filePath + " (" + std::to_string(cornerCount) + " corners -> " +
+						std::to_string(modelData_.vertices.size()) + " vertices, ACMR " + std::to_string(acmrBefore) +
+						" -> " + std::to_string(acmrAfter) + ")",
+					Logger::LogLevel::Info);
+		//========================================
+		// キャッシュの書き込み（失敗しても次回また読み込むだけ）
+		if(!ModelCache::Save(filePath, modelData_)) {
+			Logger::Log("ModelCache: failed to write cache for " + filePath, Logger::LogLevel::Warning);
+		}
+	}
+
+	///--------------------------------------------------------------
+	///						 Assimpでの読み込み
+	void Model::ImportModelFile(const std::string &filePath) {
 		//========================================
 		// Assimpインポーターの作成
 		Assimp::Importer importer;
-		const std::string filePath = directoryPath + "/" + filename;
 		const aiScene *scene = importer.ReadFile(filePath, aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
 		//========================================
 		// 読み込みエラーのチェック
@@ -138,6 +193,9 @@ namespace MagEngine {
 		//========================================
 		// シーンの階層構造を構築
 
+		//========================================
+		// 三角形の角ごとに展開した頂点
+		std::vector<MagMath::VertexData> corners;
 		//========================================
 		// メッシュの取得
 		for(uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
@@ -166,7 +224,7 @@ namespace MagEngine {
 					// aiProcess_MakeLeftHandedはz* = -1で､右手系から左手系に変換するため手動で対処
 					vertexData.position.z *= -1.0f;
 					vertexData.normal.z *= -1.0f;
-					modelData_.vertices.push_back(vertexData);
+					corners.push_back(vertexData);
 				}
 			}
 			//---------------------------------------
@@ -182,7 +240,9 @@ namespace MagEngine {
 				}
 			}
 		}
-
+		//========================================
+		// 同じ頂点を統合してインデックス化
+		MeshOptimizer::WeldVertices(corners, modelData_.vertices, modelData_.indices);
 	}
 
 	///--------------------------------------------------------------
@@ -242,6 +302,24 @@ namespace MagEngine {
 		std::memcpy(vertexData, modelData_.vertices.data(), sizeof(MagMath::VertexData) * modelData_.vertices.size());
 	}
 
+	///--------------------------------------------------------------
+	///						 インデックスデータの作成
+	void Model::CreateIndexBuffer() {
+		//========================================
+		// インデックスリソースを作る
+		indexBuffer_ = modelSetup_->GetDXManager()->CreateBufferResource(sizeof(uint32_t) * modelData_.indices.size());
+		//========================================
+		// インデックスバッファビューを作成する
+		indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+		indexBufferView_.SizeInBytes = UINT(sizeof(uint32_t) * modelData_.indices.size());
+		indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+		//========================================
+		// インデックスリソースにデータを書き込む
+		uint32_t *indexData = nullptr;
+		indexBuffer_->Map(0, nullptr, reinterpret_cast<void **>( &indexData ));
+		std::memcpy(indexData, modelData_.indices.data(), sizeof(uint32_t) * modelData_.indices.size());
+	}
+
 	///--------------------------------------------------------------
 	///						 マテリアルデータの作成
 	void Model::CreateMaterialBuffer() {
@@ -4,10 +4,12 @@
  *
  * \author Harukichimaru
  * \date   November 2024
- * \note
+ * \note   読み込んだメッシュは同一頂点を統合したインデックス付きで描画する
+ *         統合・並べ替え済みのデータは ModelCache に保存し、次回からは Assimp を通さない
  *********************************************************************/
 #pragma once
 #include "MagMath.h"
+#include "TextureHandle.h"
 //========================================
 // DX12include
 #include <d3d12.h>
@@ -36,14 +38,20 @@ namespace MagEngine {
 		/// \brief 初期化
 		void Initialize(ModelSetup *modelSetup, const std::string &directorypath, const std::string &filename);
 
+		/// \brief モデルデータの読み込み（GPUに触れないため、ワーカースレッドから呼んでよい）
+		void LoadData(const std::string &directorypath, const std::string &filename);
+
+		/// \brief GPUリソースの作成とテクスチャの読み込み（LoadData の後にメインスレッドから呼ぶ）
+		void CreateResources(ModelSetup *modelSetup);
+
 		/// \brief 更新
 		void Update();
 
 		/// \brief 描画
 		void Draw();
 
-		// TODO: この関数はどこで使われているのか？
-		/// @brief インスタンス描画
+		/// @brief インスタンス描画（Object3dSetup::FlushInstances から呼ばれる）
+		/// @param instanceCount インスタンス数
 		void InstancingDraw(uint32_t instanceCount);
 
 		/// \brief テクスチャの変更
@@ -62,13 +70,19 @@ namespace MagEngine {
 		MagMath::MaterialData LoadMaterialTemplateFile(const std::string &directoryPath, const std::string &filename);
 
 		/**----------------------------------------------------------------------------
-		 * \brief  LoadObjFile .objファイル読み込み
+		 * \brief  LoadModelFile モデルファイル読み込み
 		 * \param  directoryPath ディレクトリパス
 		 * \param  filename ファイルネーム
-		 * \note   そのままmodelDataに格納
+		 * \note   キャッシュがあればそれを使い、無ければ Assimp で読み込んで最適化しキャッシュを作る
 		 */
 		void LoadModelFile(const std::string &directoryPath, const std::string &filename);
 
+		/**----------------------------------------------------------------------------
+		 * \brief  ImportModelFile Assimpで読み込み、頂点を統合してインデックス化
+		 * \param  filePath ファイルパス
+		 */
+		void ImportModelFile(const std::string &filePath);
+
 		/// @brief ReadNode ノードの読み込み
 		/// @param node ノード
 		/// @return ノードデータ
@@ -80,6 +94,12 @@ namespace MagEngine {
 		 */
 		void CreateVertexBuffer();
 
+		/**----------------------------------------------------------------------------
+		 * \brief  インデックスバッファの作成
+		 * \note
+		 */
+		void CreateIndexBuffer();
+
 		/**----------------------------------------------------------------------------
 		 * \brief  マテリアルバッファの作成
 		 * \note
@@ -153,6 +173,22 @@ namespace MagEngine {
 			return materialData_->environmentMapStrength;
 		}
 
+		/**----------------------------------------------------------------------------
+		 * \brief  GetTextureFilePath テクスチャのファイルパス取得
+		 * \return
+		 */
+		const std::string &GetTextureFilePath() const {
+			return modelData_.material.textureFilePath;
+		}
+
+		/**----------------------------------------------------------------------------
+		 * \brief  GetBoundingSphere ローカル座標の境界球の取得（読み込み時に計算済み）
+		 * \return
+		 */
+		const MagMath::BoundingSphere &GetBoundingSphere() const {
+			return modelData_.boundingSphere;
+		}
+
 		///--------------------------------------------------------------
 		///							メンバ変数
 	private:
@@ -167,6 +203,8 @@ namespace MagEngine {
 		//---------------------------------------
 		// 頂点データ
 		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+		// インデックス
+		Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
 		// マテリアル
 		Microsoft::WRL::ComPtr<ID3D12Resource> materialBuffer_;
 
@@ -181,9 +219,11 @@ namespace MagEngine {
 		/// バッファリソースの使い道を指すポインタ
 		// 頂点
 		D3D12_VERTEX_BUFFER_VIEW vertexBufferView_ = {};
+		// インデックス
+		D3D12_INDEX_BUFFER_VIEW indexBufferView_ = {};
 
 		//---------------------------------------
 		// テクスチャ用変数
-		uint32_t textureIndex_ = 0;
+		TextureHandle textureHandle_;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "ModelCache.h"
+#include "Logger.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	namespace ModelCache {
+		namespace {
+			//========================================
+			// ファイル先頭のヘッダ（この後にテクスチャパス、頂点、インデックスが続く）
+			struct Header {
+				uint32_t magic;
+				uint32_t version;
+				uint32_t vertexStride;
+				uint32_t textureFilePathLength;
+				uint64_t sourceSize;
+				int64_t sourceWriteTime;
+				uint32_t vertexCount;
+				uint32_t indexCount;
+			};
+
+			/// \brief 頂点データの先頭オフセット（4バイト境界に揃える）
+			size_t GetVertexOffset(const Header &header) {
+				return (sizeof(Header) + header.textureFilePathLength + 3) & ~size_t(3);
+			}
+
+			/// \brief 元ファイルのサイズと更新時刻
+			bool GetSourceStamp(const std::string &sourcePath, uint64_t &outSize, int64_t &outWriteTime) {
+				std::error_code ec;
+				outSize = std::filesystem::file_size(sourcePath, ec);
+				if (ec) {
+					return false;
+				}
+				auto writeTime = std::filesystem::last_write_time(sourcePath, ec);
+				if (ec) {
+					return false;
+				}
+				outWriteTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+				return true;
+			}
+
+			///=============================================================================
+			///						読み取り専用のファイルマッピング
+			class MappedFile {
+			public:
+				explicit MappedFile(const std::string &path) {
+					file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+										FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+					if (file_ == INVALID_HANDLE_VALUE) {
+						return;
+					}
+					LARGE_INTEGER fileSize{};
+					if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0) {
+						return;
+					}
+					mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if (!mapping_) {
+						return;
+					}
+					data_ = static_cast<const uint8_t *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+					if (data_) {
+						size_ = static_cast<size_t>(fileSize.QuadPart);
+					}
+				}
+				~MappedFile() {
+					if (data_) {
+						UnmapViewOfFile(data_);
+					}
+					if (mapping_) {
+						CloseHandle(mapping_);
+					}
+					if (file_ != INVALID_HANDLE_VALUE) {
+						CloseHandle(file_);
+					}
+				}
+				MappedFile(const MappedFile &) = delete;
+				MappedFile &operator=(const MappedFile &) = delete;
+
+				const uint8_t *GetData() const {
+					return data_;
+				}
+				size_t GetSize() const {
+					return size_;
+				}
+
+			private:
+				HANDLE file_ = INVALID_HANDLE_VALUE;
+				HANDLE mapping_ = nullptr;
+				const uint8_t *data_ = nullptr;
+				size_t size_ = 0;
+			};
+		}
+
+		///=============================================================================
+		///						キャッシュのパス
+		std::string GetCachePath(const std::string &sourcePath) {
+			return sourcePath + ".mgmesh";
+		}
+
+		///=============================================================================
+		///						読み込み
+		bool Load(const std::string &sourcePath, MagMath::ModelData &outData) {
+			uint64_t sourceSize = 0;
+			int64_t sourceWriteTime = 0;
+			if (!GetSourceStamp(sourcePath, sourceSize, sourceWriteTime)) {
+				return false;
+			}
+			MappedFile file(GetCachePath(sourcePath));
+			if (!file.GetData() || file.GetSize() < sizeof(Header)) {
+				return false;
+			}
+
+			//========================================
+			// ヘッダの検証
+			Header header;
+			std::memcpy(&header, file.GetData(), sizeof(Header));
+			if (header.magic != kMagic || header.version != kVersion ||
+				header.vertexStride != sizeof(MagMath::VertexData) ||
+				header.sourceSize != sourceSize || header.sourceWriteTime != sourceWriteTime) {
+				return false;
+			}
+			const size_t vertexOffset = GetVertexOffset(header);
+			const size_t vertexBytes = sizeof(MagMath::VertexData) * header.vertexCount;
+			const size_t indexBytes = sizeof(uint32_t) * header.indexCount;
+			if (file.GetSize() < vertexOffset + vertexBytes + indexBytes) {
+				Logger::Log("ModelCache: truncated cache for " + sourcePath, Logger::LogLevel::Warning);
+				return false;
+			}
+
+			//========================================
+			// マップした領域から取り出す
+			const uint8_t *data = file.GetData();
+			outData.material.textureFilePath.assign(reinterpret_cast<const char *>(data + sizeof(Header)), header.textureFilePathLength);
+			outData.vertices.resize(header.vertexCount);
+			std::memcpy(outData.vertices.data(), data + vertexOffset, vertexBytes);
+			outData.indices.resize(header.indexCount);
+			std::memcpy(outData.indices.data(), data + vertexOffset + vertexBytes, indexBytes);
+			return true;
+		}
+
+		///=============================================================================
+		///						書き込み
+		bool Save(const std::string &sourcePath, const MagMath::ModelData &data) {
+			Header header{};
+			header.magic = kMagic;
+			header.version = kVersion;
+			header.vertexStride = sizeof(MagMath::VertexData);
+			header.textureFilePathLength = static_cast<uint32_t>(data.material.textureFilePath.size());
+			header.vertexCount = static_cast<uint32_t>(data.vertices.size());
+			header.indexCount = static_cast<uint32_t>(data.indices.size());
+			if (!GetSourceStamp(sourcePath, header.sourceSize, header.sourceWriteTime)) {
+				return false;
+			}
+
+			//========================================
+			// 一時ファイルに書いてから置き換える（途中で落ちても壊れたキャッシュを残さない）
+			const std::string cachePath = GetCachePath(sourcePath);
+			const std::string tempPath = cachePath + ".tmp";
+			{
+				std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+				if (!file) {
+					return false;
+				}
+				file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+				file.write(data.material.textureFilePath.data(), header.textureFilePathLength);
+				const char padding[4] = {};
+				file.write(padding, GetVertexOffset(header) - sizeof(Header) - header.textureFilePathLength);
+				file.write(reinterpret_cast<const char *>(data.vertices.data()), sizeof(MagMath::VertexData) * data.vertices.size());
+				file.write(reinterpret_cast<const char *>(data.indices.data()), sizeof(uint32_t) * data.indices.size());
+				if (!file) {
+					return false;
+				}
+			}
+			std::error_code ec;
+			std::filesystem::rename(tempPath, cachePath, ec);
+			if (ec) {
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,42 @@
+/*********************************************************************
+ * \file   ModelCache.h
+ * \brief  インポート済みメッシュのバイナリキャッシュ
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   統合・最適化済みの頂点とインデックスを元ファイルの隣（"<元ファイル>.mgmesh"）に保存する
+ *         元ファイルのサイズと更新時刻が一致する場合のみ使用し、一致しなければ作り直す
+ *         .mtl だけを編集した場合はキャッシュを削除すること
+ *********************************************************************/
+#pragma once
+#include "ModelData.h"
+#include <cstdint>
+#include <string>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						モデルキャッシュ
+	namespace ModelCache {
+		//========================================
+		// ファイル識別子とバージョン（形式や頂点レイアウトを変えたら上げる）
+		constexpr uint32_t kMagic = 0x4853454Du; // "MESH"
+		constexpr uint32_t kVersion = 1;
+
+		/// \brief 元ファイルに対応するキャッシュのパス
+		std::string GetCachePath(const std::string &sourcePath);
+
+		/// \brief キャッシュを読み込む（ファイルをメモリにマップして読む）
+		/// \param sourcePath 元ファイルのパス
+		/// \param outData [out] 頂点・インデックス・テクスチャパス
+		/// \return キャッシュが無い・古い・壊れている場合は false
+		bool Load(const std::string &sourcePath, MagMath::ModelData &outData);
+
+		/// \brief キャッシュを書き込む
+		/// \param sourcePath 元ファイルのパス
+		/// \param data 頂点・インデックス・テクスチャパス
+		/// \return 書き込みに失敗した場合は false（読み込みには影響しない）
+		bool Save(const std::string &sourcePath, const MagMath::ModelData &data);
+	}
+}
@@ -7,6 +7,7 @@
  * \note
  *********************************************************************/
 #include "ModelManager.h"
+#include "TextureManager.h"
  ///=============================================================================
  ///                        namespace MagEngine
 namespace MagEngine {
@@ -42,6 +43,14 @@ namespace MagEngine {
 			//早期リターン！
 			return;
 		}
+		//========================================
+		// 非同期読み込み中なら完了を待つ
+		auto pending = pendingModels_.find(filePath);
+		if(pending != pendingModels_.end()) {
+			AssetLoadHandle handle = pending->second;
+			AssetLoader::GetInstance()->Wait(handle);
+			return;
+		}
 
 		//========================================
 		// モデルの生成とファイル読み込み、初期化
@@ -53,6 +62,51 @@ namespace MagEngine {
 		models_.insert(std::make_pair(filePath, std::move(model)));
 	}
 
+	///=============================================================================
+	///						モデルの非同期読み込み
+	AssetLoadHandle ModelManager::LoadModelAsync(const std::string &filePath) {
+		//========================================
+		// 読み込み済み・読み込み中の場合はそのハンドル
+		if(models_.contains(filePath)) {
+			return AssetLoadHandle::MakeReady();
+		}
+		auto pending = pendingModels_.find(filePath);
+		if(pending != pendingModels_.end()) {
+			return pending->second;
+		}
+
+		//========================================
+		// モデルとテクスチャのデコードはワーカー、GPUリソースの作成はメインスレッドで行う
+		// テクスチャのパスはモデルを読むまで分からないため、登録済みかの確認はワーカーで行う
+		// NOTE: 登録済みのテクスチャはデコードしない。読み込み中同士が重なった場合のみデコードは重複するが登録は1度だけ
+		struct PendingModel {
+			std::unique_ptr<Model> model;
+			DirectX::ScratchImage texture;
+			bool isTextureDecoded = false;
+		};
+		auto pendingModel = std::make_shared<PendingModel>();
+		pendingModel->model = std::make_unique<Model>();
+		AssetLoadHandle handle = AssetLoader::GetInstance()->Enqueue(
+			[pendingModel, filePath]() {
+				pendingModel->model->LoadData("resources/model", filePath);
+				const std::string &texturePath = pendingModel->model->GetTextureFilePath();
+				if(!TextureManager::GetInstance()->IsTextureLoaded(texturePath)) {
+					TextureManager::GetInstance()->DecodeTexture(texturePath, pendingModel->texture);
+					pendingModel->isTextureDecoded = true;
+				}
+			},
+			[this, pendingModel, filePath]() {
+				if(pendingModel->isTextureDecoded) {
+					TextureManager::GetInstance()->RegisterTexture(pendingModel->model->GetTextureFilePath(), pendingModel->texture);
+				}
+				pendingModel->model->CreateResources(modelSetup_.get());
+				models_.insert(std::make_pair(filePath, std::move(pendingModel->model)));
+				pendingModels_.erase(filePath);
+			});
+		pendingModels_[filePath] = handle;
+		return handle;
+	}
+
 	///=============================================================================
 	///						モデルデータの検索
 	Model *ModelManager::FindModel(const std::string &filePath) {
@@ -9,6 +9,7 @@
 #pragma once
 //========================================
 // 自作ヘッダファイル
+#include "AssetLoader.h"
 #include "Model.h"
 #include "ModelSetup.h"
 //========================================
@@ -42,10 +43,18 @@ namespace MagEngine {
 		/**----------------------------------------------------------------------------
 		 * \brief  LoadMedel モデルの読み込み
 		 * \param  filePath ファイルパス
-		 * \note
+		 * \note   非同期読み込み中のモデルは完了を待つ
 		 */
 		void LoadModel(const std::string &filePath);
 
+		/**----------------------------------------------------------------------------
+		 * \brief  LoadModelAsync モデルの非同期読み込み
+		 * \param  filePath ファイルパス
+		 * \return 読み込みハンドル（GPUリソースの作成まで終わると Ready）
+		 * \note   モデルとテクスチャのデコードはワーカーで行い、Ready になるまで FindModel は nullptr を返す
+		 */
+		AssetLoadHandle LoadModelAsync(const std::string &filePath);
+
 		/**----------------------------------------------------------------------------
 		 * \brief  FindModel モデルデータの検索
 		 * \param  filePath ファイルパス
@@ -91,5 +100,7 @@ namespace MagEngine {
 		// モデルデータコンテナ
 		// NOTE:vectorだと検索が遅いのでmapを使う
 		std::map<std::string, std::unique_ptr<Model>> models_;
+		// 非同期読み込み中のモデル
+		std::map<std::string, AssetLoadHandle> pendingModels_;
 	};
 }
\ No newline at end of file
@@ -28,8 +28,9 @@ namespace MagEngine {
 
 		//========================================
 		// テクスチャの読み込み
+		environmentTextureHandle_ = TextureHandle{};
 		if(!texturePath.empty()) {
-			TextureManager::GetInstance()->LoadTexture(texturePath);
+			environmentTextureHandle_ = TextureManager::GetInstance()->LoadTexture(texturePath);
 		}
 	}
 }
\ No newline at end of file
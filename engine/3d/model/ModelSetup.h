@@ -8,6 +8,7 @@
  *********************************************************************/
 #pragma once
 #include "DirectXCore.h"
+#include "TextureHandle.h"
 #include <string>
  ///=============================================================================
  ///                        namespace MagEngine
@@ -58,6 +59,15 @@ namespace MagEngine {
 			return !environmentTexturePath_.empty();
 		}
 
+		/**----------------------------------------------------------------------------
+		 * \brief  GetEnvironmentTextureHandle 環境マップテクスチャのハンドル取得
+		 * \return
+		 * \note
+		 */
+		TextureHandle GetEnvironmentTextureHandle() const {
+			return environmentTextureHandle_;
+		}
+
 		///--------------------------------------------------------------
 		///							メンバ変数
 	private:
@@ -68,5 +78,6 @@ namespace MagEngine {
 		//---------------------------------------
 		// 環境マップテクスチャパス
 		std::string environmentTexturePath_;
+		TextureHandle environmentTextureHandle_;
 	};
 }
\ No newline at end of file
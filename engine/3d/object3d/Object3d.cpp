@@ -8,6 +8,7 @@
  *********************************************************************/
 #include "Object3d.h"
 #include "Camera.h"
+#include "CullingManager.h"
 #include "LightManager.h"
 #include "Object3dSetup.h"
 //---------------------------------------
@@ -19,10 +20,19 @@
 #include "AffineTransformations.h"
 #include "MathFunc4x4.h"
 #include "TextureManager.h"
+#include <cassert>
 #include <cmath>
 ///=============================================================================
 ///                        namespace MagEngine
 namespace MagEngine {
+	///=============================================================================
+	///						デストラクタ
+	Object3d::~Object3d() {
+		if (transformNode_ != TransformHierarchy::kInvalidNode) {
+			TransformHierarchy::GetInstance()->DestroyNode(transformNode_);
+		}
+	}
+
 	///=============================================================================
 	///						初期化
 	void Object3d::Initialize(Object3dSetup *object3dSetup) {
@@ -45,6 +55,30 @@ namespace MagEngine {
 		//========================================
 		// ワールド行列の初期化
 		transform_ = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+		if (transformNode_ == TransformHierarchy::kInvalidNode) {
+			transformNode_ = TransformHierarchy::GetInstance()->CreateNode();
+		}
+
+		//========================================
+		// カメラの取得
+		camera_ = object3dSetup_->GetDefaultCamera();
+	}
+
+	///=============================================================================
+	///						インスタンス描画用の初期化
+	void Object3d::InitializeInstanced(Object3dSetup *object3dSetup) {
+		//========================================
+		// 引数からSetupを受け取る
+		this->object3dSetup_ = object3dSetup;
+		// NOTE: 変換行列は Object3dSetup がフレーム毎にアップロードリングへまとめて書き込む
+		isInstanced_ = true;
+
+		//========================================
+		// ワールド行列の初期化
+		transform_ = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+		if (transformNode_ == TransformHierarchy::kInvalidNode) {
+			transformNode_ = TransformHierarchy::GetInstance()->CreateNode();
+		}
 
 		//========================================
 		// カメラの取得
@@ -55,54 +89,99 @@ namespace MagEngine {
 	///						更新
 	void Object3d::Update() {
 		//========================================
-		// カメラの位置を取得
+		// カメラの取得
 		camera_ = object3dSetup_->GetDefaultCamera();
-		// カメラの位置を書き込む
-		cameraData_->worldPosition = camera_->GetTransform().translate;
 
 		//========================================
-		// ライトの位置を取得
-		// 並行光源
-		*directionalLightData_ = object3dSetup_->GetLightManager()->GetDirectionalLight();
-		// 点光源
-		*pointLightData_ = object3dSetup_->GetLightManager()->GetPointLight();
-		// スポットライト
-		*spotLightData_ = object3dSetup_->GetLightManager()->GetSpotLight();
+		// カメラとライトを書き込む（インスタンス描画用は Object3dSetup で共有するため不要）
+		if (!isInstanced_) {
+			// カメラの位置を書き込む
+			cameraData_->worldPosition = camera_->GetTransform().translate;
+			// 並行光源
+			*directionalLightData_ = object3dSetup_->GetLightManager()->GetDirectionalLight();
+			// 点光源
+			*pointLightData_ = object3dSetup_->GetLightManager()->GetPointLight();
+			// スポットライト
+			*spotLightData_ = object3dSetup_->GetLightManager()->GetSpotLight();
+		}
+
+		//========================================
+		// 階層へトランスフォームを渡す（前回と同じ値ならダーティにならない）
+		// NOTE: 行列は描画直前に UpdateMatrices でまとめて求める
+		TransformHierarchy::GetInstance()->SetLocalTransform(transformNode_, transform_);
+	}
+
+	///=============================================================================
+	///						変換行列の更新
+	void Object3d::UpdateMatrices() {
+		//========================================
+		// 階層に変更が残っていれば先に反映する（通常は MagFramework::Update で反映済み）
+		TransformHierarchy *hierarchy = TransformHierarchy::GetInstance();
+		if (hierarchy->IsDirty()) {
+			hierarchy->Update();
+		}
+
+		//========================================
+		// ワールド行列もカメラも前回から変わっていなければ何もしない
+		const uint32_t worldVersion = hierarchy->GetWorldVersion(transformNode_);
+		const uint32_t viewProjectionVersion = camera_ ? camera_->GetViewProjectionVersion() : 0;
+		if (worldVersion == matrixWorldVersion_ && camera_ == matrixCamera_ && viewProjectionVersion == matrixViewProjectionVersion_) {
+			return;
+		}
+		matrixWorldVersion_ = worldVersion;
+		matrixCamera_ = camera_;
+		matrixViewProjectionVersion_ = viewProjectionVersion;
 
 		//========================================
-		// TransformからWorld行列を作成
-		MagMath::Matrix4x4 worldMatrix = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
-		MagMath::Matrix4x4 worldViewProjectionMatrix;
+		// ワールド行列と逆行列は階層で計算済みのものを使う
+		const MagMath::Matrix4x4 &worldMatrix = hierarchy->GetWorldMatrix(transformNode_);
+		transformationMatrix_.World = worldMatrix;
+		transformationMatrix_.WorldInvTranspose = hierarchy->GetWorldInverseMatrix(transformNode_);
 
 		//========================================
-		// カメラがセットされている場合はビュー行列を作成
+		// カメラがセットされている場合はビュープロジェクション行列を掛ける
 		if (camera_) {
-			// カメラのビュー行列を取得
-			const MagMath::Matrix4x4 &viewProjectionMatrix = camera_->GetViewProjectionMatrix();
-			// ワールドビュープロジェクション行列を計算
-			worldViewProjectionMatrix = Multiply4x4(worldMatrix, viewProjectionMatrix);
+			transformationMatrix_.WVP = Multiply4x4(worldMatrix, camera_->GetViewProjectionMatrix());
 		} else {
 			// カメラがセットされていない場合はワールド行列をそのまま使う
 			// NOTE:カメラがセットされてなくても描画できるようにするため
-			worldViewProjectionMatrix = worldMatrix;
+			transformationMatrix_.WVP = worldMatrix;
 		}
 		//========================================
-		// トランスフォーメーションマトリックスバッファに書き込む
-		transformationMatrixData_->WVP = worldViewProjectionMatrix;
-		transformationMatrixData_->World = worldMatrix;
-		transformationMatrixData_->WorldInvTranspose = Inverse4x4(worldMatrix);
+		// バッファを持つ場合は書き込む
+		if (transformationMatrixData_) {
+			*transformationMatrixData_ = transformationMatrix_;
+		}
 	}
 
 	///=============================================================================
 	///						描画
 	// NOTE:見た目を持たないオブジェクトが存在する
 	void Object3d::Draw() {
+		//========================================
+		// 変換行列の更新（変化が無ければ何もしない）
+		UpdateMatrices();
+
+		//========================================
+		// インスタンス描画用はバッチに登録し、Object3dSetup::FlushInstances でまとめて描画する
+		if (isInstanced_) {
+			object3dSetup_->SubmitInstance(model_, transformationMatrix_);
+			return;
+		}
+
 		//========================================
 		// モデルが存在しない場合は描画しない
 		if (!transformationMatrixBuffer_) {
 			throw std::runtime_error("One or more buffers are not initialized.");
 		}
 
+		//========================================
+		// 視錐台・描画距離の外なら描画しない
+		if (model_ && !CullingManager::GetInstance()->IsVisible(CullingCategory::Object3d,
+																  TransformBoundingSphere(model_->GetBoundingSphere(), transformationMatrix_.World))) {
+			return;
+		}
+
 		//========================================
 		// コマンドリスト取得
 		auto commandList = object3dSetup_->GetDXManager()->GetCommandList();
@@ -124,6 +203,84 @@ namespace MagEngine {
 		}
 	}
 
+	///=============================================================================
+	///						並行光源の設定
+	void Object3d::SetDirectionalLight(const MagMath::Vector4 &color, const MagMath::Vector3 &direction, float intensity) {
+		// インスタンス描画用はライトを LightManager で共有しているため個別に設定できない
+		assert(!isInstanced_ && "Object3d: instanced objects use the LightManager lights.");
+		if (isInstanced_) {
+			return;
+		}
+		directionalLightData_->color = color;
+		directionalLightData_->direction = direction;
+		directionalLightData_->intensity = intensity;
+	}
+
+	///=============================================================================
+	///						並行光源の取得
+	const MagMath::DirectionalLight &Object3d::GetDirectionalLight() const {
+		if (isInstanced_) {
+			assert(object3dSetup_->GetLightManager());
+			return object3dSetup_->GetLightManager()->GetDirectionalLight();
+		}
+		return *directionalLightData_;
+	}
+
+	///=============================================================================
+	///						ポイントライトの設定
+	void Object3d::SetPointLight(const MagMath::Vector4 &color, const MagMath::Vector3 &position, float intensity,
+								 float radius, float decay) {
+		assert(!isInstanced_ && "Object3d: instanced objects use the LightManager lights.");
+		if (isInstanced_) {
+			return;
+		}
+		pointLightData_->color = color;
+		pointLightData_->position = position;
+		pointLightData_->intensity = intensity;
+		pointLightData_->radius = radius;
+		pointLightData_->decay = decay;
+	}
+
+	///=============================================================================
+	///						ポイントライトの取得
+	const MagMath::PointLight &Object3d::GetPointLight() const {
+		if (isInstanced_) {
+			assert(object3dSetup_->GetLightManager());
+			return object3dSetup_->GetLightManager()->GetPointLight();
+		}
+		return *pointLightData_;
+	}
+
+	///=============================================================================
+	///						スポットライトの設定
+	void Object3d::SetSpotLight(const MagMath::Vector4 &color, const MagMath::Vector3 &position,
+								const MagMath::Vector3 &direction, float intensity,
+								float distance, float decay, float angle) {
+		assert(!isInstanced_ && "Object3d: instanced objects use the LightManager lights.");
+		if (isInstanced_) {
+			return;
+		}
+		spotLightData_->color = color;
+		spotLightData_->position = position;
+		spotLightData_->direction = direction;
+		spotLightData_->intensity = intensity;
+		spotLightData_->distance = distance;
+		spotLightData_->decay = decay;
+		// 内側の角度（完全に明るい領域）と外側の角度（フェード開始）を設定
+		spotLightData_->cosFalloffStart = cosf(angle * 0.7f); // 内側: 70%の角度
+		spotLightData_->cosFalloffEnd = cosf(angle);		  // 外側: 設定角度
+	}
+
+	///=============================================================================
+	///						スポットライトの取得
+	const MagMath::SpotLight &Object3d::GetSpotLight() const {
+		if (isInstanced_) {
+			assert(object3dSetup_->GetLightManager());
+			return object3dSetup_->GetLightManager()->GetSpotLight();
+		}
+		return *spotLightData_;
+	}
+
 	///=============================================================================
 	///						テクスチャの変更
 	void Object3d::ChangeTexture(const std::string &texturePath) {
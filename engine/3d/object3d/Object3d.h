@@ -10,6 +10,7 @@
 #include "MagMath.h"
 #include "Model.h"
 #include "ModelManager.h"
+#include "TransformHierarchy.h"
 //========================================
 // DX12include
 #include <d3d12.h>
@@ -34,13 +35,25 @@ namespace MagEngine {
 		///--------------------------------------------------------------
 		///							メンバ関数
 	public:
+		Object3d() = default;
+		/// \brief デストラクタ（トランスフォーム階層のノードを破棄）
+		~Object3d();
+		// NOTE: 階層のノードを1つだけ持つため複製は禁止
+		Object3d(const Object3d &) = delete;
+		Object3d &operator=(const Object3d &) = delete;
+
 		/// \brief 初期化
 		void Initialize(Object3dSetup *object3dSetup);
 
+		/// \brief インスタンス描画用の初期化（個別の定数バッファを作らない）
+		/// \note  Draw は Object3dSetup のバッチに登録し、同じモデルのオブジェクトとまとめて描画する
+		///        カメラとライトは全オブジェクトで共有するため、ライトの個別設定は使えない
+		void InitializeInstanced(Object3dSetup *object3dSetup);
+
 		/// \brief 更新
 		void Update();
 
-		/// \brief 描画
+		/// \brief 描画（インスタンス描画用の場合はバッチへの登録のみ）
 		void Draw();
 
 		/// \brief ImGui描画
@@ -74,6 +87,12 @@ namespace MagEngine {
 		 */
 		void CreateCameraBuffer();
 
+		/**----------------------------------------------------------------------------
+		 * \brief  UpdateMatrices 変換行列の更新
+		 * \note   ワールド行列とカメラのどちらも変わっていなければ何もしない
+		 */
+		void UpdateMatrices();
+
 		///--------------------------------------------------------------
 		///							入出力関数
 	public:
@@ -85,6 +104,13 @@ namespace MagEngine {
 			model_ = ModelManager::GetInstance()->FindModel(filePath);
 		}
 
+		/**----------------------------------------------------------------------------
+		 * \brief  IsInstanced インスタンス描画用か
+		 */
+		bool IsInstanced() const {
+			return isInstanced_;
+		}
+
 		MagMath::Transform *GetTransform() {
 			return &transform_;
 		} // Transformのポインタを取得する関数
@@ -141,6 +167,25 @@ namespace MagEngine {
 			return transform_.translate;
 		}
 
+		/**----------------------------------------------------------------------------
+		 * \brief  SetParent 親の設定
+		 * \param  parent 親のオブジェクト（nullptr で親なし）
+		 * \return 親子関係が循環する場合は設定せず false
+		 * \note   設定後のトランスフォームは親から見たローカルの値として扱う
+		 */
+		bool SetParent(const Object3d *parent) {
+			return TransformHierarchy::GetInstance()->SetParent(
+				transformNode_, parent ? parent->transformNode_ : TransformHierarchy::kInvalidNode);
+		}
+
+		/**----------------------------------------------------------------------------
+		 * \brief  GetWorldMatrix ワールド行列の取得（親の行列を含む）
+		 * \return 直前に更新した時点のワールド行列
+		 */
+		const MagMath::Matrix4x4 &GetWorldMatrix() const {
+			return TransformHierarchy::GetInstance()->GetWorldMatrix(transformNode_);
+		}
+
 		/**----------------------------------------------------------------------------
 		 * \brief  SetCamera カメラの設定
 		 * \param  camera
@@ -149,26 +194,27 @@ namespace MagEngine {
 			this->camera_ = camera;
 		}
 
+		//========================================
+		// ライト
+		// NOTE: インスタンス描画用の Object3d は個別のライトバッファを持たない。
+		//       ライトは Object3dSetup が LightManager の値を全インスタンスで共有し、
+		//       スペキュラーのカメラ位置にはデフォルトカメラの位置を使う。
+		//       そのため Set 系は呼べず（assert）、Get 系は LightManager の値を返す
+
 		/**----------------------------------------------------------------------------
-		 * \brief  SetDirectionalLight 並行光源の設定
+		 * \brief  SetDirectionalLight 並行光源の設定（インスタンス描画用では不可）
 		 * \param  color
 		 * \param  direction
 		 * \param  intensity
 		 */
-		void SetDirectionalLight(const MagMath::Vector4 &color, const MagMath::Vector3 &direction, float intensity) {
-			directionalLightData_->color = color;
-			directionalLightData_->direction = direction;
-			directionalLightData_->intensity = intensity;
-		}
+		void SetDirectionalLight(const MagMath::Vector4 &color, const MagMath::Vector3 &direction, float intensity);
 		/*
 		 * \brief  GetDirectionalLight 並行光源の取得
 		 */
-		const MagMath::DirectionalLight &GetDirectionalLight() const {
-			return *directionalLightData_;
-		}
+		const MagMath::DirectionalLight &GetDirectionalLight() const;
 
 		/**----------------------------------------------------------------------------
-		 * \brief  SetPointLight ポイントライトの設定（拡張版）
+		 * \brief  SetPointLight ポイントライトの設定（拡張版。インスタンス描画用では不可）
 		 * \param  color ライトの色
 		 * \param  position ライトの位置
 		 * \param  intensity 光の強度
@@ -176,23 +222,15 @@ namespace MagEngine {
 		 * \param  decay 減衰の度合い（1.0が線形、2.0が二乗減衰）
 		 */
 		void SetPointLight(const MagMath::Vector4 &color, const MagMath::Vector3 &position, float intensity,
-						   float radius = 10.0f, float decay = 2.0f) {
-			pointLightData_->color = color;
-			pointLightData_->position = position;
-			pointLightData_->intensity = intensity;
-			pointLightData_->radius = radius;
-			pointLightData_->decay = decay;
-		}
+						   float radius = 10.0f, float decay = 2.0f);
 		/*
 		 * \brief  GetPointLight ポイントライトの取得
 		 * \return 現在設定されているポイントライト情報
 		 */
-		const MagMath::PointLight &GetPointLight() const {
-			return *pointLightData_;
-		}
+		const MagMath::PointLight &GetPointLight() const;
 
 		/**----------------------------------------------------------------------------
-		 * \brief  SetSpotLight スポットライトの設定
+		 * \brief  SetSpotLight スポットライトの設定（インスタンス描画用では不可）
 		 * \param  color ライトの色
 		 * \param  position ライトの位置
 		 * \param  direction ライトの方向
@@ -204,24 +242,12 @@ namespace MagEngine {
 		void SetSpotLight(const MagMath::Vector4 &color, const MagMath::Vector3 &position,
 						  const MagMath::Vector3 &direction, float intensity,
 						  float distance = 15.0f, float decay = 2.0f,
-						  float angle = 0.5f) {
-			spotLightData_->color = color;
-			spotLightData_->position = position;
-			spotLightData_->direction = direction;
-			spotLightData_->intensity = intensity;
-			spotLightData_->distance = distance;
-			spotLightData_->decay = decay;
-			// 内側の角度（完全に明るい領域）と外側の角度（フェード開始）を設定
-			spotLightData_->cosFalloffStart = cosf(angle * 0.7f); // 内側: 70%の角度
-			spotLightData_->cosFalloffEnd = cosf(angle);		  // 外側: 設定角度
-		}
+						  float angle = 0.5f);
 		/*
 		 * \brief  GetSpotLight スポットライトの取得
 		 * \return 現在設定されているスポットライト情報
 		 */
-		const MagMath::SpotLight &GetSpotLight() const {
-			return *spotLightData_;
-		}
+		const MagMath::SpotLight &GetSpotLight() const;
 
 		/**----------------------------------------------------------------------------
 		 * \brief  SetMaterialColor マテリアルカラーの設定
@@ -316,8 +342,19 @@ namespace MagEngine {
 		// TODO:スポットライト
 		MagMath::SpotLight *spotLightData_ = nullptr;
 		//========================================
+		// 直前の Update で計算した変換行列（インスタンス描画で使用）
+		MagMath::TransformationMatrix transformationMatrix_ = {};
+		// インスタンス描画用か
+		bool isInstanced_ = false;
+		//========================================
 		// Transform
 		MagMath::Transform transform_ = {};
+		// トランスフォーム階層のノード番号
+		uint32_t transformNode_ = TransformHierarchy::kInvalidNode;
+		// transformationMatrix_ を求めたときのワールド行列・カメラの番号（変化の判定用）
+		uint32_t matrixWorldVersion_ = UINT32_MAX;
+		const Camera *matrixCamera_ = nullptr;
+		uint32_t matrixViewProjectionVersion_ = UINT32_MAX;
 		//========================================
 		// カメラ
 		Camera *camera_ = nullptr;
@@ -7,7 +7,12 @@
  * \note
  *********************************************************************/
 #include "Object3dSetup.h"
+#include "CullingManager.h"
+#include "LightManager.h"
 #include "Logger.h"
+#include "Model.h"
+#include "Object3d.h"
+#include <cstring>
 using namespace Logger;
 ///=============================================================================
 ///                        namespace MagEngine
@@ -36,6 +41,150 @@ namespace MagEngine {
 		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	}
 
+	///=============================================================================
+	///						 インスタンス描画に登録
+	void Object3dSetup::SubmitInstance(Model *model, const MagMath::TransformationMatrix &transformationMatrix) {
+		if(!model) {
+			return;
+		}
+		auto it = batchIds_.find(model);
+		if(it == batchIds_.end()) {
+			it = batchIds_.emplace(model, static_cast<uint32_t>(batches_.size())).first;
+			batchModels_.push_back(model);
+			batches_.emplace_back();
+		}
+		batches_[it->second].push_back(transformationMatrix);
+	}
+
+	///=============================================================================
+	///						 インスタンスをまとめて描画
+	void Object3dSetup::FlushInstances() {
+		lastInstancedDrawCount_ = 0;
+		lastInstanceCount_ = 0;
+
+		auto commandList = dxCore_->GetCommandList();
+		bool isSetup = false;
+		for(uint32_t batchId = 0; batchId < batches_.size(); ++batchId) {
+			std::vector<MagMath::TransformationMatrix> &batch = batches_[batchId];
+			//========================================
+			// 視錐台・描画距離の外のインスタンスを除く
+			CullBatch(batchModels_[batchId], batch);
+			if(batch.empty()) {
+				continue;
+			}
+
+			//========================================
+			// 描画設定（最初のバッチでのみ行う）
+			if(!isSetup) {
+				commandList->SetGraphicsRootSignature(rootSignature_.Get());
+				commandList->SetPipelineState(instancedPipelineState_.Get());
+				commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+				if(!BindSharedConstants()) {
+					break;
+				}
+				isSetup = true;
+			}
+
+			//========================================
+			// 変換行列をアップロードリングへ書き込む
+			// NOTE: 確保できない場合（リングの容量不足）は DirectXCore が警告を出し、このモデルは描画しない
+			size_t instanceSize = sizeof(MagMath::TransformationMatrix) * batch.size();
+			UploadAllocation instanceAllocation = dxCore_->AllocateUpload(instanceSize);
+			if(!instanceAllocation.cpuAddress) {
+				continue;
+			}
+			std::memcpy(instanceAllocation.cpuAddress, batch.data(), instanceSize);
+
+			//========================================
+			// モデルごとに1回の描画
+			commandList->SetGraphicsRootShaderResourceView(8, instanceAllocation.gpuAddress);
+			batchModels_[batchId]->InstancingDraw(static_cast<uint32_t>(batch.size()));
+			++lastInstancedDrawCount_;
+			lastInstanceCount_ += static_cast<uint32_t>(batch.size());
+		}
+
+		//========================================
+		// 次のフレームの登録に備えて空にする（描画できなかったバッチも持ち越さない）
+		for(std::vector<MagMath::TransformationMatrix> &batch : batches_) {
+			batch.clear();
+		}
+	}
+
+	///=============================================================================
+	///						 バッチのカリング
+	void Object3dSetup::CullBatch(const Model *model, std::vector<MagMath::TransformationMatrix> &batch) {
+		const uint32_t count = static_cast<uint32_t>(batch.size());
+		if(count == 0) {
+			return;
+		}
+		//========================================
+		// ワールド座標の境界球をSoAへ展開
+		cullCenterX_.resize(count);
+		cullCenterY_.resize(count);
+		cullCenterZ_.resize(count);
+		cullRadius_.resize(count);
+		cullVisible_.resize(count);
+		const MagMath::BoundingSphere &localSphere = model->GetBoundingSphere();
+		for(uint32_t i = 0; i < count; ++i) {
+			const MagMath::BoundingSphere worldSphere = TransformBoundingSphere(localSphere, batch[i].World);
+			cullCenterX_[i] = worldSphere.center.x;
+			cullCenterY_[i] = worldSphere.center.y;
+			cullCenterZ_[i] = worldSphere.center.z;
+			cullRadius_[i] = worldSphere.radius;
+		}
+		//========================================
+		// 一括判定し、描画するものを前に詰める（登録順を保つ）
+		const SphereStreams spheres = {cullCenterX_.data(), cullCenterY_.data(), cullCenterZ_.data(), cullRadius_.data()};
+		const uint32_t visibleCount = CullingManager::GetInstance()->CullSpheres(CullingCategory::Object3d, spheres, count, cullVisible_.data());
+		if(visibleCount == count) {
+			return;
+		}
+		uint32_t writeIndex = 0;
+		for(uint32_t i = 0; i < count; ++i) {
+			if(cullVisible_[i]) {
+				batch[writeIndex++] = batch[i];
+			}
+		}
+		batch.resize(writeIndex);
+	}
+
+	///=============================================================================
+	///						 カメラとライトの定数バッファの設定
+	bool Object3dSetup::BindSharedConstants() {
+		UploadAllocation directionalLightAllocation = dxCore_->AllocateUpload(sizeof(MagMath::DirectionalLight));
+		UploadAllocation cameraAllocation = dxCore_->AllocateUpload(sizeof(CameraForGpu));
+		UploadAllocation pointLightAllocation = dxCore_->AllocateUpload(sizeof(MagMath::PointLight));
+		UploadAllocation spotLightAllocation = dxCore_->AllocateUpload(sizeof(MagMath::SpotLight));
+		if(!directionalLightAllocation.cpuAddress || !cameraAllocation.cpuAddress ||
+		   !pointLightAllocation.cpuAddress || !spotLightAllocation.cpuAddress) {
+			return false;
+		}
+
+		//========================================
+		// カメラの位置
+		CameraForGpu *cameraData = static_cast<CameraForGpu *>(cameraAllocation.cpuAddress);
+		cameraData->worldPosition = defaultCamera_ ? defaultCamera_->GetTransform().translate : MagMath::Vector3{0.0f, 0.0f, 0.0f};
+
+		//========================================
+		// ライト（Object3d::Update と同じく LightManager の値を使う）
+		if(lightManager_) {
+			*static_cast<MagMath::DirectionalLight *>(directionalLightAllocation.cpuAddress) = lightManager_->GetDirectionalLight();
+			*static_cast<MagMath::PointLight *>(pointLightAllocation.cpuAddress) = lightManager_->GetPointLight();
+			*static_cast<MagMath::SpotLight *>(spotLightAllocation.cpuAddress) = lightManager_->GetSpotLight();
+		} else {
+			*static_cast<MagMath::DirectionalLight *>(directionalLightAllocation.cpuAddress) = {};
+			*static_cast<MagMath::PointLight *>(pointLightAllocation.cpuAddress) = {};
+			*static_cast<MagMath::SpotLight *>(spotLightAllocation.cpuAddress) = {};
+		}
+
+		auto commandList = dxCore_->GetCommandList();
+		commandList->SetGraphicsRootConstantBufferView(3, directionalLightAllocation.gpuAddress);
+		commandList->SetGraphicsRootConstantBufferView(4, cameraAllocation.gpuAddress);
+		commandList->SetGraphicsRootConstantBufferView(5, pointLightAllocation.gpuAddress);
+		commandList->SetGraphicsRootConstantBufferView(6, spotLightAllocation.gpuAddress);
+		return true;
+	}
+
 	///=============================================================================
 	///						 ルートシグネイチャーの作成
 	void Object3dSetup::CreateRootSignature() {
@@ -55,8 +204,8 @@ namespace MagEngine {
 		descriptorRange[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 		descriptorRange[1].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 
-		// ルートパラメータを8つに変更（環境マップ用に1つ追加）
-		D3D12_ROOT_PARAMETER rootParameters[8] = {};
+		// ルートパラメータを9つに変更（環境マップ用とインスタンス描画用に追加）
+		D3D12_ROOT_PARAMETER rootParameters[9] = {};
 		rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
 		rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 		rootParameters[0].Descriptor.ShaderRegister = 0;
@@ -95,6 +244,11 @@ namespace MagEngine {
 		rootParameters[7].DescriptorTable.pDescriptorRanges = &descriptorRange[1];
 		rootParameters[7].DescriptorTable.NumDescriptorRanges = 1;
 
+		// インスタンスごとの変換行列（t0、インスタンス描画の頂点シェーダーでのみ使用）
+		rootParameters[8].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+		rootParameters[8].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+		rootParameters[8].Descriptor.ShaderRegister = 0;
+
 		descriptionRootSignature.pParameters = rootParameters;
 		descriptionRootSignature.NumParameters = _countof(rootParameters);
 
@@ -227,5 +381,19 @@ namespace MagEngine {
 			throw std::runtime_error("ENGINE MESSAGE: Object3d Failed to create graphics pipeline state :(");
 		}
 		Log("Object3d Graphics pipeline state created successfully :)", LogLevel::Success);
+
+		//========================================
+		// インスタンス描画用PSO（変換行列をストラクチャードバッファから読む）
+		Microsoft::WRL::ComPtr<IDxcBlob> instancedVertexShaderBlob = dxCore_->CompileShader(L"resources/shader/Object3dInstanced.VS.hlsl", L"vs_6_0");
+		if(!instancedVertexShaderBlob) {
+			throw std::runtime_error("ENGINE MESSAGE: Object3d Failed to compile instanced vertex shader :(");
+		}
+		graphicsPipelineStateDesc.VS = { instancedVertexShaderBlob->GetBufferPointer(), instancedVertexShaderBlob->GetBufferSize() };
+		hr = dxCore_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc,
+			IID_PPV_ARGS(&instancedPipelineState_));
+		if(FAILED(hr)) {
+			throw std::runtime_error("ENGINE MESSAGE: Object3d Failed to create instanced graphics pipeline state :(");
+		}
+		Log("Object3d Instanced graphics pipeline state created successfully :)", LogLevel::Success);
 	}
 }
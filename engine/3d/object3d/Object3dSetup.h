@@ -9,12 +9,16 @@
 #pragma once
 #include "Camera.h"
 #include "DirectXCore.h"
+#include "TransformationMatrix.h"
+#include <unordered_map>
+#include <vector>
  ///=============================================================================
  ///                        namespace MagEngine
 namespace MagEngine {
 ///=============================================================================
 ///						クラス
 	class LightManager;
+	class Model;
 	class Object3dSetup {
 		///--------------------------------------------------------------
 		///						 メンバ関数
@@ -27,6 +31,15 @@ namespace MagEngine {
 	/// COMMENT: GPU の描画状態切り替えを最小化。複数オブジェクトの連続描画効率を向上
 	void CommonDrawSetup();
 
+		/// @brief SubmitInstance インスタンス描画に登録
+		/// @param model 描画するモデル（同じモデルのインスタンスは1回の描画にまとめる）
+		/// @param transformationMatrix インスタンスの変換行列
+		void SubmitInstance(Model *model, const MagMath::TransformationMatrix &transformationMatrix);
+
+		/// @brief FlushInstances 登録されたインスタンスをモデルごとにまとめて描画
+		/// @note 変換行列はアップロードリング上のストラクチャードバッファ、カメラとライトは全モデルで共有する
+		void FlushInstances();
+
 		///--------------------------------------------------------------
 		///						 静的メンバ関数
 	private:
@@ -36,6 +49,15 @@ namespace MagEngine {
 		/// @brief グラフィックスパイプラインの作成
 		void CreateGraphicsPipeline();
 
+		/// @brief カメラとライトの定数バッファをアップロードリングに書き込んで設定
+		/// @return 確保に失敗した場合 false
+		bool BindSharedConstants();
+
+		/// @brief バッチの境界球を一括判定し、描画するインスタンスだけを前に詰める
+		/// @param model モデル（ローカル座標の境界球を持つ）
+		/// @param batch [in,out] 変換行列（描画しないものを取り除く）
+		void CullBatch(const Model *model, std::vector<MagMath::TransformationMatrix> &batch);
+
 		///--------------------------------------------------------------
 		///							入出力関数
 	public:
@@ -69,6 +91,16 @@ namespace MagEngine {
 			return lightManager_;
 		}
 
+		/// @brief GetLastInstancedDrawCount 直前の FlushInstances で発行した描画数
+		uint32_t GetLastInstancedDrawCount() const {
+			return lastInstancedDrawCount_;
+		}
+
+		/// @brief GetLastInstanceCount 直前の FlushInstances で描画したインスタンス数
+		uint32_t GetLastInstanceCount() const {
+			return lastInstanceCount_;
+		}
+
 		///--------------------------------------------------------------
 		///							メンバ変数
 	private:
@@ -91,10 +123,26 @@ namespace MagEngine {
 		// グラフィックスパイプライン
 		/// COMMENT: PSO キャッシング。ドロー呼び出し前の状態設定を削減
 		Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState_;
+		// インスタンス描画用（頂点シェーダーのみ異なる）
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> instancedPipelineState_;
 
 		//========================================
 		// デフォルトカメラ
 		/// COMMENT: カメラバッファを複数オブジェクト間で共有（メモリ最適化）
 		Camera *defaultCamera_ = nullptr;
+
+		//========================================
+		// インスタンス描画のバッチ（モデルごとに今フレームの変換行列を集める）
+		/// COMMENT: 配列は毎フレーム clear して容量を使い回す
+		std::unordered_map<Model *, uint32_t> batchIds_;
+		std::vector<Model *> batchModels_;
+		std::vector<std::vector<MagMath::TransformationMatrix>> batches_;
+		uint32_t lastInstancedDrawCount_ = 0;
+		uint32_t lastInstanceCount_ = 0;
+
+		//========================================
+		// カリング用の作業領域（ワールド座標の境界球のSoAと判定結果）
+		std::vector<float> cullCenterX_, cullCenterY_, cullCenterZ_, cullRadius_;
+		std::vector<uint8_t> cullVisible_;
 	};
 }
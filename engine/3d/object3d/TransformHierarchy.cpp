@@ -0,0 +1,344 @@
+#include "TransformHierarchy.h"
+#include <cassert>
+#include <cstring>
+
+namespace {
+	///=============================================================================
+	///						旧スロットの値を新しい順に集める（作業領域と入れ替える）
+	template <typename T>
+	void GatherSlots(std::vector<T> &values, std::vector<T> &scratch, const std::vector<uint32_t> &oldSlots) {
+		scratch.resize(oldSlots.size());
+		for (size_t slot = 0; slot < oldSlots.size(); ++slot) {
+			scratch[slot] = values[oldSlots[slot]];
+		}
+		values.swap(scratch);
+	}
+}
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						インスタンスの取得
+	TransformHierarchy *TransformHierarchy::GetInstance() {
+		static TransformHierarchy instance;
+		return &instance;
+	}
+
+	///=============================================================================
+	///						ノードの作成
+	uint32_t TransformHierarchy::CreateNode() {
+		//========================================
+		// ノード番号の確保（破棄済みの番号を再利用）
+		uint32_t node;
+		if (!freeNodes_.empty()) {
+			node = freeNodes_.back();
+			freeNodes_.pop_back();
+		} else {
+			node = static_cast<uint32_t>(slotOfNode_.size());
+			slotOfNode_.push_back(kInvalidNode);
+			parentOfNode_.push_back(kInvalidNode);
+			firstChildOfNode_.push_back(kInvalidNode);
+			nextSiblingOfNode_.push_back(kInvalidNode);
+			prevSiblingOfNode_.push_back(kInvalidNode);
+		}
+
+		//========================================
+		// 親なしのノードは末尾に追加しても「親が子より前」を保てる
+		const uint32_t slot = static_cast<uint32_t>(nodeOfSlot_.size());
+		slotOfNode_[node] = slot;
+		parentOfNode_[node] = kInvalidNode;
+		firstChildOfNode_[node] = kInvalidNode;
+		nextSiblingOfNode_[node] = kInvalidNode;
+		prevSiblingOfNode_[node] = kInvalidNode;
+		nodeOfSlot_.push_back(node);
+		parentSlot_.push_back(kInvalidNode);
+		local_.push_back({{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}});
+		world_.push_back(MagMath::Identity4x4());
+		worldInverse_.push_back(MagMath::Identity4x4());
+		worldVersion_.push_back(0);
+		isLocalDirty_.push_back(0);
+		isWorldChanged_.push_back(0);
+		MarkDirty(slot);
+		++nodeCount_;
+		return node;
+	}
+
+	///=============================================================================
+	///						ノードの破棄
+	void TransformHierarchy::DestroyNode(uint32_t node) {
+		assert(node < slotOfNode_.size() && slotOfNode_[node] != kInvalidNode);
+		//========================================
+		// 子ノードを親なしにする（親なしは並び順の条件を崩さない）
+		for (uint32_t child = firstChildOfNode_[node]; child != kInvalidNode;) {
+			const uint32_t next = nextSiblingOfNode_[child];
+			parentOfNode_[child] = kInvalidNode;
+			nextSiblingOfNode_[child] = kInvalidNode;
+			prevSiblingOfNode_[child] = kInvalidNode;
+			parentSlot_[slotOfNode_[child]] = kInvalidNode;
+			MarkDirty(slotOfNode_[child]);
+			child = next;
+		}
+		firstChildOfNode_[node] = kInvalidNode;
+		if (parentOfNode_[node] != kInvalidNode) {
+			UnlinkChild(node);
+		}
+
+		//========================================
+		// スロットを取り除く
+		const uint32_t slot = slotOfNode_[node];
+		if (isLocalDirty_[slot]) {
+			isLocalDirty_[slot] = 0;
+			--dirtyCount_;
+		}
+		RemoveSlot(slot);
+		slotOfNode_[node] = kInvalidNode;
+		parentOfNode_[node] = kInvalidNode;
+		freeNodes_.push_back(node);
+		--nodeCount_;
+	}
+
+	///=============================================================================
+	///						親の設定
+	bool TransformHierarchy::SetParent(uint32_t node, uint32_t parent) {
+		assert(node < slotOfNode_.size() && slotOfNode_[node] != kInvalidNode);
+		if (parentOfNode_[node] == parent) {
+			return true;
+		}
+		//========================================
+		// 循環の確認（親をたどって自身に戻らないか）
+		for (uint32_t ancestor = parent; ancestor != kInvalidNode; ancestor = parentOfNode_[ancestor]) {
+			if (ancestor == node) {
+				return false;
+			}
+		}
+		if (parentOfNode_[node] != kInvalidNode) {
+			UnlinkChild(node);
+		}
+		if (parent != kInvalidNode) {
+			LinkChild(node, parent);
+		}
+		parentOfNode_[node] = parent;
+
+		//========================================
+		// 親が自身より前にあれば並び順はそのまま使える
+		const uint32_t slot = slotOfNode_[node];
+		const uint32_t parentSlot = parent == kInvalidNode ? kInvalidNode : slotOfNode_[parent];
+		if (parentSlot == kInvalidNode || parentSlot < slot) {
+			parentSlot_[slot] = parentSlot;
+		} else {
+			isOrderDirty_ = true;
+		}
+		MarkDirty(slot);
+		return true;
+	}
+
+	///=============================================================================
+	///						ローカルのトランスフォームの設定
+	void TransformHierarchy::SetLocalTransform(uint32_t node, const MagMath::Transform &local) {
+		const uint32_t slot = slotOfNode_[node];
+		if (std::memcmp(&local_[slot], &local, sizeof(MagMath::Transform)) == 0) {
+			return;
+		}
+		local_[slot] = local;
+		MarkDirty(slot);
+	}
+
+	///=============================================================================
+	///						更新
+	void TransformHierarchy::Update() {
+		lastUpdatedCount_ = 0;
+		if (isOrderDirty_) {
+			RebuildOrder();
+		} else if (emptySlotCount_ * 4 > nodeOfSlot_.size()) {
+			// 空きスロットが全体の1/4を超えたら詰める
+			CompactSlots();
+		}
+		if (dirtyCount_ == 0) {
+			return;
+		}
+
+		//========================================
+		// 先頭から1度だけ走査（親は必ず先に更新済み）
+		const uint32_t slotCount = static_cast<uint32_t>(nodeOfSlot_.size());
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			const uint32_t parentSlot = parentSlot_[slot];
+			const bool isParentChanged = parentSlot != kInvalidNode && isWorldChanged_[parentSlot];
+			if (!isLocalDirty_[slot] && !isParentChanged) {
+				isWorldChanged_[slot] = 0;
+				continue;
+			}
+			const MagMath::Transform &local = local_[slot];
+			const MagMath::Matrix4x4 localMatrix = MagMath::MakeAffineMatrix(local.scale, local.rotate, local.translate);
+			world_[slot] = parentSlot == kInvalidNode ? localMatrix : MagMath::Multiply4x4(localMatrix, world_[parentSlot]);
+			worldInverse_[slot] = MagMath::InverseAffine4x4(world_[slot]);
+			++worldVersion_[slot];
+			isLocalDirty_[slot] = 0;
+			isWorldChanged_[slot] = 1;
+			++lastUpdatedCount_;
+		}
+		dirtyCount_ = 0;
+	}
+
+	///=============================================================================
+	///						ダーティフラグを立てる
+	void TransformHierarchy::MarkDirty(uint32_t slot) {
+		if (!isLocalDirty_[slot]) {
+			isLocalDirty_[slot] = 1;
+			++dirtyCount_;
+		}
+	}
+
+	///=============================================================================
+	///						親の子リストへつなぐ（先頭に追加）
+	void TransformHierarchy::LinkChild(uint32_t node, uint32_t parent) {
+		const uint32_t next = firstChildOfNode_[parent];
+		prevSiblingOfNode_[node] = kInvalidNode;
+		nextSiblingOfNode_[node] = next;
+		if (next != kInvalidNode) {
+			prevSiblingOfNode_[next] = node;
+		}
+		firstChildOfNode_[parent] = node;
+	}
+
+	///=============================================================================
+	///						親の子リストから外す
+	void TransformHierarchy::UnlinkChild(uint32_t node) {
+		const uint32_t prev = prevSiblingOfNode_[node];
+		const uint32_t next = nextSiblingOfNode_[node];
+		if (prev != kInvalidNode) {
+			nextSiblingOfNode_[prev] = next;
+		} else {
+			firstChildOfNode_[parentOfNode_[node]] = next;
+		}
+		if (next != kInvalidNode) {
+			prevSiblingOfNode_[next] = prev;
+		}
+		prevSiblingOfNode_[node] = kInvalidNode;
+		nextSiblingOfNode_[node] = kInvalidNode;
+	}
+
+	///=============================================================================
+	///						スロットの取り除き
+	void TransformHierarchy::RemoveSlot(uint32_t slot) {
+		const uint32_t lastSlot = static_cast<uint32_t>(nodeOfSlot_.size()) - 1;
+		if (slot != lastSlot) {
+			//========================================
+			// 末尾のノードは子を持たないため、親より後ろであれば空いた位置へ移せる
+			const uint32_t lastParentSlot = parentSlot_[lastSlot];
+			if (isOrderDirty_ || (lastParentSlot != kInvalidNode && lastParentSlot >= slot)) {
+				// 移せない場合は空きスロットとして残し、Update でまとめて詰める
+				nodeOfSlot_[slot] = kInvalidNode;
+				parentSlot_[slot] = kInvalidNode;
+				isWorldChanged_[slot] = 0;
+				++emptySlotCount_;
+				return;
+			}
+			MoveSlot(lastSlot, slot);
+		}
+		ResizeSlots(lastSlot);
+
+		//========================================
+		// 末尾に残った空きスロットも取り除く
+		while (!nodeOfSlot_.empty() && nodeOfSlot_.back() == kInvalidNode) {
+			ResizeSlots(static_cast<uint32_t>(nodeOfSlot_.size()) - 1);
+			--emptySlotCount_;
+		}
+	}
+
+	///=============================================================================
+	///						スロットの中身を移す
+	void TransformHierarchy::MoveSlot(uint32_t from, uint32_t to) {
+		const uint32_t node = nodeOfSlot_[from];
+		nodeOfSlot_[to] = node;
+		parentSlot_[to] = parentSlot_[from];
+		local_[to] = local_[from];
+		world_[to] = world_[from];
+		worldInverse_[to] = worldInverse_[from];
+		worldVersion_[to] = worldVersion_[from];
+		isLocalDirty_[to] = isLocalDirty_[from];
+		isWorldChanged_[to] = isWorldChanged_[from];
+		slotOfNode_[node] = to;
+	}
+
+	///=============================================================================
+	///						スロット数の変更
+	void TransformHierarchy::ResizeSlots(uint32_t slotCount) {
+		nodeOfSlot_.resize(slotCount);
+		parentSlot_.resize(slotCount);
+		local_.resize(slotCount);
+		world_.resize(slotCount);
+		worldInverse_.resize(slotCount);
+		worldVersion_.resize(slotCount);
+		isLocalDirty_.resize(slotCount);
+		isWorldChanged_.resize(slotCount);
+	}
+
+	///=============================================================================
+	///						空きスロットを詰める
+	void TransformHierarchy::CompactSlots() {
+		//========================================
+		// 前から詰めるため、親が子より前にある並びは崩れない
+		uint32_t slotCount = 0;
+		for (uint32_t slot = 0; slot < nodeOfSlot_.size(); ++slot) {
+			if (nodeOfSlot_[slot] == kInvalidNode) {
+				continue;
+			}
+			if (slot != slotCount) {
+				MoveSlot(slot, slotCount);
+			}
+			++slotCount;
+		}
+		ResizeSlots(slotCount);
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			const uint32_t parent = parentOfNode_[nodeOfSlot_[slot]];
+			parentSlot_[slot] = parent == kInvalidNode ? kInvalidNode : slotOfNode_[parent];
+		}
+		emptySlotCount_ = 0;
+	}
+
+	///=============================================================================
+	///						幅優先順に並べ直す
+	void TransformHierarchy::RebuildOrder() {
+		//========================================
+		// 親なしのノードを今の並びのまま先頭に置き、子リストを順にたどる
+		std::vector<uint32_t> &order = orderScratch_;
+		order.clear();
+		order.reserve(nodeCount_);
+		for (uint32_t node : nodeOfSlot_) {
+			if (node != kInvalidNode && parentOfNode_[node] == kInvalidNode) {
+				order.push_back(node);
+			}
+		}
+		for (size_t i = 0; i < order.size(); ++i) {
+			for (uint32_t child = firstChildOfNode_[order[i]]; child != kInvalidNode; child = nextSiblingOfNode_[child]) {
+				order.push_back(child);
+			}
+		}
+
+		//========================================
+		// 新しい順に配列を詰め直す（作業領域と入れ替えて確保を避ける）
+		const uint32_t slotCount = static_cast<uint32_t>(order.size());
+		oldSlotScratch_.resize(slotCount);
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			oldSlotScratch_[slot] = slotOfNode_[order[slot]];
+		}
+		GatherSlots(local_, localScratch_, oldSlotScratch_);
+		GatherSlots(world_, worldScratch_, oldSlotScratch_);
+		GatherSlots(worldInverse_, worldInverseScratch_, oldSlotScratch_);
+		GatherSlots(worldVersion_, worldVersionScratch_, oldSlotScratch_);
+		GatherSlots(isLocalDirty_, isLocalDirtyScratch_, oldSlotScratch_);
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			slotOfNode_[order[slot]] = slot;
+		}
+		parentSlot_.resize(slotCount);
+		for (uint32_t slot = 0; slot < slotCount; ++slot) {
+			const uint32_t parent = parentOfNode_[order[slot]];
+			parentSlot_[slot] = parent == kInvalidNode ? kInvalidNode : slotOfNode_[parent];
+		}
+		nodeOfSlot_.swap(order);
+		isWorldChanged_.assign(slotCount, 0);
+		emptySlotCount_ = 0;
+		isOrderDirty_ = false;
+	}
+}
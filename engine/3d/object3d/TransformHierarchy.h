@@ -0,0 +1,152 @@
+/*********************************************************************
+ * \file   TransformHierarchy.h
+ * \brief  親子関係を持つトランスフォームの一括更新（ダーティフラグ付き）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   ノードは親が必ず子より前に並ぶ幅優先順の配列に格納し、Update は先頭から1度走査するだけで済む
+ *         ローカルのトランスフォームが変わったノードと、ワールド行列が変わったノードの子だけを再計算するため、
+ *         動かないオブジェクトは初回以降フラグの確認のみで済む
+ *         破棄は末尾のノードとの入れ替えか空きスロットの記録で済ませ、並べ直しは親より前へ子を付け替えたときだけ行う
+ *         GPUリソースには触れないため、GPUなしで動作を確認できる（tests/TransformHierarchyTest.cpp）
+ *********************************************************************/
+#pragma once
+#include "MagMath.h"
+#include <cstdint>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						トランスフォーム階層
+	class TransformHierarchy {
+		///--------------------------------------------------------------
+		///							メンバ関数
+	public:
+		//========================================
+		// 無効なノード番号（親なしを表す）
+		static constexpr uint32_t kInvalidNode = UINT32_MAX;
+
+		/// \brief インスタンスの取得（Object3d が共有する階層）
+		static TransformHierarchy *GetInstance();
+
+		/// \brief ノードの作成（親なし・単位トランスフォーム）
+		/// \return ノード番号（破棄するまで変わらない）
+		uint32_t CreateNode();
+
+		/// \brief ノードの破棄
+		/// \note 子ノードは親なしになり、ローカルのトランスフォームがそのままワールドになる
+		void DestroyNode(uint32_t node);
+
+		/// \brief 親の設定
+		/// \param node ノード番号
+		/// \param parent 親のノード番号（kInvalidNode で親なし）
+		/// \return 循環する場合は設定せず false
+		bool SetParent(uint32_t node, uint32_t parent);
+
+		/// \brief ローカルのトランスフォームの設定（前回と同じ値なら何もしない）
+		void SetLocalTransform(uint32_t node, const MagMath::Transform &local);
+
+		/// \brief 変更のあったノードのワールド行列と逆行列を更新
+		/// \note 変更が無ければ配列を走査しない
+		void Update();
+
+		///--------------------------------------------------------------
+		///							入出力関数
+	public:
+		uint32_t GetParent(uint32_t node) const {
+			return parentOfNode_[node];
+		}
+		/// \brief ワールド行列（直前の Update の結果）
+		const MagMath::Matrix4x4 &GetWorldMatrix(uint32_t node) const {
+			return world_[slotOfNode_[node]];
+		}
+		/// \brief ワールド行列の逆行列（直前の Update の結果）
+		const MagMath::Matrix4x4 &GetWorldInverseMatrix(uint32_t node) const {
+			return worldInverse_[slotOfNode_[node]];
+		}
+		/// \brief ワールド行列を再計算するたびに増える番号（利用側のキャッシュの判定用）
+		uint32_t GetWorldVersion(uint32_t node) const {
+			return worldVersion_[slotOfNode_[node]];
+		}
+		/// \brief 次の Update で再計算が必要か
+		bool IsDirty() const {
+			return dirtyCount_ > 0 || isOrderDirty_;
+		}
+		/// \brief 有効なノード数
+		uint32_t GetNodeCount() const {
+			return nodeCount_;
+		}
+		/// \brief 直前の Update で再計算したノード数
+		uint32_t GetLastUpdatedCount() const {
+			return lastUpdatedCount_;
+		}
+
+		///--------------------------------------------------------------
+		///							内部処理
+	private:
+		/// \brief ダーティフラグを立てる
+		void MarkDirty(uint32_t slot);
+
+		/// \brief 親の子リストへつなぐ
+		void LinkChild(uint32_t node, uint32_t parent);
+
+		/// \brief 親の子リストから外す
+		void UnlinkChild(uint32_t node);
+
+		/// \brief スロットの取り除き（末尾のノードで埋められなければ空きスロットとして残す）
+		void RemoveSlot(uint32_t slot);
+
+		/// \brief スロットの中身を移す
+		void MoveSlot(uint32_t from, uint32_t to);
+
+		/// \brief スロット数の変更
+		void ResizeSlots(uint32_t slotCount);
+
+		/// \brief 空きスロットを詰める（並び順は保つ）
+		void CompactSlots();
+
+		/// \brief 子リストをたどって幅優先順に並べ直す
+		void RebuildOrder();
+
+		///--------------------------------------------------------------
+		///							メンバ変数
+	private:
+		//========================================
+		// ノード番号で引く情報
+		std::vector<uint32_t> slotOfNode_;	 // ノード番号 → 配列の位置（破棄済みは kInvalidNode）
+		std::vector<uint32_t> parentOfNode_; // ノード番号 → 親のノード番号
+		std::vector<uint32_t> firstChildOfNode_;  // ノード番号 → 最初の子のノード番号
+		std::vector<uint32_t> nextSiblingOfNode_; // ノード番号 → 次の兄弟のノード番号
+		std::vector<uint32_t> prevSiblingOfNode_; // ノード番号 → 前の兄弟のノード番号
+		std::vector<uint32_t> freeNodes_;	 // 再利用できるノード番号
+
+		//========================================
+		// 幅優先順の配列（親は必ず子より前）
+		std::vector<uint32_t> nodeOfSlot_; // 配列の位置 → ノード番号（破棄済みは kInvalidNode）
+		std::vector<uint32_t> parentSlot_; // 親の配列の位置（親なしは kInvalidNode）
+		std::vector<MagMath::Transform> local_;
+		std::vector<MagMath::Matrix4x4> world_;
+		std::vector<MagMath::Matrix4x4> worldInverse_;
+		std::vector<uint32_t> worldVersion_;
+		std::vector<uint8_t> isLocalDirty_;	  // ローカルのトランスフォームまたは親が変わった
+		std::vector<uint8_t> isWorldChanged_; // 今回の Update でワールド行列を再計算した（子の判定用）
+
+		//========================================
+		// 並べ直し用の作業領域（容量を使い回す）
+		std::vector<uint32_t> orderScratch_;
+		std::vector<uint32_t> oldSlotScratch_;
+		std::vector<MagMath::Transform> localScratch_;
+		std::vector<MagMath::Matrix4x4> worldScratch_;
+		std::vector<MagMath::Matrix4x4> worldInverseScratch_;
+		std::vector<uint32_t> worldVersionScratch_;
+		std::vector<uint8_t> isLocalDirtyScratch_;
+
+		uint32_t nodeCount_ = 0;
+		uint32_t emptySlotCount_ = 0; // 破棄後に残した空きスロットの数
+		uint32_t dirtyCount_ = 0;
+		uint32_t lastUpdatedCount_ = 0;
+		bool isOrderDirty_ = false;
+	};
+}
@@ -73,7 +73,7 @@ namespace MagEngine {
 		// トランスフォーメーションマトリックスバッファに書き込む
 		transformationMatrixData_->WVP = worldViewProjectionMatrix;
 		transformationMatrixData_->World = worldMatrix;
-		transformationMatrixData_->WorldInvTranspose = Inverse4x4(worldMatrix);
+		transformationMatrixData_->WorldInvTranspose = InverseAffine4x4(worldMatrix);
 
 		//========================================
 		// ライト情報の更新
@@ -98,7 +98,7 @@ namespace MagEngine {
 
 		//========================================
 		// テクスチャが設定されていない場合は描画しない
-		if (texturePath_.empty()) {
+		if (!textureHandle_.IsValid()) {
 			return;
 		}
 
@@ -116,7 +116,7 @@ namespace MagEngine {
 		// トランスフォーメーションマトリックスバッファの設定
 		commandList->SetGraphicsRootConstantBufferView(0, transformationMatrixBuffer_->GetGPUVirtualAddress());
 		// テクスチャの設定
-		commandList->SetGraphicsRootDescriptorTable(1, TextureManager::GetInstance()->GetSrvHandleGPU(texturePath_));
+		commandList->SetGraphicsRootDescriptorTable(1, TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_));
 
 		//========================================
 		// ライト定数バッファの設定
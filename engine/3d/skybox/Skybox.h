@@ -72,9 +72,10 @@ namespace MagEngine {
 			this->camera_ = camera;
 		}
 
-		/// \brief SetTexture テクスチャの設定
+		/// \brief SetTexture テクスチャの設定（未読み込みのテクスチャは読み込む）
 		void SetTexture(const std::string &texturePath) {
 			texturePath_ = texturePath;
+			textureHandle_ = texturePath.empty() ? TextureHandle{} : TextureManager::GetInstance()->LoadTexture(texturePath);
 		}
 
 		/// \brief GetTransform トランスフォーメーションのポインタを取得
@@ -165,6 +166,7 @@ namespace MagEngine {
 		//========================================
 		// テクスチャパス
 		std::string texturePath_ = "";
+		TextureHandle textureHandle_;
 
 		//========================================
 		// Transform
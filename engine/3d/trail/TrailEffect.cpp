@@ -21,6 +21,18 @@ namespace MagEngine {
 	///=============================================================================
 	///						初期化
 	void TrailEffect::Initialize(TrailEffectSetup *setup, const TrailEffectPreset &preset) {
+		Initialize(setup);
+
+		//========================================
+		// プリセット内容をEmitterに適用
+		ApplyPreset(preset);
+
+		Log("TrailEffect initialized with preset: " + preset.name, Logger::LogLevel::Info);
+	}
+
+	///=============================================================================
+	///						プリセットなしで初期化
+	void TrailEffect::Initialize(TrailEffectSetup *setup) {
 		//========================================
 		// 引数チェック
 		if (!setup) {
@@ -30,17 +42,10 @@ namespace MagEngine {
 		//========================================
 		// 引数から設定を受け取る
 		setup_ = setup;
-		currentPreset_ = preset;
 
 		//========================================
 		// Emitterの初期化
 		emitter_.Initialize(setup_);
-
-		//========================================
-		// プリセット内容をEmitterに適用
-		ApplyPreset(currentPreset_);
-
-		Log("TrailEffect initialized with preset: " + preset.name, Logger::LogLevel::Info);
 	}
 
 	///=============================================================================
@@ -141,7 +146,11 @@ namespace MagEngine {
 		emitter_.SetStartColor(preset.startColor);
 		emitter_.SetEndColor(preset.endColor);
 
-		Log("Preset applied: " + preset.name, Logger::LogLevel::Info);
+		//========================================
+		// 同じプリセットのトレイルはまとめて描画する
+		if (setup_) {
+			emitter_.SetBatchId(setup_->GetBatchId(preset.name));
+		}
 	}
 
 	///=============================================================================
@@ -34,6 +34,12 @@ namespace MagEngine {
 		 */
 		void Initialize(TrailEffectSetup *setup, const TrailEffectPreset &preset);
 
+		/**----------------------------------------------------------------------------
+		 * \brief  プリセットなしで初期化（プールのスロット用。プリセットは貸出時に適用する）
+		 * \param  setup TrailEffectSetupポインタ
+		 */
+		void Initialize(TrailEffectSetup *setup);
+
 		/**----------------------------------------------------------------------------
 		 * \brief  更新処理
 		 * \param  deltaTime フレーム間の経過時間
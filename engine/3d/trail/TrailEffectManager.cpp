@@ -6,11 +6,13 @@
  * \date   March 2026
  * \note
  *********************************************************************/
+#define NOMINMAX
 #include "TrailEffectManager.h"
 #include "Logger.h"
 #include "TrailEffectSetup.h"
 #include "externals/imgui/imgui.h"
 #include "externals/json.hpp"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -33,6 +35,10 @@ namespace MagEngine {
 		// Setupを保持
 		setup_ = setup;
 
+		//========================================
+		// トレイルプールを事前に確保（戦闘中にトレイルを生成しないため）
+		ReservePool(kDefaultPoolCapacity);
+
 		Log("TrailEffectManager initialized", LogLevel::Success);
 	}
 
@@ -46,6 +52,22 @@ namespace MagEngine {
 				pair.second->Update(deltaTime);
 			}
 		}
+
+		//========================================
+		// プールのトレイルを更新
+		for (uint32_t index = 0; index < trailPool_.size(); ++index) {
+			TrailSlot &slot = trailPool_[index];
+			if (slot.state == TrailSlotState::Free) {
+				continue;
+			}
+			slot.effect->Update(deltaTime);
+
+			// フェードし終えたらプールに戻す
+			if (slot.state == TrailSlotState::Fading && slot.effect->GetParticleCount() == 0) {
+				slot.state = TrailSlotState::Free;
+				freeTrailSlots_.push_back(index);
+			}
+		}
 	}
 
 	///=============================================================================
@@ -58,6 +80,14 @@ namespace MagEngine {
 				pair.second->Draw();
 			}
 		}
+
+		//========================================
+		// プールのトレイルを描画
+		for (TrailSlot &slot : trailPool_) {
+			if (slot.state != TrailSlotState::Free) {
+				slot.effect->Draw();
+			}
+		}
 	}
 
 	///=============================================================================
@@ -69,6 +99,12 @@ namespace MagEngine {
 		// 統計情報
 		ImGui::Text("Active Effects: %zu", GetEffectCount());
 		ImGui::Text("Registered Presets: %zu", GetPresetCount());
+		ImGui::Text("Trail Pool: %zu / %zu in use (Grown: %u, Failed: %u)",
+					trailPool_.size() - freeTrailSlots_.size(), trailPool_.size(), poolGrowCount_, acquireFailCount_);
+		if (setup_) {
+			ImGui::Text("Trail Draws: %u (Trails: %u, Batches: %u)",
+						setup_->GetLastDrawCount(), setup_->GetLastTrailCount(), setup_->GetBatchCount());
+		}
 		ImGui::Separator();
 
 		//========================================
@@ -483,6 +519,94 @@ namespace MagEngine {
 		return it->second.get();
 	}
 
+	///=============================================================================
+	///						プールのスロットを事前に確保
+	void TrailEffectManager::ReservePool(uint32_t capacity) {
+		if (!setup_) {
+			return;
+		}
+
+		//========================================
+		// 頂点スロットを確保できる数までに制限する（スロットのないトレイルは描画されない）
+		capacity = std::min(capacity, static_cast<uint32_t>(trailPool_.size()) + setup_->GetFreeVertexSlotCount());
+
+		//========================================
+		// 足りない分のスロットを作成（プリセットは貸出時に適用する）
+		trailPool_.reserve(capacity);
+		freeTrailSlots_.reserve(capacity);
+		while (trailPool_.size() < capacity) {
+			TrailSlot slot;
+			slot.effect = std::make_unique<TrailEffect>();
+			slot.effect->Initialize(setup_);
+			freeTrailSlots_.push_back(static_cast<uint32_t>(trailPool_.size()));
+			trailPool_.push_back(std::move(slot));
+		}
+	}
+
+	///=============================================================================
+	///						プールからトレイルを借りる
+	TrailHandle TrailEffectManager::AcquireTrail(const std::string &presetName) {
+		//========================================
+		// プリセットを検索
+		auto presetIt = presets_.find(presetName);
+		if (presetIt == presets_.end()) {
+			Log("Preset not found: " + presetName, LogLevel::Warning);
+			return TrailHandle{};
+		}
+
+		//========================================
+		// 空きがない場合はプールを倍に拡張（1つずつ増やすと毎回再確保になる）
+		// NOTE: 頂点スロットが尽きている場合は拡張できないため、無効なハンドルを返す
+		if (freeTrailSlots_.empty()) {
+			uint32_t currentSize = static_cast<uint32_t>(trailPool_.size());
+			ReservePool(currentSize > 0 ? currentSize * 2 : kDefaultPoolCapacity);
+			if (freeTrailSlots_.empty()) {
+				++acquireFailCount_;
+				return TrailHandle{};
+			}
+			++poolGrowCount_;
+		}
+
+		//========================================
+		// スロットを貸し出す
+		uint32_t index = freeTrailSlots_.back();
+		freeTrailSlots_.pop_back();
+		TrailSlot &slot = trailPool_[index];
+		slot.state = TrailSlotState::Active;
+		slot.effect->ApplyPreset(presetIt->second);
+		slot.effect->ClearTrails();
+		slot.effect->SetPosition({0.0f, 0.0f, 0.0f});
+		slot.effect->SetEnabled(true);
+
+		return TrailHandle{index, slot.generation};
+	}
+
+	///=============================================================================
+	///						トレイルをプールに返す
+	void TrailEffectManager::ReleaseTrail(TrailHandle &handle) {
+		if (GetTrail(handle)) {
+			//========================================
+			// 世代を進めて古いハンドルを無効にし、軌跡が消えるまでフェードさせる
+			TrailSlot &slot = trailPool_[handle.index];
+			++slot.generation;
+			slot.state = TrailSlotState::Fading;
+		}
+		handle = TrailHandle{};
+	}
+
+	///=============================================================================
+	///						借りているトレイルを取得
+	TrailEffect *TrailEffectManager::GetTrail(const TrailHandle &handle) {
+		if (handle.index >= trailPool_.size()) {
+			return nullptr;
+		}
+		TrailSlot &slot = trailPool_[handle.index];
+		if (slot.state != TrailSlotState::Active || slot.generation != handle.generation) {
+			return nullptr;
+		}
+		return slot.effect.get();
+	}
+
 	///=============================================================================
 	///						すべてのエフェクトを破棄
 	void TrailEffectManager::DestroyAllEffects() {
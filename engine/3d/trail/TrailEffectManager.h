@@ -5,10 +5,12 @@
  * \author MagEngine
  * \date   March 2026
  * \note   複数のトレイルエフェクトインスタンスとプリセットを管理
+ *         弾などの短命なトレイルはプールから世代付きハンドルで借り、返却後はその場でフェードさせて再利用する
  *********************************************************************/
 #pragma once
 #include "TrailEffect.h"
 #include "TrailEffectPreset.h"
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -22,6 +24,23 @@ namespace MagEngine {
 	///						前方宣言
 	class TrailEffectSetup;
 
+	///=============================================================================
+	///						構造体
+
+	/**----------------------------------------------------------------------------
+	 * \brief  TrailHandle プールから借りたトレイルのハンドル
+	 * \note   返却後は世代が変わるため、古いハンドルからは取得できない
+	 */
+	struct TrailHandle {
+		static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+		uint32_t index = kInvalidIndex; ///< プールのスロット番号
+		uint32_t generation = 0;		///< 借りた時点のスロットの世代
+
+		bool IsValid() const {
+			return index != kInvalidIndex;
+		}
+	};
+
 	///=============================================================================
 	///						クラス
 	class TrailEffectManager {
@@ -37,11 +56,13 @@ namespace MagEngine {
 		/**----------------------------------------------------------------------------
 		 * \brief  更新処理
 		 * \param  deltaTime フレーム間の経過時間
+		 * \note   プールのトレイルも更新し、フェードし終えたものをプールに戻す
 		 */
 		void Update(float deltaTime);
 
 		/**----------------------------------------------------------------------------
 		 * \brief  描画
+		 * \note   名前付きのインスタンスとプールのトレイル（フェード中を含む）を描画
 		 */
 		void Draw();
 
@@ -124,6 +145,46 @@ namespace MagEngine {
 		 */
 		const TrailEffect *GetEffect(const std::string &instanceName) const;
 
+		///--------------------------------------------------------------
+		///						 プール管理
+	public:
+		/**----------------------------------------------------------------------------
+		 * \brief  プールのスロットを事前に確保
+		 * \param  capacity スロット数（現在より少ない場合は何もしない。空いている頂点スロット数までに制限する）
+		 */
+		void ReservePool(uint32_t capacity);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  プールからトレイルを借りる
+		 * \param  presetName プリセット名
+		 * \return ハンドル（プリセットが見つからない場合、頂点スロットが尽きている場合は無効なハンドル）
+		 * \note   空きがない場合はスロットを追加する（追加回数は ImGui に表示）
+		 *         プールは TrailEffectSetup の頂点スロット数（kMaxVertexSlots）を超えて拡張しない
+		 */
+		TrailHandle AcquireTrail(const std::string &presetName);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  トレイルをプールに返す
+		 * \param  handle 返すハンドル（無効なハンドルに書き換える）
+		 * \note   残っている軌跡はその場でフェードし、消えてからスロットを再利用する
+		 */
+		void ReleaseTrail(TrailHandle &handle);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  借りているトレイルを取得
+		 * \param  handle ハンドル
+		 * \return TrailEffectポインタ（返却済み・無効なハンドルの場合はnullptr）
+		 */
+		TrailEffect *GetTrail(const TrailHandle &handle);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  プールのスロット数を取得
+		 * \return スロット数
+		 */
+		size_t GetPoolCapacity() const {
+			return trailPool_.size();
+		}
+
 		///--------------------------------------------------------------
 		///						 一括操作
 	public:
@@ -195,6 +256,24 @@ namespace MagEngine {
 		// インスタンス管理
 		std::map<std::string, std::unique_ptr<TrailEffect>> activeEffects_;
 
+		//========================================
+		// トレイルプール
+		enum class TrailSlotState {
+			Free,	///< 未使用
+			Active, ///< 貸出中
+			Fading, ///< 返却済み（軌跡が消えるまで描画する）
+		};
+		struct TrailSlot {
+			std::unique_ptr<TrailEffect> effect;
+			uint32_t generation = 0;
+			TrailSlotState state = TrailSlotState::Free;
+		};
+		static constexpr uint32_t kDefaultPoolCapacity = 128;
+		std::vector<TrailSlot> trailPool_;
+		std::vector<uint32_t> freeTrailSlots_;
+		uint32_t poolGrowCount_ = 0;	 ///< 空きがなくプールを拡張した回数
+		uint32_t acquireFailCount_ = 0; ///< 頂点スロットが尽きて貸し出せなかった回数
+
 		//========================================
 		// エディター用
 		std::string editingPresetName_;		  ///< 編集中のプリセット名
@@ -7,9 +7,11 @@
  * \note
  *********************************************************************/
 #include "TrailEffectSetup.h"
+#include "Camera.h"
+#include "CullingManager.h"
 #include "DirectXCore.h"
 #include "Logger.h"
-#include "SrvSetup.h"
+#include "TrailEmitter.h"
 #include <stdexcept>
 
 using namespace Logger;
@@ -29,6 +31,16 @@ namespace MagEngine {
 		// グラフィックスパイプラインの生成
 		CreateGraphicsPipeline();
 
+		//========================================
+		// 頂点スロットと共通インデックスバッファの生成
+		CreateBuffers();
+
+		//========================================
+		// プリセットなしのトレイル用バッチ（番号0）
+		batchIds_.clear();
+		batches_.clear();
+		GetBatchId("");
+
 		Log("TrailEffectSetup initialized.", LogLevel::Success);
 	}
 
@@ -47,20 +59,234 @@ namespace MagEngine {
 		// プリミティブトポロジーをセット（三角形リスト）
 		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
+		// 共通インデックスバッファ（頂点はVSがスロットから引くため頂点バッファは使わない）
+		commandList->IASetIndexBuffer(&indexBufferView_);
+
 		//========================================
 		// テクスチャはColorのグラデーションで表現される
 		// ポイントのageに応じてStartColorからEndColorへ補間される
 	}
 
+	///=============================================================================
+	///						 頂点スロットの確保
+	TrailVertex *TrailEffectSetup::AcquireVertexSlot(uint32_t &outVertexBase) {
+		if (freeVertexSlots_.empty()) {
+			outVertexBase = kInvalidVertexBase;
+			return nullptr;
+		}
+		uint32_t slot = freeVertexSlots_.back();
+		freeVertexSlots_.pop_back();
+		outVertexBase = slot * kSlotVertexCount;
+		return vertexData_ + outVertexBase;
+	}
+
+	///=============================================================================
+	///						 頂点スロットの解放
+	void TrailEffectSetup::ReleaseVertexSlot(uint32_t vertexBase) {
+		if (vertexBase == kInvalidVertexBase) {
+			return;
+		}
+		freeVertexSlots_.push_back(vertexBase / kSlotVertexCount);
+	}
+
+	///=============================================================================
+	///						 バッチ番号の取得
+	uint32_t TrailEffectSetup::GetBatchId(const std::string &batchName) {
+		auto it = batchIds_.find(batchName);
+		if (it != batchIds_.end()) {
+			return it->second;
+		}
+		uint32_t batchId = static_cast<uint32_t>(batches_.size());
+		batches_.emplace_back();
+		batchIds_.emplace(batchName, batchId);
+		return batchId;
+	}
+
+	///=============================================================================
+	///						 トレイルをバッチに登録
+	void TrailEffectSetup::SubmitTrail(uint32_t batchId, const TrailEmitter *emitter) {
+		if (!emitter || batchId >= batches_.size()) {
+			return;
+		}
+		batches_[batchId].push_back(emitter);
+	}
+
+	///=============================================================================
+	///						 バッチごとにまとめて描画
+	void TrailEffectSetup::FlushBatches() {
+		lastDrawCount_ = 0;
+		lastTrailCount_ = 0;
+
+		//========================================
+		// カメラ定数バッファ（全バッチ共通）
+		UploadAllocation cameraAllocation{};
+		if (defaultCamera_) {
+			cameraAllocation = dxCore_->AllocateUpload(sizeof(CameraConstant));
+			if (cameraAllocation.cpuAddress) {
+				CameraConstant *cameraData = static_cast<CameraConstant *>(cameraAllocation.cpuAddress);
+				cameraData->viewProj = defaultCamera_->GetViewProjectionMatrix();
+				cameraData->worldPosition = defaultCamera_->GetTranslate();
+				cameraData->time = 0.0f;
+			}
+		}
+
+		auto commandList = dxCore_->GetCommandList();
+		for (std::vector<const TrailEmitter *> &batch : batches_) {
+			//========================================
+			// 視錐台・描画距離の外のトレイルを除く
+			CullBatch(batch);
+			if (batch.empty()) {
+				continue;
+			}
+			if (!cameraAllocation.cpuAddress) {
+				batch.clear();
+				continue;
+			}
+
+			//========================================
+			// トレイルごとのパラメータと描画範囲だけをアップロードリングへ書き込む
+			// NOTE: 確保できない場合（リングの容量不足）は DirectXCore が警告を出し、このバッチは描画しない
+			UploadAllocation instanceAllocation = dxCore_->AllocateUpload(sizeof(TrailInstance) * batch.size());
+			if (!instanceAllocation.cpuAddress) {
+				batch.clear();
+				continue;
+			}
+			TrailInstance *instanceData = static_cast<TrailInstance *>(instanceAllocation.cpuAddress);
+			uint32_t maxPointCount = 0;
+			for (uint32_t trailIndex = 0; trailIndex < batch.size(); ++trailIndex) {
+				instanceData[trailIndex] = batch[trailIndex]->MakeInstance();
+				if (instanceData[trailIndex].pointCount > maxPointCount) {
+					maxPointCount = instanceData[trailIndex].pointCount;
+				}
+			}
+
+			//========================================
+			// 描画設定
+			CommonDrawSetup();
+
+			// トレイルごとのパラメータと描画範囲（t0）
+			commandList->SetGraphicsRootShaderResourceView(0, instanceAllocation.gpuAddress);
+			// カメラ定数バッファ（b1）
+			commandList->SetGraphicsRootConstantBufferView(1, cameraAllocation.gpuAddress);
+			// 頂点スロット（t1）
+			commandList->SetGraphicsRootShaderResourceView(2, vertexBuffer_->GetGPUVirtualAddress());
+
+			//========================================
+			// 描画コール（1トレイル1インスタンス。最も長いトレイルのセグメント数まで描き、短いトレイルの余りはVSで潰す）
+			UINT indexCount = (maxPointCount - 1) * 6;
+			commandList->DrawIndexedInstanced(indexCount, static_cast<UINT>(batch.size()), 0, 0, 0);
+			++lastDrawCount_;
+			lastTrailCount_ += static_cast<uint32_t>(batch.size());
+
+			//========================================
+			// 次のフレームに向けて登録をクリア
+			batch.clear();
+		}
+	}
+
+	///=============================================================================
+	///						バッチのカリング
+	void TrailEffectSetup::CullBatch(std::vector<const TrailEmitter *> &batch) {
+		const uint32_t count = static_cast<uint32_t>(batch.size());
+		if (count == 0) {
+			return;
+		}
+		//========================================
+		// 境界球をSoAへ展開
+		cullCenterX_.resize(count);
+		cullCenterY_.resize(count);
+		cullCenterZ_.resize(count);
+		cullRadius_.resize(count);
+		cullVisible_.resize(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			const MagMath::BoundingSphere sphere = batch[i]->ComputeBoundingSphere();
+			cullCenterX_[i] = sphere.center.x;
+			cullCenterY_[i] = sphere.center.y;
+			cullCenterZ_[i] = sphere.center.z;
+			cullRadius_[i] = sphere.radius;
+		}
+		//========================================
+		// 一括判定し、描画するものを前に詰める（登録順を保つ）
+		const SphereStreams spheres = {cullCenterX_.data(), cullCenterY_.data(), cullCenterZ_.data(), cullRadius_.data()};
+		const uint32_t visibleCount = CullingManager::GetInstance()->CullSpheres(CullingCategory::Trail, spheres, count, cullVisible_.data());
+		if (visibleCount == count) {
+			return;
+		}
+		uint32_t writeIndex = 0;
+		for (uint32_t i = 0; i < count; ++i) {
+			if (cullVisible_[i]) {
+				batch[writeIndex++] = batch[i];
+			}
+		}
+		batch.resize(writeIndex);
+	}
+
+	///=============================================================================
+	///						 頂点スロットと共通インデックスバッファの作成
+	void TrailEffectSetup::CreateBuffers() {
+		//========================================
+		// 頂点スロット（全トレイル分を1つのバッファに持ち、常時マップしたままにする）
+		// NOTE: エミッターは更新中（GPUが前のフレームを読み終えた後）に追加したポイントの頂点だけを書き込む
+		size_t vertexBufferSize = sizeof(TrailVertex) * kSlotVertexCount * kMaxVertexSlots;
+		vertexBuffer_ = dxCore_->CreateBufferResource(vertexBufferSize);
+		if (!vertexBuffer_) {
+			throw std::runtime_error("TrailEffectSetup vertex buffer creation failed.");
+		}
+		D3D12_RANGE readRange{0, 0};
+		vertexBuffer_->Map(0, &readRange, reinterpret_cast<void **>(&vertexData_));
+
+		// 空きスロット（番号の小さい順に貸し出す）
+		freeVertexSlots_.clear();
+		freeVertexSlots_.reserve(kMaxVertexSlots);
+		for (uint32_t slot = kMaxVertexSlots; slot > 0; --slot) {
+			freeVertexSlots_.push_back(slot - 1);
+		}
+
+		//========================================
+		// 共通インデックスバッファ（1度だけ書き込む）
+		// セグメント k はリングの先頭から k 番目と k+1 番目のポイントを結ぶ。値は 2 * ポイント番号 + 左右
+		// COMMENT: リングの位置への変換はVSで行うため、全トレイルが同じパターンを使える
+		const uint32_t segmentCount = kSlotPointCount - 1;
+		size_t indexBufferSize = sizeof(uint32_t) * segmentCount * 6;
+		indexBuffer_ = dxCore_->CreateBufferResource(indexBufferSize);
+		if (!indexBuffer_) {
+			throw std::runtime_error("TrailEffectSetup index buffer creation failed.");
+		}
+		uint32_t *indexData = nullptr;
+		indexBuffer_->Map(0, &readRange, reinterpret_cast<void **>(&indexData));
+		for (uint32_t k = 0; k < segmentCount; ++k) {
+			uint32_t l0 = k * 2;
+			uint32_t r0 = l0 + 1;
+			uint32_t l1 = l0 + 2;
+			uint32_t r1 = l0 + 3;
+			uint32_t *segment = indexData + k * 6;
+
+			segment[0] = l0;
+			segment[1] = r0;
+			segment[2] = l1;
+
+			segment[3] = r0;
+			segment[4] = r1;
+			segment[5] = l1;
+		}
+		indexBuffer_->Unmap(0, nullptr);
+
+		indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+		indexBufferView_.SizeInBytes = static_cast<UINT>(indexBufferSize);
+		indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+
+		Log("Trail vertex slots created: " + std::to_string(kMaxVertexSlots) + " x " + std::to_string(kSlotVertexCount) + " vertices", LogLevel::Success);
+	}
+
 	///=============================================================================
 	///						 ルートシグネイチャーの作成
 	void TrailEffectSetup::CreateRootSignature() {
 		//========================================
-		// RootParameterの設定（2つのパラメータ）
-		D3D12_ROOT_PARAMETER rootParameters[2] = {};
+		// RootParameterの設定（3つのパラメータ）
+		D3D12_ROOT_PARAMETER rootParameters[3] = {};
 
-		// パラメータ定数バッファ（b0）
-		rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+		// トレイルごとのパラメータと描画範囲（t0, StructuredBuffer）
+		rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
 		rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
 		rootParameters[0].Descriptor.ShaderRegister = 0;
 
@@ -69,6 +295,11 @@ namespace MagEngine {
 		rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
 		rootParameters[1].Descriptor.ShaderRegister = 1;
 
+		// 頂点スロット（t1, StructuredBuffer。VSが頂点を引く）
+		rootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+		rootParameters[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+		rootParameters[2].Descriptor.ShaderRegister = 1;
+
 		//========================================
 		// StaticSamplerの設定
 		D3D12_STATIC_SAMPLER_DESC staticSampler{};
@@ -123,27 +354,10 @@ namespace MagEngine {
 
 		//========================================
 		// InputLayoutの設定を行う
-		D3D12_INPUT_ELEMENT_DESC elements[3] = {};
-
-		// 頂点データ（位置）
-		elements[0].SemanticName = "POSITION";
-		elements[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-		elements[0].AlignedByteOffset = 0;
-
-		// 法線データ
-		elements[1].SemanticName = "NORMAL";
-		elements[1].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-		elements[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
-
-		// エイジデータ（経過時間率）
-		elements[2].SemanticName = "TEXCOORD";
-		elements[2].SemanticIndex = 0;
-		elements[2].Format = DXGI_FORMAT_R32_FLOAT;
-		elements[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
-
+		// NOTE: 頂点は SV_VertexID（共通インデックスの値）と SV_InstanceID からVSが頂点スロットを引くため入力要素はない
 		D3D12_INPUT_LAYOUT_DESC inputLayout{};
-		inputLayout.pInputElementDescs = elements;
-		inputLayout.NumElements = _countof(elements);
+		inputLayout.pInputElementDescs = nullptr;
+		inputLayout.NumElements = 0;
 
 		//========================================
 		// Shaderをcompileする
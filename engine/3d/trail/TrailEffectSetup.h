@@ -5,10 +5,18 @@
  * \author MagEngine
  * \date   March 2026
  * \note   トレイルレンダリング用のルートシグネチャとパイプライン設定を管理
+ *         トレイルの頂点は常時マップした1つの頂点バッファにトレイル1本分ずつのスロットで持ち、
+ *         エミッターは追加したポイントの頂点だけをスロットへ書き込む（毎フレームの再転送はしない）
+ *         インデックスは全トレイル共通の相対パターンを1度だけ作り、VSがスロットの先頭・リングの先頭から頂点を引く
+ *         同じプリセットのトレイルは1トレイル1インスタンスとして、プリセットごとに1回で描画する
  *********************************************************************/
 #pragma once
+#include <cstdint>
 #include <d3d12.h>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <wrl/client.h>
 
 ///=============================================================================
@@ -19,11 +27,20 @@ namespace MagEngine {
 	///						前方宣言
 	class DirectXCore;
 	class Camera;
-	class SrvSetup;
+	class TrailEmitter;
+	struct TrailVertex;
 
 	///=============================================================================
 	///						クラス
 	class TrailEffectSetup {
+		///--------------------------------------------------------------
+		///						 定数
+	public:
+		static constexpr uint32_t kSlotPointCount = 128;				   ///< 1スロット（トレイル1本）のポイント数
+		static constexpr uint32_t kSlotVertexCount = kSlotPointCount * 2; ///< 1スロットの頂点数（1ポイントにつき左右2頂点）
+		static constexpr uint32_t kMaxVertexSlots = 512;				   ///< スロット数（同時に存在できるトレイル数）
+		static constexpr uint32_t kInvalidVertexBase = UINT32_MAX;
+
 		///--------------------------------------------------------------
 		///						 メンバ関数
 	public:
@@ -39,6 +56,40 @@ namespace MagEngine {
 		 */
 		void CommonDrawSetup();
 
+		/**----------------------------------------------------------------------------
+		 * \brief  頂点スロットの確保（トレイル1本分、kSlotVertexCount 頂点）
+		 * \param  outVertexBase [out] スロットの先頭頂点番号（空きが無い場合は kInvalidVertexBase）
+		 * \return 書き込み先（空きが無い場合は nullptr）
+		 * \note   常時マップしたアップロードヒープを直接指す。GPUが前のフレームを読み終えた後（更新中）に書き込むこと
+		 */
+		TrailVertex *AcquireVertexSlot(uint32_t &outVertexBase);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  頂点スロットの解放
+		 * \param  vertexBase AcquireVertexSlot で受け取った先頭頂点番号
+		 */
+		void ReleaseVertexSlot(uint32_t vertexBase);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  バッチ番号の取得（未登録の名前は新しいバッチを作る）
+		 * \param  batchName バッチ名（プリセット名）
+		 * \return バッチ番号（0はプリセットなしのトレイル用）
+		 */
+		uint32_t GetBatchId(const std::string &batchName);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  トレイルをバッチに登録
+		 * \param  batchId バッチ番号
+		 * \param  emitter 描画するトレイル（FlushBatches まで有効であること）
+		 */
+		void SubmitTrail(uint32_t batchId, const TrailEmitter *emitter);
+
+		/**----------------------------------------------------------------------------
+		 * \brief  登録されたトレイルをバッチごとにまとめて描画
+		 * \note   毎フレーム転送するのはトレイルごとのパラメータと描画範囲だけ（アップロードリング）
+		 */
+		void FlushBatches();
+
 		///--------------------------------------------------------------
 		///						 入出力関数
 	public:
@@ -67,11 +118,35 @@ namespace MagEngine {
 		}
 
 		/**----------------------------------------------------------------------------
-		 * \brief  SetSrvSetup SrvSetupの設定
-		 * \param  srvSetup SrvSetupポインタ
+		 * \brief  GetLastDrawCount 直前の FlushBatches で発行した描画数の取得
+		 * \return 描画数
+		 */
+		uint32_t GetLastDrawCount() const {
+			return lastDrawCount_;
+		}
+
+		/**----------------------------------------------------------------------------
+		 * \brief  GetLastTrailCount 直前の FlushBatches で描画したトレイル数の取得
+		 * \return トレイル数
+		 */
+		uint32_t GetLastTrailCount() const {
+			return lastTrailCount_;
+		}
+
+		/**----------------------------------------------------------------------------
+		 * \brief  GetBatchCount バッチ数の取得
+		 * \return バッチ数
+		 */
+		uint32_t GetBatchCount() const {
+			return static_cast<uint32_t>(batches_.size());
+		}
+
+		/**----------------------------------------------------------------------------
+		 * \brief  GetFreeVertexSlotCount 空いている頂点スロット数の取得
+		 * \return スロット数
 		 */
-		void SetSrvSetup(SrvSetup *srvSetup) {
-			srvSetup_ = srvSetup;
+		uint32_t GetFreeVertexSlotCount() const {
+			return static_cast<uint32_t>(freeVertexSlots_.size());
 		}
 
 		///--------------------------------------------------------------
@@ -87,6 +162,17 @@ namespace MagEngine {
 		 */
 		void CreateGraphicsPipeline();
 
+		/**----------------------------------------------------------------------------
+		 * \brief  頂点スロットの頂点バッファと共通インデックスバッファの作成
+		 */
+		void CreateBuffers();
+
+		/**----------------------------------------------------------------------------
+		 * \brief  バッチの境界球を一括判定し、描画するトレイルだけを残す
+		 * \param  batch [in,out] トレイル（描画しないものを取り除く）
+		 */
+		void CullBatch(std::vector<const TrailEmitter *> &batch);
+
 		///--------------------------------------------------------------
 		///						 メンバ変数
 	private:
@@ -98,10 +184,6 @@ namespace MagEngine {
 		// Cameraポインタ
 		Camera *defaultCamera_ = nullptr;
 
-		//========================================
-		// SrvSetupポインタ
-		SrvSetup *srvSetup_ = nullptr;
-
 		//========================================
 		// RootSignature
 		Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
@@ -109,5 +191,28 @@ namespace MagEngine {
 		//========================================
 		// グラフィックスパイプライン
 		Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+
+		//========================================
+		// 頂点スロット（トレイル1本につき1スロット。常時マップしたまま）
+		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+		TrailVertex *vertexData_ = nullptr;
+		std::vector<uint32_t> freeVertexSlots_;
+
+		//========================================
+		// 共通インデックスバッファ（セグメント k はスロット内のポイント k と k+1 を結ぶ。値は先頭からの相対）
+		Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
+		D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+
+		//========================================
+		// バッチ（プリセット名ごとに今フレーム描画するトレイルを集める）
+		std::unordered_map<std::string, uint32_t> batchIds_;
+		std::vector<std::vector<const TrailEmitter *>> batches_;
+		uint32_t lastDrawCount_ = 0;
+		uint32_t lastTrailCount_ = 0;
+
+		//========================================
+		// カリング用の作業領域（境界球のSoAと判定結果）
+		std::vector<float> cullCenterX_, cullCenterY_, cullCenterZ_, cullRadius_;
+		std::vector<uint8_t> cullVisible_;
 	};
 }
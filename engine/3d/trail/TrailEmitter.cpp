@@ -10,12 +10,9 @@
 // 以下はstd::maxを使用する場合に必要
 #define NOMINMAX
 #include "TrailEmitter.h"
-#include "Camera.h"
-#include "DirectXCore.h"
 #include "Logger.h"
 #include "TrailEffectSetup.h"
 #include <algorithm>
-#include <cstring>
 
 using namespace Logger;
 
@@ -23,6 +20,14 @@ using namespace Logger;
 ///                        namespace MagEngine
 namespace MagEngine {
 
+	///=============================================================================
+	///						デストラクタ
+	TrailEmitter::~TrailEmitter() {
+		if (setup_ && vertexData_) {
+			setup_->ReleaseVertexSlot(vertexBase_);
+		}
+	}
+
 	///=============================================================================
 	///						初期化
 	void TrailEmitter::Initialize(TrailEffectSetup *setup) {
@@ -32,22 +37,31 @@ namespace MagEngine {
 			throw std::runtime_error("TrailEmitter: TrailEffectSetup is null.");
 		}
 
+		//========================================
+		// 再初期化の場合は以前の頂点スロットを返す
+		if (setup_ && vertexData_) {
+			setup_->ReleaseVertexSlot(vertexBase_);
+			vertexData_ = nullptr;
+		}
+
 		//========================================
 		// 引数からSetupsを受け取る
 		setup_ = setup;
 
 		//========================================
 		// メッシュデータ初期化
-		trailHistory_.clear();
-		vertices_.clear();
-		indices_.clear();
+		trailHistory_.assign(maxTrailPoints_, TrailPoint{});
+		historyHead_ = 0;
+		historyCount_ = 0;
 		lastEmitPosition_ = {0.0f, 0.0f, 0.0f};
 		accumulatedTime_ = 0.0f;
 
 		//========================================
-		// 各種バッファの作成
-		CreateVertexBuffer();
-		CreateConstantBuffers();
+		// 頂点スロットの確保（maxTrailPoints * 2 (左右の頂点)。空きが無い場合は描画しない）
+		vertexData_ = setup_->AcquireVertexSlot(vertexBase_);
+		if (!vertexData_) {
+			Log("TrailEmitter: no free vertex slot, this trail is not drawn", LogLevel::Warning);
+		}
 
 		//========================================
 		// デフォルト値の設定
@@ -57,64 +71,7 @@ namespace MagEngine {
 		paramsCPU_.lifeTime = 3.0f;
 		paramsCPU_.velocityDamping = 0.95f;
 		paramsCPU_.gravityInfluence = 0.2f;
-
-		Log("TrailEmitter initialized", LogLevel::Info);
-	}
-
-	///=============================================================================
-	///						頂点バッファの作成
-	void TrailEmitter::CreateVertexBuffer() {
-		//========================================
-		// 頂点バッファの作成（リボンメッシュ用）
-		// 最大 maxTrailPoints * 2 (左右の頂点) * 3 インデックス/セグメント
-		auto dxCore = setup_->GetDXCore();
-		size_t maxVertexCount = maxTrailPoints_ * 2;
-		size_t vertexBufferSize = sizeof(TrailVertex) * maxVertexCount;
-		vertexBuffer_ = dxCore->CreateBufferResource(vertexBufferSize);
-
-		//========================================
-		// 頂点バッファビューの設定
-		vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
-		vertexBufferView_.SizeInBytes = static_cast<UINT>(vertexBufferSize);
-		vertexBufferView_.StrideInBytes = sizeof(TrailVertex);
-
-		//========================================
-		// インデックスバッファの作成
-		// 最大 (maxTrailPoints - 1) * 6 インデックス（2三角形/セグメント）
-		size_t maxIndexCount = (maxTrailPoints_ - 1) * 6;
-		size_t indexBufferSize = sizeof(uint32_t) * maxIndexCount;
-		indexBuffer_ = dxCore->CreateBufferResource(indexBufferSize);
-
-		//========================================
-		// インデックスバッファビューの設定
-		indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
-		indexBufferView_.SizeInBytes = static_cast<UINT>(indexBufferSize);
-		indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
-	}
-
-	///=============================================================================
-	///						定数バッファの作成
-	void TrailEmitter::CreateConstantBuffers() {
-		auto dxCore = setup_->GetDXCore();
-
-		//========================================
-		// パラメータ用定数バッファの作成
-		// 定数バッファのサイズを 256 バイトの倍数に設定
-		size_t paramsSize = (sizeof(TrailRenderParams) + 255) & ~255;
-		paramsCB_ = dxCore->CreateBufferResource(paramsSize);
-		// 書き込むためのアドレスを取得
-		paramsCB_->Map(0, nullptr, reinterpret_cast<void **>(&paramsData_));
-		// 初期化
-		*paramsData_ = paramsCPU_;
-
-		//========================================
-		// カメラ用定数バッファの作成
-		size_t cameraSize = (sizeof(CameraConstant) + 255) & ~255;
-		cameraCB_ = dxCore->CreateBufferResource(cameraSize);
-		// 書き込むためのアドレスを取得
-		cameraCB_->Map(0, nullptr, reinterpret_cast<void **>(&cameraData_));
-		// 初期化
-		*cameraData_ = cameraCPU_;
+		// NOTE: プールのスロットごとに呼ばれるため、ログは出さない（TrailEffect 側で出す）
 	}
 
 	///=============================================================================
@@ -128,22 +85,6 @@ namespace MagEngine {
 		//========================================
 		// 古いポイントを削除
 		RemoveExpiredPoints(accumulatedTime_);
-
-		//========================================
-		// GPUバッファへパラメータをコピー
-		if (paramsData_) {
-			*paramsData_ = paramsCPU_;
-		}
-
-		//========================================
-		// カメラ情報を更新
-		auto camera = setup_->GetDefaultCamera();
-		if (camera && cameraData_) {
-			cameraCPU_.viewProj = camera->GetViewProjectionMatrix();
-			cameraCPU_.worldPosition = camera->GetTranslate();
-			cameraCPU_.time = accumulatedTime_;
-			*cameraData_ = cameraCPU_;
-		}
 	}
 
 	///=============================================================================
@@ -151,91 +92,122 @@ namespace MagEngine {
 	void TrailEmitter::Draw() {
 		//========================================
 		// 描画可能かチェック
-		if (!setup_ || !vertexBuffer_ || !indexBuffer_ || trailHistory_.size() < 2) {
+		if (!setup_ || !vertexData_ || historyCount_ < 2) {
 			return;
 		}
 
 		//========================================
-		// メッシュを再構築
-		BuildRibbonMesh();
-
-		//========================================
-		// インデックス数が0の場合はスキップ
-		if (indices_.empty()) {
-			return;
-		}
-
-		//========================================
-		// 共通描画設定
-		setup_->CommonDrawSetup();
-		auto commandList = setup_->GetDXCore()->GetCommandList();
-
-		//========================================
-		// 頂点バッファの設定
-		commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
-
-		//========================================
-		// インデックスバッファの設定
-		commandList->IASetIndexBuffer(&indexBufferView_);
+		// バッチに登録（頂点はスロットに書き込み済み。描画は FlushBatches で行う）
+		setup_->SubmitTrail(batchId_, this);
+	}
 
-		//========================================
-		// 定数バッファの設定
-		// パラメータ定数バッファ（b0）
-		commandList->SetGraphicsRootConstantBufferView(0, paramsCB_->GetGPUVirtualAddress());
+	///=============================================================================
+	///						まとめ描画用の情報を作る
+	TrailInstance TrailEmitter::MakeInstance() const {
+		TrailInstance instance;
+		instance.params = paramsCPU_;
+		instance.vertexBase = vertexBase_;
+		instance.head = historyHead_;
+		instance.pointCount = historyCount_;
+		instance.pointCapacity = maxTrailPoints_;
+		return instance;
+	}
 
+	///=============================================================================
+	///						境界球を求める
+	MagMath::BoundingSphere TrailEmitter::ComputeBoundingSphere() const {
+		MagMath::BoundingSphere sphere = {};
+		if (historyCount_ == 0) {
+			return sphere;
+		}
 		//========================================
-		// カメラ定数バッファの設定（b1）
-		commandList->SetGraphicsRootConstantBufferView(1, cameraCB_->GetGPUVirtualAddress());
-
+		// ポイントのAABBの中心を球の中心にする
+		const MagMath::Vector3 &first = trailHistory_[historyHead_].position;
+		MagMath::Vector3 minPosition = first;
+		MagMath::Vector3 maxPosition = first;
+		for (uint32_t i = 1; i < historyCount_; ++i) {
+			const MagMath::Vector3 &position = trailHistory_[(historyHead_ + i) % maxTrailPoints_].position;
+			minPosition.x = std::min(minPosition.x, position.x);
+			minPosition.y = std::min(minPosition.y, position.y);
+			minPosition.z = std::min(minPosition.z, position.z);
+			maxPosition.x = std::max(maxPosition.x, position.x);
+			maxPosition.y = std::max(maxPosition.y, position.y);
+			maxPosition.z = std::max(maxPosition.z, position.z);
+		}
+		sphere.center = (minPosition + maxPosition) * 0.5f;
 		//========================================
-		// 描画コール
-		commandList->DrawIndexedInstanced(static_cast<UINT>(indices_.size()), 1, 0, 0, 0);
+		// AABBの対角の半分に、VSで左右へ広げる幅を加える
+		sphere.radius = MagMath::Length(maxPosition - minPosition) * 0.5f + paramsCPU_.width;
+		return sphere;
 	}
 
 	///=============================================================================
 	///						軌跡を生成
 	void TrailEmitter::EmitTrail(const MagMath::Vector3 &position,
 								 const MagMath::Vector3 &velocity) {
+		if (!vertexData_) {
+			return;
+		}
+
 		//========================================
 		// 最小距離以上の距離がある場合のみポイントを追加
 		float distance = MagMath::Length(position - lastEmitPosition_);
-		if (distance < minPointDistance_ && !trailHistory_.empty()) {
+		if (distance < minPointDistance_ && historyCount_ > 0) {
 			return; // 最小距離に達していない
 		}
 
+		//========================================
+		// 最大ポイント数に達している場合は最も古いものを上書き
+		if (historyCount_ == maxTrailPoints_) {
+			historyHead_ = (historyHead_ + 1) % maxTrailPoints_;
+			--historyCount_;
+		}
+
 		//========================================
 		// 新しいポイントを追加
-		TrailPoint newPoint;
+		uint32_t slot = (historyHead_ + historyCount_) % maxTrailPoints_;
+		TrailPoint &newPoint = trailHistory_[slot];
 		newPoint.position = position;
 		newPoint.time = accumulatedTime_;
-		trailHistory_.push_back(newPoint);
+		++historyCount_;
 		lastEmitPosition_ = position;
 
 		//========================================
-		// 最大ポイント数を超えた場合は古いものから削除
-		if (trailHistory_.size() > maxTrailPoints_) {
-			trailHistory_.erase(trailHistory_.begin());
+		// 進行方向を求め、新しいポイントと直前のポイントの頂点だけを書き込む
+		// NOTE: 直前のポイントの向きは次のポイントへの方向なので、ここで確定する
+		MagMath::Vector3 tangent{0.0f, 0.0f, 1.0f};
+		if (historyCount_ >= 2) {
+			uint32_t prevSlot = (slot + maxTrailPoints_ - 1) % maxTrailPoints_;
+			MagMath::Vector3 delta = position - trailHistory_[prevSlot].position;
+			float len = MagMath::Length(delta);
+			if (len > 0.001f) {
+				tangent = delta * (1.0f / len);
+			}
+			WritePointVertices(prevSlot, tangent);
 		}
+		WritePointVertices(slot, tangent);
 	}
 
 	///=============================================================================
 	///						すべての軌跡をクリア
 	void TrailEmitter::ClearTrails() {
-		trailHistory_.clear();
-		vertices_.clear();
-		indices_.clear();
-		Log("All trail particles cleared", LogLevel::Info);
+		// NOTE: プールのトレイルを貸し出すたびに呼ばれるため、ログは出さない
+		historyHead_ = 0;
+		historyCount_ = 0;
+		accumulatedTime_ = 0.0f;
+		paramsCPU_.time = 0.0f;
 	}
 
 	///=============================================================================
 	///						古いポイントを削除
 	void TrailEmitter::RemoveExpiredPoints(float currentTime) {
 		//========================================
-		// ライフタイムが終わったポイントを削除
-		while (!trailHistory_.empty()) {
-			float pointAge = currentTime - trailHistory_.front().time;
+		// ライフタイムが終わったポイントを削除（先頭スロットを進めるだけ）
+		while (historyCount_ > 0) {
+			float pointAge = currentTime - trailHistory_[historyHead_].time;
 			if (pointAge > paramsCPU_.lifeTime) {
-				trailHistory_.erase(trailHistory_.begin());
+				historyHead_ = (historyHead_ + 1) % maxTrailPoints_;
+				--historyCount_;
 			} else {
 				break;
 			}
@@ -243,111 +215,12 @@ namespace MagEngine {
 	}
 
 	///=============================================================================
-	///						リボンメッシュを生成
-	void TrailEmitter::BuildRibbonMesh() {
-		vertices_.clear();
-		indices_.clear();
-
-		if (trailHistory_.size() < 2) {
-			return;
-		}
-
-		//========================================
-		// ポイント履歴から頂点を生成
-		GenerateVerticesFromHistory();
-
-		//========================================
-		// メモリに転送
-		if (!vertices_.empty() && vertexBuffer_) {
-			size_t bufferSize = sizeof(TrailVertex) * vertices_.size();
-			if (vertexBuffer_->GetDesc().Width >= bufferSize) {
-				void *vertexData = nullptr;
-				D3D12_RANGE readRange{0, 0};
-				vertexBuffer_->Map(0, &readRange, &vertexData);
-				std::memcpy(vertexData, vertices_.data(), bufferSize);
-				vertexBuffer_->Unmap(0, nullptr);
-			}
-		}
-
-		if (!indices_.empty() && indexBuffer_) {
-			size_t bufferSize = sizeof(uint32_t) * indices_.size();
-			if (indexBuffer_->GetDesc().Width >= bufferSize) {
-				void *indexData = nullptr;
-				D3D12_RANGE readRange{0, 0};
-				indexBuffer_->Map(0, &readRange, &indexData);
-				std::memcpy(indexData, indices_.data(), bufferSize);
-				indexBuffer_->Unmap(0, nullptr);
-			}
-		}
-	}
-
-	void TrailEmitter::GenerateVerticesFromHistory() {
-		// 簡易実装：後で詳細版に置き換え
-		if (trailHistory_.empty()) {
-			return;
-		}
-
-		MagMath::Vector3 cameraPos = cameraCPU_.worldPosition;
-
-		for (size_t i = 0; i < trailHistory_.size(); ++i) {
-			const TrailPoint &point = trailHistory_[i];
-			float pointAge = paramsCPU_.time - point.time;
-			float lifeFraction = std::max(0.0f, std::min(1.0f, pointAge / paramsCPU_.lifeTime));
-
-			MagMath::Vector3 direction{0.0f, 0.0f, 1.0f};
-			if (i < trailHistory_.size() - 1) {
-				MagMath::Vector3 delta = trailHistory_[i + 1].position - point.position;
-				float len = MagMath::Length(delta);
-				if (len > 0.001f) {
-					direction = MagMath::Normalize(delta);
-				}
-			}
-
-			MagMath::Vector3 toCamera = cameraPos - point.position;
-			float toLen = MagMath::Length(toCamera);
-			if (toLen > 0.001f) {
-				toCamera = MagMath::Normalize(toCamera);
-			} else {
-				toCamera = {0.0f, 0.0f, 1.0f};
-			}
+	///						指定スロットの頂点を書き込む
+	void TrailEmitter::WritePointVertices(uint32_t slot, const MagMath::Vector3 &tangent) {
+		const TrailPoint &point = trailHistory_[slot];
 
-			MagMath::Vector3 normal = MagMath::Cross(direction, toCamera);
-			float normLen = MagMath::Length(normal);
-			if (normLen > 0.001f) {
-				normal = MagMath::Normalize(normal);
-			} else {
-				normal = {1.0f, 0.0f, 0.0f};
-			}
-
-			float width = paramsCPU_.width * (1.0f - lifeFraction);
-
-			TrailVertex leftVertex;
-			leftVertex.position = point.position - normal * width;
-			leftVertex.age = lifeFraction;
-			leftVertex.normal = -normal;
-
-			TrailVertex rightVertex;
-			rightVertex.position = point.position + normal * width;
-			rightVertex.age = lifeFraction;
-			rightVertex.normal = normal;
-
-			vertices_.push_back(leftVertex);
-			vertices_.push_back(rightVertex);
-		}
-
-		for (size_t i = 0; i + 3 < vertices_.size(); i += 2) {
-			uint32_t l0 = static_cast<uint32_t>(i);
-			uint32_t r0 = static_cast<uint32_t>(i + 1);
-			uint32_t l1 = static_cast<uint32_t>(i + 2);
-			uint32_t r1 = static_cast<uint32_t>(i + 3);
-
-			indices_.push_back(l0);
-			indices_.push_back(r0);
-			indices_.push_back(l1);
-
-			indices_.push_back(r0);
-			indices_.push_back(r1);
-			indices_.push_back(l1);
-		}
+		// NOTE: 書き込み先はアップロードヒープ（書き込み結合）なので、読み返さずに1頂点ずつまとめて書く
+		vertexData_[slot * 2] = TrailVertex{point.position, point.time, tangent, -1.0f};
+		vertexData_[slot * 2 + 1] = TrailVertex{point.position, point.time, tangent, 1.0f};
 	}
 }
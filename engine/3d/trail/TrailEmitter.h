@@ -5,14 +5,17 @@
  * \author MagEngine
  * \date   March 2026
  * \note   軌跡パーティクルのバッファ管理と更新を担当
+ *         ポイント履歴はリングバッファで管理し、頂点は TrailEffectSetup の頂点スロットにリングの順で持つ
+ *         追加されたポイントの頂点だけをCPUで書き込み、幅の展開はVSで行う
+ *         描画は TrailEffectSetup にまとめて登録し、プリセット単位の1ドローで描く
  *********************************************************************/
 #pragma once
 #include "MagMath.h"
 #include "TrailEffectPreset.h"
-#include <d3d12.h>
+#include "TrailEffectSetup.h"
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
-#include <wrl/client.h>
 
 ///=============================================================================
 ///                        namespace MagEngine
@@ -20,7 +23,6 @@ namespace MagEngine {
 
 	///=============================================================================
 	///						前方宣言
-	class TrailEffectSetup;
 
 	///=============================================================================
 	///						構造体
@@ -36,18 +38,19 @@ namespace MagEngine {
 
 	/**----------------------------------------------------------------------------
 	 * \brief  TrailVertex トレイル頂点構造体
-	 * \note   GPU用の頂点データ
+	 * \note   1ポイントにつき左右2頂点
+	 *         経過時間率・カメラ方向への幅の展開はVSで求めるため、生成後に書き換える必要がない
 	 */
-	struct alignas(16) TrailVertex {
-		MagMath::Vector3 position; ///< 頂点位置
-		float age;				   ///< 経過時間率 (0.0-1.0)
-		MagMath::Vector3 normal;   ///< 法線方向
-		float padding;			   ///< パディング
+	struct TrailVertex {
+		MagMath::Vector3 position; ///< ポイントの位置（中心線）
+		float time;				   ///< ポイントの生成時刻
+		MagMath::Vector3 tangent;  ///< 進行方向（正規化済み）
+		float side;				   ///< 幅方向の符号（左:-1 / 右:+1）
 	};
 
 	/**----------------------------------------------------------------------------
 	 * \brief  TrailRenderParams トレイルレンダリングパラメータ（GPU用）
-	 * \note   トレイルの見た目を制御するパラメータ群
+	 * \note   トレイルの見た目を制御するパラメータ群（StructuredBufferの要素）
 	 */
 	struct alignas(16) TrailRenderParams {
 		MagMath::Vector3 color{0.5f, 0.5f, 0.5f};	   ///< エフェクト色（基本色）
@@ -62,6 +65,18 @@ namespace MagEngine {
 		float padding = 0.0f;						   ///< パディング
 	};
 
+	/**----------------------------------------------------------------------------
+	 * \brief  TrailInstance まとめ描画のトレイル1本分（GPU用）
+	 * \note   SV_InstanceID で参照する。VSは vertexBase からリングの先頭 head を起点に頂点を引く
+	 */
+	struct alignas(16) TrailInstance {
+		TrailRenderParams params;	///< 描画パラメータ
+		uint32_t vertexBase = 0;	///< 頂点スロットの先頭頂点番号
+		uint32_t head = 0;			///< 最も古いポイントのリング内の番号
+		uint32_t pointCount = 0;	///< 有効なポイント数
+		uint32_t pointCapacity = 0; ///< リングのポイント数
+	};
+
 	/**----------------------------------------------------------------------------
 	 * \brief  CameraConstant カメラ定数バッファ構造体（GPU用）
 	 * \note   トレイル描画に必要なカメラ情報
@@ -78,6 +93,13 @@ namespace MagEngine {
 		///--------------------------------------------------------------
 		///						 メンバ関数
 	public:
+		TrailEmitter() = default;
+		/// @brief 頂点スロットを TrailEffectSetup へ返す
+		~TrailEmitter();
+		// 頂点スロットを二重に返さないようコピー禁止
+		TrailEmitter(const TrailEmitter &) = delete;
+		TrailEmitter &operator=(const TrailEmitter &) = delete;
+
 		/**----------------------------------------------------------------------------
 		 * \brief  初期化
 		 * \param  setup TrailEffectSetupポインタ
@@ -91,10 +113,23 @@ namespace MagEngine {
 		void Update(float deltaTime);
 
 		/**----------------------------------------------------------------------------
-		 * \brief  描画
+		 * \brief  描画（TrailEffectSetup のバッチに登録）
+		 * \note   実際の描画は TrailEffectSetup::FlushBatches でまとめて行う
 		 */
 		void Draw();
 
+		/**----------------------------------------------------------------------------
+		 * \brief  まとめ描画用のトレイル1本分の情報を作る
+		 * \return 描画パラメータと頂点スロット内の描画範囲
+		 */
+		TrailInstance MakeInstance() const;
+
+		/**----------------------------------------------------------------------------
+		 * \brief  有効なポイントと描画幅を包む境界球を求める（カリング用）
+		 * \return ワールド座標の境界球（ポイントが無い場合は半径0）
+		 */
+		MagMath::BoundingSphere ComputeBoundingSphere() const;
+
 		/**----------------------------------------------------------------------------
 		 * \brief  軌跡の生成
 		 * \param  position 生成位置
@@ -179,31 +214,34 @@ namespace MagEngine {
 		 * \return パーティクル数
 		 */
 		size_t GetParticleCount() const {
-			return trailHistory_.size();
+			return historyCount_;
 		}
 
-		///--------------------------------------------------------------
-		///						 静的メンバ関数
-	private:
-		/**----------------------------------------------------------------------------
-		 * \brief  頂点バッファの作成
-		 */
-		void CreateVertexBuffer();
-
 		/**----------------------------------------------------------------------------
-		 * \brief  定数バッファの作成
+		 * \brief  描画パラメータの取得
+		 * \return 描画パラメータ
 		 */
-		void CreateConstantBuffers();
+		const TrailRenderParams &GetRenderParams() const {
+			return paramsCPU_;
+		}
 
 		/**----------------------------------------------------------------------------
-		 * \brief  リボンメッシュを生成（頂点・インデックスバッファを更新）
+		 * \brief  バッチ番号の設定
+		 * \param  batchId TrailEffectSetup::GetBatchId で取得した番号
 		 */
-		void BuildRibbonMesh();
+		void SetBatchId(uint32_t batchId) {
+			batchId_ = batchId;
+		}
 
+		///--------------------------------------------------------------
+		///						 静的メンバ関数
+	private:
 		/**----------------------------------------------------------------------------
-		 * \brief  ポイント履歴から頂点を生成
+		 * \brief  指定スロットのポイントの頂点を書き込む
+		 * \param  slot リングバッファのスロット番号
+		 * \param  tangent 進行方向（正規化済み）
 		 */
-		void GenerateVerticesFromHistory();
+		void WritePointVertices(uint32_t slot, const MagMath::Vector3 &tangent);
 
 		/**----------------------------------------------------------------------------
 		 * \brief  古いポイントを削除
@@ -219,33 +257,21 @@ namespace MagEngine {
 
 		//========================================
 		// トレイルポイント履歴（リング）
-		std::vector<TrailPoint> trailHistory_;
-		size_t maxTrailPoints_ = 128;	///< 最大ポイント数
-		float minPointDistance_ = 0.1f; ///< ポイント生成の最小距離
-
-		//========================================
-		// 頂点データ（CPU側）
-		std::vector<TrailVertex> vertices_;
-		std::vector<uint32_t> indices_;
+		std::vector<TrailPoint> trailHistory_;						  ///< maxTrailPoints_ 個のスロット
+		uint32_t historyHead_ = 0;									  ///< 最も古いポイントのスロット
+		uint32_t historyCount_ = 0;									  ///< 有効なポイント数
+		uint32_t maxTrailPoints_ = TrailEffectSetup::kSlotPointCount; ///< 最大ポイント数（頂点スロットの大きさ）
+		float minPointDistance_ = 0.1f;								  ///< ポイント生成の最小距離
 
 		//========================================
-		// 頂点バッファ
-		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
-		Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
-		D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-		D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+		// 頂点（TrailEffectSetup の頂点スロット。リングのスロット s の頂点は 2s, 2s+1 に置く）
+		TrailVertex *vertexData_ = nullptr;
+		uint32_t vertexBase_ = TrailEffectSetup::kInvalidVertexBase;
 
 		//========================================
-		// 定数バッファ
-		Microsoft::WRL::ComPtr<ID3D12Resource> paramsCB_;
-		TrailRenderParams *paramsData_ = nullptr;
+		// 描画パラメータ
 		TrailRenderParams paramsCPU_;
-
-		//========================================
-		// カメラ定数バッファ
-		Microsoft::WRL::ComPtr<ID3D12Resource> cameraCB_;
-		CameraConstant *cameraData_ = nullptr;
-		CameraConstant cameraCPU_;
+		uint32_t batchId_ = 0; ///< 登録先のバッチ番号
 
 		//========================================
 		// その他
@@ -0,0 +1,191 @@
+#include "AssetLoader.h"
+#include "Logger.h"
+#include "ModelManager.h"
+#include "TextureManager.h"
+#include "externals/json.hpp"
+#include <algorithm>
+#include <fstream>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	AssetLoader *AssetLoader::instance_ = nullptr;
+
+	///=============================================================================
+	///						インスタンスの取得
+	AssetLoader *AssetLoader::GetInstance() {
+		if (instance_ == nullptr) {
+			instance_ = new AssetLoader();
+			instance_->Initialize();
+		}
+		return instance_;
+	}
+
+	///=============================================================================
+	///						初期化
+	void AssetLoader::Initialize(uint32_t workerCount) {
+		if (!workers_.empty()) {
+			return;
+		}
+		if (workerCount == 0) {
+			// NOTE: 読み込みはI/O待ちも多いが、JobSystemのワーカーと取り合わないよう控えめにする
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = std::clamp(hardwareThreads / 2, 1u, 4u);
+		}
+
+		isStopping_ = false;
+		workers_.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			workers_.emplace_back(&AssetLoader::WorkerLoop, this);
+		}
+	}
+
+	///=============================================================================
+	///						終了処理
+	void AssetLoader::Finalize() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isStopping_ = true;
+			queuedJobs_.clear();
+		}
+		wakeCondition_.notify_all();
+		for (std::thread &worker : workers_) {
+			worker.join();
+		}
+		workers_.clear();
+		completedJobs_.clear();
+		pendingCount_ = 0;
+
+		if (instance_ == this) {
+			instance_ = nullptr;
+			delete this;
+		}
+	}
+
+	///=============================================================================
+	///						ジョブの追加
+	AssetLoadHandle AssetLoader::Enqueue(DecodeFunc decode, FinalizeFunc finalize) {
+		AssetLoadHandle handle;
+		handle.isReady_ = std::make_shared<std::atomic<bool>>(false);
+		++pendingCount_;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			queuedJobs_.push_back({std::move(decode), std::move(finalize), handle.isReady_});
+		}
+		wakeCondition_.notify_one();
+		return handle;
+	}
+
+	///=============================================================================
+	///						完了したジョブの finalize
+	uint32_t AssetLoader::ProcessCompleted() {
+		std::vector<Job> completed;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			completed.swap(completedJobs_);
+		}
+		for (Job &job : completed) {
+			if (job.finalize) {
+				job.finalize();
+			}
+			job.isReady->store(true, std::memory_order_release);
+			--pendingCount_;
+		}
+		return static_cast<uint32_t>(completed.size());
+	}
+
+	///=============================================================================
+	///						完了待ち
+	void AssetLoader::Wait(const AssetLoadHandle &handle) {
+		while (true) {
+			ProcessCompleted();
+			if (handle.IsReady()) {
+				return;
+			}
+			std::unique_lock<std::mutex> lock(mutex_);
+			completedCondition_.wait(lock, [this]() {
+				return !completedJobs_.empty();
+			});
+		}
+	}
+
+	void AssetLoader::Wait(const std::vector<AssetLoadHandle> &handles) {
+		for (const AssetLoadHandle &handle : handles) {
+			Wait(handle);
+		}
+	}
+
+	///=============================================================================
+	///						マニフェストの読み込み
+	std::vector<AssetLoadHandle> AssetLoader::PreloadManifest(const std::string &manifestPath) {
+		std::vector<AssetLoadHandle> handles;
+		std::ifstream file(manifestPath);
+		if (!file.is_open()) {
+			Logger::Log("AssetLoader: manifest not found: " + manifestPath, Logger::LogLevel::Error);
+			return handles;
+		}
+		nlohmann::json manifest;
+		try {
+			file >> manifest;
+		} catch (const nlohmann::json::parse_error &e) {
+			Logger::Log("AssetLoader: failed to parse manifest " + manifestPath + " : " + e.what(), Logger::LogLevel::Error);
+			return handles;
+		}
+
+		//========================================
+		// テクスチャ・モデルの順に読み込みを開始
+		if (manifest.contains("textures")) {
+			for (const auto &path : manifest["textures"]) {
+				handles.push_back(TextureManager::GetInstance()->LoadTextureAsync(path.get<std::string>()));
+			}
+		}
+		if (manifest.contains("models")) {
+			for (const auto &path : manifest["models"]) {
+				handles.push_back(ModelManager::GetInstance()->LoadModelAsync(path.get<std::string>()));
+			}
+		}
+		return handles;
+	}
+
+	///=============================================================================
+	///						全ハンドルの完了判定
+	bool AssetLoader::IsAllReady(const std::vector<AssetLoadHandle> &handles) {
+		return std::all_of(handles.begin(), handles.end(), [](const AssetLoadHandle &handle) {
+			return handle.IsReady();
+		});
+	}
+
+	///=============================================================================
+	///						ワーカースレッドのループ
+	void AssetLoader::WorkerLoop() {
+		// WICによるデコードにはスレッド毎のCOM初期化が必要
+		CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+		while (true) {
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				wakeCondition_.wait(lock, [this]() {
+					return isStopping_ || !queuedJobs_.empty();
+				});
+				if (isStopping_) {
+					break;
+				}
+				job = std::move(queuedJobs_.front());
+				queuedJobs_.pop_front();
+			}
+
+			if (job.decode) {
+				job.decode();
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				completedJobs_.push_back(std::move(job));
+			}
+			completedCondition_.notify_all();
+		}
+
+		CoUninitialize();
+	}
+}
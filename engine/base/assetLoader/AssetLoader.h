@@ -0,0 +1,134 @@
+/*********************************************************************
+ * \file   AssetLoader.h
+ * \brief  アセットの非同期読み込み（ワーカーでデコード、メインスレッドでGPUへ転送）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   ファイル読み込み・Assimp・テクスチャのデコードはワーカースレッドで並列に行い、
+ *         リソース生成やSRV確保などGPUに触れる処理は ProcessCompleted でメインスレッドから実行する
+ *         ProcessCompleted / Wait / Enqueue はメインスレッドからのみ呼ぶこと
+ *********************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						読み込みハンドル
+	class AssetLoadHandle {
+	public:
+		AssetLoadHandle() = default;
+
+		/// @brief 読み込み済みを表すハンドル
+		static AssetLoadHandle MakeReady() {
+			AssetLoadHandle handle;
+			handle.isReady_ = std::make_shared<std::atomic<bool>>(true);
+			return handle;
+		}
+
+		/// @brief 有効なハンドルか
+		bool IsValid() const {
+			return isReady_ != nullptr;
+		}
+
+		/// @brief GPUへの転送まで完了し、使用できる状態か（無効なハンドルは完了扱い）
+		bool IsReady() const {
+			return !isReady_ || isReady_->load(std::memory_order_acquire);
+		}
+
+	private:
+		friend class AssetLoader;
+		std::shared_ptr<std::atomic<bool>> isReady_;
+	};
+
+	///=============================================================================
+	///						アセットローダー
+	class AssetLoader {
+		///--------------------------------------------------------------
+		///						 メンバ関数
+	public:
+		/// @brief ワーカースレッドで実行する処理（ファイル読み込み・デコード）
+		using DecodeFunc = std::function<void()>;
+		/// @brief メインスレッドで実行する処理（GPUリソースの生成・登録）
+		using FinalizeFunc = std::function<void()>;
+
+		/// @brief インスタンスの取得
+		/// @note 未初期化の場合は既定のワーカー数で初期化する
+		static AssetLoader *GetInstance();
+
+		/// @brief 初期化
+		/// @param workerCount ワーカースレッド数（0で論理コア数の半分、最大4）
+		void Initialize(uint32_t workerCount = 0);
+
+		/// @brief 終了処理（未処理のジョブは破棄する）
+		void Finalize();
+
+		/// @brief 読み込みジョブを追加
+		/// @param decode ワーカーで実行する処理
+		/// @param finalize decode 完了後にメインスレッドで実行する処理
+		/// @return finalize の完了で Ready になるハンドル
+		AssetLoadHandle Enqueue(DecodeFunc decode, FinalizeFunc finalize);
+
+		/// @brief デコードが完了したジョブの finalize を実行（毎フレーム呼ぶ）
+		/// @return 実行したジョブ数
+		uint32_t ProcessCompleted();
+
+		/// @brief ハンドルの完了を待つ（待つ間も ProcessCompleted を実行する）
+		void Wait(const AssetLoadHandle &handle);
+
+		/// @brief 全てのハンドルの完了を待つ
+		void Wait(const std::vector<AssetLoadHandle> &handles);
+
+		/// @brief マニフェスト（JSON）に書かれたテクスチャとモデルの読み込みを開始
+		/// @param manifestPath マニフェストのパス
+		/// @return 各アセットのハンドル
+		/// @note 形式は { "textures": ["a.dds", ...], "models": ["b.obj", ...] }
+		std::vector<AssetLoadHandle> PreloadManifest(const std::string &manifestPath);
+
+		/// @brief 全てのハンドルが完了しているか（ローディング画面のポーリング用）
+		static bool IsAllReady(const std::vector<AssetLoadHandle> &handles);
+
+		/// @brief 追加済みで finalize が終わっていないジョブ数
+		uint32_t GetPendingCount() const {
+			return pendingCount_;
+		}
+
+		///--------------------------------------------------------------
+		///						 内部処理
+	private:
+		/// @brief 読み込みジョブ
+		struct Job {
+			DecodeFunc decode;
+			FinalizeFunc finalize;
+			std::shared_ptr<std::atomic<bool>> isReady;
+		};
+
+		/// @brief ワーカースレッドのループ
+		void WorkerLoop();
+
+		///--------------------------------------------------------------
+		///						 メンバ変数
+	private:
+		static AssetLoader *instance_;
+
+		std::vector<std::thread> workers_;
+		std::mutex mutex_;
+		std::condition_variable wakeCondition_;
+		std::condition_variable completedCondition_;
+		bool isStopping_ = false;
+
+		std::deque<Job> queuedJobs_;	   // デコード待ち
+		std::vector<Job> completedJobs_; // finalize 待ち
+		uint32_t pendingCount_ = 0;	   // メインスレッドのみで更新
+	};
+}
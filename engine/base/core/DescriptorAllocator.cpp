@@ -0,0 +1,162 @@
+#include "DescriptorAllocator.h"
+#include <algorithm>
+#include <iterator>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						初期化
+	void DescriptorAllocator::Initialize(uint32_t capacity) {
+		capacity_ = capacity;
+		freeRanges_.clear();
+		allocations_.clear();
+		pendingFrees_.clear();
+		if (capacity_ > 0) {
+			freeRanges_.emplace(0, capacity_);
+		}
+		usedCount_ = 0;
+		pendingCount_ = 0;
+		peakCount_ = 0;
+		failedCount_ = 0;
+		std::fill(std::begin(categoryStats_), std::end(categoryStats_), CategoryStats{});
+	}
+
+	///=============================================================================
+	///						確保
+	uint32_t DescriptorAllocator::Allocate(uint32_t count, DescriptorCategory category) {
+		if (count == 0) {
+			++failedCount_;
+			return kInvalidIndex;
+		}
+		//========================================
+		// 収まる中で最小の空き範囲を探す（同じ大きさなら先頭が小さい方）
+		auto best = freeRanges_.end();
+		for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it) {
+			if (it->second >= count && (best == freeRanges_.end() || it->second < best->second)) {
+				best = it;
+				if (best->second == count) {
+					break;
+				}
+			}
+		}
+		if (best == freeRanges_.end()) {
+			++failedCount_;
+			return kInvalidIndex;
+		}
+
+		//========================================
+		// 空き範囲の先頭から切り出す
+		uint32_t index = best->first;
+		uint32_t remaining = best->second - count;
+		freeRanges_.erase(best);
+		if (remaining > 0) {
+			freeRanges_.emplace(index + count, remaining);
+		}
+		allocations_.emplace(index, Allocation{count, category});
+
+		//========================================
+		// 使用状況の更新
+		usedCount_ += count;
+		peakCount_ = std::max(peakCount_, usedCount_);
+		CategoryStats &stats = categoryStats_[static_cast<uint32_t>(category)];
+		stats.usedCount += count;
+		stats.peakCount = std::max(stats.peakCount, stats.usedCount);
+		++stats.allocateCount;
+		return index;
+	}
+
+	///=============================================================================
+	///						解放
+	bool DescriptorAllocator::Free(uint32_t index, uint64_t fenceValue) {
+		auto found = allocations_.find(index);
+		if (found == allocations_.end()) {
+			return false;
+		}
+		const Allocation allocation = found->second;
+		allocations_.erase(found);
+
+		usedCount_ -= allocation.count;
+		CategoryStats &stats = categoryStats_[static_cast<uint32_t>(allocation.category)];
+		stats.usedCount -= allocation.count;
+		++stats.freeCount;
+
+		//========================================
+		// GPUが参照し終わるまで保留する（フェンス値の昇順を保つ）
+		if (fenceValue == 0) {
+			InsertFreeRange(index, allocation.count);
+			return true;
+		}
+		auto position = pendingFrees_.end();
+		while (position != pendingFrees_.begin() && std::prev(position)->fenceValue > fenceValue) {
+			--position;
+		}
+		pendingFrees_.insert(position, PendingFree{index, allocation.count, fenceValue});
+		pendingCount_ += allocation.count;
+		return true;
+	}
+
+	///=============================================================================
+	///						保留中の範囲の回収
+	uint32_t DescriptorAllocator::Reclaim(uint64_t completedFenceValue) {
+		uint32_t reclaimed = 0;
+		while (!pendingFrees_.empty() && pendingFrees_.front().fenceValue <= completedFenceValue) {
+			const PendingFree &pending = pendingFrees_.front();
+			InsertFreeRange(pending.index, pending.count);
+			reclaimed += pending.count;
+			pendingFrees_.pop_front();
+		}
+		pendingCount_ -= reclaimed;
+		return reclaimed;
+	}
+
+	///=============================================================================
+	///						用途の表示名
+	const char *DescriptorAllocator::GetCategoryName(DescriptorCategory category) {
+		switch (category) {
+		case DescriptorCategory::Texture:
+			return "Texture";
+		case DescriptorCategory::RenderTexture:
+			return "RenderTexture";
+		case DescriptorCategory::StructuredBuffer:
+			return "StructuredBuffer";
+		case DescriptorCategory::Other:
+			return "Other";
+		default:
+			return "Unknown";
+		}
+	}
+
+	///=============================================================================
+	///						最大の空き範囲
+	uint32_t DescriptorAllocator::GetLargestFreeRange() const {
+		uint32_t largest = 0;
+		for (const auto &[index, count] : freeRanges_) {
+			largest = std::max(largest, count);
+		}
+		return largest;
+	}
+
+	///=============================================================================
+	///						空きリストへ戻す
+	void DescriptorAllocator::InsertFreeRange(uint32_t index, uint32_t count) {
+		auto next = freeRanges_.lower_bound(index);
+		//========================================
+		// 直前の空き範囲と接していれば結合
+		if (next != freeRanges_.begin()) {
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == index) {
+				index = prev->first;
+				count += prev->second;
+				freeRanges_.erase(prev);
+			}
+		}
+		//========================================
+		// 直後の空き範囲と接していれば結合
+		if (next != freeRanges_.end() && index + count == next->first) {
+			count += next->second;
+			freeRanges_.erase(next);
+		}
+		freeRanges_.emplace(index, count);
+	}
+}
@@ -0,0 +1,142 @@
+/*********************************************************************
+ * \file   DescriptorAllocator.h
+ * \brief  ディスクリプタヒープの番号管理（空きリスト方式のCPU側ロジック）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   空き領域を [先頭, 個数] の範囲で管理し、ディスクリプタテーブル用の連続範囲も確保できる
+ *         解放した範囲は指定フェンス値の完了まで保留し、Reclaim で空きリストへ戻して隣接範囲と結合する
+ *         GPUリソースには触れないため、GPUなしで動作を確認できる（tests/DescriptorAllocatorTest.cpp）
+ *********************************************************************/
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						ディスクリプタの用途（使用量の集計用）
+	enum class DescriptorCategory : uint32_t {
+		Texture,		  // 読み込んだテクスチャ
+		RenderTexture,	  // オフスクリーンのレンダーテクスチャ
+		StructuredBuffer, // 構造化バッファ
+		Other,			  // その他
+		Count
+	};
+
+	///=============================================================================
+	///						空きリスト方式のディスクリプタアロケータ
+	class DescriptorAllocator {
+		///--------------------------------------------------------------
+		///							メンバ関数
+	public:
+		//========================================
+		// 確保失敗を表す番号
+		static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+		/// \brief 用途ごとの使用状況
+		struct CategoryStats {
+			uint32_t usedCount = 0;		// 使用中のディスクリプタ数
+			uint32_t peakCount = 0;		// 使用中のディスクリプタ数の最大
+			uint32_t allocateCount = 0; // 確保した回数
+			uint32_t freeCount = 0;		// 解放した回数
+		};
+
+		/// \brief 初期化（全体を1つの空き範囲にする）
+		/// \param capacity ヒープのディスクリプタ数
+		void Initialize(uint32_t capacity);
+
+		/// \brief 連続した範囲を確保
+		/// \param count ディスクリプタ数
+		/// \param category 用途
+		/// \return 先頭の番号（空きが足りない場合 kInvalidIndex）
+		/// \note 収まる範囲のうち最も小さいものから切り出し、大きな空き範囲を残す
+		uint32_t Allocate(uint32_t count, DescriptorCategory category);
+
+		/// \brief 範囲を解放
+		/// \param index Allocate が返した先頭の番号
+		/// \param fenceValue この範囲を参照するコマンドの完了でシグナルされるフェンス値（0なら即座に再利用できる）
+		/// \return 確保されていない番号の場合 false
+		bool Free(uint32_t index, uint64_t fenceValue);
+
+		/// \brief 完了したフェンス値までの保留中の範囲を空きリストへ戻す
+		/// \param completedFenceValue GPUが完了したフェンス値
+		/// \return 戻したディスクリプタ数
+		uint32_t Reclaim(uint64_t completedFenceValue);
+
+		/// \brief 用途の表示名
+		static const char *GetCategoryName(DescriptorCategory category);
+
+		///--------------------------------------------------------------
+		///							入出力関数
+	public:
+		uint32_t GetCapacity() const {
+			return capacity_;
+		}
+		/// \brief 使用中のディスクリプタ数（保留中を含まない）
+		uint32_t GetUsedCount() const {
+			return usedCount_;
+		}
+		/// \brief フェンス待ちで再利用できないディスクリプタ数
+		uint32_t GetPendingCount() const {
+			return pendingCount_;
+		}
+		/// \brief すぐに確保できるディスクリプタ数
+		uint32_t GetFreeCount() const {
+			return capacity_ - usedCount_ - pendingCount_;
+		}
+		/// \brief 空き範囲の数（断片化の目安）
+		uint32_t GetFreeRangeCount() const {
+			return static_cast<uint32_t>(freeRanges_.size());
+		}
+		/// \brief 1度に確保できる最大の連続数
+		uint32_t GetLargestFreeRange() const;
+		/// \brief これまでの使用中ディスクリプタ数の最大
+		uint32_t GetPeakCount() const {
+			return peakCount_;
+		}
+		/// \brief 確保に失敗した回数
+		uint32_t GetFailedCount() const {
+			return failedCount_;
+		}
+		const CategoryStats &GetCategoryStats(DescriptorCategory category) const {
+			return categoryStats_[static_cast<uint32_t>(category)];
+		}
+
+		///--------------------------------------------------------------
+		///							内部処理
+	private:
+		/// \brief 確保済みの範囲
+		struct Allocation {
+			uint32_t count;
+			DescriptorCategory category;
+		};
+
+		/// \brief フェンス待ちの範囲
+		struct PendingFree {
+			uint32_t index;
+			uint32_t count;
+			uint64_t fenceValue;
+		};
+
+		/// \brief 空きリストへ戻し、前後の空き範囲と結合する
+		void InsertFreeRange(uint32_t index, uint32_t count);
+
+		///--------------------------------------------------------------
+		///							メンバ変数
+	private:
+		uint32_t capacity_ = 0;
+		std::map<uint32_t, uint32_t> freeRanges_;				// 先頭の番号 → 個数（先頭順）
+		std::unordered_map<uint32_t, Allocation> allocations_; // 先頭の番号 → 確保済みの範囲
+		std::deque<PendingFree> pendingFrees_;					// フェンス値の昇順
+
+		uint32_t usedCount_ = 0;
+		uint32_t pendingCount_ = 0;
+		uint32_t peakCount_ = 0;
+		uint32_t failedCount_ = 0;
+		CategoryStats categoryStats_[static_cast<uint32_t>(DescriptorCategory::Count)] = {};
+	};
+}
@@ -45,13 +45,8 @@ namespace MagEngine {
 		commandList_->SetGraphicsRootSignature(renderTextureRootSignature_.Get());
 		commandList_->SetPipelineState(renderTextureGraphicsPipelineState_.Get());
 
-		D3D12_GPU_DESCRIPTOR_HANDLE srvHandle;
-
-		if(renderResourceIndex_ == 0) {
-			srvHandle = TextureManager::GetInstance()->GetSrvHandleGPU("RenderTexture0");
-		} else {
-			srvHandle = TextureManager::GetInstance()->GetSrvHandleGPU("RenderTexture1");
-		}
+		TextureManager *textureManager = TextureManager::GetInstance();
+		D3D12_GPU_DESCRIPTOR_HANDLE srvHandle = textureManager->GetSrvHandleGPU(textureManager->GetRenderTextureHandle(renderResourceIndex_));
 
 		// srvHandle.ptr が 0 または異常な値でないか確認
 		assert(srvHandle.ptr != 0);
@@ -76,6 +71,9 @@ namespace MagEngine {
 		// コマンドリストのクローズと実行
 		CloseCommandList();
 		ExecuteCommandList();
+		// アップロードリングを次のフレーム領域へ
+		uploadAllocator_.EndFrame(fenceValue_);
+		BeginUploadFrame();
 	}
 
 	///=============================================================================
@@ -109,6 +107,8 @@ namespace MagEngine {
 		CreateSwapChain();
 		// フェンスの生成
 		CreateFence();
+		// アップロードリングの生成
+		CreateUploadRing();
 		// 深度バッファの生成
 		CreateDepthBuffer();
 		// 様々なヒープサイズの取得
@@ -734,6 +734,91 @@ namespace MagEngine {
 		return resource;
 	}
 
+	///=============================================================================
+	///						デフォルトヒープのバッファリソースの生成
+	Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCore::CreateDefaultBufferResource(size_t sizeInByte) {
+		D3D12_RESOURCE_DESC resourceDesc{};
+		resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+		resourceDesc.Width = sizeInByte;
+		resourceDesc.Height = 1;
+		resourceDesc.DepthOrArraySize = 1;
+		resourceDesc.MipLevels = 1;
+		resourceDesc.SampleDesc.Count = 1;
+		resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+		//=======================================
+		// デフォルトヒープ（CPUから書き込めない）
+		D3D12_HEAP_PROPERTIES defaultHeapProperties{};
+		defaultHeapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+		//=======================================
+		// リソースを作成
+		// NOTE: バッファは COMMON から COPY_DEST や読み取り状態へ暗黙に昇格する
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource = nullptr;
+		HRESULT hr = device_->CreateCommittedResource(
+			&defaultHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&resourceDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(&resource));
+		if(FAILED(hr) || !resource) {
+			return nullptr;
+		}
+
+		return resource;
+	}
+
+	///=============================================================================
+	///						アップロードリングの生成
+	void DirectXCore::CreateUploadRing() {
+		uploadAllocator_.Initialize(kUploadRegionSize, kUploadRegionCount);
+		uploadRingResource_ = CreateBufferResource(uploadAllocator_.GetCapacity());
+		assert(uploadRingResource_);
+		// COMMENT: アップロードヒープは常時マップしたままで問題ない
+		D3D12_RANGE readRange{0, 0};
+		uploadRingResource_->Map(0, &readRange, reinterpret_cast<void **>(&uploadRingData_));
+		BeginUploadFrame();
+		Logger::Log(std::format("Upload ring created: {} regions x {} KB", kUploadRegionCount, kUploadRegionSize / 1024), Logger::LogLevel::Success);
+	}
+
+	///=============================================================================
+	///						次のフレーム領域へ
+	void DirectXCore::BeginUploadFrame() {
+		//=======================================
+		// 前回この領域を使ったフレームのコマンドが完了していなければ待つ
+		uint64_t waitValue = uploadAllocator_.BeginFrame();
+		if(waitValue != 0 && fence_->GetCompletedValue() < waitValue) {
+			fence_->SetEventOnCompletion(waitValue, fenceEvent_);
+			WaitForSingleObject(fenceEvent_, INFINITE);
+		}
+	}
+
+	///=============================================================================
+	///						アップロード領域からバッファへコピー
+	void DirectXCore::CopyUploadToBuffer(const UploadAllocation &allocation, ID3D12Resource *destination, uint64_t destinationOffset) {
+		assert(allocation.cpuAddress && destination);
+		uint64_t sourceOffset = allocation.gpuAddress - uploadRingResource_->GetGPUVirtualAddress();
+		commandList_->CopyBufferRegion(destination, destinationOffset, uploadRingResource_.Get(), sourceOffset, allocation.size);
+	}
+
+	///=============================================================================
+	///						アップロードリングから確保
+	UploadAllocation DirectXCore::AllocateUpload(size_t size, size_t alignment) {
+		UploadAllocation allocation;
+		size_t offset = uploadAllocator_.Allocate(size, alignment);
+		if(offset == FrameUploadAllocator::kInvalidOffset) {
+			// 1フレームにつき最初の失敗だけ記録する
+			if(uploadAllocator_.GetFailedCount() == 1) {
+				Logger::Log(std::format("Upload ring is full: requested {} bytes, used {} / {} bytes",
+					size, uploadAllocator_.GetUsedBytes(), uploadAllocator_.GetRegionSize()), Logger::LogLevel::Warning);
+			}
+			return allocation;
+		}
+		allocation.cpuAddress = uploadRingData_ + offset;
+		allocation.gpuAddress = uploadRingResource_->GetGPUVirtualAddress() + offset;
+		allocation.size = size;
+		return allocation;
+	}
+
 	///=============================================================================
 	///						テクスチャリソースの生成
 	Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCore::CreateTextureResource(const DirectX::TexMetadata &metadata) {
@@ -20,6 +20,7 @@
 #include "MagMath.h"
 #include "WstringUtility.h"
 #include "Logger.h"
+#include "FrameUploadAllocator.h"
 #include "FullscreenPassRendere.h"
 #include "GrayscaleEffect.h"
 #include "WinApp.h"
@@ -50,6 +51,14 @@ extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg
 ///=============================================================================
 ///                        namespace MagEngine
 namespace MagEngine {
+	///=============================================================================
+	///						アップロードリングからの確保結果
+	struct UploadAllocation {
+		void *cpuAddress = nullptr;				  // 書き込み先（確保失敗時は nullptr）
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0; // GPU仮想アドレス
+		size_t size = 0;						  // バイト数
+	};
+
 ///=============================================================================
 ///						クラス
 	class PostEffectManager;
@@ -203,6 +212,13 @@ namespace MagEngine {
 		/// @return
 		Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResource(size_t sizeInByte);
 
+		//========================================
+		/// @brief CreateDefaultBufferResource GPU専用（デフォルトヒープ）のバッファリソースの生成
+		/// @param sizeInByte サイズ
+		/// @return
+		/// @note 状態は COMMON で作成する。書き込みは CopyUploadToBuffer で行う
+		Microsoft::WRL::ComPtr<ID3D12Resource> CreateDefaultBufferResource(size_t sizeInByte);
+
 		//========================================
 		/// @brief CreateTextureResource テクスチャリソースの生成
 		/// @param metadata メタデータ
@@ -223,6 +239,57 @@ namespace MagEngine {
 		/// @return
 		static DirectX::ScratchImage LoadTexture(const std::string &filePath);
 
+		///--------------------------------------------------------------
+		///						アップロードリング（フレーム単位の動的データ）
+	public:
+		//========================================
+		/// @brief AllocateUpload 現フレームのアップロード領域から確保
+		/// @param size バイト数
+		/// @param alignment アライメント（2の累乗。CBVとして使う場合は256）
+		/// @return 確保結果（容量不足の場合 cpuAddress が nullptr）
+		/// @note 領域は後のフレームで再利用されるため、確保したフレームのうちに描画コマンドへ積むこと
+		UploadAllocation AllocateUpload(size_t size, size_t alignment = kUploadAlignment);
+
+		//========================================
+		/// @brief CopyUploadToBuffer アップロード領域からバッファへのコピーをコマンドに積む
+		/// @param allocation AllocateUpload の確保結果
+		/// @param destination コピー先（COPY_DEST 状態、または COMMON から暗黙に昇格できること）
+		/// @param destinationOffset コピー先のバイトオフセット
+		void CopyUploadToBuffer(const UploadAllocation &allocation, ID3D12Resource *destination, uint64_t destinationOffset);
+
+		//========================================
+		/// @brief GetUploadFrameSerial アップロード領域のフレーム番号（確保したフレームの判定用）
+		uint64_t GetUploadFrameSerial() const {
+			return uploadAllocator_.GetFrameSerial();
+		}
+
+		//========================================
+		/// @brief GetUploadAllocator アップロードリングの状態取得（使用量の表示用）
+		const FrameUploadAllocator &GetUploadAllocator() const {
+			return uploadAllocator_;
+		}
+
+		//========================================
+		/// @brief GetCurrentFrameFenceValue 現フレームのコマンド完了時にシグナルされるフェンス値
+		uint64_t GetCurrentFrameFenceValue() const {
+			return fenceValue_ + 1;
+		}
+
+		//========================================
+		/// @brief GetCompletedFenceValue GPUが完了したフェンス値
+		uint64_t GetCompletedFenceValue() const {
+			return fence_->GetCompletedValue();
+		}
+
+	private:
+		//========================================
+		/// @brief CreateUploadRing アップロードリングの生成（常時マップ）
+		void CreateUploadRing();
+
+		//========================================
+		/// @brief BeginUploadFrame 次のフレーム領域へ進む（領域を使っていたフレームの完了を待つ）
+		void BeginUploadFrame();
+
 		///--------------------------------------------------------------
 		///						レンダーテクスチャ系
 	public:
@@ -449,6 +516,15 @@ namespace MagEngine {
 		uint64_t fenceValue_ = 0;
 		HANDLE fenceEvent_ = nullptr; // Initialize to nullptr
 
+		//========================================
+		// アップロードリング
+		static constexpr size_t kUploadRegionSize = 16 * 1024 * 1024; // 1フレーム領域のバイト数
+		static constexpr uint32_t kUploadRegionCount = 3;			   // フレーム領域の数
+		static constexpr size_t kUploadAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+		Microsoft::WRL::ComPtr<ID3D12Resource> uploadRingResource_;
+		uint8_t *uploadRingData_ = nullptr;
+		FrameUploadAllocator uploadAllocator_;
+
 		//========================================
 		// 深度バッファ
 		D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle_{};
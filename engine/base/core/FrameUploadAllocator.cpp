@@ -0,0 +1,52 @@
+#include "FrameUploadAllocator.h"
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						初期化
+	void FrameUploadAllocator::Initialize(size_t regionSize, uint32_t regionCount) {
+		regionSize_ = regionSize;
+		regionFences_.assign(regionCount > 0 ? regionCount : 1, 0);
+		// COMMENT: 最初の BeginFrame で領域0から使い始める
+		currentRegion_ = static_cast<uint32_t>(regionFences_.size()) - 1;
+		offset_ = 0;
+		frameSerial_ = 0;
+		peakBytes_ = 0;
+		failedCount_ = 0;
+	}
+
+	///=============================================================================
+	///						次のフレーム領域へ
+	uint64_t FrameUploadAllocator::BeginFrame() {
+		currentRegion_ = (currentRegion_ + 1) % static_cast<uint32_t>(regionFences_.size());
+		offset_ = 0;
+		failedCount_ = 0;
+		++frameSerial_;
+		return regionFences_[currentRegion_];
+	}
+
+	///=============================================================================
+	///						切り出し
+	size_t FrameUploadAllocator::Allocate(size_t size, size_t alignment) {
+		if (alignment == 0) {
+			alignment = 1;
+		}
+		size_t alignedOffset = (offset_ + alignment - 1) & ~(alignment - 1);
+		if (size > regionSize_ || alignedOffset > regionSize_ - size) {
+			++failedCount_;
+			return kInvalidOffset;
+		}
+		offset_ = alignedOffset + size;
+		if (offset_ > peakBytes_) {
+			peakBytes_ = offset_;
+		}
+		return static_cast<size_t>(currentRegion_) * regionSize_ + alignedOffset;
+	}
+
+	///=============================================================================
+	///						フレーム領域の使用終了
+	void FrameUploadAllocator::EndFrame(uint64_t fenceValue) {
+		regionFences_[currentRegion_] = fenceValue;
+	}
+}
@@ -0,0 +1,90 @@
+/*********************************************************************
+ * \file   FrameUploadAllocator.h
+ * \brief  フレーム単位のリニアアロケータ（アップロードリングのCPU側ロジック）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   1つの大きなバッファを N 個のフレーム領域に分け、領域内はバンプポインタで切り出す
+ *         このクラス自体はGPUの完了を確認しない。BeginFrame が返すフェンス値まで待つのは呼び出し側の責任で、
+ *         DirectXCore::BeginUploadFrame がその待機を行う
+ *         GPUリソースには触れないため、GPUなしで動作を確認できる（tests/FrameUploadAllocatorTest.cpp）
+ *********************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						フレーム単位のリニアアロケータ
+	class FrameUploadAllocator {
+		///--------------------------------------------------------------
+		///							メンバ関数
+	public:
+		//========================================
+		// 確保失敗を表すオフセット
+		static constexpr size_t kInvalidOffset = SIZE_MAX;
+
+		/// \brief 初期化
+		/// \param regionSize 1フレーム領域のバイト数
+		/// \param regionCount フレーム領域の数（同時に処理中のフレーム数以上）
+		void Initialize(size_t regionSize, uint32_t regionCount);
+
+		/// \brief 次のフレーム領域へ進む
+		/// \return この領域を書き込む前に完了を待つ必要があるフェンス値（0なら待ち不要）
+		uint64_t BeginFrame();
+
+		/// \brief 現在のフレーム領域から切り出す
+		/// \param size バイト数
+		/// \param alignment アライメント（2の累乗）
+		/// \return バッファ先頭からのオフセット（容量不足の場合 kInvalidOffset）
+		size_t Allocate(size_t size, size_t alignment);
+
+		/// \brief 現在のフレーム領域の使用を終了
+		/// \param fenceValue このフレームのコマンド完了時にシグナルされるフェンス値
+		void EndFrame(uint64_t fenceValue);
+
+		///--------------------------------------------------------------
+		///							入出力関数
+	public:
+		/// \brief バッファ全体のバイト数
+		size_t GetCapacity() const {
+			return regionSize_ * regionFences_.size();
+		}
+		size_t GetRegionSize() const {
+			return regionSize_;
+		}
+		uint32_t GetRegionCount() const {
+			return static_cast<uint32_t>(regionFences_.size());
+		}
+		/// \brief BeginFrame の呼び出し回数（確保したフレームの識別用）
+		uint64_t GetFrameSerial() const {
+			return frameSerial_;
+		}
+		/// \brief 現在のフレームで使用中のバイト数
+		size_t GetUsedBytes() const {
+			return offset_;
+		}
+		/// \brief これまでの1フレームあたりの最大使用バイト数
+		size_t GetPeakBytes() const {
+			return peakBytes_;
+		}
+		/// \brief 現在のフレームで確保に失敗した回数
+		uint32_t GetFailedCount() const {
+			return failedCount_;
+		}
+
+		///--------------------------------------------------------------
+		///							メンバ変数
+	private:
+		size_t regionSize_ = 0;
+		std::vector<uint64_t> regionFences_; // 領域ごとの最後に使用したフレームのフェンス値
+		uint32_t currentRegion_ = 0;
+		size_t offset_ = 0; // 現在の領域内の使用量
+		uint64_t frameSerial_ = 0;
+		size_t peakBytes_ = 0;
+		uint32_t failedCount_ = 0;
+	};
+}
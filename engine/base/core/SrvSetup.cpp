@@ -7,6 +7,9 @@
  * \note
  *********************************************************************/
 #include "SrvSetup.h"
+#include "ImguiSetup.h"
+#include "Logger.h"
+#include <format>
 ///=============================================================================
 ///                        namespace MagEngine
 namespace MagEngine {
@@ -21,26 +24,86 @@ namespace MagEngine {
 		descriptorHeap_ = dxCore_->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, kMaxSRVCount_, true);
 		// ディスクリプタ1個分のサイズを取得して記録
 		descriptorSizeSRV_ = dxCore_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		//========================================
+		// 空きリストの初期化
+		allocator_.Initialize(kMaxSRVCount_);
 	}
 
 	///=============================================================================
 	///						ループ前処理
 	void SrvSetup::PreDraw() {
+		//========================================
+		// 解放待ちのディスクリプタを回収
+		allocator_.Reclaim(dxCore_->GetCompletedFenceValue());
 		ID3D12DescriptorHeap *descriptorHeaps[] = {descriptorHeap_.Get()};
 		dxCore_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
 	}
 
 	///=============================================================================
 	///						メモリ確保
-	uint32_t SrvSetup::Allocate() {
-		// returnする番号を一旦記録
-		uint32_t index = useIndex_;
-		// 次に使用するディスクリプタのインデックスを進める
-		useIndex_++;
-		// 上で記録した番号を返す
+	uint32_t SrvSetup::Allocate(DescriptorCategory category) {
+		return AllocateRange(1, category);
+	}
+
+	///=============================================================================
+	///						連続したメモリ確保
+	uint32_t SrvSetup::AllocateRange(uint32_t count, DescriptorCategory category) {
+		uint32_t index = allocator_.Allocate(count, category);
+		if (index == DescriptorAllocator::kInvalidIndex) {
+			Logger::Log(std::format("SrvSetup: failed to allocate {} descriptors for {} (free {} / largest range {} / pending {})",
+									count, DescriptorAllocator::GetCategoryName(category), allocator_.GetFreeCount(),
+									allocator_.GetLargestFreeRange(), allocator_.GetPendingCount()),
+						Logger::LogLevel::Error);
+		}
 		return index;
 	}
 
+	///=============================================================================
+	///						解放
+	void SrvSetup::Free(uint32_t srvIndex) {
+		// COMMENT: 記録済みのコマンドが参照している可能性があるため、現フレームの完了まで再利用しない
+		if (!allocator_.Free(srvIndex, dxCore_->GetCurrentFrameFenceValue())) {
+			Logger::Log(std::format("SrvSetup: freeing unallocated descriptor {}", srvIndex), Logger::LogLevel::Warning);
+		}
+	}
+
+	///=============================================================================
+	///						使用状況の表示
+	void SrvSetup::DrawImGui() {
+		ImGui::Begin("SrvSetup");
+		ImGui::Text("Used: %u / %u (Peak %u)", allocator_.GetUsedCount(), allocator_.GetCapacity(), allocator_.GetPeakCount());
+		ImGui::Text("Pending: %u / Free ranges: %u (Largest %u)", allocator_.GetPendingCount(), allocator_.GetFreeRangeCount(), allocator_.GetLargestFreeRange());
+		ImGui::Text("Failed: %u", allocator_.GetFailedCount());
+		ImGui::Separator();
+		//========================================
+		// 用途ごとの使用状況
+		if (ImGui::BeginTable("SrvCategories", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Category");
+			ImGui::TableSetupColumn("Used");
+			ImGui::TableSetupColumn("Peak");
+			ImGui::TableSetupColumn("Alloc");
+			ImGui::TableSetupColumn("Free");
+			ImGui::TableHeadersRow();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(DescriptorCategory::Count); ++i) {
+				DescriptorCategory category = static_cast<DescriptorCategory>(i);
+				const DescriptorAllocator::CategoryStats &stats = allocator_.GetCategoryStats(category);
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(DescriptorAllocator::GetCategoryName(category));
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.usedCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.peakCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.allocateCount);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.freeCount);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::End();
+	}
+
 	///=============================================================================
 	///						SRV生成(テクスチャ用)
 	void SrvSetup::CreateSRVforTexture2D(uint32_t srvIndex, ID3D12Resource *pResource, DXGI_FORMAT format, UINT mipLevels) {
@@ -7,6 +7,7 @@
  * \note
  *********************************************************************/
 #pragma once
+#include "DescriptorAllocator.h"
 #include "DirectXCore.h"
 ///=============================================================================
 ///                        namespace MagEngine
@@ -21,18 +22,33 @@ namespace MagEngine {
 		/// \brief 初期化
 		void Initialize(DirectXCore *dxCore);
 
-		/// @brief PreDraw ループ前処理
+		/// @brief PreDraw ループ前処理（GPUが参照し終えたディスクリプタを回収する）
 		void PreDraw();
 
 		/// @brief Allocate メモリ確保
-		/// @return 確保したSRVのインデックス
-		uint32_t Allocate();
+		/// @param category 用途（使用量の集計用）
+		/// @return 確保したSRVのインデックス（満杯の場合 DescriptorAllocator::kInvalidIndex）
+		uint32_t Allocate(DescriptorCategory category = DescriptorCategory::Texture);
+
+		/// @brief AllocateRange 連続したSRVの確保（ディスクリプタテーブル用）
+		/// @param count ディスクリプタ数
+		/// @param category 用途（使用量の集計用）
+		/// @return 先頭のSRVのインデックス（空きが足りない場合 DescriptorAllocator::kInvalidIndex）
+		uint32_t AllocateRange(uint32_t count, DescriptorCategory category);
+
+		/// @brief Free SRVの解放
+		/// @param srvIndex Allocate / AllocateRange が返したインデックス
+		/// @note 現フレームのコマンドが完了するまで再利用しない
+		void Free(uint32_t srvIndex);
 
 		/// @brief IsFull SRVが満杯かどうか
-		bool IsFull() {
-			return useIndex_ >= kMaxSRVCount_;
+		bool IsFull() const {
+			return allocator_.GetFreeCount() == 0;
 		}
 
+		/// @brief DrawImGui 使用状況の表示
+		void DrawImGui();
+
 		/// \brief CreateSRVforTexture2D SRV生成(テクスチャ用)
 		/// \param srvIndex インデックス
 		/// \param pResource リソース
@@ -76,6 +92,11 @@ namespace MagEngine {
 		/// @param srvIndex SRVインデックス
 		void SetGraphicsRootDescriptorTable(uint32_t rootParameterIndex, uint32_t srvIndex);
 
+		/// @brief GetAllocator ディスクリプタの確保状況の取得
+		const DescriptorAllocator &GetAllocator() const {
+			return allocator_;
+		}
+
 		//========================================
 		// 最大SRV数
 		static const uint32_t kMaxSRVCount_ = 512;
@@ -94,7 +115,7 @@ namespace MagEngine {
 		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap_ = nullptr;
 
 		//========================================
-		// 次に使用するディスクリプタのインデックス
-		uint32_t useIndex_ = 0;
+		// ディスクリプタの空きリスト
+		DescriptorAllocator allocator_;
 	};
 }
\ No newline at end of file
@@ -57,6 +57,16 @@ namespace MagEngine {
 		// ウィンドウの生成
 		win_->CreateGameWindow(L"MagEngine_Ver1.4.6");
 
+		///--------------------------------------------------------------
+		///						 ジョブシステム
+		/// COMMENT: ワーカースレッド数はハードウェアスレッド数-1（メインスレッドも処理に参加）
+		JobSystem::GetInstance()->Initialize();
+
+		///--------------------------------------------------------------
+		///						 アセットローダー
+		/// COMMENT: デコードはワーカー、GPUへの転送は Update の先頭でメインスレッドから行う
+		AssetLoader::GetInstance()->Initialize();
+
 		///--------------------------------------------------------------
 		///						 ダイレクトX生成
 		dxCore_ = std::make_unique<DirectXCore>();
@@ -173,8 +183,6 @@ namespace MagEngine {
 		trailEffectSetup_ = std::make_unique<TrailEffectSetup>();
 		// トレイルエフェクトセットアップの初期化
 		trailEffectSetup_->Initialize(dxCore_.get());
-		// トレイルエフェクトセットアップにSrvSetupを設定
-		trailEffectSetup_->SetSrvSetup(srvSetup_.get());
 
 		///--------------------------------------------------------------
 		///						 トレイルエフェクトマネージャ
@@ -236,6 +244,10 @@ namespace MagEngine {
 	///=============================================================================
 	///						更新
 	void MagFramework::Update() {
+		//========================================
+		// 非同期読み込みが完了したアセットの登録
+		AssetLoader::GetInstance()->ProcessCompleted();
+
 		//========================================
 		// デバックカメラの呼び出し1,2
 		if (Input::GetInstance()->PushKey(DIK_1)) {
@@ -249,6 +261,10 @@ namespace MagEngine {
 		// カメラの更新
 		CameraManager::GetInstance()->UpdateAll();
 
+		//========================================
+		// カリングの視錐台の更新（カメラ更新後、各描画処理より前に1度だけ）
+		CullingManager::GetInstance()->BeginFrame(CameraManager::GetInstance()->GetCurrentCamera());
+
 		//========================================
 		// デバックテキストの更新（カメラ更新後に実行）
 		DebugTextManager::GetInstance()->SetCamera(CameraManager::GetInstance()->GetCurrentCamera());
@@ -286,6 +302,10 @@ namespace MagEngine {
 		//========================================
 		// シーンマネージャの更新
 		sceneManager_->Update();
+
+		//========================================
+		// トランスフォーム階層の更新（変更のあったオブジェクトと子のみ再計算）
+		TransformHierarchy::GetInstance()->Update();
 	}
 
 	///=============================================================================
@@ -306,6 +326,9 @@ namespace MagEngine {
 		// audioの終了処理
 		MAudioG::GetInstance()->Finalize();
 		//========================================
+		// アセットローダーの終了処理（各マネージャより先にワーカーを止める）
+		AssetLoader::GetInstance()->Finalize();
+		//========================================
 		// テクスチャマネージャの終了処理
 		TextureManager::GetInstance()->Finalize();
 		//========================================
@@ -315,6 +338,9 @@ namespace MagEngine {
 		// ラインマネージャの終了処理
 		LineManager::GetInstance()->Finalize();
 		//========================================
+		// ジョブシステムの終了処理
+		JobSystem::GetInstance()->Finalize();
+		//========================================
 		// ダイレクトX
 		dxCore_->ReleaseDirectX();
 		//========================================
@@ -389,6 +415,10 @@ namespace MagEngine {
 		trailEffectManager_->DrawImGui();
 		// ImGuiでデバッグテキストを描画
 		DebugTextManager::GetInstance()->DrawImGui();
+		// SRVヒープの使用状況
+		srvSetup_->DrawImGui();
+		// カリングのImGui描画
+		CullingManager::GetInstance()->DrawImGui();
 		// ポストエフェクトのImGui描画
 		DrawPostEffectImGui();
 #endif // DEBUG
@@ -433,6 +463,8 @@ namespace MagEngine {
 		object3dSetup_->CommonDrawSetup();
 		// 3D描画
 		sceneManager_->Object3DDraw();
+		// インスタンス描画に登録されたオブジェクトをモデルごとにまとめて描画
+		object3dSetup_->FlushInstances();
 	}
 
 	///=============================================================================
@@ -461,8 +493,10 @@ namespace MagEngine {
 		//========================================
 		// TrailEffect共通描画設定
 		trailEffectSetup_->CommonDrawSetup();
-		// TrailEffect描画
+		// TrailEffect描画（各トレイルはバッチに登録される）
 		sceneManager_->TrailEffectDraw();
+		// プリセットごとにまとめて描画
+		trailEffectSetup_->FlushBatches();
 	}
 
 	///=============================================================================
@@ -17,16 +17,19 @@
 
 //========================================
 // Framework
+#include "AssetLoader.h"
 #include "Camera.h"
 #include "DirectXCore.h"
 #if ENABLE_IMGUI
 #include "ImguiSetup.h"
 #endif
 #include "Input.h"
+#include "JobSystem.h"
 #include "SrvSetup.h"
 #include "WinApp.h"
 // Manager
 #include "CameraManager.h"
+#include "CullingManager.h"
 #include "DebugTextManager.h"
 #include "LightManager.h"
 #include "LineManager.h"
@@ -36,6 +39,7 @@
 #include "SceneFactory.h"
 #include "SceneManager.h"
 #include "TextureManager.h"
+#include "TransformHierarchy.h"
 // Setup
 #include "CloudSetup.h"
 #include "Object3dSetup.h"
@@ -155,14 +159,15 @@ namespace MagEngine {
 		// マネージャ
 		// ポストエフェクトマネージャ
 		std::unique_ptr<PostEffectManager> postEffectManager_;
+		// トレイルエフェクトマネージャ
+		// NOTE: シーン内の弾がデストラクタでプールのトレイルを返すため、シーンマネージャより先に宣言する
+		std::unique_ptr<TrailEffectManager> trailEffectManager_;
 		// シーンマネージャ
 		std::unique_ptr<SceneManager> sceneManager_;
 		// シーンファクトリー
 		std::unique_ptr<SceneFactory> sceneFactory_;
 		// ライトマネージャ
 		std::unique_ptr<LightManager> lightManager_;
-		// トレイルエフェクトマネージャ
-		std::unique_ptr<TrailEffectManager> trailEffectManager_;
 		//========================================
 		// エディター
 		std::unique_ptr<EditorLayout> editorLayout_;
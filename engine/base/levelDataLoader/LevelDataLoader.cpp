@@ -191,8 +191,7 @@ namespace MagEngine {
 		for(const auto &rootObject : levelData_.objects) {
 			if(rootObject) {
 				// 各ルートオブジェクトを再帰的にObject3Dに変換
-				MagMath::Transform rootTransform = { {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f} };
-				CreateObject3DFromLevelObject(rootObject, object3dSetup, outObjectList, rootTransform);
+				CreateObject3DFromLevelObject(rootObject, object3dSetup, outObjectList, nullptr);
 			}
 		}
 
@@ -205,7 +204,7 @@ namespace MagEngine {
 	void LevelDataLoader::CreateObject3DFromLevelObject(const std::unique_ptr<LevelObject> &levelObject,
 		Object3dSetup *object3dSetup,
 		std::vector<std::unique_ptr<Object3d>> &outObjectList,
-		const MagMath::Transform &parentTransform) {
+		const Object3d *parent) {
 		if(!levelObject) {
 			return;
 		}
@@ -238,56 +237,27 @@ namespace MagEngine {
 			}
 		}
 
-		// 親のトランスフォームと現在のオブジェクトのトランスフォームを合成
-		MagMath::Transform combinedTransform = CombineTransforms(parentTransform, levelObject->transform);
+		// 親子関係を設定し、トランスフォームは親から見たローカルの値のまま設定
+		// NOTE: ワールド行列はトランスフォーム階層で親の行列を掛けて求める
+		object3d->SetParent(parent);
+		object3d->SetTransform(levelObject->transform);
 
-		// Object3Dにトランスフォームを設定（エンジンのメソッド名に合わせる）
-		object3d->SetScale(combinedTransform.scale);
-		object3d->SetRotation(combinedTransform.rotate);
-		object3d->SetPosition(combinedTransform.translate);
-
-		// Object3Dを更新してワールド行列を確定
+		// Object3Dを更新して階層へトランスフォームを渡す
 		object3d->Update();
 
-		// リストに追加
+		// リストに追加（unique_ptrなので子から参照しても位置は変わらない）
+		const Object3d *current = object3d.get();
 		outObjectList.push_back(std::move(object3d));
 
 		// 子オブジェクトを再帰的に処理
 		for(const auto &child : levelObject->children) {
 			if(child) {
-				// 現在のオブジェクトのトランスフォームを親として子を処理
-				CreateObject3DFromLevelObject(child, object3dSetup, outObjectList, combinedTransform);
+				// 現在のオブジェクトを親として子を処理
+				CreateObject3DFromLevelObject(child, object3dSetup, outObjectList, current);
 			}
 		}
 	}
 
-	///=============================================================================
-	///                        2つのTransformを合成（親→子の順で適用）
-	MagMath::Transform LevelDataLoader::CombineTransforms(const MagMath::Transform &parent, const MagMath::Transform &child) {
-		MagMath::Transform combined;
-
-		// スケールの合成（乗算）
-		combined.scale.x = parent.scale.x * child.scale.x;
-		combined.scale.y = parent.scale.y * child.scale.y;
-		combined.scale.z = parent.scale.z * child.scale.z;
-
-		// 回転の合成（度数法での加算）
-		// 注意: 実際のゲームエンジンではクォータニオンを使用するべきだが、
-		//       ここでは簡易的にオイラー角の加算で処理
-		combined.rotate.x = parent.rotate.x + child.rotate.x;
-		combined.rotate.y = parent.rotate.y + child.rotate.y;
-		combined.rotate.z = parent.rotate.z + child.rotate.z;
-
-		// 平行移動の合成
-		// 子の位置を親のスケールとローテーションを考慮して変換
-		// 簡易実装: スケールのみ適用（回転変換は複雑なため省略）
-		combined.translate.x = parent.translate.x + ( child.translate.x * parent.scale.x );
-		combined.translate.y = parent.translate.y + ( child.translate.y * parent.scale.y );
-		combined.translate.z = parent.translate.z + ( child.translate.z * parent.scale.z );
-
-		return combined;
-	}
-
 	///=============================================================================
 	///                        ImGui描画（デバッグ用）
 	void LevelDataLoader::ImGuiDraw(std::vector<std::unique_ptr<Object3d>> &outObjectList) {
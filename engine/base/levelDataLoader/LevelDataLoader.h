@@ -95,21 +95,13 @@ namespace MagEngine {
 		/// \param levelObject 変換元のLevelObject
 		/// \param object3dSetup Object3D初期化用のセットアップクラス
 		/// \param outObjectList Object3Dを格納するリスト
-		/// \param parentTransform 親のトランスフォーム（階層構造用）
-		/// \note 子オブジェクトも再帰的に処理し、親の座標変換を適用する
+		/// \param parent 親のObject3D（ルートの場合は nullptr）
+		/// \note 子オブジェクトも再帰的に処理し、トランスフォーム階層で親の座標変換を適用する
 		///       file_nameが空のオブジェクトは空のObject3Dとして作成される
 		void CreateObject3DFromLevelObject(const std::unique_ptr<LevelObject> &levelObject,
 			Object3dSetup *object3dSetup,
 			std::vector<std::unique_ptr<Object3d>> &outObjectList,
-			const MagMath::Transform &parentTransform = { {1, 1, 1}, {0, 0, 0}, {0, 0, 0} });
-
-/// \brief 2つのTransformを合成（親→子の順で適用）
-/// \param parent 親のTransform
-/// \param child 子のTransform
-/// \return 合成されたTransform
-/// \note スケール・回転・平行移動の順で適用
-///       回転は度数法で計算される点に注意
-		MagMath::Transform CombineTransforms(const MagMath::Transform &parent, const MagMath::Transform &child);
+			const Object3d *parent = nullptr);
 
 		/// \brief Blender（右手系）からエンジン（左手系）への座標変換
 		/// \param blenderPos Blender座標系の位置ベクトル
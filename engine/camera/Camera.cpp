@@ -11,9 +11,14 @@
 //---------------------------------------
 // 自作数学関数
 #include "MagMath.h"
+#include <cstring>
 ///=============================================================================
 ///                        namespace MagEngine
 namespace MagEngine {
+	namespace {
+		// ビュープロジェクション行列の番号（カメラ間で重複しないよう全カメラで共有する）
+		uint32_t sViewProjectionVersionCounter = 0;
+	}
 
 ///=============================================================================
 ///						デフォルトコンストラクタ
@@ -25,9 +30,13 @@ namespace MagEngine {
 		, nearClipRange_(0.1f)
 		, farClipRange_(100.0f)
 		, worldMatrix_(MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate))
-		, viewMatrix_(Inverse4x4(worldMatrix_))
+		, viewMatrix_(InverseAffine4x4(worldMatrix_))
 		, projectionMatrix_(MagMath::MakePerspectiveFovMatrix(horizontalFieldOfView_, aspectRatio_, nearClipRange_, farClipRange_))
 		, viewProjectionMatrix_(Multiply4x4(viewMatrix_, projectionMatrix_)) {
+		// 構築時に求めた行列の元の値を記録
+		cachedTransform_ = transform_;
+		cachedProjection_ = {horizontalFieldOfView_, aspectRatio_, nearClipRange_, farClipRange_};
+		viewProjectionVersion_ = ++sViewProjectionVersionCounter;
 	}
 
 	///=============================================================================
@@ -38,22 +47,35 @@ namespace MagEngine {
 	///=============================================================================
 	///						更新
 	void Camera::Update() {
-		// ---------------------------------------
-		// cameraTransformからcameraMatrixを作成
-		worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
-		// cameraTransformからviewMatrixを作成
-		viewMatrix_ = Inverse4x4(worldMatrix_);
+		//---------------------------------------
+		// トランスフォームが変わった場合のみビュー行列を作り直す
+		const bool isViewDirty = std::memcmp(&transform_, &cachedTransform_, sizeof(MagMath::Transform)) != 0;
+		if (isViewDirty) {
+			// cameraTransformからcameraMatrixを作成
+			worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+			// cameraTransformからviewMatrixを作成（アフィン行列なので上3x3の逆行列で求める）
+			viewMatrix_ = InverseAffine4x4(worldMatrix_);
+			cachedTransform_ = transform_;
+		}
 
 		//---------------------------------------
-		// 正射影行列の作成
-		projectionMatrix_ = MagMath::MakePerspectiveFovMatrix(
-			horizontalFieldOfView_,
-			aspectRatio_,
-			nearClipRange_,
-			farClipRange_);
+		// 視野角・アスペクト比・クリップ距離が変わった場合のみ透視投影行列を作り直す
+		const ProjectionParams projection = {horizontalFieldOfView_, aspectRatio_, nearClipRange_, farClipRange_};
+		const bool isProjectionDirty = std::memcmp(&projection, &cachedProjection_, sizeof(ProjectionParams)) != 0;
+		if (isProjectionDirty) {
+			projectionMatrix_ = MagMath::MakePerspectiveFovMatrix(
+				horizontalFieldOfView_,
+				aspectRatio_,
+				nearClipRange_,
+				farClipRange_);
+			cachedProjection_ = projection;
+		}
 
 		//========================================
 		// ビュー・プロジェクション行列を計算
-		viewProjectionMatrix_ = MagMath::Multiply4x4(viewMatrix_, projectionMatrix_);
+		if (isViewDirty || isProjectionDirty) {
+			viewProjectionMatrix_ = MagMath::Multiply4x4(viewMatrix_, projectionMatrix_);
+			viewProjectionVersion_ = ++sViewProjectionVersionCounter;
+		}
 	}
 }
\ No newline at end of file
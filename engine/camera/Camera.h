@@ -8,6 +8,7 @@
  *********************************************************************/
 #pragma once
 #include "MagMath.h"
+#include <cstdint>
 
 ///=============================================================================
 ///                        namespace MagEngine
@@ -65,6 +66,12 @@ namespace MagEngine {
 		 */
 		const MagMath::Matrix4x4 &GetViewProjectionMatrix() const { return viewProjectionMatrix_; }
 
+		/**----------------------------------------------------------------------------
+		 * \brief  GetViewProjectionVersion ビュープロジェクション行列を作り直すたびに増える番号
+		 * \return 番号（全カメラで重複しない。利用側で行列のキャッシュが有効か判定する）
+		 */
+		uint32_t GetViewProjectionVersion() const { return viewProjectionVersion_; }
+
 		/**----------------------------------------------------------------------------
 		 * \brief  SetTransform トランスフォームの設定
 		 * \param  transform トランスフォーム
@@ -171,6 +178,20 @@ namespace MagEngine {
 		//---------------------------------------
 		// ビュープロジェクション行列
 		MagMath::Matrix4x4 viewProjectionMatrix_;
+		// ビュープロジェクション行列を作り直した回数
+		uint32_t viewProjectionVersion_ = 0;
+
+		//---------------------------------------
+		// 行列を求めたときの値（Update で変化を判定する）
+		// NOTE: GetTransform 等を経由せず値が書き換わっても検出できるよう、フラグではなく値を比較する
+		struct ProjectionParams {
+			float fovY;
+			float aspectRatio;
+			float nearClip;
+			float farClip;
+		};
+		MagMath::Transform cachedTransform_ = {};
+		ProjectionParams cachedProjection_ = {};
 
 	};
 
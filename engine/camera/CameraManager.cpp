@@ -386,6 +386,7 @@ namespace MagEngine {
 	///=============================================================================
 	///						デバッグ用の視覚情報を描画
 	void CameraManager::DrawDebugVisualizations() {
+		LineManager::CallerScope lineCaller("Camera");
 		LineManager *lineManager = LineManager::GetInstance();
 		if(!lineManager) {
 			return;
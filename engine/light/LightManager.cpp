@@ -189,6 +189,7 @@ namespace MagEngine {
 	void LightManager::DrawLightDebugLines() {
 		if (!lineManager_ || !showLightDebug_)
 			return;
+		LineManager::CallerScope lineCaller("Light");
 
 		// 現在アクティブなライトを可視化
 		if (showDirectionalLightDebug_) {
@@ -146,6 +146,57 @@ namespace MagMath {
 		return inverseMatrix;
 	}
 
+	/**----------------------------------------------------------------------------
+	 * \brief  InverseAffine4x4 アフィン行列の逆行列を求める
+	 * \param  matrix 4列目が (0, 0, 0, 1) のアフィン行列
+	 * \return Matrix4x4
+	 * \note   上3x3の逆行列（余因子の転置 / 行列式）と、平行移動に符号を反転して掛けたものから組み立てる
+	 *         回転のみなら上3x3は転置と一致する。スケールや親子合成で生じるせん断も扱える
+	 */
+	inline Matrix4x4 InverseAffine4x4(const Matrix4x4 &matrix) {
+		const auto &m = matrix.m;
+		//========================================
+		// 上3x3の余因子（転置して並べる）
+		const float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+		const float c01 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+		const float c02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+		const float c10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+		const float c11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+		const float c12 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+		const float c20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+		const float c21 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+		const float c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+		// 行列式が0の場合は逆行列は存在しない
+		const float det = m[0][0] * c00 + m[0][1] * c10 + m[0][2] * c20;
+		if (det == 0) {
+			throw std::runtime_error("Matrix is singular and cannot be inverted.");
+		}
+		const float inverseDet = 1.0f / det;
+
+		Matrix4x4 result;
+		result.m[0][0] = c00 * inverseDet;
+		result.m[0][1] = c01 * inverseDet;
+		result.m[0][2] = c02 * inverseDet;
+		result.m[0][3] = 0.0f;
+		result.m[1][0] = c10 * inverseDet;
+		result.m[1][1] = c11 * inverseDet;
+		result.m[1][2] = c12 * inverseDet;
+		result.m[1][3] = 0.0f;
+		result.m[2][0] = c20 * inverseDet;
+		result.m[2][1] = c21 * inverseDet;
+		result.m[2][2] = c22 * inverseDet;
+		result.m[2][3] = 0.0f;
+		//========================================
+		// 平行移動 = -t * (上3x3の逆行列)
+		const float tx = m[3][0], ty = m[3][1], tz = m[3][2];
+		result.m[3][0] = -(tx * result.m[0][0] + ty * result.m[1][0] + tz * result.m[2][0]);
+		result.m[3][1] = -(tx * result.m[0][1] + ty * result.m[1][1] + tz * result.m[2][1]);
+		result.m[3][2] = -(tx * result.m[0][2] + ty * result.m[1][2] + tz * result.m[2][2]);
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
 	/**----------------------------------------------------------------------------
 	 * \brief  Cofactor4x4 余因子行列を求める
 	 * \param  matrix
@@ -21,5 +21,6 @@
 
 //========================================
 // その他
+#include <BoundingSphere.h>
 #include <Transform.h>
 
@@ -0,0 +1,14 @@
+#pragma once
+#include "Vector3.h"
+
+namespace MagMath {
+
+	/// <summary>
+	/// 境界球
+	/// </summary>
+	struct BoundingSphere {
+		Vector3 center;
+		float radius;
+	};
+
+} // namespace MagMath
@@ -1,7 +1,9 @@
 #pragma once
+#include "BoundingSphere.h"
 #include "MaterialData.h"
 #include "Matrix4x4.h"
 #include "VertexData.h"
+#include <cstdint>
 #include <vector>
 
 namespace MagMath {
@@ -17,8 +19,10 @@ namespace MagMath {
 	/// @brief モデルデータ
 	struct ModelData {
 		std::vector<VertexData> vertices;
+		std::vector<uint32_t> indices; // 三角形リストのインデックス（空の場合は頂点をそのまま描画）
 		MaterialData material;
 		Node rootNode; // ルートノード
+		BoundingSphere boundingSphere = {}; // ローカル座標の境界球（読み込み時に頂点から求める）
 	};
 
 } // namespace MagMath
\ No newline at end of file
@@ -57,12 +57,8 @@ namespace MagEngine {
 			dxCore_->GetCommandList()->SetGraphicsRootSignature(dxCore_->GetRenderTextureRootSignature().Get());
 			dxCore_->GetCommandList()->SetPipelineState(dxCore_->GetRenderTexturePipelineState().Get());
 
-			D3D12_GPU_DESCRIPTOR_HANDLE srvHandle;
-			if (renderResourceIndex == 0) {
-				srvHandle = TextureManager::GetInstance()->GetSrvHandleGPU("RenderTexture0");
-			} else {
-				srvHandle = TextureManager::GetInstance()->GetSrvHandleGPU("RenderTexture1");
-			}
+			TextureManager *textureManager = TextureManager::GetInstance();
+			D3D12_GPU_DESCRIPTOR_HANDLE srvHandle = textureManager->GetSrvHandleGPU(textureManager->GetRenderTextureHandle(renderResourceIndex));
 
 			assert(srvHandle.ptr != 0);
 			dxCore_->GetCommandList()->SetGraphicsRootDescriptorTable(0, srvHandle);
@@ -111,11 +107,8 @@ namespace MagEngine {
 		}
 
 		// 入力テクスチャを設定
-		if (inputIndex == 0) {
-			srvHandle = TextureManager::GetInstance()->GetSrvHandleGPU("RenderTexture0");
-		} else {
-			srvHandle = TextureManager::GetInstance()->GetSrvHandleGPU("RenderTexture1");
-		}
+		TextureManager *textureManager = TextureManager::GetInstance();
+		srvHandle = textureManager->GetSrvHandleGPU(textureManager->GetRenderTextureHandle(inputIndex));
 
 		assert(srvHandle.ptr != 0);
 		dxCore_->GetCommandList()->SetGraphicsRootDescriptorTable(0, srvHandle);
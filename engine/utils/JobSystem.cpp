@@ -0,0 +1,162 @@
+#include "JobSystem.h"
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	JobSystem *JobSystem::instance_ = nullptr;
+
+	namespace {
+		// ジョブ実行中のスレッドか（入れ子のParallelForは直列実行）
+		thread_local bool tIsInsideJob = false;
+	}
+
+	///=============================================================================
+	///						インスタンスの取得
+	JobSystem *JobSystem::GetInstance() {
+		if (instance_ == nullptr) {
+			instance_ = new JobSystem();
+			instance_->Initialize();
+		}
+		return instance_;
+	}
+
+	///=============================================================================
+	///						初期化
+	void JobSystem::Initialize(uint32_t workerCount) {
+		if (!workers_.empty()) {
+			return;
+		}
+		if (workerCount == 0) {
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		isStopping_ = false;
+		workers_.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			workers_.emplace_back(&JobSystem::WorkerLoop, this);
+		}
+	}
+
+	///=============================================================================
+	///						終了処理
+	void JobSystem::Finalize() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isStopping_ = true;
+		}
+		wakeCondition_.notify_all();
+		for (std::thread &worker : workers_) {
+			worker.join();
+		}
+		workers_.clear();
+
+		if (instance_ == this) {
+			instance_ = nullptr;
+			delete this;
+		}
+	}
+
+	///=============================================================================
+	///						並列実行
+	void JobSystem::ParallelFor(uint32_t count, uint32_t chunkSize, ChunkFunc func, const void *context) {
+		if (count == 0 || chunkSize == 0) {
+			return;
+		}
+		uint32_t chunkCount = GetChunkCount(count, chunkSize);
+
+		//========================================
+		// 分割の必要がない場合は直列実行
+		if (chunkCount == 1 || workers_.empty() || tIsInsideJob) {
+			for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+				uint32_t begin = chunk * chunkSize;
+				uint32_t end = begin + chunkSize < count ? begin + chunkSize : count;
+				func(context, begin, end, chunk);
+			}
+			return;
+		}
+
+		//========================================
+		// バッチを公開してワーカーを起こす
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			func_ = func;
+			context_ = context;
+			count_ = count;
+			chunkSize_ = chunkSize;
+			chunkCount_ = chunkCount;
+			nextChunk_.store(0, std::memory_order_relaxed);
+			pendingChunks_.store(chunkCount, std::memory_order_relaxed);
+			++generation_;
+		}
+		wakeCondition_.notify_all();
+
+		//========================================
+		// 呼び出しスレッドも処理に参加
+		RunChunks();
+
+		//========================================
+		// 全チャンクの完了と、参加ワーカーの離脱を待つ
+		// NOTE: 離脱を待たないと次のバッチでワーカーが古い関数を実行する恐れがある
+		std::unique_lock<std::mutex> lock(mutex_);
+		doneCondition_.wait(lock, [this]() {
+			return pendingChunks_.load(std::memory_order_acquire) == 0 && activeWorkers_ == 0;
+		});
+		func_ = nullptr;
+		context_ = nullptr;
+	}
+
+	///=============================================================================
+	///						ワーカースレッドのループ
+	void JobSystem::WorkerLoop() {
+		uint64_t seenGeneration = 0;
+		tIsInsideJob = true;
+
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				wakeCondition_.wait(lock, [this, seenGeneration]() {
+					return isStopping_ || (generation_ != seenGeneration && func_ != nullptr);
+				});
+				if (isStopping_) {
+					return;
+				}
+				seenGeneration = generation_;
+				++activeWorkers_;
+			}
+
+			RunChunks();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				--activeWorkers_;
+			}
+			doneCondition_.notify_all();
+		}
+	}
+
+	///=============================================================================
+	///						チャンクの取得と実行
+	void JobSystem::RunChunks() {
+		bool wasInsideJob = tIsInsideJob;
+		tIsInsideJob = true;
+
+		while (true) {
+			uint32_t chunk = nextChunk_.fetch_add(1, std::memory_order_relaxed);
+			if (chunk >= chunkCount_) {
+				break;
+			}
+			uint32_t begin = chunk * chunkSize_;
+			uint32_t end = begin + chunkSize_ < count_ ? begin + chunkSize_ : count_;
+			func_(context_, begin, end, chunk);
+
+			if (pendingChunks_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				// 最後のチャンク：待機中の呼び出しスレッドへ通知
+				std::lock_guard<std::mutex> lock(mutex_);
+				doneCondition_.notify_all();
+			}
+		}
+
+		tIsInsideJob = wasInsideJob;
+	}
+}
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * \file   JobSystem.h
+ * \brief  ワーカースレッドによる並列実行（ParallelFor）
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   範囲をチャンクに分割し、呼び出しスレッドも含めて並列処理する
+ *         チャンク番号は決定的なので、チャンク毎の出力をその順で結合すれば結果は再現可能
+ *********************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	///=============================================================================
+	///						ジョブシステム
+	class JobSystem {
+		///--------------------------------------------------------------
+		///						 メンバ関数
+	public:
+		/// @brief チャンク処理関数（context, begin, end, chunkIndex）
+		using ChunkFunc = void (*)(const void *, uint32_t, uint32_t, uint32_t);
+
+		/// @brief インスタンスの取得
+		/// @note 未初期化の場合は既定のワーカー数で初期化する（エンジン外のツールからも利用可能）
+		static JobSystem *GetInstance();
+
+		/// @brief 初期化
+		/// @param workerCount ワーカースレッド数（0で論理コア数-1）
+		void Initialize(uint32_t workerCount = 0);
+
+		/// @brief 終了処理
+		void Finalize();
+
+		/// @brief [0, count)をchunkSize毎に分割して並列実行し、全チャンクの完了を待つ
+		/// @param count 要素数
+		/// @param chunkSize 1チャンクの要素数
+		/// @param func チャンク処理関数（begin, end, chunkIndex を受け取る呼び出し可能オブジェクト）
+		/// @note ジョブ内から呼ばれた場合は呼び出しスレッドで直列実行する
+		/// @note 関数ポインタと呼び出し元のオブジェクトのアドレスで渡すため、確保もコピーも発生しない
+		template <typename Func>
+		void ParallelFor(uint32_t count, uint32_t chunkSize, const Func &func) {
+			ParallelFor(count, chunkSize, [](const void *context, uint32_t begin, uint32_t end, uint32_t chunk) {
+				(*static_cast<const Func *>(context))(begin, end, chunk);
+			}, &func);
+		}
+
+		/// @brief ParallelFor の本体（関数ポインタとその引数で受け取る）
+		/// @param context func に渡すポインタ
+		void ParallelFor(uint32_t count, uint32_t chunkSize, ChunkFunc func, const void *context);
+
+		/// @brief チャンク数を取得（呼び出し側のチャンク毎バッファ確保用）
+		static uint32_t GetChunkCount(uint32_t count, uint32_t chunkSize) {
+			return chunkSize == 0 ? 0 : (count + chunkSize - 1) / chunkSize;
+		}
+
+		/// @brief 並列実行に参加するスレッド数（呼び出しスレッドを含む）
+		uint32_t GetThreadCount() const {
+			return static_cast<uint32_t>(workers_.size()) + 1;
+		}
+
+		///--------------------------------------------------------------
+		///						 内部処理
+	private:
+		/// @brief ワーカースレッドのループ
+		void WorkerLoop();
+
+		/// @brief 現在のバッチからチャンクを取得して実行
+		void RunChunks();
+
+		///--------------------------------------------------------------
+		///						 メンバ変数
+	private:
+		static JobSystem *instance_;
+
+		std::vector<std::thread> workers_;
+		std::mutex mutex_;
+		std::condition_variable wakeCondition_;
+		std::condition_variable doneCondition_;
+		bool isStopping_ = false;
+
+		//========================================
+		// 実行中のバッチ
+		ChunkFunc func_ = nullptr;
+		const void *context_ = nullptr;
+		uint32_t count_ = 0;
+		uint32_t chunkSize_ = 0;
+		uint32_t chunkCount_ = 0;
+		uint64_t generation_ = 0;	  ///< バッチ毎に増加（ワーカーの起床判定）
+		uint32_t activeWorkers_ = 0;  ///< バッチに参加中のワーカー数
+		std::atomic<uint32_t> nextChunk_{0};
+		std::atomic<uint32_t> pendingChunks_{0};
+	};
+}
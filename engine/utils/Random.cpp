@@ -0,0 +1,227 @@
+#include "Random.h"
+
+#if defined(__AVX2__)
+#define RANDOM_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_1__) || defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__)
+// NOTE: x64はSSE2が必ず使えるため、SSEパスを既定とする
+#define RANDOM_SSE
+#include <immintrin.h>
+#endif
+
+///=============================================================================
+///                        namespace MagEngine
+namespace MagEngine {
+	namespace {
+		//========================================
+		// 定数
+		constexpr uint32_t kCounterStep = 0x9E3779B9u; // カウンタ下位32bitの加算定数（黄金比）
+		constexpr uint32_t kCounterHighStep = 0x632BE5ABu; // カウンタ上位32bitをキーへ混ぜる定数
+		constexpr uint32_t kMixMultiplier0 = 0x7FEB352Du;
+		constexpr uint32_t kMixMultiplier1 = 0x846CA68Bu;
+		constexpr float kUnitScale = 1.0f / 16777216.0f; // 2^-24
+		constexpr uint64_t kDefaultSessionSeed = 0x4D6167456E67696Eull;
+
+		uint64_t gSessionSeed = kDefaultSessionSeed;
+
+		///=============================================================================
+		///						32bitの攪拌関数
+		inline uint32_t Mix32(uint32_t x) {
+			x ^= x >> 16;
+			x *= kMixMultiplier0;
+			x ^= x >> 15;
+			x *= kMixMultiplier1;
+			x ^= x >> 16;
+			return x;
+		}
+
+		///=============================================================================
+		///						64bitの攪拌関数（SplitMix64）
+		inline uint64_t Mix64(uint64_t x) {
+			x += 0x9E3779B97F4A7C15ull;
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+			return x ^ (x >> 31);
+		}
+
+		///=============================================================================
+		///						カウンタ上位を混ぜた第2キー
+		inline uint32_t MakeHighKey(uint64_t key, uint32_t counterHigh) {
+			return static_cast<uint32_t>(key >> 32) + counterHigh * kCounterHighStep;
+		}
+
+		///=============================================================================
+		///						(キー, カウンタ) から値を求める
+		// COMMENT: カウンタ下位を黄金比で散らしてから2段攪拌する。各段は全単射なので同じキーで値が偏らない
+		inline uint32_t Generate(uint32_t key0, uint32_t key1, uint32_t counterLow) {
+			uint32_t x = Mix32(counterLow * kCounterStep + key0);
+			return Mix32(x ^ key1);
+		}
+
+		inline float ToUnitFloat(uint32_t value) {
+			return static_cast<float>(value >> 8) * kUnitScale;
+		}
+
+#if defined(RANDOM_AVX2)
+		inline __m256i Mix32x8(__m256i x) {
+			x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+			x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(kMixMultiplier0)));
+			x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+			x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(kMixMultiplier1)));
+			return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+		}
+#elif defined(RANDOM_SSE)
+		// 32bit乗算の下位（SSE2には _mm_mullo_epi32 が無いため64bit乗算2回で求める）
+		inline __m128i MulLo32(__m128i a, __m128i b) {
+#if defined(__SSE4_1__)
+			return _mm_mullo_epi32(a, b);
+#else
+			__m128i even = _mm_mul_epu32(a, b);
+			__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+			return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+									  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+		}
+
+		inline __m128i Mix32x4(__m128i x) {
+			x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+			x = MulLo32(x, _mm_set1_epi32(static_cast<int>(kMixMultiplier0)));
+			x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+			x = MulLo32(x, _mm_set1_epi32(static_cast<int>(kMixMultiplier1)));
+			return _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+		}
+#endif
+
+		///=============================================================================
+		///						カウンタ上位が変わらない区間の一括生成
+		void FillRun(float *out, uint32_t count, uint32_t key0, uint32_t key1, uint32_t counterLow, float min, float extent) {
+			uint32_t i = 0;
+#if defined(RANDOM_AVX2)
+			const __m256i step = _mm256_set1_epi32(static_cast<int>(kCounterStep));
+			const __m256i k0 = _mm256_set1_epi32(static_cast<int>(key0));
+			const __m256i k1 = _mm256_set1_epi32(static_cast<int>(key1));
+			const __m256 scale = _mm256_set1_ps(kUnitScale);
+			const __m256 vMin = _mm256_set1_ps(min);
+			const __m256 vExtent = _mm256_set1_ps(extent);
+			__m256i counter = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(counterLow)),
+											   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+			const __m256i counterAdvance = _mm256_set1_epi32(8);
+			for (; i + 8 <= count; i += 8) {
+				__m256i x = Mix32x8(_mm256_add_epi32(_mm256_mullo_epi32(counter, step), k0));
+				x = Mix32x8(_mm256_xor_si256(x, k1));
+				__m256 unit = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8)), scale);
+				_mm256_storeu_ps(out + i, _mm256_add_ps(vMin, _mm256_mul_ps(vExtent, unit)));
+				counter = _mm256_add_epi32(counter, counterAdvance);
+			}
+#elif defined(RANDOM_SSE)
+			const __m128i step = _mm_set1_epi32(static_cast<int>(kCounterStep));
+			const __m128i k0 = _mm_set1_epi32(static_cast<int>(key0));
+			const __m128i k1 = _mm_set1_epi32(static_cast<int>(key1));
+			const __m128 scale = _mm_set1_ps(kUnitScale);
+			const __m128 vMin = _mm_set1_ps(min);
+			const __m128 vExtent = _mm_set1_ps(extent);
+			__m128i counter = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(counterLow)), _mm_setr_epi32(0, 1, 2, 3));
+			const __m128i counterAdvance = _mm_set1_epi32(4);
+			for (; i + 4 <= count; i += 4) {
+				__m128i x = Mix32x4(_mm_add_epi32(MulLo32(counter, step), k0));
+				x = Mix32x4(_mm_xor_si128(x, k1));
+				__m128 unit = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 8)), scale);
+				_mm_storeu_ps(out + i, _mm_add_ps(vMin, _mm_mul_ps(vExtent, unit)));
+				counter = _mm_add_epi32(counter, counterAdvance);
+			}
+#endif
+			// 端数（および非対応環境）はスカラーで処理
+			for (; i < count; ++i) {
+				out[i] = min + extent * ToUnitFloat(Generate(key0, key1, counterLow + i));
+			}
+		}
+	}
+
+	///=============================================================================
+	///						32bitの乱数
+	uint32_t RandomStream::NextUInt() {
+		return At(counter_++);
+	}
+
+	///=============================================================================
+	///						[0, 1) の乱数
+	float RandomStream::NextFloat() {
+		return ToUnitFloat(NextUInt());
+	}
+
+	///=============================================================================
+	///						[min, max] の整数乱数
+	int RandomStream::RangeInt(int min, int max) {
+		if (max <= min) {
+			return min;
+		}
+		// COMMENT: 32bit値と幅の積の上位を使う（剰余より偏りが小さい）
+		uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - static_cast<int64_t>(min)) + 1;
+		uint64_t offset = (static_cast<uint64_t>(NextUInt()) * span) >> 32;
+		return static_cast<int>(static_cast<int64_t>(min) + static_cast<int64_t>(offset));
+	}
+
+	///=============================================================================
+	///						一括生成
+	void RandomStream::Fill(float *out, uint32_t count, float min, float extent) {
+		const uint32_t key0 = static_cast<uint32_t>(key_);
+		while (count > 0) {
+			// カウンタ下位が一周する境界で区切る（区間内は第2キーが一定）
+			const uint32_t counterLow = static_cast<uint32_t>(counter_);
+			const uint64_t untilWrap = 0x100000000ull - counterLow;
+			const uint32_t run = untilWrap < count ? static_cast<uint32_t>(untilWrap) : count;
+			FillRun(out, run, key0, MakeHighKey(key_, static_cast<uint32_t>(counter_ >> 32)), counterLow, min, extent);
+			out += run;
+			count -= run;
+			counter_ += run;
+		}
+	}
+
+	///=============================================================================
+	///						指定カウンタの値
+	uint32_t RandomStream::At(uint64_t counter) const {
+		return Generate(static_cast<uint32_t>(key_),
+						MakeHighKey(key_, static_cast<uint32_t>(counter >> 32)),
+						static_cast<uint32_t>(counter));
+	}
+
+	///=============================================================================
+	///                        namespace Random
+	namespace Random {
+		///=============================================================================
+		///						セッションシードの設定
+		void SetSessionSeed(uint64_t seed) {
+			gSessionSeed = seed;
+		}
+
+		///=============================================================================
+		///						セッションシードの取得
+		uint64_t GetSessionSeed() {
+			return gSessionSeed;
+		}
+
+		///=============================================================================
+		///						ストリームの作成
+		RandomStream CreateStream(std::string_view systemName, uint64_t index) {
+			// システム名のハッシュ（FNV-1a）
+			uint64_t nameHash = 0xCBF29CE484222325ull;
+			for (char c : systemName) {
+				nameHash ^= static_cast<uint8_t>(c);
+				nameHash *= 0x100000001B3ull;
+			}
+			return RandomStream(Mix64(gSessionSeed ^ Mix64(nameHash + Mix64(index))));
+		}
+
+		///=============================================================================
+		///						命令セット名
+		const char *GetInstructionSetName() {
+#if defined(RANDOM_AVX2)
+			return "AVX2";
+#elif defined(RANDOM_SSE)
+			return "SSE";
+#else
+			return "Scalar";
+#endif
+		}
+	}
+}
@@ -0,0 +1,35 @@
+#include "Line.hlsli"
+
+cbuffer TransformationMatrix : register(b0)
+{
+    float4x4 WVP;
+    float4x4 World;
+    float4x4 WorldInvTranspose;
+}
+
+// 単位形状1つ分の変換と色
+struct LineShapeInstance
+{
+    float4x4 world;
+    float4 color;
+    float thickness;
+    float3 padding;
+};
+
+StructuredBuffer<LineShapeInstance> gInstances : register(t0);
+
+struct VertexShaderInput
+{
+    float3 position : POSITION0; // 単位形状の頂点
+};
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
+{
+    VertexShaderOutput output;
+    LineShapeInstance instance = gInstances[instanceId];
+    float4 worldPosition = mul(float4(input.position, 1.0f), instance.world);
+    output.position = mul(worldPosition, WVP);
+    output.color = instance.color;
+    output.thickness = instance.thickness;
+    return output;
+}
@@ -0,0 +1,20 @@
+#include "Object3d.hlsli"
+
+///=============================================================================
+///						ストラクチャードバッファ
+
+// インスタンスごとの変換行列（アップロードリング上）
+StructuredBuffer<TransformationMatrix> gInstances : register(t0);
+
+///=============================================================================
+///						VertexShader
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID){
+    VertexShaderOutput output;
+    TransformationMatrix instance = gInstances[instanceId];
+    output.texcoord = input.texcoord;
+    output.position = mul(input.position, instance.WVP);
+    output.normal = normalize(mul(input.normal, (float3x3) instance.WorldInverseTranspose));
+    output.worldPosition = (float3) mul(input.position, instance.World).xyz;
+    
+    return output;
+}
@@ -9,15 +9,16 @@
 #include "Trail.hlsli"
 
 ///=============================================================================
-///						コンスタントバッファ
+///						リソース
 
-// トレイルレンダリングパラメータ（b0）
-ConstantBuffer<TrailRenderParams> gTrailParams : register(b0);
+// トレイルごとのレンダリングパラメータと描画範囲（t0）
+StructuredBuffer<TrailInstance> gTrails : register(t0);
 
 ///=============================================================================
 ///						PixelShader
 PixelShaderOutput main(VertexShaderOutput input) {
 	PixelShaderOutput output;
+	TrailRenderParams gTrailParams = gTrails[input.trailIndex].params;
 	
 	//========================================
 	// エイジ（0.0～1.0）に基づくフェードアウト計算
@@ -9,19 +9,47 @@
 #include "Trail.hlsli"
 
 ///=============================================================================
-///						コンスタントバッファ
+///						リソース
+
+// トレイルごとのレンダリングパラメータと描画範囲（t0）
+StructuredBuffer<TrailInstance> gTrails : register(t0);
+
+// 頂点スロット（t1）
+StructuredBuffer<TrailVertex> gVertices : register(t1);
 
 // カメラ定数バッファ（b1）
 ConstantBuffer<CameraConstant> gCamera : register(b1);
 
 ///=============================================================================
 ///						VertexShader
-VertexShaderOutput main(VertexShaderInput input) {
+// vertexId は共通インデックスの値（2 * 先頭からのポイント番号 + 左右）
+VertexShaderOutput main(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID) {
 	VertexShaderOutput output;
+	TrailInstance trail = gTrails[instanceId];
+	TrailRenderParams gTrailParams = trail.params;
+	
+	//========================================
+	// 頂点スロットから頂点を引く
+	// 有効なポイントを超える分は最後のポイントに潰し、面積0の三角形にする（最も長いトレイルに合わせて描くため）
+	uint pointIndex = min(vertexId / 2, trail.pointCount - 1);
+	uint slot = (trail.head + pointIndex) % trail.pointCapacity;
+	TrailVertex input = gVertices[trail.vertexBase + slot * 2 + (vertexId & 1)];
+	
+	//========================================
+	// エイジ（0.0～1.0で正規化）を生成時刻から求める
+	float age = saturate((gTrailParams.time - input.time) / gTrailParams.lifeTime);
+	
+	//========================================
+	// カメラ方向と進行方向に垂直な幅方向を求める
+	float3 toCamera = gCamera.worldPosition - input.position;
+	toCamera = length(toCamera) > 0.001f ? normalize(toCamera) : float3(0.0f, 0.0f, 1.0f);
+	float3 normal = cross(input.tangent, toCamera);
+	normal = length(normal) > 0.001f ? normalize(normal) : float3(1.0f, 0.0f, 0.0f);
 	
 	//========================================
-	// ワールド座標をそのまま使用（CPU側で既にワールド座標に変換済み）
-	float3 worldPos = input.position;
+	// 幅を展開したワールド座標（古いポイントほど細くする）
+	float width = gTrailParams.width * (1.0f - age);
+	float3 worldPos = input.position + normal * (input.side * width);
 	
 	//========================================
 	// ビュープロジェクション変換
@@ -32,12 +60,13 @@ VertexShaderOutput main(VertexShaderInput input) {
 	output.worldPosition = worldPos;
 	
 	//========================================
-	// 法線をそのまま使用
-	output.normal = normalize(input.normal);
+	// 法線は展開した側を向ける
+	output.normal = normal * input.side;
 	
 	//========================================
-	// エイジを設定（0.0～1.0で正規化）
-	output.age = input.age;
+	// エイジを設定
+	output.age = age;
+	output.trailIndex = instanceId;
 	
 	return output;
 }
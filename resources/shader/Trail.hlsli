@@ -7,14 +7,16 @@ struct VertexShaderOutput {
 	float3 normal : NORMAL0;
 	float3 worldPosition : POSITION0;
 	float age : TEXCOORD0;
+	nointerpolation uint trailIndex : TRAILINDEX0; // バッチ内のトレイル番号
 };
 
 //========================================
-// 頂点シェーダー入力
-struct VertexShaderInput {
-	float3 position : POSITION0;
-	float age : TEXCOORD0;
-	float3 normal : NORMAL0;
+// トレイル頂点（頂点スロットのStructuredBufferの要素。1ポイントにつき左右2頂点）
+struct TrailVertex {
+	float3 position;	// ポイントの位置（中心線）
+	float time;			// ポイントの生成時刻
+	float3 tangent;		// 進行方向（正規化済み）
+	float side;			// 幅方向の符号（左:-1 / 右:+1）
 };
 
 ///=============================================================================
@@ -26,7 +28,7 @@ struct PixelShaderOutput {
 };
 
 //========================================
-// トレイルレンダリングパラメータ
+// トレイルレンダリングパラメータ（トレイルごとにStructuredBufferの1要素）
 struct TrailRenderParams {
 	float3 color;				// エフェクト色（基本色）
 	float opacity;				// 透明度 (0.0-1.0)
@@ -40,6 +42,16 @@ struct TrailRenderParams {
 	float padding;				// パディング
 };
 
+//========================================
+// まとめ描画のトレイル1本分（SV_InstanceID で参照）
+struct TrailInstance {
+	TrailRenderParams params;	// 描画パラメータ
+	uint vertexBase;			// 頂点スロットの先頭頂点番号
+	uint head;					// 最も古いポイントのリング内の番号
+	uint pointCount;			// 有効なポイント数
+	uint pointCapacity;			// リングのポイント数
+};
+
 //========================================
 // カメラ定数バッファ
 struct CameraConstant {
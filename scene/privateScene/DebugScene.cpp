@@ -16,6 +16,7 @@
 #include "ModelManager.h"
 #include "ParticlePreset.h"
 #include "SceneContext.h"
+#include "TextureManager.h"
 #include "TrailEffectManager.h"
 #include "TrailEffectPreset.h"
 #include "imgui.h"
@@ -405,6 +406,11 @@ void DebugScene::ImGuiDraw() {
 				levelDataLoader_->CreateObjectsFromLevelData(object3dSetup_, levelObjects_);
 			}
 		}
+		// テクスチャの再読み込みボタン（ハンドルはそのまま、古いSRVはフレーム完了後に解放される）
+		if (ImGui::Button("Reload Textures")) {
+			uint32_t reloadedCount = TextureManager::GetInstance()->ReloadAllTextures();
+			Logger::Log("DebugScene: reloaded " + std::to_string(reloadedCount) + " textures", Logger::LogLevel::Info);
+		}
 
 		ImGui::Separator();
 		// レベルオブジェクトの操作UI
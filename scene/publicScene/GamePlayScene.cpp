@@ -21,6 +21,7 @@
 #include "Player.h"
 #include "SceneTransition.h"
 #include "Skydome.h"
+#include "TrailEffectManager.h"
 using namespace MagEngine;
 
 ///=============================================================================
@@ -86,8 +87,10 @@ void GamePlayScene::Initialize(SceneContext *context) {
 	// 爆発エフェクト用の複数の形状を作成
 	// 1. メインの爆発エフェクト（Board形状 - 火花）
 	particle_->CreateParticleGroup("ExplosionSparks", "circle2.dds", ParticleShape::Board);
-	// 2. リング形状の衝撃波（ヒットリアクション用にも使用）
+	// 2. リング形状の衝撃波（ヒットリアクション用にも使用。向きを固定するためビルボードなし）
+	particle_->SetBillboard(false);
 	particle_->CreateParticleGroup("ExplosionRing", "circle2.dds", ParticleShape::Ring);
+	particle_->SetBillboard(true);
 	// 3. シリンダー形状の煙柱
 	particle_->CreateParticleGroup("ExplosionSmoke", "circle2.dds", ParticleShape::Cylinder);
 
@@ -147,15 +150,21 @@ void GamePlayScene::Initialize(SceneContext *context) {
 	player_->SetEnemyManager(enemyManager_.get());
 
 	// プレイヤーにTrailEffectManagerを設定（弾・ミサイルトレイル用）
-	MagEngine::TrailEffectManager *trailEffectManager = context->GetTrailEffectManager();
-	if (trailEffectManager) {
-		player_->SetTrailEffectManager(trailEffectManager);
+	trailEffectManager_ = context->GetTrailEffectManager();
+	if (trailEffectManager_) {
+		player_->SetTrailEffectManager(trailEffectManager_);
 	}
 
 	//========================================
 	// 当たり判定（軽量システムで初期化）
 	collisionManager_ = std::make_unique<CollisionManager>();
 	collisionManager_->Initialize(32.0f, 256); // セルサイズ32.0f、最大256オブジェクト
+	// プレイヤーにCollisionManagerを設定（ロックオン・ミサイルの空間クエリ用）
+	player_->SetCollisionManager(collisionManager_.get());
+	// 当たり判定は生成時に1度だけ登録し、削除時に登録解除する（衝突IDと接触状態をフレーム間で保つ）
+	// NOTE: 敵・弾・ミサイルは各管理クラスがスポーン時に登録する
+	collisionManager_->RegisterObject(player_.get());
+	enemyManager_->SetCollisionManager(collisionManager_.get());
 
 	//========================================
 	// 敵の位置にデバッグテキストを配置（固定位置）
@@ -542,43 +551,8 @@ void GamePlayScene::Update() {
 	}
 
 	//=========================================
-	//  当たり判定（最適化済み）
-	//  リセットではなく登録解除/登録で管理
-	collisionManager_->Reset(); // 一旦リセット（簡単のため）
-	//  プレイヤーの当たり判定を登録
-	if (player_) {
-		collisionManager_->RegisterObject(player_.get());
-	}
-	//  敵の当たり判定を登録
-	if (enemyManager_) {
-		enemyManager_->RegisterCollisions(collisionManager_.get());
-	}
-	//  プレイヤーの弾とミサイルの当たり判定を登録
-	if (player_) {
-		const auto &bullets = player_->GetBullets();
-		for (const auto &bullet : bullets) {
-			if (bullet->IsAlive()) {
-				collisionManager_->RegisterObject(bullet.get());
-			}
-		}
-
-		const auto &missiles = player_->GetMissiles();
-		for (const auto &missile : missiles) {
-			if (missile->IsAlive()) {
-				collisionManager_->RegisterObject(missile.get());
-			}
-		}
-	}
-	//  敵の弾の当たり判定を登録
-	if (enemyManager_) {
-		auto enemyBullets = enemyManager_->GetAllEnemyBullets();
-		for (auto *bullet : enemyBullets) {
-			if (bullet) {
-				collisionManager_->RegisterObject(bullet);
-			}
-		}
-	}
 	//  当たり判定の更新
+	//  NOTE: 登録は生成時、登録解除は削除時に各管理クラスが行うため、ここでは判定のみ
 	collisionManager_->Update();
 
 #ifdef _DEBUG
@@ -678,10 +652,9 @@ void GamePlayScene::CloudDraw() {
 ///=============================================================================
 ///						TrailEffect描画
 void GamePlayScene::TrailEffectDraw() {
-	// プレイヤーの弾のトレイル描画
-	if (player_) {
-		player_->DrawBulletsTrails();
-		player_->DrawMissilesTrails();
+	// プレイヤーの弾のトレイル描画（返却済みでフェード中のトレイルも含む）
+	if (trailEffectManager_) {
+		trailEffectManager_->Draw();
 	}
 }
 
@@ -782,6 +755,16 @@ void GamePlayScene::ImGuiDraw() {
 		ImGui::End();
 	}
 
+	//========================================
+	// パーティクル ウィンドウ
+	{
+		ImGui::SetNextWindowPos(ImVec2(800.0f, 300.0f), ImGuiCond_FirstUseEver);
+		ImGui::SetNextWindowSize(ImVec2(400.0f, 300.0f), ImGuiCond_FirstUseEver);
+		ImGui::Begin("Particle Debug");
+		particle_->DrawImGui();
+		ImGui::End();
+	}
+
 	//========================================
 	// UI系 - UIManagerが独立したウィンドウを管理するため、
 	// 外側のウィンドウなしで直接呼び出す
@@ -36,6 +36,9 @@ class Player;
 class EnemyManager;
 class SceneTransition;
 class SceneContext;
+namespace MagEngine {
+	class TrailEffectManager;
+}
 
 ///=============================================================================
 ///                         ゲームプレイシーンクラス
@@ -123,6 +126,10 @@ private:
 	// UI管理
 	std::unique_ptr<UIManager> uiManager_;
 
+	//========================================
+	// トレイルエフェクト管理（弾・ミサイルのトレイルを描画）
+	MagEngine::TrailEffectManager *trailEffectManager_ = nullptr;
+
 	//========================================
 	// ゲーム状態
 	bool isGameOver_;
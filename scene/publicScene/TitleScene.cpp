@@ -29,48 +29,9 @@ void TitleScene::Initialize(SceneContext *context) {
 
 	//========================================
 	// 読み込み関係
-	// TextureManager::GetInstance()->LoadTexture(".dds");
-	// スプライト
-	TextureManager::GetInstance()->LoadTexture("uvChecker.dds");
-	// 演出系
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Title.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Triangle.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_PressEnter.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_PressA.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Engage.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_GameOver.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Comprete.dds");
-	// 操作ガイドUI
-	TextureManager::GetInstance()->LoadTexture("xbox_button_color_a.dds");
-	TextureManager::GetInstance()->LoadTexture("xbox_button_color_b.dds");
-	TextureManager::GetInstance()->LoadTexture("xbox_button_color_x.dds");
-	TextureManager::GetInstance()->LoadTexture("xbox_button_color_y.dds");
-	TextureManager::GetInstance()->LoadTexture("xbox_rt.dds");
-	TextureManager::GetInstance()->LoadTexture("xbox_ls.dds");
-	TextureManager::GetInstance()->LoadTexture("white1x1.dds"); // トランジション用
-	// 操作テキスト
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Dodge.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_MachineGun.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_ControlStick.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Missile.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Test.dds");
-	// メニューテキスト
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Resume.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Controls.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_ReturntoTitle.dds");
-	TextureManager::GetInstance()->LoadTexture("WolfOne_Pause.dds");
-	// モデル
-	ModelManager::GetInstance()->LoadModel("jet.obj"); // モデルは事前にロードしておく
-	ModelManager::GetInstance()->LoadModel("Missile.obj");
-	ModelManager::GetInstance()->LoadModel("Bullet.obj");  // 弾のモデル
-	ModelManager::GetInstance()->LoadModel("ground.obj");  // 地形のモデル
-	ModelManager::GetInstance()->LoadModel("skydome.obj"); // 地面のモデルもロード
-	// スカイボックス
-	TextureManager::GetInstance()->LoadTexture("rostock_laage_airport_4k.dds");
-	TextureManager::GetInstance()->LoadTexture("qwantani_dusk_2_puresky_4k.dds");
-	TextureManager::GetInstance()->LoadTexture("overcast_soil_puresky_4k.dds");
-	TextureManager::GetInstance()->LoadTexture("moonless_golf_4k.dds");
-	TextureManager::GetInstance()->LoadTexture("kloppenheim_02_puresky_4k.dds");
+	// NOTE: スプライト・演出・操作ガイド・モデル・スカイボックスの一覧は resources/manifest/TitleScene.json
+	// デコードはワーカーで並列に行い、全て揃うまで待つ
+	AssetLoader::GetInstance()->Wait(AssetLoader::GetInstance()->PreloadManifest("resources/manifest/TitleScene.json"));
 
 	//========================================
 	// カメラ設定
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * \file   DescriptorAllocatorTest.cpp
+ * \brief  DescriptorAllocator のテスト
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   フェンス待ちの解放・隣接範囲の結合・最小の空き範囲からの切り出しを確認する
+ *********************************************************************/
+#include "DescriptorAllocator.h"
+#include "TestCommon.h"
+
+using namespace MagEngine;
+
+///=============================================================================
+///						テスト本体
+int RunDescriptorAllocatorTests() {
+	int failures = 0;
+
+	//========================================
+	// 確保と連続範囲
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(16);
+		const uint32_t a = allocator.Allocate(1, DescriptorCategory::Texture);
+		const uint32_t table = allocator.Allocate(4, DescriptorCategory::StructuredBuffer);
+		MAG_TEST_CHECK(a == 0);
+		MAG_TEST_CHECK(table == 1);
+		MAG_TEST_CHECK(allocator.GetUsedCount() == 5);
+		MAG_TEST_CHECK(allocator.GetFreeCount() == 11);
+		MAG_TEST_CHECK(allocator.Allocate(12, DescriptorCategory::Texture) == DescriptorAllocator::kInvalidIndex);
+		MAG_TEST_CHECK(allocator.Allocate(0, DescriptorCategory::Texture) == DescriptorAllocator::kInvalidIndex);
+		MAG_TEST_CHECK(allocator.GetFailedCount() == 2);
+		MAG_TEST_CHECK(allocator.GetCategoryStats(DescriptorCategory::StructuredBuffer).usedCount == 4);
+	}
+
+	//========================================
+	// フェンス待ちの解放（完了するまで再利用しない）
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(4);
+		const uint32_t a = allocator.Allocate(2, DescriptorCategory::Texture);
+		const uint32_t b = allocator.Allocate(2, DescriptorCategory::Texture);
+		MAG_TEST_CHECK(allocator.Free(a, 10));
+		MAG_TEST_CHECK(!allocator.Free(a, 10));
+		MAG_TEST_CHECK(allocator.GetPendingCount() == 2);
+		MAG_TEST_CHECK(allocator.Allocate(1, DescriptorCategory::Texture) == DescriptorAllocator::kInvalidIndex);
+		MAG_TEST_CHECK(allocator.Reclaim(9) == 0);
+		MAG_TEST_CHECK(allocator.Reclaim(10) == 2);
+		MAG_TEST_CHECK(allocator.GetPendingCount() == 0);
+		MAG_TEST_CHECK(allocator.Allocate(2, DescriptorCategory::Texture) == a);
+		MAG_TEST_CHECK(allocator.Free(b, 0));
+		MAG_TEST_CHECK(allocator.GetFreeCount() == 2);
+	}
+
+	//========================================
+	// フェンス値が前後して解放されても、完了した分だけ回収する
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(3);
+		const uint32_t a = allocator.Allocate(1, DescriptorCategory::Texture);
+		const uint32_t b = allocator.Allocate(1, DescriptorCategory::Texture);
+		const uint32_t c = allocator.Allocate(1, DescriptorCategory::Texture);
+		allocator.Free(a, 30);
+		allocator.Free(b, 10);
+		allocator.Free(c, 20);
+		MAG_TEST_CHECK(allocator.Reclaim(20) == 2);
+		MAG_TEST_CHECK(allocator.GetPendingCount() == 1);
+		MAG_TEST_CHECK(allocator.GetLargestFreeRange() == 2);
+		MAG_TEST_CHECK(allocator.Reclaim(30) == 1);
+	}
+
+	//========================================
+	// 隣接する空き範囲の結合
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(8);
+		uint32_t indices[4];
+		for (uint32_t &index : indices) {
+			index = allocator.Allocate(2, DescriptorCategory::Texture);
+		}
+		allocator.Free(indices[0], 0);
+		allocator.Free(indices[2], 0);
+		MAG_TEST_CHECK(allocator.GetFreeRangeCount() == 2);
+		allocator.Free(indices[1], 0);
+		MAG_TEST_CHECK(allocator.GetFreeRangeCount() == 1);
+		MAG_TEST_CHECK(allocator.GetLargestFreeRange() == 6);
+		allocator.Free(indices[3], 0);
+		MAG_TEST_CHECK(allocator.GetLargestFreeRange() == 8);
+		MAG_TEST_CHECK(allocator.GetUsedCount() == 0);
+	}
+
+	//========================================
+	// 収まる中で最小の空き範囲から切り出す（大きな空き範囲を残す）
+	{
+		DescriptorAllocator allocator;
+		allocator.Initialize(10);
+		const uint32_t a = allocator.Allocate(3, DescriptorCategory::Texture); // [0, 3)
+		allocator.Allocate(1, DescriptorCategory::Texture);					  // [3, 4)
+		const uint32_t c = allocator.Allocate(1, DescriptorCategory::Texture); // [4, 5)
+		allocator.Allocate(1, DescriptorCategory::Texture);					  // [5, 6)
+		allocator.Free(a, 0);												  // 空き: [0, 3) と [6, 10)
+		allocator.Free(c, 0);												  // 空き: [4, 5) が増える
+		MAG_TEST_CHECK(allocator.Allocate(1, DescriptorCategory::Texture) == 4);
+		MAG_TEST_CHECK(allocator.Allocate(3, DescriptorCategory::Texture) == 0);
+		MAG_TEST_CHECK(allocator.GetLargestFreeRange() == 4);
+		MAG_TEST_CHECK(allocator.GetPeakCount() == 6);
+	}
+	return failures;
+}
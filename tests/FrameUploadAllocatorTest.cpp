@@ -0,0 +1,61 @@
+/*********************************************************************
+ * \file   FrameUploadAllocatorTest.cpp
+ * \brief  FrameUploadAllocator のテスト
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   領域内の切り出し・アライメント・容量不足・領域の巡回と再利用前に待つフェンス値を確認する
+ *********************************************************************/
+#include "FrameUploadAllocator.h"
+#include "TestCommon.h"
+
+using namespace MagEngine;
+
+///=============================================================================
+///						テスト本体
+int RunFrameUploadAllocatorTests() {
+	int failures = 0;
+
+	//========================================
+	// 領域内の切り出しとアライメント
+	{
+		FrameUploadAllocator allocator;
+		allocator.Initialize(1024, 3);
+		MAG_TEST_CHECK(allocator.GetCapacity() == 3072);
+		MAG_TEST_CHECK(allocator.BeginFrame() == 0);
+		MAG_TEST_CHECK(allocator.Allocate(10, 4) == 0);
+		MAG_TEST_CHECK(allocator.Allocate(16, 256) == 256);
+		MAG_TEST_CHECK(allocator.Allocate(1, 0) == 272);
+		MAG_TEST_CHECK(allocator.GetUsedBytes() == 273);
+		// 容量不足は失敗として数え、使用量は変えない
+		MAG_TEST_CHECK(allocator.Allocate(1024, 4) == FrameUploadAllocator::kInvalidOffset);
+		MAG_TEST_CHECK(allocator.Allocate(800, 256) == FrameUploadAllocator::kInvalidOffset);
+		MAG_TEST_CHECK(allocator.GetFailedCount() == 2);
+		MAG_TEST_CHECK(allocator.GetUsedBytes() == 273);
+		MAG_TEST_CHECK(allocator.Allocate(751, 1) == 273);
+		MAG_TEST_CHECK(allocator.GetUsedBytes() == 1024);
+		MAG_TEST_CHECK(allocator.GetPeakBytes() == 1024);
+	}
+
+	//========================================
+	// 領域の巡回と、再利用前に待つフェンス値
+	{
+		FrameUploadAllocator allocator;
+		allocator.Initialize(256, 3);
+		for (uint64_t frame = 1; frame <= 7; ++frame) {
+			const uint64_t waitFence = allocator.BeginFrame();
+			// 3フレーム前に同じ領域を使ったフレームのフェンス値を返す
+			MAG_TEST_CHECK(waitFence == (frame > 3 ? (frame - 3) * 10 : 0));
+			MAG_TEST_CHECK(allocator.GetFrameSerial() == frame);
+			MAG_TEST_CHECK(allocator.GetFailedCount() == 0);
+			MAG_TEST_CHECK(allocator.GetUsedBytes() == 0);
+			MAG_TEST_CHECK(allocator.Allocate(16, 16) == ((frame - 1) % 3) * 256);
+			if (frame == 2) {
+				allocator.Allocate(512, 16);
+			}
+			allocator.EndFrame(frame * 10);
+		}
+		MAG_TEST_CHECK(allocator.GetPeakBytes() == 16);
+	}
+	return failures;
+}
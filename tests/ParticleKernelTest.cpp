@@ -0,0 +1,39 @@
+/*********************************************************************
+ * \file   ParticleKernelTest.cpp
+ * \brief  ParticlePool / ParticleKernel のテスト
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   従来の std::list 方式と同じ出力になるかを、消滅を含むフレームで比較する
+ *********************************************************************/
+#include "ParticleBenchmark.h"
+#include "ParticleKernel.h"
+#include "TestCommon.h"
+
+using namespace MagEngine;
+
+///=============================================================================
+///						テスト本体
+int RunParticleKernelTests() {
+	int failures = 0;
+	std::printf("  kernel: %s\n", ParticleKernel::GetInstructionSetName());
+
+	//========================================
+	// SIMDの端数処理も通るよう、8の倍数でない数も含めて比較する
+	for (uint32_t particleCount : {1u, 7u, 513u, 4096u}) {
+		for (uint32_t seed : {12345u, 67890u}) {
+			const ParticleBenchmark::Accuracy accuracy = ParticleBenchmark::VerifyKernel(particleCount, 30, 1.0e-4f, seed);
+			std::printf("  particles=%u seed=%u compared=%u expired=%u maxError=%g\n",
+						particleCount, seed, accuracy.comparedInstances, accuracy.expiredInstances, accuracy.maxError);
+			MAG_TEST_CHECK(accuracy.passed);
+			MAG_TEST_CHECK(accuracy.comparedInstances > 0);
+		}
+	}
+
+	//========================================
+	// 寿命の尽きるパーティクルが実際に含まれていること
+	const ParticleBenchmark::Accuracy accuracy = ParticleBenchmark::VerifyKernel(4096, 30);
+	MAG_TEST_CHECK(accuracy.expiredInstances > 0);
+	MAG_TEST_CHECK(accuracy.expiredInstances < 4096);
+	return failures;
+}
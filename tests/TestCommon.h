@@ -0,0 +1,29 @@
+/*********************************************************************
+ * \file   TestCommon.h
+ * \brief  テスト共通の判定マクロ
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   ウィンドウ・D3D12デバイス・ImGuiを使わないコンソール実行用
+ *         失敗は標準出力に書き出し、テスト関数は失敗数を返す
+ *********************************************************************/
+#pragma once
+#include <cstdio>
+
+//========================================
+// 条件を判定し、失敗なら失敗数を数える
+// NOTE: 呼び出し側の関数に int failures が必要
+#define MAG_TEST_CHECK(condition)                                                          \
+	do {                                                                                   \
+		if (!(condition)) {                                                                \
+			std::printf("  FAILED: %s (%s:%d)\n", #condition, __FILE__, __LINE__);         \
+			++failures;                                                                    \
+		}                                                                                  \
+	} while (false)
+
+///=============================================================================
+///						テスト関数（失敗数を返す）
+int RunParticleKernelTests();
+int RunDescriptorAllocatorTests();
+int RunFrameUploadAllocatorTests();
+int RunTransformHierarchyTests();
@@ -0,0 +1,36 @@
+/*********************************************************************
+ * \file   TestMain.cpp
+ * \brief  テストのエントリーポイント
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   CIから実行し、失敗があれば終了コード1を返す
+ *********************************************************************/
+#include "TestCommon.h"
+
+int main() {
+	//========================================
+	// テスト一覧
+	struct TestCase {
+		const char *name;
+		int (*run)();
+	};
+	const TestCase tests[] = {
+		{"ParticleKernel", RunParticleKernelTests},
+		{"DescriptorAllocator", RunDescriptorAllocatorTests},
+		{"FrameUploadAllocator", RunFrameUploadAllocatorTests},
+		{"TransformHierarchy", RunTransformHierarchyTests},
+	};
+
+	//========================================
+	// 実行
+	int totalFailures = 0;
+	for (const TestCase &test : tests) {
+		std::printf("[ RUN  ] %s\n", test.name);
+		const int failures = test.run();
+		std::printf("[ %s ] %s\n", failures == 0 ? " OK " : "FAIL", test.name);
+		totalFailures += failures;
+	}
+	std::printf("%d failure(s)\n", totalFailures);
+	return totalFailures == 0 ? 0 : 1;
+}
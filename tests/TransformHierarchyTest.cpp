@@ -0,0 +1,121 @@
+/*********************************************************************
+ * \file   TransformHierarchyTest.cpp
+ * \brief  TransformHierarchy のテスト
+ *
+ * \author Harukichimaru
+ * \date   January 2025
+ * \note   作成・破棄・親の付け替えを無作為に繰り返し、親をたどって計算したワールド行列と一致するかを確認する
+ *********************************************************************/
+#include "TransformHierarchy.h"
+#include "TestCommon.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace MagEngine;
+
+namespace {
+	///=============================================================================
+	///						親をたどってワールド行列を計算する（比較用）
+	MagMath::Matrix4x4 ComputeWorld(const TransformHierarchy &hierarchy, const std::vector<MagMath::Transform> &locals, uint32_t node) {
+		const MagMath::Transform &local = locals[node];
+		const MagMath::Matrix4x4 localMatrix = MagMath::MakeAffineMatrix(local.scale, local.rotate, local.translate);
+		const uint32_t parent = hierarchy.GetParent(node);
+		if (parent == TransformHierarchy::kInvalidNode) {
+			return localMatrix;
+		}
+		return MagMath::Multiply4x4(localMatrix, ComputeWorld(hierarchy, locals, parent));
+	}
+
+	///=============================================================================
+	///						行列の差の最大値
+	float MaxDifference(const MagMath::Matrix4x4 &a, const MagMath::Matrix4x4 &b) {
+		float maxError = 0.0f;
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				maxError = std::fmax(maxError, std::fabs(a.m[row][column] - b.m[row][column]));
+			}
+		}
+		return maxError;
+	}
+}
+
+///=============================================================================
+///						テスト本体
+int RunTransformHierarchyTests() {
+	int failures = 0;
+
+	//========================================
+	// 子を持つノードの破棄で子が親なしになる
+	{
+		TransformHierarchy hierarchy;
+		const uint32_t parent = hierarchy.CreateNode();
+		const uint32_t child = hierarchy.CreateNode();
+		const uint32_t other = hierarchy.CreateNode();
+		MAG_TEST_CHECK(hierarchy.SetParent(child, parent));
+		MAG_TEST_CHECK(!hierarchy.SetParent(parent, child));
+		hierarchy.SetLocalTransform(parent, {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f}});
+		hierarchy.Update();
+		MAG_TEST_CHECK(hierarchy.GetWorldMatrix(child).m[3][0] == 5.0f);
+		hierarchy.DestroyNode(parent);
+		MAG_TEST_CHECK(hierarchy.GetParent(child) == TransformHierarchy::kInvalidNode);
+		hierarchy.Update();
+		MAG_TEST_CHECK(hierarchy.GetWorldMatrix(child).m[3][0] == 0.0f);
+		// 親なしで変更の無いノードは再計算しない
+		MAG_TEST_CHECK(hierarchy.GetLastUpdatedCount() == 1);
+		hierarchy.DestroyNode(other);
+		hierarchy.Update();
+		MAG_TEST_CHECK(hierarchy.GetLastUpdatedCount() == 0);
+		MAG_TEST_CHECK(hierarchy.GetNodeCount() == 1);
+	}
+
+	//========================================
+	// 無作為な操作の後も、親をたどって計算した結果と一致する
+	for (uint32_t seed : {1u, 2u, 3u}) {
+		TransformHierarchy hierarchy;
+		std::mt19937 engine(seed);
+		std::uniform_real_distribution<float> valueDist(-2.0f, 2.0f);
+		std::vector<MagMath::Transform> locals;
+		std::vector<uint32_t> liveNodes;
+		float maxError = 0.0f;
+		for (uint32_t frame = 0; frame < 200; ++frame) {
+			for (uint32_t operation = 0; operation < 16; ++operation) {
+				const uint32_t kind = engine() % 8;
+				if (liveNodes.size() < 4 || kind < 2) {
+					const uint32_t node = hierarchy.CreateNode();
+					if (locals.size() <= node) {
+						locals.resize(node + 1);
+					}
+					locals[node] = {{1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+					liveNodes.push_back(node);
+				} else if (kind < 4) {
+					const size_t index = engine() % liveNodes.size();
+					hierarchy.DestroyNode(liveNodes[index]);
+					liveNodes[index] = liveNodes.back();
+					liveNodes.pop_back();
+				} else if (kind < 6) {
+					const uint32_t node = liveNodes[engine() % liveNodes.size()];
+					const uint32_t parent = engine() % 4 == 0 ? TransformHierarchy::kInvalidNode : liveNodes[engine() % liveNodes.size()];
+					if (parent != node) {
+						hierarchy.SetParent(node, parent);
+					}
+				} else {
+					const uint32_t node = liveNodes[engine() % liveNodes.size()];
+					locals[node] = {{1.0f, 1.0f, 1.0f},
+									{valueDist(engine), valueDist(engine), valueDist(engine)},
+									{valueDist(engine), valueDist(engine), valueDist(engine)}};
+					hierarchy.SetLocalTransform(node, locals[node]);
+				}
+			}
+			hierarchy.Update();
+			for (uint32_t node : liveNodes) {
+				maxError = std::fmax(maxError, MaxDifference(hierarchy.GetWorldMatrix(node), ComputeWorld(hierarchy, locals, node)));
+			}
+			MAG_TEST_CHECK(!hierarchy.IsDirty());
+			MAG_TEST_CHECK(hierarchy.GetNodeCount() == liveNodes.size());
+		}
+		std::printf("  seed=%u nodes=%u maxError=%g\n", seed, hierarchy.GetNodeCount(), maxError);
+		MAG_TEST_CHECK(maxError < 1.0e-3f);
+	}
+	return failures;
+}